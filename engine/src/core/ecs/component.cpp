@@ -2,5 +2,5 @@
 
 namespace Sunset
 {
-	int g_component_counter = 0;
+	std::atomic_int g_component_counter{ 0 };
 }
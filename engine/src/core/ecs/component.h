@@ -3,13 +3,15 @@
 #include <minimal.h>
 #include <bit_vector.h>
 
+#include <atomic>
+
 namespace Sunset
 {
 	constexpr int MAX_COMPONENTS = 32;
 
 	using ComponentMask = BitVector<MAX_COMPONENTS>;
 
-	extern int g_component_counter;
+	extern std::atomic_int g_component_counter;
 
 	template<class T>
 	int get_component_id()
@@ -58,6 +58,68 @@ namespace Sunset
 
 		body_comp->body_data.dirty_flags |= PhysicsBodyDirtyFlags::BODY;
 	}
+	// Batched version of set_body_shape for spawning many bodies at once. Bodies are grouped by body type and damping,
+	// and each group shares one shape built from shape_data.
+	template<typename T>
+	void set_body_shapes(BodyComponent* const* body_comps, uint32_t count, T shape_data)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		PhysicsContext* const phys_context = Physics::get()->context();
+
+		std::vector<uint32_t> order(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			assert(body_comps[i] != nullptr && "Cannot set body shape on a null body component!");
+			if (body_comps[i]->body_data.body >= 0)
+			{
+				phys_context->destroy_body(body_comps[i]->body_data.body);
+			}
+			order[i] = i;
+		}
+
+		const auto batch_key = [body_comps](uint32_t index)
+		{
+			const PhysicsBodyData& body_data = body_comps[index]->body_data;
+			return std::make_tuple(body_data.body_type, body_data.linear_damping, body_data.angular_damping);
+		};
+		std::stable_sort(order.begin(), order.end(), [&batch_key](uint32_t a, uint32_t b) { return batch_key(a) < batch_key(b); });
+
+		std::vector<glm::vec3> positions(count);
+		std::vector<glm::quat> rotations(count);
+		std::vector<BodyHandle> bodies(count);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			positions[i] = body_comps[order[i]]->body_data.position;
+			rotations[i] = body_comps[order[i]]->body_data.rotation;
+		}
+
+		uint32_t batch_start = 0;
+		while (batch_start < count)
+		{
+			uint32_t batch_end = batch_start + 1;
+			while (batch_end < count && batch_key(order[batch_end]) == batch_key(order[batch_start]))
+			{
+				++batch_end;
+			}
+
+			const PhysicsBodyData& batch_body_data = body_comps[order[batch_start]]->body_data;
+			phys_context->create_bodies(shape_data, batch_end - batch_start, positions.data() + batch_start, rotations.data() + batch_start, batch_body_data.body_type, batch_body_data.linear_damping, batch_body_data.angular_damping, bodies.data() + batch_start);
+
+			batch_start = batch_end;
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			body_comps[order[i]]->body_data.body = bodies[i];
+			body_comps[order[i]]->body_data.dirty_flags |= PhysicsBodyDirtyFlags::BODY;
+		}
+	}
+
 	void set_body_position(BodyComponent* body_comp, const glm::vec3& position);
 	void set_body_rotation(BodyComponent* body_comp, const glm::vec3& rotation);
 	void set_body_velocity(BodyComponent* body_comp, const glm::vec3& velocity);
@@ -134,4 +134,17 @@ namespace Sunset
 			set_frame_jitter_enabled(camera_comp, b_enabled);
 		}
 	}
+
+	void set_distance_cull_enabled(CameraControlComponent* camera_comp, bool b_enabled)
+	{
+		camera_comp->data.b_distance_cull = b_enabled;
+	}
+
+	void set_distance_cull_enabled(class Scene* scene, EntityID entity, bool b_enabled)
+	{
+		if (CameraControlComponent* const camera_comp = scene->get_component<CameraControlComponent>(entity))
+		{
+			set_distance_cull_enabled(camera_comp, b_enabled);
+		}
+	}
 }
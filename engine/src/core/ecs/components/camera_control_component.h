@@ -36,6 +36,8 @@ namespace Sunset
 		glm::vec3 forward{ 0.0f, 0.0f, -1.0f };
 		CameraData gpu_data;
 		bool b_frame_jitter{ true };
+		// Whether the near and far planes cull meshes, on the GPU and in the CPU pre-cull alike
+		bool b_distance_cull{ true };
 		int32_t current_jitter_index{ -1 };
 	};
 
@@ -60,6 +62,7 @@ namespace Sunset
 	void set_move_speed(CameraControlComponent* camera_comp, float new_move_speed);
 	void set_look_speed(CameraControlComponent* camera_comp, float new_look_speed);
 	void set_frame_jitter_enabled(CameraControlComponent* camera_comp, bool b_enabled);
+	void set_distance_cull_enabled(CameraControlComponent* camera_comp, bool b_enabled);
 
 	void set_camera_fov(class Scene* scene, EntityID entity, float new_fov);
 	void set_camera_aspect_ratio(class Scene* scene, EntityID entity, float new_aspect_ratio);
@@ -70,4 +73,5 @@ namespace Sunset
 	void set_camera_move_speed(class Scene* scene, EntityID entity, float new_move_speed);
 	void set_camera_look_speed(class Scene* scene, EntityID entity, float new_look_speed);
 	void set_frame_jitter_enabled(class Scene* scene, EntityID entity, bool b_enabled);
+	void set_distance_cull_enabled(class Scene* scene, EntityID entity, bool b_enabled);
 }
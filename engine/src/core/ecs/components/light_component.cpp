@@ -8,6 +8,7 @@ namespace Sunset
 	{
 		light = LightGlobals::get()->new_shared_data();
 		light_data_buffer_offset = LightGlobals::get()->get_shared_data_index(light);
+		LightGlobals::get()->light_data.mark_dirty(light_data_buffer_offset);
 	}
 
 	LightComponent::~LightComponent()
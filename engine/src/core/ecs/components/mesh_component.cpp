@@ -4,27 +4,206 @@
 #include <graphics/renderer.h>
 #include <graphics/resource/buffer.h>
 #include <minimal.h>
+#include <utility/maths.h>
 
 namespace Sunset
 {
+	MeshComponent::MeshComponent(const MeshComponent& other)
+	{
+		*this = other;
+	}
+
+	MeshComponent::MeshComponent(MeshComponent&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MeshComponent& MeshComponent::operator=(const MeshComponent& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		if (spilled_sections >= 0)
+		{
+			MeshSectionPool::get()->release(spilled_sections, section_count);
+			spilled_sections = -1;
+		}
+
+		mesh = other.mesh;
+		section_count = other.section_count;
+		custom_bounds_scale = other.custom_bounds_scale;
+		inline_materials = other.inline_materials;
+		inline_resource_states = other.inline_resource_states;
+		lod_count = other.lod_count;
+		current_lod = other.current_lod;
+		draw_revision = other.draw_revision;
+
+		// Copies get their own span so that per instance material changes don't leak into other components
+		if (other.spilled_sections >= 0)
+		{
+			MeshSectionPool* const section_pool = MeshSectionPool::get();
+			spilled_sections = section_pool->allocate(section_count);
+			std::copy_n(section_pool->materials(other.spilled_sections), section_count, section_pool->materials(spilled_sections));
+			std::copy_n(section_pool->resource_states(other.spilled_sections), section_count, section_pool->resource_states(spilled_sections));
+		}
+
+		return *this;
+	}
+
+	MeshComponent& MeshComponent::operator=(MeshComponent&& other) noexcept
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		if (spilled_sections >= 0)
+		{
+			MeshSectionPool::get()->release(spilled_sections, section_count);
+		}
+
+		mesh = other.mesh;
+		section_count = other.section_count;
+		custom_bounds_scale = other.custom_bounds_scale;
+		inline_materials = other.inline_materials;
+		inline_resource_states = other.inline_resource_states;
+		lod_count = other.lod_count;
+		current_lod = other.current_lod;
+		draw_revision = other.draw_revision;
+		spilled_sections = other.spilled_sections;
+
+		other.spilled_sections = -1;
+
+		return *this;
+	}
+
+	MeshComponent::~MeshComponent()
+	{
+		if (spilled_sections >= 0)
+		{
+			MeshSectionPool::get()->release(spilled_sections, section_count);
+		}
+	}
+
+	uint32_t MeshSectionPool::span_capacity(uint32_t section_count)
+	{
+		return Maths::npot(std::max(section_count, MESH_INLINE_SECTIONS + 1));
+	}
+
+	int32_t MeshSectionPool::allocate(uint32_t section_count)
+	{
+		const uint32_t capacity = span_capacity(section_count);
+		assert(capacity <= MESH_SECTION_POOL_CHUNK_SIZE && "Mesh section span does not fit in a mesh section pool chunk");
+
+		std::scoped_lock lock(pool_mutex);
+
+		std::vector<int32_t>& free_list = free_spans[capacity];
+		if (!free_list.empty())
+		{
+			const int32_t offset = free_list.back();
+			free_list.pop_back();
+			return offset;
+		}
+
+		// Start a new chunk when the span doesn't fit in what is left of the current one
+		if (allocated_section_count + capacity > chunk_count * MESH_SECTION_POOL_CHUNK_SIZE)
+		{
+			assert(chunk_count < MESH_SECTION_POOL_MAX_CHUNKS && "Ran out of mesh section pool chunks! Try increasing MESH_SECTION_POOL_MAX_CHUNKS.");
+			chunks[chunk_count] = std::make_unique<SectionChunk>();
+			allocated_section_count = chunk_count * MESH_SECTION_POOL_CHUNK_SIZE;
+			++chunk_count;
+		}
+
+		const int32_t offset = static_cast<int32_t>(allocated_section_count);
+		allocated_section_count += capacity;
+		return offset;
+	}
+
+	void MeshSectionPool::release(int32_t offset, uint32_t section_count)
+	{
+		assert(offset >= 0 && "Cannot release an invalid mesh section span");
+
+		std::scoped_lock lock(pool_mutex);
+
+		std::fill_n(materials(offset), section_count, 0);
+		std::fill_n(resource_states(offset), section_count, 0);
+		free_spans[span_capacity(section_count)].push_back(offset);
+	}
+
 	void set_mesh(MeshComponent* mesh_comp, MeshID mesh)
 	{
 		assert(mesh_comp != nullptr && "Cannot set mesh on null mesh component");
+
+		Mesh* const new_mesh = CACHE_FETCH(Mesh, mesh);
+		const uint32_t new_section_count = new_mesh->sections.size();
+		assert(new_section_count <= MAX_MESH_MATERIALS && "Mesh has more sections than a mesh component supports");
+
+		MeshSectionPool* const section_pool = MeshSectionPool::get();
+
+		// Materials set before the mesh apply to every section, so new sections inherit the first section's material
+		const MaterialID default_material = mesh_materials(mesh_comp)[0];
+
+		int32_t new_spilled_sections = -1;
+		if (new_section_count > MESH_INLINE_SECTIONS)
+		{
+			new_spilled_sections = section_pool->allocate(new_section_count);
+			MaterialID* const new_materials = section_pool->materials(new_spilled_sections);
+			const uint32_t kept_count = std::min(std::max(mesh_comp->section_count, MESH_INLINE_SECTIONS), new_section_count);
+			std::copy_n(mesh_materials(mesh_comp), kept_count, new_materials);
+			std::fill(new_materials + kept_count, new_materials + new_section_count, default_material);
+		}
+		else if (mesh_comp->spilled_sections >= 0)
+		{
+			std::copy_n(section_pool->materials(mesh_comp->spilled_sections), MESH_INLINE_SECTIONS, mesh_comp->inline_materials.data());
+		}
+
+		if (mesh_comp->spilled_sections >= 0)
+		{
+			section_pool->release(mesh_comp->spilled_sections, mesh_comp->section_count);
+		}
+
+		// Resource states depend on the mesh buffers, so they get rebuilt by the mesh processor
+		mesh_comp->inline_resource_states.fill(0);
+		mesh_comp->spilled_sections = new_spilled_sections;
 		mesh_comp->mesh = mesh;
-		mesh_comp->section_count = CACHE_FETCH(Mesh, mesh)->sections.size();
+		mesh_comp->section_count = new_section_count;
+		mesh_comp->lod_count = static_cast<uint8_t>(get_mesh_lod_count(new_mesh));
+		mesh_comp->current_lod = 0;
+		++mesh_comp->draw_revision;
 	}
 
 	void set_material(MeshComponent* mesh_comp, MaterialID material, int32_t section)
 	{
 		assert(mesh_comp != nullptr && "Cannot set material on null mesh component");
+		MaterialID* const materials = mesh_materials(mesh_comp);
 		if (section >= 0)
 		{
-			mesh_comp->materials[section] = material;
+			assert(section < std::max(mesh_comp->section_count, MESH_INLINE_SECTIONS) && "Out of bounds access on mesh sections array");
+			materials[section] = material;
 		}
 		else
 		{
-			mesh_comp->materials.fill(material);
+			std::fill_n(materials, std::max(mesh_comp->section_count, MESH_INLINE_SECTIONS), material);
 		}
+		++mesh_comp->draw_revision;
+	}
+
+	MaterialID* mesh_materials(MeshComponent* mesh_comp)
+	{
+		assert(mesh_comp != nullptr && "Cannot get materials via null mesh component");
+		return mesh_comp->spilled_sections >= 0
+			? MeshSectionPool::get()->materials(mesh_comp->spilled_sections)
+			: mesh_comp->inline_materials.data();
+	}
+
+	ResourceStateID* mesh_resource_states(MeshComponent* mesh_comp)
+	{
+		assert(mesh_comp != nullptr && "Cannot get resource states via null mesh component");
+		return mesh_comp->spilled_sections >= 0
+			? MeshSectionPool::get()->resource_states(mesh_comp->spilled_sections)
+			: mesh_comp->inline_resource_states.data();
 	}
 
 	void set_custom_bounds_scale(MeshComponent* mesh_comp, float bounds_scale)
@@ -44,14 +223,37 @@ namespace Sunset
 		return 0;
 	}
 
-	size_t mesh_index_count(MeshComponent* mesh_comp, uint32_t section)
+	size_t mesh_index_count(MeshComponent* mesh_comp, uint32_t section, uint32_t lod)
 	{
 		assert(mesh_comp != nullptr && "Cannot get index count via null mesh component");
 		Mesh* const mesh = CACHE_FETCH(Mesh, mesh_comp->mesh);
 		if (mesh != nullptr)
 		{
 			assert(section < mesh->sections.size() && "Out of bounds access on mesh sections array");
-			return mesh->sections[section].indices.size();
+			return get_mesh_section_lod(mesh->sections[section], lod).index_count;
+		}
+		return 0;
+	}
+
+	size_t mesh_index_start(MeshComponent* mesh_comp, uint32_t section, uint32_t lod)
+	{
+		assert(mesh_comp != nullptr && "Cannot get index start via null mesh component");
+		Mesh* const mesh = CACHE_FETCH(Mesh, mesh_comp->mesh);
+		if (mesh != nullptr)
+		{
+			assert(section < mesh->sections.size() && "Out of bounds access on mesh sections array");
+			return mesh->sections[section].index_allocation.offset + get_mesh_section_lod(mesh->sections[section], lod).first_index;
+		}
+		return 0;
+	}
+
+	int32_t mesh_vertex_offset(MeshComponent* mesh_comp)
+	{
+		assert(mesh_comp != nullptr && "Cannot get vertex offset via null mesh component");
+		Mesh* const mesh = CACHE_FETCH(Mesh, mesh_comp->mesh);
+		if (mesh != nullptr)
+		{
+			return static_cast<int32_t>(mesh->vertex_allocation.offset);
 		}
 		return 0;
 	}
@@ -1,27 +1,110 @@
 #pragma once
 
+#include <minimal.h>
 #include <resource_types.h>
 #include <pipeline_types.h>
 #include <graphics/resource/material.h>
+#include <utility/pattern/singleton.h>
 #include <glm/glm.hpp>
 
+#include <mutex>
+
 namespace Sunset
 {
+	// Most meshes only have a handful of sections, so that many section materials and resource states are stored inline.
+	// Meshes with more sections spill over into spans allocated from the shared MeshSectionPool.
+	constexpr uint32_t MESH_INLINE_SECTIONS = 4;
+
 	struct MeshComponent
 	{
-		MeshID mesh;
+		MeshComponent() = default;
+		MeshComponent(const MeshComponent& other);
+		MeshComponent(MeshComponent&& other) noexcept;
+		MeshComponent& operator=(const MeshComponent& other);
+		MeshComponent& operator=(MeshComponent&& other) noexcept;
+		~MeshComponent();
+
+		MeshID mesh{ 0 };
 		uint32_t section_count{ 0 };
 		float custom_bounds_scale{ 1.1f };
-		std::array<MaterialID, MAX_MESH_MATERIALS> materials;
-		std::array<ResourceStateID, MAX_MESH_RESOURCE_STATES> resource_states;
+		int32_t spilled_sections{ -1 };
+		// Cached from the mesh so single LOD meshes can skip selection without fetching it
+		uint8_t lod_count{ 1 };
+		uint8_t current_lod{ 0 };
+		// Bumped whenever the mesh, a material or the LOD changes, so retained draws know to rebuild
+		uint32_t draw_revision{ 0 };
+		std::array<MaterialID, MESH_INLINE_SECTIONS> inline_materials{};
+		std::array<ResourceStateID, MESH_INLINE_SECTIONS> inline_resource_states{};
+	};
+
+	// Spans never cross a chunk and chunks are never moved, so pointers into a span stay valid while other spans are allocated
+	constexpr uint32_t MESH_SECTION_POOL_CHUNK_SIZE = 4096;
+	constexpr uint32_t MESH_SECTION_POOL_MAX_CHUNKS = 256;
+
+	class MeshSectionPool : public Singleton<MeshSectionPool>
+	{
+		friend class Singleton;
+
+	public:
+		void initialize() { }
+
+		int32_t allocate(uint32_t section_count);
+		void release(int32_t offset, uint32_t section_count);
+
+		MaterialID* materials(int32_t offset)
+		{
+			return &chunks[offset / MESH_SECTION_POOL_CHUNK_SIZE]->materials[offset % MESH_SECTION_POOL_CHUNK_SIZE];
+		}
+
+		ResourceStateID* resource_states(int32_t offset)
+		{
+			return &chunks[offset / MESH_SECTION_POOL_CHUNK_SIZE]->resource_states[offset % MESH_SECTION_POOL_CHUNK_SIZE];
+		}
+
+		size_t get_allocated_section_count() const
+		{
+			return allocated_section_count;
+		}
+
+	private:
+		MeshSectionPool() = default;
+		MeshSectionPool(MeshSectionPool&& other) = delete;
+		MeshSectionPool(const MeshSectionPool& other) = delete;
+		MeshSectionPool& operator=(const MeshSectionPool& other) = delete;
+		~MeshSectionPool() = default;
+
+	protected:
+		struct SectionChunk
+		{
+			std::array<MaterialID, MESH_SECTION_POOL_CHUNK_SIZE> materials{};
+			std::array<ResourceStateID, MESH_SECTION_POOL_CHUNK_SIZE> resource_states{};
+		};
+
+		static uint32_t span_capacity(uint32_t section_count);
+
+	protected:
+		std::mutex pool_mutex;
+		// Fixed size so that looking up a chunk never races with a new chunk being added
+		std::array<std::unique_ptr<SectionChunk>, MESH_SECTION_POOL_MAX_CHUNKS> chunks;
+		uint32_t chunk_count{ 0 };
+		// Start of the unallocated tail of the last chunk
+		uint32_t allocated_section_count{ 0 };
+		// Released spans bucketed by their capacity so they can be handed back out without searching
+		phmap::flat_hash_map<uint32_t, std::vector<int32_t>> free_spans;
 	};
 
 	void set_mesh(MeshComponent* mesh_comp, MeshID mesh);
 	void set_material(MeshComponent* mesh_comp, MaterialID material, int32_t section = -1);
 	void set_custom_bounds_scale(MeshComponent* mesh_comp, float bounds_scale);
 
+	// Contiguous per section arrays, valid for section_count entries (and at least MESH_INLINE_SECTIONS)
+	MaterialID* mesh_materials(MeshComponent* mesh_comp);
+	ResourceStateID* mesh_resource_states(MeshComponent* mesh_comp);
+
 	size_t mesh_vertex_count(MeshComponent* mesh_comp);
-	size_t mesh_index_count(MeshComponent* mesh_comp, uint32_t section = 0);
+	size_t mesh_index_count(MeshComponent* mesh_comp, uint32_t section = 0, uint32_t lod = 0);
+	size_t mesh_index_start(MeshComponent* mesh_comp, uint32_t section = 0, uint32_t lod = 0);
+	int32_t mesh_vertex_offset(MeshComponent* mesh_comp);
 	BufferID mesh_vertex_buffer(MeshComponent* mesh_comp);
 	BufferID mesh_index_buffer(MeshComponent* mesh_comp, uint32_t section = 0);
 	Bounds mesh_local_bounds(MeshComponent* mesh_comp);
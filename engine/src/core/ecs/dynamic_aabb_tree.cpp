@@ -0,0 +1,427 @@
+#include <core/ecs/dynamic_aabb_tree.h>
+
+namespace Sunset
+{
+	DynamicAABBTree::DynamicAABBTree(float margin)
+		: margin(margin)
+	{
+	}
+
+	int32_t DynamicAABBTree::insert(EntityID entity, const AABB& bounds)
+	{
+		const int32_t proxy = allocate_node();
+
+		Node& node = nodes[proxy];
+		node.tight_bounds = bounds;
+		node.bounds = { bounds.min - glm::vec3(margin), bounds.max + glm::vec3(margin) };
+		node.entity = entity;
+		node.height = 0;
+
+		insert_leaf(proxy);
+		++proxy_count;
+
+		return proxy;
+	}
+
+	void DynamicAABBTree::remove(int32_t proxy)
+	{
+		assert(proxy >= 0 && proxy < nodes.size() && nodes[proxy].is_leaf() && "Cannot remove an invalid AABB tree proxy");
+
+		remove_leaf(proxy);
+		free_node(proxy);
+		--proxy_count;
+	}
+
+	bool DynamicAABBTree::move(int32_t proxy, const AABB& bounds)
+	{
+		assert(proxy >= 0 && proxy < nodes.size() && nodes[proxy].is_leaf() && "Cannot move an invalid AABB tree proxy");
+
+		Node& node = nodes[proxy];
+		if (aabb_contains(node.bounds, bounds))
+		{
+			node.tight_bounds = bounds;
+			return false;
+		}
+
+		// Extend the fattened box along the direction of travel so steadily moving entities reinsert less often
+		const glm::vec3 displacement = (bounds.min + bounds.max - node.tight_bounds.min - node.tight_bounds.max) * (0.5f * AABB_TREE_DISPLACEMENT_MULTIPLIER);
+
+		AABB fat_bounds = { bounds.min - glm::vec3(margin), bounds.max + glm::vec3(margin) };
+		fat_bounds.min = glm::min(fat_bounds.min, fat_bounds.min + displacement);
+		fat_bounds.max = glm::max(fat_bounds.max, fat_bounds.max + displacement);
+
+		remove_leaf(proxy);
+
+		nodes[proxy].tight_bounds = bounds;
+		nodes[proxy].bounds = fat_bounds;
+
+		insert_leaf(proxy);
+
+		return true;
+	}
+
+	void DynamicAABBTree::update_entity(EntityID entity, const AABB& bounds)
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		if (entity_index >= entity_proxies.size())
+		{
+			entity_proxies.resize(std::max(size_t(entity_index) + 1, entity_proxies.size() * 2), NULL_NODE);
+		}
+
+		int32_t& proxy = entity_proxies[entity_index];
+		if (proxy != NULL_NODE && nodes[proxy].entity != entity)
+		{
+			// The slot belongs to a previous version of this entity index
+			remove(proxy);
+			proxy = NULL_NODE;
+		}
+
+		if (proxy == NULL_NODE)
+		{
+			proxy = insert(entity, bounds);
+		}
+		else
+		{
+			move(proxy, bounds);
+		}
+	}
+
+	void DynamicAABBTree::remove_entity(EntityID entity)
+	{
+		const int32_t proxy = get_entity_proxy(entity);
+		if (proxy != NULL_NODE)
+		{
+			remove(proxy);
+			entity_proxies[get_entity_index(entity)] = NULL_NODE;
+		}
+	}
+
+	bool DynamicAABBTree::contains_entity(EntityID entity) const
+	{
+		return get_entity_proxy(entity) != NULL_NODE;
+	}
+
+	int32_t DynamicAABBTree::get_entity_proxy(EntityID entity) const
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		if (entity_index >= entity_proxies.size())
+		{
+			return NULL_NODE;
+		}
+		const int32_t proxy = entity_proxies[entity_index];
+		return proxy != NULL_NODE && nodes[proxy].entity == entity ? proxy : NULL_NODE;
+	}
+
+	void DynamicAABBTree::query_aabb(const AABB& aabb, std::vector<EntityID>& out_entities) const
+	{
+		query(
+			[&aabb](const AABB& node_bounds) { return aabb_overlaps(node_bounds, aabb); },
+			[&out_entities](EntityID entity) { out_entities.push_back(entity); }
+		);
+	}
+
+	void DynamicAABBTree::query_sphere(const glm::vec3& center, float radius, std::vector<EntityID>& out_entities) const
+	{
+		query(
+			[&center, radius](const AABB& node_bounds) { return aabb_overlaps_sphere(node_bounds, center, radius); },
+			[&out_entities](EntityID entity) { out_entities.push_back(entity); }
+		);
+	}
+
+	void DynamicAABBTree::query_frustum(const glm::vec4* planes, uint32_t plane_count, std::vector<EntityID>& out_entities) const
+	{
+		query(
+			[planes, plane_count](const AABB& node_bounds) { return aabb_overlaps_frustum(node_bounds, planes, plane_count); },
+			[&out_entities](EntityID entity) { out_entities.push_back(entity); }
+		);
+	}
+
+	void DynamicAABBTree::query_ray(const glm::vec3& origin, const glm::vec3& direction, float max_distance, std::vector<EntityID>& out_entities) const
+	{
+		const glm::vec3 inverse_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+		query(
+			[&origin, &inverse_direction, max_distance](const AABB& node_bounds) { return aabb_overlaps_ray(node_bounds, origin, inverse_direction, max_distance); },
+			[&out_entities](EntityID entity) { out_entities.push_back(entity); }
+		);
+	}
+
+	void DynamicAABBTree::clear()
+	{
+		nodes.clear();
+		entity_proxies.clear();
+		root = NULL_NODE;
+		free_list = NULL_NODE;
+		proxy_count = 0;
+	}
+
+	bool DynamicAABBTree::validate() const
+	{
+		if (root == NULL_NODE)
+		{
+			return proxy_count == 0;
+		}
+		return nodes[root].parent == NULL_NODE && validate_node(root);
+	}
+
+	int32_t DynamicAABBTree::allocate_node()
+	{
+		if (free_list == NULL_NODE)
+		{
+			nodes.emplace_back();
+			return int32_t(nodes.size() - 1);
+		}
+
+		const int32_t node = free_list;
+		free_list = nodes[node].parent;
+		nodes[node] = Node();
+		return node;
+	}
+
+	void DynamicAABBTree::free_node(int32_t node)
+	{
+		nodes[node].parent = free_list;
+		nodes[node].child_a = NULL_NODE;
+		nodes[node].child_b = NULL_NODE;
+		nodes[node].entity = INVALID_ENTITY;
+		nodes[node].height = -1;
+		free_list = node;
+	}
+
+	void DynamicAABBTree::insert_leaf(int32_t leaf)
+	{
+		if (root == NULL_NODE)
+		{
+			root = leaf;
+			nodes[root].parent = NULL_NODE;
+			return;
+		}
+
+		// Descend towards the sibling that minimizes the surface area added to the tree
+		const AABB leaf_bounds = nodes[leaf].bounds;
+		int32_t index = root;
+		while (!nodes[index].is_leaf())
+		{
+			const Node& node = nodes[index];
+
+			const float area = aabb_surface_area(node.bounds);
+			const float combined_area = aabb_surface_area(aabb_union(node.bounds, leaf_bounds));
+
+			// Cost of pairing the leaf with this node under a new parent
+			const float cost = 2.0f * combined_area;
+			// Minimum cost pushed onto every ancestor when descending further
+			const float inheritance_cost = 2.0f * (combined_area - area);
+
+			auto descend_cost = [this, &leaf_bounds, inheritance_cost](int32_t child)
+			{
+				const Node& child_node = nodes[child];
+				const float child_combined_area = aabb_surface_area(aabb_union(child_node.bounds, leaf_bounds));
+				return child_node.is_leaf()
+					? child_combined_area + inheritance_cost
+					: child_combined_area - aabb_surface_area(child_node.bounds) + inheritance_cost;
+			};
+
+			const float cost_a = descend_cost(node.child_a);
+			const float cost_b = descend_cost(node.child_b);
+
+			if (cost < cost_a && cost < cost_b)
+			{
+				break;
+			}
+
+			index = cost_a < cost_b ? node.child_a : node.child_b;
+		}
+
+		const int32_t sibling = index;
+		const int32_t old_parent = nodes[sibling].parent;
+
+		const int32_t new_parent = allocate_node();
+		nodes[new_parent].parent = old_parent;
+		nodes[new_parent].bounds = aabb_union(leaf_bounds, nodes[sibling].bounds);
+		nodes[new_parent].height = nodes[sibling].height + 1;
+		nodes[new_parent].child_a = sibling;
+		nodes[new_parent].child_b = leaf;
+		nodes[sibling].parent = new_parent;
+		nodes[leaf].parent = new_parent;
+
+		if (old_parent != NULL_NODE)
+		{
+			if (nodes[old_parent].child_a == sibling)
+			{
+				nodes[old_parent].child_a = new_parent;
+			}
+			else
+			{
+				nodes[old_parent].child_b = new_parent;
+			}
+		}
+		else
+		{
+			root = new_parent;
+		}
+
+		refit_ancestors(new_parent);
+	}
+
+	void DynamicAABBTree::remove_leaf(int32_t leaf)
+	{
+		if (leaf == root)
+		{
+			root = NULL_NODE;
+			return;
+		}
+
+		const int32_t parent = nodes[leaf].parent;
+		const int32_t grand_parent = nodes[parent].parent;
+		const int32_t sibling = nodes[parent].child_a == leaf ? nodes[parent].child_b : nodes[parent].child_a;
+
+		if (grand_parent != NULL_NODE)
+		{
+			if (nodes[grand_parent].child_a == parent)
+			{
+				nodes[grand_parent].child_a = sibling;
+			}
+			else
+			{
+				nodes[grand_parent].child_b = sibling;
+			}
+			nodes[sibling].parent = grand_parent;
+			free_node(parent);
+
+			refit_ancestors(grand_parent);
+		}
+		else
+		{
+			root = sibling;
+			nodes[sibling].parent = NULL_NODE;
+			free_node(parent);
+		}
+	}
+
+	void DynamicAABBTree::refit_ancestors(int32_t node)
+	{
+		int32_t index = node;
+		while (index != NULL_NODE)
+		{
+			index = balance(index);
+
+			Node& current = nodes[index];
+			const Node& child_a = nodes[current.child_a];
+			const Node& child_b = nodes[current.child_b];
+
+			current.height = 1 + std::max(child_a.height, child_b.height);
+			current.bounds = aabb_union(child_a.bounds, child_b.bounds);
+
+			index = current.parent;
+		}
+	}
+
+	int32_t DynamicAABBTree::balance(int32_t node_a)
+	{
+		Node& a = nodes[node_a];
+		if (a.is_leaf() || a.height < 2)
+		{
+			return node_a;
+		}
+
+		const int32_t node_b = a.child_a;
+		const int32_t node_c = a.child_b;
+		Node& b = nodes[node_b];
+		Node& c = nodes[node_c];
+
+		const int32_t height_difference = c.height - b.height;
+
+		// Rotates the taller child up into A's place, handing its shorter grandchild down to A
+		auto rotate_up = [this, node_a, &a](int32_t node_up, Node& up, const Node& other, bool b_up_is_child_a) -> int32_t
+		{
+			const int32_t node_f = up.child_a;
+			const int32_t node_g = up.child_b;
+			Node& f = nodes[node_f];
+			Node& g = nodes[node_g];
+
+			up.child_a = node_a;
+			up.parent = a.parent;
+			a.parent = node_up;
+
+			if (up.parent != NULL_NODE)
+			{
+				if (nodes[up.parent].child_a == node_a)
+				{
+					nodes[up.parent].child_a = node_up;
+				}
+				else
+				{
+					nodes[up.parent].child_b = node_up;
+				}
+			}
+			else
+			{
+				root = node_up;
+			}
+
+			const bool b_keep_f = f.height > g.height;
+			const int32_t node_kept = b_keep_f ? node_f : node_g;
+			const int32_t node_moved = b_keep_f ? node_g : node_f;
+			Node& kept = nodes[node_kept];
+			Node& moved = nodes[node_moved];
+
+			up.child_b = node_kept;
+			if (b_up_is_child_a)
+			{
+				a.child_a = node_moved;
+			}
+			else
+			{
+				a.child_b = node_moved;
+			}
+			moved.parent = node_a;
+
+			a.bounds = aabb_union(other.bounds, moved.bounds);
+			a.height = 1 + std::max(other.height, moved.height);
+			up.bounds = aabb_union(a.bounds, kept.bounds);
+			up.height = 1 + std::max(a.height, kept.height);
+
+			return node_up;
+		};
+
+		if (height_difference > 1)
+		{
+			return rotate_up(node_c, c, b, false);
+		}
+
+		if (height_difference < -1)
+		{
+			return rotate_up(node_b, b, c, true);
+		}
+
+		return node_a;
+	}
+
+	bool DynamicAABBTree::validate_node(int32_t node) const
+	{
+		const Node& current = nodes[node];
+		if (current.is_leaf())
+		{
+			return current.height == 0 && current.child_b == NULL_NODE && aabb_contains(current.bounds, current.tight_bounds);
+		}
+
+		const Node& child_a = nodes[current.child_a];
+		const Node& child_b = nodes[current.child_b];
+
+		if (child_a.parent != node || child_b.parent != node)
+		{
+			return false;
+		}
+
+		if (current.height != 1 + std::max(child_a.height, child_b.height))
+		{
+			return false;
+		}
+
+		if (!aabb_contains(current.bounds, child_a.bounds) || !aabb_contains(current.bounds, child_b.bounds))
+		{
+			return false;
+		}
+
+		return validate_node(current.child_a) && validate_node(current.child_b);
+	}
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <minimal.h>
+#include <core/ecs/entity.h>
+
+namespace Sunset
+{
+	struct AABB
+	{
+		glm::vec3 min{ 0.0f };
+		glm::vec3 max{ 0.0f };
+	};
+
+	inline AABB aabb_from_bounds(const Bounds& bounds)
+	{
+		return { bounds.origin - bounds.extents, bounds.origin + bounds.extents };
+	}
+
+	inline AABB aabb_union(const AABB& a, const AABB& b)
+	{
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	inline float aabb_surface_area(const AABB& aabb)
+	{
+		const glm::vec3 size = aabb.max - aabb.min;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	inline bool aabb_contains(const AABB& outer, const AABB& inner)
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+			&& outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+	}
+
+	inline bool aabb_overlaps(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x
+			&& a.min.y <= b.max.y && a.max.y >= b.min.y
+			&& a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	inline bool aabb_overlaps_sphere(const AABB& aabb, const glm::vec3& center, float radius)
+	{
+		const glm::vec3 closest = glm::max(aabb.min, glm::min(center, aabb.max));
+		const glm::vec3 delta = closest - center;
+		return delta.x * delta.x + delta.y * delta.y + delta.z * delta.z <= radius * radius;
+	}
+
+	// Planes are expected to point inwards, matching the camera frustum planes
+	inline bool aabb_overlaps_frustum(const AABB& aabb, const glm::vec4* planes, uint32_t plane_count)
+	{
+		for (uint32_t i = 0; i < plane_count; ++i)
+		{
+			const glm::vec4& plane = planes[i];
+			const glm::vec3 positive_vertex(
+				plane.x >= 0.0f ? aabb.max.x : aabb.min.x,
+				plane.y >= 0.0f ? aabb.max.y : aabb.min.y,
+				plane.z >= 0.0f ? aabb.max.z : aabb.min.z
+			);
+			if (plane.x * positive_vertex.x + plane.y * positive_vertex.y + plane.z * positive_vertex.z + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Slab test, inverse_direction components may be infinite for axis aligned rays
+	inline bool aabb_overlaps_ray(const AABB& aabb, const glm::vec3& origin, const glm::vec3& inverse_direction, float max_distance)
+	{
+		float t_min = 0.0f;
+		float t_max = max_distance;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const float t1 = (aabb.min[axis] - origin[axis]) * inverse_direction[axis];
+			const float t2 = (aabb.max[axis] - origin[axis]) * inverse_direction[axis];
+			// Written so NaNs from 0 * inf leave the interval untouched
+			t_min = std::max(t_min, std::min(t1, t2));
+			t_max = std::min(t_max, std::max(t1, t2));
+		}
+		return t_min <= t_max;
+	}
+
+	// Transforms a local space box by an affine matrix, producing the world space box that encloses it
+	inline AABB transform_aabb(const AABB& local_aabb, const glm::mat4& transform)
+	{
+		const glm::vec3 center = (local_aabb.min + local_aabb.max) * 0.5f;
+		const glm::vec3 extents = (local_aabb.max - local_aabb.min) * 0.5f;
+
+		const glm::vec3 world_center = glm::vec3(transform * glm::vec4(center, 1.0f));
+		const glm::vec3 world_extents(
+			std::abs(transform[0].x) * extents.x + std::abs(transform[1].x) * extents.y + std::abs(transform[2].x) * extents.z,
+			std::abs(transform[0].y) * extents.x + std::abs(transform[1].y) * extents.y + std::abs(transform[2].y) * extents.z,
+			std::abs(transform[0].z) * extents.x + std::abs(transform[1].z) * extents.y + std::abs(transform[2].z) * extents.z
+		);
+
+		return { world_center - world_extents, world_center + world_extents };
+	}
+
+	constexpr float DEFAULT_AABB_TREE_MARGIN = 0.1f;
+	// How many frames of movement a reinserted leaf's fattened box is extended by
+	constexpr float AABB_TREE_DISPLACEMENT_MULTIPLIER = 4.0f;
+	constexpr uint32_t MAX_AABB_TREE_QUERY_DEPTH = 256;
+
+	// Incrementally updated bounding volume hierarchy over entity world bounds. Leaves store fattened boxes so
+	// small movements don't touch the tree, and inserts/removals refit and rotate the ancestors to keep it balanced.
+	// Queries test the tight bounds at the leaves, so results match a brute force walk over the same boxes.
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr int32_t NULL_NODE = -1;
+
+		struct Node
+		{
+			AABB bounds;
+			AABB tight_bounds;
+			EntityID entity{ INVALID_ENTITY };
+			// Doubles as the next free node while the node sits in the free list
+			int32_t parent{ NULL_NODE };
+			int32_t child_a{ NULL_NODE };
+			int32_t child_b{ NULL_NODE };
+			// Leaves have a height of 0, free nodes -1
+			int32_t height{ -1 };
+
+			bool is_leaf() const
+			{
+				return child_a == NULL_NODE;
+			}
+		};
+
+	public:
+		DynamicAABBTree(float margin = DEFAULT_AABB_TREE_MARGIN);
+
+		int32_t insert(EntityID entity, const AABB& bounds);
+		void remove(int32_t proxy);
+		// Returns true if the leaf had to be reinserted because the bounds escaped the fattened box
+		bool move(int32_t proxy, const AABB& bounds);
+
+		// Inserts or moves the proxy owned by the entity
+		void update_entity(EntityID entity, const AABB& bounds);
+		void remove_entity(EntityID entity);
+		bool contains_entity(EntityID entity) const;
+		int32_t get_entity_proxy(EntityID entity) const;
+
+		void query_aabb(const AABB& aabb, std::vector<EntityID>& out_entities) const;
+		void query_sphere(const glm::vec3& center, float radius, std::vector<EntityID>& out_entities) const;
+		void query_frustum(const glm::vec4* planes, uint32_t plane_count, std::vector<EntityID>& out_entities) const;
+		void query_ray(const glm::vec3& origin, const glm::vec3& direction, float max_distance, std::vector<EntityID>& out_entities) const;
+
+		// Walks every node whose fattened box passes overlap_test, calling visit with each leaf whose tight box does too
+		template<typename OverlapFunc, typename VisitFunc>
+		void query(OverlapFunc&& overlap_test, VisitFunc&& visit) const
+		{
+			if (root == NULL_NODE)
+			{
+				return;
+			}
+
+			std::array<int32_t, MAX_AABB_TREE_QUERY_DEPTH> stack;
+			uint32_t stack_size = 0;
+			stack[stack_size++] = root;
+
+			while (stack_size > 0)
+			{
+				const Node& node = nodes[stack[--stack_size]];
+				if (!overlap_test(node.bounds))
+				{
+					continue;
+				}
+
+				if (node.is_leaf())
+				{
+					if (overlap_test(node.tight_bounds))
+					{
+						visit(node.entity);
+					}
+				}
+				else
+				{
+					assert(stack_size + 2 <= MAX_AABB_TREE_QUERY_DEPTH && "Dynamic AABB tree query stack overflow");
+					stack[stack_size++] = node.child_a;
+					stack[stack_size++] = node.child_b;
+				}
+			}
+		}
+
+		void clear();
+
+		size_t size() const
+		{
+			return proxy_count;
+		}
+
+		int32_t get_height() const
+		{
+			return root == NULL_NODE ? 0 : nodes[root].height;
+		}
+
+		const AABB& get_fat_bounds(int32_t proxy) const
+		{
+			return nodes[proxy].bounds;
+		}
+
+		// Checks parent links, heights and that every parent encloses its children
+		bool validate() const;
+
+	protected:
+		int32_t allocate_node();
+		void free_node(int32_t node);
+
+		void insert_leaf(int32_t leaf);
+		void remove_leaf(int32_t leaf);
+		void refit_ancestors(int32_t node);
+		int32_t balance(int32_t node);
+
+		bool validate_node(int32_t node) const;
+
+	protected:
+		std::vector<Node> nodes;
+		// Indexed by entity index, so entities can find their leaf without a hash lookup
+		std::vector<int32_t> entity_proxies;
+		int32_t root{ NULL_NODE };
+		int32_t free_list{ NULL_NODE };
+		size_t proxy_count{ 0 };
+		float margin{ DEFAULT_AABB_TREE_MARGIN };
+	};
+}
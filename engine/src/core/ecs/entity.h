@@ -46,4 +46,16 @@ namespace Sunset
 	}
 
 	#define INVALID_ENTITY create_entity_id(EntityIndex(-1), 0)
+
+	// Placeholder IDs handed out when recording deferred entity creation. Live entities never carry version 0,
+	// so these can't alias a real entity and get resolved to one when the owning command buffer is played back.
+	inline EntityID create_temporary_entity_id(uint32_t command_buffer_index, uint32_t local_index)
+	{
+		return create_entity_id(((command_buffer_index + 1) << 22) | (local_index & 0x3FFFFF), 0);
+	}
+
+	inline bool is_temporary_entity(EntityID id)
+	{
+		return is_valid_entity(id) && get_entity_version(id) == 0;
+	}
 }
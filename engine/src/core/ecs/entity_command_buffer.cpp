@@ -0,0 +1,65 @@
+#include <core/ecs/entity_command_buffer.h>
+
+namespace Sunset
+{
+	EntityCommandBuffer::EntityCommandBuffer(uint32_t buffer_index)
+		: buffer_index(buffer_index), owner_thread(std::this_thread::get_id())
+	{
+	}
+
+	EntityCommandBuffer::~EntityCommandBuffer()
+	{
+		reset();
+	}
+
+	EntityID EntityCommandBuffer::create_entity()
+	{
+		const EntityID temporary_id = create_temporary_entity_id(buffer_index, uint32_t(created_entities.size()));
+		created_entities.push_back(temporary_id);
+		return temporary_id;
+	}
+
+	void EntityCommandBuffer::destroy_entity(EntityID entity)
+	{
+		destroyed_entities.push_back(entity);
+	}
+
+	void EntityCommandBuffer::reset()
+	{
+		for (EntityAddComponentCommand& command : add_commands)
+		{
+			if (command.payload != nullptr)
+			{
+				command.destroy(command.payload);
+			}
+		}
+
+		created_entities.clear();
+		destroyed_entities.clear();
+		add_commands.clear();
+		remove_commands.clear();
+
+		current_payload_block = 0;
+		current_payload_offset = 0;
+	}
+
+	void* EntityCommandBuffer::allocate_payload(size_t size, size_t alignment)
+	{
+		size_t aligned_offset = (current_payload_offset + alignment - 1) & ~(alignment - 1);
+		if (current_payload_block < payload_blocks.size() && aligned_offset + size > PAYLOAD_BLOCK_SIZE)
+		{
+			++current_payload_block;
+			aligned_offset = 0;
+		}
+
+		if (current_payload_block >= payload_blocks.size())
+		{
+			payload_blocks.emplace_back(new std::byte[PAYLOAD_BLOCK_SIZE]);
+			aligned_offset = 0;
+		}
+
+		current_payload_offset = aligned_offset + size;
+
+		return payload_blocks[current_payload_block].get() + aligned_offset;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <minimal.h>
+#include <core/ecs/entity.h>
+#include <core/ecs/component.h>
+
+#include <thread>
+
+namespace Sunset
+{
+	namespace EntityCommandOps
+	{
+		// Defined alongside Scene, since they need its component storage
+		template<typename T>
+		void assign_component(class Scene* scene, EntityID entity, void* payload);
+		template<typename T>
+		void unassign_component(class Scene* scene, EntityID entity);
+		template<typename T>
+		void destroy_payload(void* payload);
+	}
+
+	struct EntityAddComponentCommand
+	{
+		EntityID entity{ 0 };
+		int32_t component_id{ -1 };
+		void* payload{ nullptr };
+		void (*assign)(class Scene*, EntityID, void*){ nullptr };
+		void (*destroy)(void*){ nullptr };
+	};
+
+	struct EntityRemoveComponentCommand
+	{
+		EntityID entity{ 0 };
+		int32_t component_id{ -1 };
+		void (*unassign)(class Scene*, EntityID){ nullptr };
+	};
+
+	// Records structural scene changes (entity creation/destruction, component add/remove) so they can be
+	// issued from jobs or while iterating a SceneView. Each thread records into its own buffer, obtained through
+	// Scene::get_entity_command_buffer, and the scene plays every buffer back at its update sync points.
+	class EntityCommandBuffer
+	{
+		friend class Scene;
+
+	public:
+		static constexpr size_t PAYLOAD_BLOCK_SIZE = 64 * 1024;
+		static constexpr size_t MAX_PAYLOAD_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+		explicit EntityCommandBuffer(uint32_t buffer_index);
+		EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+		EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+		~EntityCommandBuffer();
+
+		// Returns a temporary entity ID that can be used with the other commands in any buffer of the same scene until playback
+		EntityID create_entity();
+		void destroy_entity(EntityID entity);
+
+		// Returns the pending component value, which stays valid and writable until the buffer is played back
+		template<typename T>
+		T* add_component(EntityID entity, T value = T())
+		{
+			static_assert(sizeof(T) <= PAYLOAD_BLOCK_SIZE, "Component is too large to be recorded in an entity command buffer");
+			static_assert(alignof(T) <= MAX_PAYLOAD_ALIGNMENT, "Component alignment exceeds what entity command buffers support");
+
+			T* const payload = new (allocate_payload(sizeof(T), alignof(T))) T(std::move(value));
+			add_commands.push_back({
+				.entity = entity,
+				.component_id = get_component_id<T>(),
+				.payload = payload,
+				.assign = &EntityCommandOps::assign_component<T>,
+				.destroy = &EntityCommandOps::destroy_payload<T>
+			});
+			return payload;
+		}
+
+		template<typename T>
+		void remove_component(EntityID entity)
+		{
+			remove_commands.push_back({
+				.entity = entity,
+				.component_id = get_component_id<T>(),
+				.unassign = &EntityCommandOps::unassign_component<T>
+			});
+		}
+
+		bool empty() const
+		{
+			return created_entities.empty() && destroyed_entities.empty() && add_commands.empty() && remove_commands.empty();
+		}
+
+		uint32_t get_buffer_index() const
+		{
+			return buffer_index;
+		}
+
+		// Drops all recorded commands, destroying any pending component values that were never played back
+		void reset();
+
+	protected:
+		void* allocate_payload(size_t size, size_t alignment);
+
+	protected:
+		uint32_t buffer_index{ 0 };
+		std::thread::id owner_thread;
+		std::vector<EntityID> created_entities;
+		std::vector<EntityID> destroyed_entities;
+		std::vector<EntityAddComponentCommand> add_commands;
+		std::vector<EntityRemoveComponentCommand> remove_commands;
+		// Payloads live in fixed size blocks so pointers handed out by add_component stay stable while recording
+		std::vector<std::unique_ptr<std::byte[]>> payload_blocks;
+		size_t current_payload_block{ 0 };
+		size_t current_payload_offset{ 0 };
+	};
+}
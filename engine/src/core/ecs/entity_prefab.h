@@ -0,0 +1,32 @@
+#pragma once
+
+#include <minimal.h>
+
+#include <tuple>
+
+namespace Sunset
+{
+	// A set of component prototypes that Scene::instantiate copies onto every spawned entity
+	template<typename... ComponentTypes>
+	struct EntityPrefab
+	{
+		EntityPrefab() = default;
+		explicit EntityPrefab(ComponentTypes... prototypes)
+			: components(std::move(prototypes)...)
+		{ }
+
+		template<typename T>
+		T& get()
+		{
+			return std::get<T>(components);
+		}
+
+		template<typename T>
+		const T& get() const
+		{
+			return std::get<T>(components);
+		}
+
+		std::tuple<ComponentTypes...> components;
+	};
+}
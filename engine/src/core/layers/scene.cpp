@@ -1,6 +1,7 @@
 #include <core/layers/scene.h>
 #include <core/subsystems/static_mesh_processor.h>
 #include <core/subsystems/transform_processor.h>
+#include <core/subsystems/bounds_processor.h>
 #include <core/subsystems/camera_control_processor.h>
 #include <core/subsystems/camera_input_controller.h>
 #include <core/subsystems/scene_lighting_processor.h>
@@ -12,10 +13,16 @@
 #include <graphics/renderer.h>
 #include <graphics/resource/buffer.h>
 #include <graphics/resource/image.h>
+#include <utility/cvar.h>
 
 namespace Sunset
 {
+	AutoCVar_Bool cvar_parallel_subsystem_ticks("scene.parallel_subsystem_ticks", "Whether or not independent scene subsystems are allowed to tick concurrently on job threads", true);
+
+	static std::atomic_uint64_t g_scene_uid_counter{ 1 };
+
 	Scene::Scene()
+		: scene_uid(g_scene_uid_counter++)
 	{
 		subsystems.reserve(MAX_COMPONENTS);
 		component_pools.reserve(MAX_COMPONENTS);
@@ -23,6 +30,17 @@ namespace Sunset
 		free_entities.reserve(MIN_ENTITIES);
 	}
 
+	Scene::~Scene()
+	{
+		for (const Entity& entity : entities)
+		{
+			if (is_valid_entity(entity.id))
+			{
+				destroy_entity_components(get_entity_index(entity.id));
+			}
+		}
+	}
+
 	void Scene::initialize()
 	{
 		add_default_camera();
@@ -37,29 +55,55 @@ namespace Sunset
 			(*it)->destroy(this);
 		}
 
+		// Command buffers are only reset since recording threads may still have them cached
+		for (std::unique_ptr<EntityCommandBuffer>& command_buffer : entity_command_buffers)
+		{
+			command_buffer->reset();
+		}
+
 		subsystems.clear();
+		subsystem_lookup.clear();
+		b_subsystem_graph_dirty = true;
+		for (const Entity& entity : entities)
+		{
+			if (is_valid_entity(entity.id))
+			{
+				destroy_entity_components(get_entity_index(entity.id));
+			}
+		}
+
 		component_pools.clear();
-		entities.clear();;
+		component_destructors.clear();
+		spatial_index.clear();
+		entities.clear();
 		free_entities.clear();
 	}
 
 	void Scene::update(double delta_time)
 	{
-		// TODO: We can look for a more configurable way to group subsystems into tick buckets that can all update asynchronously at some point
-		for (auto it = subsystems.begin(); it != subsystems.end(); ++it)
+		const SubsystemTickGraph& tick_graph = get_subsystem_graph();
+		const bool b_parallel = cvar_parallel_subsystem_ticks.get();
+
 		{
-			(*it)->pre_update(this);
+			ZoneScopedN("Scene::update: pre_update");
+			tick_graph.run(subsystems, [this](Subsystem* subsystem) { subsystem->pre_update(this); }, b_parallel);
 		}
 
-		for (auto it = subsystems.begin(); it != subsystems.end(); ++it)
+		flush_entity_commands();
+
 		{
-			(*it)->update(this, delta_time);
+			ZoneScopedN("Scene::update: update");
+			tick_graph.run(subsystems, [this, delta_time](Subsystem* subsystem) { subsystem->update(this, delta_time); }, b_parallel);
 		}
 
-		for (auto it = subsystems.begin(); it != subsystems.end(); ++it)
+		flush_entity_commands();
+
 		{
-			(*it)->post_update(this);
+			ZoneScopedN("Scene::update: post_update");
+			tick_graph.run(subsystems, [this](Subsystem* subsystem) { subsystem->post_update(this); }, b_parallel);
 		}
+
+		flush_entity_commands();
 	}
 
 	Sunset::EntityID Scene::make_entity()
@@ -76,14 +120,213 @@ namespace Sunset
 		return entities.back().id;
 	}
 
+	void Scene::make_entities(uint32_t count, std::vector<EntityID>& out_entities)
+	{
+		out_entities.reserve(out_entities.size() + count);
+
+		const uint32_t reused_count = std::min(count, uint32_t(free_entities.size()));
+		for (uint32_t i = 0; i < reused_count; ++i)
+		{
+			out_entities.push_back(make_entity());
+		}
+
+		const uint32_t appended_count = count - reused_count;
+		reserve_entities(entities.size() + appended_count);
+
+		for (uint32_t i = 0; i < appended_count; ++i)
+		{
+			entities.push_back({ create_entity_id(EntityIndex(entities.size()), 1), ComponentMask{} });
+			out_entities.push_back(entities.back().id);
+		}
+	}
+
+	void Scene::reserve_entities(size_t entity_count)
+	{
+		if (entity_count > entities.capacity())
+		{
+			entities.reserve(std::max(entity_count, entities.capacity() * 2));
+		}
+
+		for (std::unique_ptr<StaticBytePoolAllocator>& component_pool : component_pools)
+		{
+			if (component_pool != nullptr && component_pool->capacity() < entities.capacity())
+			{
+				component_pool->grow(entities.capacity());
+			}
+		}
+	}
+
 	void Scene::destroy_entity(EntityID entity_id)
 	{
+		spatial_index.remove_entity(entity_id);
+
+		destroy_entity_components(get_entity_index(entity_id));
+
 		const EntityID new_id = create_entity_id(EntityIndex(-1), get_entity_version(entity_id) + 1);
 		entities[get_entity_index(entity_id)].id = new_id;
 		entities[get_entity_index(entity_id)].components.reset();
 		free_entities.push_back(get_entity_index(entity_id));
 	}
 
+	void Scene::destroy_entity_components(EntityIndex entity_index)
+	{
+		for (size_t component_id = 0; component_id < component_destructors.size(); ++component_id)
+		{
+			if (component_destructors[component_id] != nullptr && entities[entity_index].components.test(component_id))
+			{
+				component_destructors[component_id](component_pools[component_id]->get(entity_index));
+			}
+		}
+	}
+
+	EntityCommandBuffer* Scene::get_entity_command_buffer()
+	{
+		struct CachedEntityCommandBuffer
+		{
+			uint64_t scene_uid{ 0 };
+			EntityCommandBuffer* command_buffer{ nullptr };
+		};
+		thread_local CachedEntityCommandBuffer cached_buffer;
+
+		if (cached_buffer.scene_uid == scene_uid)
+		{
+			return cached_buffer.command_buffer;
+		}
+
+		std::scoped_lock lock(entity_command_buffers_mutex);
+
+		const std::thread::id this_thread = std::this_thread::get_id();
+		auto found = std::find_if(
+			entity_command_buffers.begin(),
+			entity_command_buffers.end(),
+			[this_thread](const std::unique_ptr<EntityCommandBuffer>& command_buffer)
+			{
+				return command_buffer->owner_thread == this_thread;
+			}
+		);
+
+		EntityCommandBuffer* command_buffer = nullptr;
+		if (found != entity_command_buffers.end())
+		{
+			command_buffer = (*found).get();
+		}
+		else
+		{
+			entity_command_buffers.push_back(std::make_unique<EntityCommandBuffer>(uint32_t(entity_command_buffers.size())));
+			command_buffer = entity_command_buffers.back().get();
+		}
+
+		cached_buffer = { scene_uid, command_buffer };
+
+		return command_buffer;
+	}
+
+	void Scene::flush_entity_commands()
+	{
+		std::scoped_lock lock(entity_command_buffers_mutex);
+
+		const bool b_has_commands = std::any_of(
+			entity_command_buffers.begin(),
+			entity_command_buffers.end(),
+			[](const std::unique_ptr<EntityCommandBuffer>& command_buffer)
+			{
+				return !command_buffer->empty();
+			}
+		);
+		if (!b_has_commands)
+		{
+			return;
+		}
+
+		ZoneScopedN("Scene::flush_entity_commands");
+
+		// Commands are applied grouped by type: creations first so temporary IDs from any buffer can be resolved,
+		// then component adds and removes grouped by component type, and finally destructions.
+		temporary_entity_mappings.clear();
+		for (std::unique_ptr<EntityCommandBuffer>& command_buffer : entity_command_buffers)
+		{
+			for (EntityID temporary_id : command_buffer->created_entities)
+			{
+				temporary_entity_mappings.insert({ temporary_id, make_entity() });
+			}
+		}
+
+		pending_add_commands.clear();
+		for (std::unique_ptr<EntityCommandBuffer>& command_buffer : entity_command_buffers)
+		{
+			for (EntityAddComponentCommand& command : command_buffer->add_commands)
+			{
+				pending_add_commands.push_back(&command);
+			}
+		}
+		std::stable_sort(pending_add_commands.begin(), pending_add_commands.end(), [](const EntityAddComponentCommand* a, const EntityAddComponentCommand* b)
+		{
+			return a->component_id < b->component_id;
+		});
+		for (EntityAddComponentCommand* command : pending_add_commands)
+		{
+			const EntityID entity = resolve_command_entity(command->entity);
+			if (is_live_entity(entity))
+			{
+				command->assign(this, entity, command->payload);
+			}
+			command->destroy(command->payload);
+			command->payload = nullptr;
+		}
+
+		pending_remove_commands.clear();
+		for (std::unique_ptr<EntityCommandBuffer>& command_buffer : entity_command_buffers)
+		{
+			for (EntityRemoveComponentCommand& command : command_buffer->remove_commands)
+			{
+				pending_remove_commands.push_back(&command);
+			}
+		}
+		std::stable_sort(pending_remove_commands.begin(), pending_remove_commands.end(), [](const EntityRemoveComponentCommand* a, const EntityRemoveComponentCommand* b)
+		{
+			return a->component_id < b->component_id;
+		});
+		for (EntityRemoveComponentCommand* command : pending_remove_commands)
+		{
+			const EntityID entity = resolve_command_entity(command->entity);
+			if (is_live_entity(entity))
+			{
+				command->unassign(this, entity);
+			}
+		}
+
+		for (std::unique_ptr<EntityCommandBuffer>& command_buffer : entity_command_buffers)
+		{
+			for (EntityID destroyed_id : command_buffer->destroyed_entities)
+			{
+				// Liveness check also filters out entities destroyed more than once
+				const EntityID entity = resolve_command_entity(destroyed_id);
+				if (is_live_entity(entity))
+				{
+					destroy_entity(entity);
+				}
+			}
+			command_buffer->reset();
+		}
+	}
+
+	EntityID Scene::resolve_command_entity(EntityID entity_id)
+	{
+		if (!is_temporary_entity(entity_id))
+		{
+			return entity_id;
+		}
+		auto found = temporary_entity_mappings.find(entity_id);
+		return found != temporary_entity_mappings.end() ? (*found).second : INVALID_ENTITY;
+	}
+
+	bool Scene::is_live_entity(EntityID entity_id) const
+	{
+		return is_valid_entity(entity_id)
+			&& get_entity_index(entity_id) < entities.size()
+			&& entities[get_entity_index(entity_id)].id == entity_id;
+	}
+
 	void Scene::add_default_camera()
 	{
 		if (active_camera == 0)
@@ -108,6 +351,7 @@ namespace Sunset
 		// TODO: Look for a more extensible way to add arbitrary external subsystems
 		add_subsystem<CameraControlProcessor>();
 		add_subsystem<TransformProcessor>();
+		add_subsystem<BoundsProcessor>();
 		add_subsystem<StaticMeshProcessor>();
 		add_subsystem<LightProcessor>();
 		add_subsystem<SceneLightingProcessor>();
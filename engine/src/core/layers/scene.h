@@ -1,11 +1,16 @@
 #pragma once
 
 #include <type_traits>
+#include <mutex>
 
 #include <minimal.h>
 #include <core/simulation_layer.h>
 #include <core/subsystem.h>
+#include <core/subsystem_tick_graph.h>
 #include <core/ecs/entity.h>
+#include <core/ecs/entity_command_buffer.h>
+#include <core/ecs/entity_prefab.h>
+#include <core/ecs/dynamic_aabb_tree.h>
 #include <memory/allocators/pool_allocator.h>
 
 namespace Sunset
@@ -65,7 +70,7 @@ namespace Sunset
 			Scene();
 			Scene(const Scene&) = delete;
 			Scene& operator=(const Scene&) = delete;
-			~Scene() = default;
+			~Scene();
 
 			virtual void initialize() override;
 			virtual void destroy() override;
@@ -81,11 +86,19 @@ namespace Sunset
 				}
 
 				std::unique_ptr<T> new_subsystem = std::make_unique<T>();
+				new_subsystem->type_id = get_subsystem_type_id<T>();
 				new_subsystem->initialize(this);
 
 				T* new_subsystem_ptr = new_subsystem.get();
 
+				if (subsystem_lookup.size() <= new_subsystem_ptr->type_id)
+				{
+					subsystem_lookup.resize(new_subsystem_ptr->type_id + 1, nullptr);
+				}
+				subsystem_lookup[new_subsystem_ptr->type_id] = new_subsystem_ptr;
+
 				subsystems.push_back(std::move(new_subsystem));
+				b_subsystem_graph_dirty = true;
 
 				return new_subsystem_ptr;
 			}
@@ -94,25 +107,35 @@ namespace Sunset
 			T* get_subsystem()
 			{
 				assert((std::is_base_of<Subsystem, T>::value));
-				auto found = std::find_if(
-					subsystems.cbegin(),
-					subsystems.cend(),
-					[](const std::unique_ptr<Subsystem>& subsystem)
-					{ 
-						return typeid(*subsystem.get()) == typeid(T);
-					}
-				);
-				return found != subsystems.cend() ? static_cast<T*>((*found).get()) : nullptr;
+				const int type_id = get_subsystem_type_id<T>();
+				return type_id < subsystem_lookup.size() ? static_cast<T*>(subsystem_lookup[type_id]) : nullptr;
 			}
 
 			template<class T>
 			void remove_subsystem()
 			{
 				assert((std::is_base_of<Subsystem, T>::value));
-				std::erase(std::remove_if(subsystems.begin(), subsystems.end(), [](const std::unique_ptr<Subsystem>& subsystem)
-					{
-						return typeid(*subsystem.get()) == typeid(T);
-					}), subsystems.end());
+				const int type_id = get_subsystem_type_id<T>();
+				if (type_id >= subsystem_lookup.size() || subsystem_lookup[type_id] == nullptr)
+				{
+					return;
+				}
+				subsystem_lookup[type_id] = nullptr;
+				std::erase_if(subsystems, [type_id](const std::unique_ptr<Subsystem>& subsystem)
+				{
+					return subsystem->get_type_id() == type_id;
+				});
+				b_subsystem_graph_dirty = true;
+			}
+
+			const SubsystemTickGraph& get_subsystem_graph()
+			{
+				if (b_subsystem_graph_dirty)
+				{
+					subsystem_graph.build(subsystems);
+					b_subsystem_graph_dirty = false;
+				}
+				return subsystem_graph;
 			}
 
 			template<typename T>
@@ -126,16 +149,13 @@ namespace Sunset
 
 				int component_id = get_component_id<T>();
 
-				if (component_pools.size() <= component_id)
-				{
-					component_pools.resize(component_id + 1);
-				}
-				if (component_pools[component_id] == nullptr)
+				// Pools grow by whole chunks, so components already handed out keep their address
+				StaticBytePoolAllocator* const component_pool = get_or_create_component_pool<T>();
+				if (entities[get_entity_index(entity_id)].components.test(component_id))
 				{
-					component_pools[component_id] = std::make_unique<StaticBytePoolAllocator>(sizeof(T), MIN_ENTITIES);
+					std::destroy_at(static_cast<T*>(component_pool->get(get_entity_index(entity_id))));
 				}
-
-				T* component = new (component_pools[component_id]->get(get_entity_index(entity_id))) T();
+				T* component = new (component_pool->get(get_entity_index(entity_id))) T();
 
 				entities[get_entity_index(entity_id)].components.set(component_id);
 
@@ -172,13 +192,97 @@ namespace Sunset
 				}
 
 				int component_id = get_component_id<T>();
-				entities[get_entity_index(entity_id)].components.reset(component_id);
+				if (entities[get_entity_index(entity_id)].components.test(component_id))
+				{
+					std::destroy_at(static_cast<T*>(component_pools[component_id]->get(get_entity_index(entity_id))));
+				}
+				entities[get_entity_index(entity_id)].components.unset(component_id);
 			}
 
 			EntityID make_entity();
 			void destroy_entity(EntityID entity_id);
 
+			// Creates count entities at once, appending their IDs to out_entities
+			void make_entities(uint32_t count, std::vector<EntityID>& out_entities);
+			// Grows entity storage and every component pool up front so that entity_count entities fit without reallocating
+			void reserve_entities(size_t entity_count);
+
+			// Spawns count copies of a prefab, reserving storage once and copy constructing every component from its prototype.
+			// init_instance is called per spawned entity as (instance_index, entity, ComponentTypes&...) to set up per instance values.
+			template<typename... ComponentTypes, typename InitFunc>
+			void instantiate(const EntityPrefab<ComponentTypes...>& prefab, uint32_t count, std::vector<EntityID>& out_entities, InitFunc&& init_instance)
+			{
+				ZoneScopedN("Scene::instantiate");
+
+				const size_t first_instance = out_entities.size();
+				make_entities(count, out_entities);
+
+				ComponentMask prefab_mask;
+				(prefab_mask.set(get_component_id<ComponentTypes>()), ...);
+				(get_or_create_component_pool<ComponentTypes>(), ...);
+
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const EntityID entity = out_entities[first_instance + i];
+					const EntityIndex entity_index = get_entity_index(entity);
+
+					entities[entity_index].components = entities[entity_index].components | prefab_mask;
+
+					init_instance(i, entity, *construct_component<ComponentTypes>(entity_index, prefab.template get<ComponentTypes>())...);
+				}
+			}
+
+			template<typename... ComponentTypes>
+			void instantiate(const EntityPrefab<ComponentTypes...>& prefab, uint32_t count, std::vector<EntityID>& out_entities)
+			{
+				instantiate(prefab, count, out_entities, [](uint32_t, EntityID, ComponentTypes&...) { });
+			}
+
+			// Command buffer owned by the calling thread, for structural changes that can't be applied immediately
+			EntityCommandBuffer* get_entity_command_buffer();
+			// Plays back every recorded entity command buffer. Must not run while other threads are still recording.
+			void flush_entity_commands();
+
+			// Bounding volume hierarchy over the world bounds of every entity with a mesh
+			DynamicAABBTree& get_spatial_index()
+			{
+				return spatial_index;
+			}
+
 		protected:
+			template<typename T>
+			StaticBytePoolAllocator* get_or_create_component_pool()
+			{
+				const int component_id = get_component_id<T>();
+				if (component_pools.size() <= component_id)
+				{
+					component_pools.resize(component_id + 1);
+				}
+				if (component_pools[component_id] == nullptr)
+				{
+					component_pools[component_id] = std::make_unique<StaticBytePoolAllocator>(sizeof(T), MIN_ENTITIES);
+					component_destructors.resize(component_pools.size(), nullptr);
+					if constexpr (!std::is_trivially_destructible_v<T>)
+					{
+						component_destructors[component_id] = [](void* component) { std::destroy_at(static_cast<T*>(component)); };
+					}
+				}
+				component_pools[component_id]->grow(entities.capacity());
+				return component_pools[component_id].get();
+			}
+
+			template<typename T>
+			T* construct_component(EntityIndex entity_index, const T& prototype)
+			{
+				return new (component_pools[get_component_id<T>()]->get(entity_index)) T(prototype);
+			}
+
+			// Runs the destructors of every component the entity has, so components that own resources release them
+			void destroy_entity_components(EntityIndex entity_index);
+
+			EntityID resolve_command_entity(EntityID entity_id);
+			bool is_live_entity(EntityID entity_id) const;
+
 			void add_default_camera();
 			void setup_subsystems();
 			void setup_renderer_data();
@@ -186,12 +290,50 @@ namespace Sunset
 		public:
 			std::vector<std::unique_ptr<Subsystem>> subsystems;
 			std::vector<std::unique_ptr<StaticBytePoolAllocator>> component_pools;
+			// Indexed by component ID, null for trivially destructible components
+			std::vector<void(*)(void*)> component_destructors;
 			std::vector<Entity> entities;
 			std::vector<EntityIndex> free_entities;
 			EntityID active_camera{ 0 };
 			SceneData scene_data;
+
+		protected:
+			std::vector<Subsystem*> subsystem_lookup;
+			SubsystemTickGraph subsystem_graph;
+			bool b_subsystem_graph_dirty{ true };
+			DynamicAABBTree spatial_index;
+			uint64_t scene_uid{ 0 };
+			std::mutex entity_command_buffers_mutex;
+			std::vector<std::unique_ptr<EntityCommandBuffer>> entity_command_buffers;
+			phmap::flat_hash_map<EntityID, EntityID> temporary_entity_mappings;
+			std::vector<EntityAddComponentCommand*> pending_add_commands;
+			std::vector<EntityRemoveComponentCommand*> pending_remove_commands;
 	};
 
+	namespace EntityCommandOps
+	{
+		template<typename T>
+		void assign_component(Scene* scene, EntityID entity, void* payload)
+		{
+			if (T* const component = scene->assign_component<T>(entity))
+			{
+				*component = std::move(*static_cast<T*>(payload));
+			}
+		}
+
+		template<typename T>
+		void unassign_component(Scene* scene, EntityID entity)
+		{
+			scene->unassign_component<T>(entity);
+		}
+
+		template<typename T>
+		void destroy_payload(void* payload)
+		{
+			static_cast<T*>(payload)->~T();
+		}
+	}
+
 	template<typename... ComponentTypes>
 	struct SceneView
 	{
@@ -2,5 +2,5 @@
 
 namespace Sunset
 {
-
+	std::atomic_int g_subsystem_type_counter{ 0 };
 }
@@ -1,7 +1,62 @@
 #pragma once
 
+#include <minimal.h>
+#include <core/ecs/component.h>
+
 namespace Sunset
 {
+	extern std::atomic_int g_subsystem_type_counter;
+
+	template<class T>
+	int get_subsystem_type_id()
+	{
+		static int subsystem_type_id = g_subsystem_type_counter++;
+		return subsystem_type_id;
+	}
+
+	// Declares what a subsystem touches during its tick stages so the scene can figure out which subsystems are safe to run concurrently.
+	// Subsystems that never declare anything are treated as exclusive and won't run alongside any other subsystem.
+	struct SubsystemAccess
+	{
+		template<class T>
+		SubsystemAccess& read()
+		{
+			reads.set(get_component_id<T>());
+			b_exclusive = false;
+			return *this;
+		}
+
+		template<class T>
+		SubsystemAccess& write()
+		{
+			writes.set(get_component_id<T>());
+			b_exclusive = false;
+			return *this;
+		}
+
+		template<class T>
+		SubsystemAccess& run_after()
+		{
+			run_after_subsystems.push_back(get_subsystem_type_id<T>());
+			b_exclusive = false;
+			return *this;
+		}
+
+		// For subsystems that talk to the renderer or other systems that are only safe to use from the thread updating the scene
+		SubsystemAccess& main_thread()
+		{
+			b_main_thread = true;
+			b_exclusive = false;
+			return *this;
+		}
+
+		ComponentMask reads;
+		ComponentMask writes;
+		std::vector<int> run_after_subsystems;
+		bool b_exclusive{ true };
+		bool b_main_thread{ false };
+	};
+
 	class Subsystem
 	{
 	public:
@@ -13,5 +68,16 @@ namespace Sunset
 		virtual void pre_update(class Scene* scene) { };
 		virtual void update(class Scene* scene, double delta_time) = 0;
 		virtual void post_update(class Scene* scene) { };
+		virtual void declare_access(SubsystemAccess& access) { };
+
+		int get_type_id() const
+		{
+			return type_id;
+		}
+
+	protected:
+		friend class Scene;
+
+		int type_id{ -1 };
 	};
 }
@@ -0,0 +1,162 @@
+#include <core/subsystem_tick_graph.h>
+#include <job_system/job_scheduler.h>
+
+namespace Sunset
+{
+	void SubsystemTickGraph::build(const std::vector<std::unique_ptr<Subsystem>>& subsystems)
+	{
+		ZoneScopedN("SubsystemTickGraph::build");
+
+		const uint32_t subsystem_count = static_cast<uint32_t>(subsystems.size());
+
+		std::vector<SubsystemAccess> accesses(subsystem_count);
+		for (uint32_t i = 0; i < subsystem_count; ++i)
+		{
+			subsystems[i]->declare_access(accesses[i]);
+		}
+
+		std::vector<std::vector<uint32_t>> successors(subsystem_count);
+		std::vector<uint32_t> predecessor_counts(subsystem_count, 0);
+
+		const auto add_edge = [&successors, &predecessor_counts](uint32_t from, uint32_t to)
+		{
+			if (std::find(successors[from].begin(), successors[from].end(), to) == successors[from].end())
+			{
+				successors[from].push_back(to);
+				++predecessor_counts[to];
+			}
+		};
+
+		for (uint32_t i = 0; i < subsystem_count; ++i)
+		{
+			for (uint32_t j = i + 1; j < subsystem_count; ++j)
+			{
+				if (accesses_conflict(accesses[i], accesses[j]))
+				{
+					add_edge(i, j);
+				}
+			}
+
+			for (int after_type_id : accesses[i].run_after_subsystems)
+			{
+				auto found = std::find_if(subsystems.begin(), subsystems.end(), [after_type_id](const std::unique_ptr<Subsystem>& subsystem)
+				{
+					return subsystem->get_type_id() == after_type_id;
+				});
+				if (found != subsystems.end())
+				{
+					add_edge(static_cast<uint32_t>(std::distance(subsystems.begin(), found)), i);
+				}
+			}
+		}
+
+		// Kahn's algorithm, with each subsystem placed in the wave right after its latest predecessor
+		subsystem_waves.assign(subsystem_count, 0);
+
+		std::vector<uint32_t> ready;
+		ready.reserve(subsystem_count);
+		for (uint32_t i = 0; i < subsystem_count; ++i)
+		{
+			if (predecessor_counts[i] == 0)
+			{
+				ready.push_back(i);
+			}
+		}
+
+		uint32_t visited_count = 0;
+		uint32_t wave_count = 0;
+		while (!ready.empty())
+		{
+			const uint32_t current = ready.back();
+			ready.pop_back();
+			++visited_count;
+
+			wave_count = std::max(wave_count, subsystem_waves[current] + 1);
+
+			for (uint32_t successor : successors[current])
+			{
+				subsystem_waves[successor] = std::max(subsystem_waves[successor], subsystem_waves[current] + 1);
+				if (--predecessor_counts[successor] == 0)
+				{
+					ready.push_back(successor);
+				}
+			}
+		}
+
+		assert(visited_count == subsystem_count && "Subsystem run_after declarations form a cycle!");
+
+		waves.clear();
+		waves.resize(wave_count);
+
+		// Registration order is kept within each wave so main thread subsystems still tick in the order they were added
+		for (uint32_t i = 0; i < subsystem_count; ++i)
+		{
+			Wave& wave = waves[subsystem_waves[i]];
+			wave.subsystems.push_back(i);
+			if (accesses[i].b_main_thread)
+			{
+				wave.main_thread_subsystems.push_back(i);
+			}
+			else
+			{
+				wave.worker_subsystems.push_back(i);
+			}
+		}
+	}
+
+	void SubsystemTickGraph::run(const std::vector<std::unique_ptr<Subsystem>>& subsystems, const std::function<void(Subsystem*)>& stage_op, bool b_parallel) const
+	{
+		const bool b_can_run_parallel = b_parallel && JobScheduler::get()->has_available_threads();
+
+		const auto stage_job = [&stage_op](Subsystem* subsystem) -> ThreadedJob<>
+		{
+			stage_op(subsystem);
+			co_return;
+		};
+
+		for (const Wave& wave : waves)
+		{
+			// Nothing to overlap with, so skip the job round trip
+			if (!b_can_run_parallel || wave.subsystems.size() <= 1)
+			{
+				for (uint32_t index : wave.subsystems)
+				{
+					stage_op(subsystems[index].get());
+				}
+				continue;
+			}
+
+			JobBatcher<ThreadedJob<>> jobs(wave.worker_subsystems.size());
+			for (uint32_t i = 0; i < wave.worker_subsystems.size(); ++i)
+			{
+				jobs.add(stage_job(subsystems[wave.worker_subsystems[i]].get()), i);
+			}
+
+			for (uint32_t index : wave.main_thread_subsystems)
+			{
+				stage_op(subsystems[index].get());
+			}
+
+			jobs.wait_on_all();
+		}
+	}
+
+	bool SubsystemTickGraph::is_ordered_before(uint32_t before, uint32_t after) const
+	{
+		assert(before < subsystem_waves.size() && after < subsystem_waves.size());
+		return subsystem_waves[before] < subsystem_waves[after];
+	}
+
+	bool SubsystemTickGraph::accesses_conflict(const SubsystemAccess& a, const SubsystemAccess& b)
+	{
+		if (a.b_exclusive || b.b_exclusive)
+		{
+			return true;
+		}
+
+		const ComponentMask empty_mask;
+		return (a.writes & b.writes) != empty_mask
+			|| (a.writes & b.reads) != empty_mask
+			|| (a.reads & b.writes) != empty_mask;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <minimal.h>
+#include <core/subsystem.h>
+
+#include <functional>
+
+namespace Sunset
+{
+	// Dependency graph over a scene's subsystems. Subsystems whose declared accesses conflict keep their registration order,
+	// explicit run_after declarations add extra edges, and the result is flattened into waves of subsystems that can tick together.
+	class SubsystemTickGraph
+	{
+	public:
+		struct Wave
+		{
+			std::vector<uint32_t> subsystems;
+			std::vector<uint32_t> worker_subsystems;
+			std::vector<uint32_t> main_thread_subsystems;
+		};
+
+		SubsystemTickGraph() = default;
+		~SubsystemTickGraph() = default;
+
+		void build(const std::vector<std::unique_ptr<Subsystem>>& subsystems);
+		// Runs stage_op on every subsystem, one wave after the other. Worker subsystems within a wave go out to the job system
+		// while main thread subsystems run on the calling thread, and every wave is joined before the next one starts.
+		void run(const std::vector<std::unique_ptr<Subsystem>>& subsystems, const std::function<void(Subsystem*)>& stage_op, bool b_parallel = true) const;
+
+		const std::vector<Wave>& get_waves() const
+		{
+			return waves;
+		}
+
+		// Whether subsystem at index `before` is guaranteed to finish a stage before subsystem at index `after` starts it
+		bool is_ordered_before(uint32_t before, uint32_t after) const;
+
+	protected:
+		static bool accesses_conflict(const SubsystemAccess& a, const SubsystemAccess& b);
+
+	protected:
+		std::vector<Wave> waves;
+		std::vector<uint32_t> subsystem_waves;
+	};
+}
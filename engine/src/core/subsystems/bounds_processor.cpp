@@ -0,0 +1,71 @@
+#include <core/subsystems/bounds_processor.h>
+#include <core/ecs/components/mesh_component.h>
+#include <core/ecs/components/transform_component.h>
+#include <core/layers/scene.h>
+#include <core/data_globals.h>
+
+namespace Sunset
+{
+	void BoundsProcessor::initialize(class Scene* scene)
+	{
+		bounds_batch.reserve(MIN_ENTITIES);
+		batched_entities.reserve(MIN_ENTITIES);
+		batched_bounds_scales.reserve(MIN_ENTITIES);
+	}
+
+	void BoundsProcessor::update(class Scene* scene, double delta_time)
+	{
+		ZoneScopedN("BoundsProcessor::update");
+
+		EntityGlobals* const entity_globals = EntityGlobals::get();
+		DynamicAABBTree& spatial_index = scene->get_spatial_index();
+
+		bounds_batch.clear();
+		batched_entities.clear();
+		batched_bounds_scales.clear();
+
+		for (EntityID entity : SceneView<MeshComponent, TransformComponent>(*scene))
+		{
+			const EntityIndex entity_index = get_entity_index(entity);
+
+			// Entities missing from the spatial index haven't had their bounds computed yet
+			if (!entity_globals->entity_transform_dirty_states.test(entity_index) && spatial_index.contains_entity(entity))
+			{
+				continue;
+			}
+
+			MeshComponent* const mesh_comp = scene->get_component<MeshComponent>(entity);
+			TransformComponent* const transform_comp = scene->get_component<TransformComponent>(entity);
+
+			const Bounds local_bounds = mesh_local_bounds(mesh_comp);
+			bounds_batch.add(local_bounds.origin, local_bounds.extents, local_bounds.radius, &transform_comp->transform.local_matrix);
+			batched_entities.push_back(entity);
+			batched_bounds_scales.push_back(mesh_comp->custom_bounds_scale);
+		}
+
+		BoundsBatchOps::transform(bounds_batch);
+
+		for (size_t i = 0; i < batched_entities.size(); ++i)
+		{
+			const EntityID entity = batched_entities[i];
+			const glm::vec3 world_center = bounds_batch.get_world_center(i);
+			const glm::vec3 world_extents = bounds_batch.get_world_extents(i);
+
+			const EntityIndex entity_index = get_entity_index(entity);
+			EntitySceneData& entity_data = entity_globals->entity_data[entity_index];
+			entity_data.bounds_pos_radius = glm::vec4(world_center, bounds_batch.world_radius[i]);
+			entity_data.bounds_extent_and_custom_scale = glm::vec4(world_extents, batched_bounds_scales[i]);
+			entity_globals->entity_data.mark_dirty(entity_index);
+
+			spatial_index.update_entity(entity, { world_center - world_extents, world_center + world_extents });
+		}
+	}
+
+	void BoundsProcessor::declare_access(SubsystemAccess& access)
+	{
+		// Mesh resources are looked up through the resource cache, which is only safe from the main thread
+		access.read<TransformComponent>()
+			.read<MeshComponent>()
+			.main_thread();
+	}
+}
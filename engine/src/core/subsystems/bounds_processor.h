@@ -0,0 +1,34 @@
+#pragma once
+
+#include <core/subsystem.h>
+#include <core/ecs/entity.h>
+#include <utility/simd/bounds_batch.h>
+
+namespace Sunset
+{
+	// Keeps the cached world AABB and bounding sphere of every mesh entity up to date, only recomputing
+	// entities whose transform changed. Results land in the entity scene data (used by GPU and CPU culling)
+	// and the scene spatial index.
+	class BoundsProcessor : public Subsystem
+	{
+	public:
+		BoundsProcessor() = default;
+		~BoundsProcessor() = default;
+
+		virtual void initialize(class Scene* scene) override;
+		virtual void destroy(class Scene* scene) override { };
+		virtual void update(class Scene* scene, double delta_time) override;
+		virtual void declare_access(SubsystemAccess& access) override;
+
+		// Entities whose world bounds changed during the last update, e.g. for refreshing broadphase or shadow caster hints
+		const std::vector<EntityID>& get_updated_entities() const
+		{
+			return batched_entities;
+		}
+
+	protected:
+		BoundsBatch bounds_batch;
+		std::vector<EntityID> batched_entities;
+		std::vector<float> batched_bounds_scales;
+	};
+}
@@ -141,7 +141,7 @@ namespace Sunset
 				.p11 = projection[1][1],
 				.culling_enabled = true,
 				.occlusion_enabled = true,
-				.distance_check = true
+				.distance_check = camera_control_comp->data.b_distance_cull
 			};
 			
 			// Queueing this up as a render graph command as the renderer will eventually be on a separate thread, and we want some ordering
@@ -162,4 +162,10 @@ namespace Sunset
 			}));
 		}
 	}
+
+	void CameraControlProcessor::declare_access(SubsystemAccess& access)
+	{
+		access.write<CameraControlComponent>()
+			.main_thread();
+	}
 }
@@ -8,6 +8,7 @@
 #include <graphics/renderer.h>
 #include <graphics/debug_draw_helpers.h>
 #include <utility/cvar.h>
+#include <core/subsystems/static_mesh_processor.h>
 
 namespace Sunset
 {
@@ -56,7 +57,8 @@ namespace Sunset
 			{
 				const glm::vec4 light_position = transform_comp->transform.local_matrix[3];
 				entity_data.bounds_pos_radius = glm::vec4(light_position.x, light_position.y, light_position.z, light_comp->light->radius);
-				entity_data.local_transform = transform_comp->transform.local_matrix;
+				EntityGlobals::get()->entity_data.mark_dirty(entity_index);
+				LightGlobals::get()->light_data.mark_dirty(light_comp->light_data_buffer_offset);
 				LightGlobals::get()->light_dirty_states.unset(light_comp->light_data_buffer_offset);
 			}
 
@@ -77,13 +79,9 @@ namespace Sunset
 
 		QUEUE_RENDERGRAPH_COMMAND(CopyLightData, ([](class RenderGraph& render_graph, RGFrameData& frame_data, void* command_buffer)
 		{
-			// TODO: Only update dirtied entities instead of re-uploading the buffer every frame
-			Buffer* const lights_buffer = CACHE_FETCH(Buffer, LightGlobals::get()->light_data.data_buffer[frame_data.buffered_frame_number]);
-			lights_buffer->copy_from(
-				frame_data.gfx_context,
-				LightGlobals::get()->light_data.data.data(),
-				LightGlobals::get()->light_data.data.size() * sizeof(LightData)
-			);
+			LightDataShared& light_data = LightGlobals::get()->light_data;
+			Buffer* const lights_buffer = CACHE_FETCH(Buffer, light_data.data_buffer[frame_data.buffered_frame_number]);
+			light_data.upload(frame_data.gfx_context, lights_buffer, frame_data.buffered_frame_number);
 		}));
 	}
 
@@ -186,4 +184,14 @@ namespace Sunset
 
 		return corners;
 	}
+
+	void LightProcessor::declare_access(SubsystemAccess& access)
+	{
+		// Also writes entity scene data bounds, which static meshes fill in as well
+		access.read<TransformComponent>()
+			.read<CameraControlComponent>()
+			.write<LightComponent>()
+			.run_after<StaticMeshProcessor>()
+			.main_thread();
+	}
 }
@@ -14,6 +14,7 @@ namespace Sunset
 		virtual void initialize(class Scene* scene) override;
 		virtual void destroy(class Scene* scene) override { };
 		virtual void update(class Scene* scene, double delta_time) override;
+		virtual void declare_access(SubsystemAccess& access) override;
 
 		void calculate_csm_matrices(class Scene* scene, class CameraControlComponent* camera_comp, const glm::vec3& light_dir, uint32_t buffered_frame_number);
 		glm::mat4 calculate_light_space_matrix(class CameraControlComponent* camera_comp, float near, float far, const glm::vec3& light_dir, uint32_t buffered_frame_number);
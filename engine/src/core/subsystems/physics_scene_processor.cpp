@@ -128,4 +128,12 @@ namespace Sunset
 			}
 		}
 	}
+
+	void PhysicsSceneProcessor::declare_access(SubsystemAccess& access)
+	{
+		// Jolt farms its work out to the job system and waits on it, so keep the step itself off of job threads
+		access.write<BodyComponent>()
+			.write<TransformComponent>()
+			.main_thread();
+	}
 }
@@ -13,5 +13,6 @@ namespace Sunset
 		virtual void initialize(class Scene* scene) override;
 		virtual void destroy(class Scene* scene) override;
 		virtual void update(class Scene* scene, double delta_time) override;
+		virtual void declare_access(SubsystemAccess& access) override;
 	};
 }
@@ -5,6 +5,7 @@
 #include <graphics/renderer.h>
 #include <graphics/light.h>
 #include <graphics/descriptor.h>
+#include <core/subsystems/light_processor.h>
 
 namespace Sunset
 {
@@ -72,4 +73,11 @@ namespace Sunset
 
 		QUEUE_RENDERGRAPH_COMMAND(SetIrradianceMap, set_irradiance_map_callback);
 	}
+
+	void SceneLightingProcessor::declare_access(SubsystemAccess& access)
+	{
+		// Uploads the scene lighting data that the light processor fills in
+		access.run_after<LightProcessor>()
+			.main_thread();
+	}
 }
@@ -1,4 +1,5 @@
 #include <core/subsystems/static_mesh_processor.h>
+#include <core/subsystems/bounds_processor.h>
 #include <core/ecs/components/mesh_component.h>
 #include <core/ecs/components/transform_component.h>
 #include <core/ecs/components/camera_control_component.h>
@@ -14,11 +15,18 @@
 #include <graphics/resource/buffer.h>
 #include <graphics/descriptor.h>
 #include <graphics/resource/image.h>
+#include <utility/cvar.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Sunset
 {	
+	AutoCVar_Bool cvar_cpu_precull("ren.cpu_cull.enable", "Whether or not to coarsely cull mesh bounding spheres on the CPU before render tasks are submitted", true);
+	AutoCVar_Float cvar_cpu_precull_max_draw_distance("ren.cpu_cull.max_draw_distance", "Meshes further than this from the camera are culled before submission. Disabled when <= 0.", 0.0f);
+	AutoCVar_Bool cvar_lod_enable("ren.lod.enable", "Whether or not to select mesh LODs from projected screen size. When disabled every mesh draws its base LOD.", true);
+	AutoCVar_Float cvar_lod_bias("ren.lod.bias", "Global mesh LOD bias. Each positive unit halves the projected size used for selection, favoring coarser LODs.", 0.0f);
+	AutoCVar_Float cvar_lod_hysteresis("ren.lod.hysteresis", "Fraction a projected size must cross a LOD switch point by before a mesh changes LOD", 0.1f);
+
 	void StaticMeshProcessor::initialize(class Scene* scene)
 	{
 		ZoneScopedN("StaticMeshProcessor::initialize");
@@ -44,53 +52,159 @@ namespace Sunset
 		GraphicsContext* const gfx_context = Renderer::get()->context();
 		const uint32_t current_buffered_frame = gfx_context->get_buffered_frame_number();
 
+		cull_batch.clear();
+		cull_entities.clear();
+
 		for (EntityID entity : SceneView<MeshComponent, TransformComponent>(*scene))
 		{
-			const int32_t entity_index = get_entity_index(entity);
+			// World bounds are kept up to date by the BoundsProcessor
+			const EntitySceneData& entity_data = EntityGlobals::get()->entity_data[get_entity_index(entity)];
 
-			MeshComponent* const mesh_comp = scene->get_component<MeshComponent>(entity);
-			TransformComponent* const transform_comp = scene->get_component<TransformComponent>(entity);
+			cull_batch.add(glm::vec3(entity_data.bounds_pos_radius), entity_data.bounds_pos_radius.w * entity_data.bounds_extent_and_custom_scale.w);
+			cull_entities.push_back(entity);
+		}
 
-			EntitySceneData& entity_data = EntityGlobals::get()->entity_data[entity_index];
+		SphereCullView cull_view;
+		build_cull_view(scene, cull_view);
 
-			if (EntityGlobals::get()->entity_transform_dirty_states.test(entity_index))
-			{
-				const Bounds transformed_bounds = transform_mesh_bounds(mesh_comp, transform_comp->transform.local_matrix);
-				entity_data.bounds_extent_and_custom_scale = glm::vec4(transformed_bounds.extents, mesh_comp->custom_bounds_scale);
-				entity_data.bounds_pos_radius = glm::vec4(transformed_bounds.origin, transformed_bounds.radius);
-				entity_data.local_transform = transform_comp->transform.local_matrix;
-			}
+		// Coarse cull ahead of task submission, so far away meshes don't pay for sorting, batching and instance uploads.
+		// The GPU cull still runs afterwards for exact frustum and occlusion culling.
+		last_culled_count = 0;
+		if (cvar_cpu_precull.get())
+		{
+			ZoneScopedN("StaticMeshProcessor::update: cpu_precull");
+			last_culled_count = SphereCullOps::cull_parallel(cull_batch, cull_view);
+		}
+
+		MeshLODSelector lod_selector;
+		const bool b_select_lods = cvar_lod_enable.get() && build_lod_selector(scene, lod_selector);
+
+		// Draws are retained per buffered frame, since material indices differ between frames and the render
+		// thread may still be reading another frame's draws
+		MeshDrawList& draw_list = draw_lists[current_buffered_frame];
+		draw_list.begin_frame();
+
+		for (size_t cull_index = 0; cull_index < cull_entities.size(); ++cull_index)
+		{
+			const EntityID entity = cull_entities[cull_index];
+			const bool b_visible = cull_batch.visibility[cull_index] != 0;
+
+			MeshComponent* const mesh_comp = scene->get_component<MeshComponent>(entity);
 
-			for (uint32_t section_idx = 0; section_idx < mesh_comp->section_count; ++section_idx)
+			if (b_visible)
 			{
-				if (mesh_comp->resource_states[section_idx] == 0)
+				const uint32_t lod = b_select_lods ? select_lod(mesh_comp, lod_selector, cull_view.position, cull_index) : 0;
+				if (lod != mesh_comp->current_lod)
 				{
-					mesh_comp->resource_states[section_idx]  = ResourceStateBuilder::create()
-						.set_vertex_buffer(mesh_vertex_buffer(mesh_comp))
-						.set_vertex_count(mesh_vertex_count(mesh_comp))
-						.set_index_buffer(mesh_index_buffer(mesh_comp, section_idx))
-						.set_index_count(mesh_index_count(mesh_comp, section_idx))
-						.finish();
+					// Section resource states point at the current LOD's index range, so they get rebuilt with the draws
+					mesh_comp->current_lod = static_cast<uint8_t>(lod);
+					std::fill_n(mesh_resource_states(mesh_comp), mesh_comp->section_count, 0);
+					++mesh_comp->draw_revision;
 				}
+			}
+
+			if (!draw_list.is_entity_current(entity, mesh_comp->draw_revision))
+			{
+				build_entity_draws(draw_list, entity, mesh_comp, current_buffered_frame);
+			}
+
+			draw_list.set_entity_visible(entity, b_visible);
+		}
 
-				Material* const material = CACHE_FETCH(Material, mesh_comp->materials[section_idx]);
-				assert(material != nullptr && "Cannot process mesh with a null material");
+		draw_list.submit(Renderer::get()->get_mesh_task_queue(current_buffered_frame), MeshTaskQueue::use_material_agnostic_batching());
 
-				Renderer::get()
-					->fresh_rendertask()
-					->setup(mesh_comp->materials[section_idx], mesh_comp->resource_states[section_idx], 0)
-					->set_entity(entity_index)
-					->set_material_index(material->gpu_data_buffer_offset[current_buffered_frame])
-					->submit(Renderer::get()->get_mesh_task_queue(current_buffered_frame));
+		// Only entities written since this frame's buffer was last uploaded get copied
+		EntitySceneDataShared& entity_data = EntityGlobals::get()->entity_data;
+		Buffer* const entity_buffer = CACHE_FETCH(Buffer, entity_data.data_buffer[current_buffered_frame]);
+		entity_data.upload(gfx_context, entity_buffer, current_buffered_frame);
+	}
+
+	void StaticMeshProcessor::build_entity_draws(MeshDrawList& draw_list, EntityID entity, MeshComponent* mesh_comp, uint32_t buffered_frame)
+	{
+		ZoneScopedN("StaticMeshProcessor::build_entity_draws");
+
+		MaterialID* const materials = mesh_materials(mesh_comp);
+		ResourceStateID* const resource_states = mesh_resource_states(mesh_comp);
+		const uint32_t lod = mesh_comp->current_lod;
+
+		std::array<MeshDrawDesc, MAX_MESH_MATERIALS> draws;
+		for (uint32_t section_idx = 0; section_idx < mesh_comp->section_count; ++section_idx)
+		{
+			if (resource_states[section_idx] == 0)
+			{
+				resource_states[section_idx] = ResourceStateBuilder::create()
+					.set_vertex_buffer(mesh_vertex_buffer(mesh_comp))
+					.set_vertex_count(mesh_vertex_count(mesh_comp))
+					.set_vertex_offset(mesh_vertex_offset(mesh_comp))
+					.set_index_buffer(mesh_index_buffer(mesh_comp, section_idx))
+					.set_index_count(mesh_index_count(mesh_comp, section_idx, lod))
+					.set_index_start(mesh_index_start(mesh_comp, section_idx, lod))
+					.finish();
 			}
+
+			Material* const material = CACHE_FETCH(Material, materials[section_idx]);
+			assert(material != nullptr && "Cannot process mesh with a null material");
+
+			draws[section_idx] = {
+				.material = materials[section_idx],
+				.material_index = static_cast<uint32_t>(material->gpu_data_buffer_offset[buffered_frame]),
+				.resource_state = resource_states[section_idx]
+			};
+		}
+
+		draw_list.set_entity_draws(entity, mesh_comp->draw_revision, draws.data(), mesh_comp->section_count);
+	}
+
+	void StaticMeshProcessor::build_cull_view(class Scene* scene, SphereCullView& out_view) const
+	{
+		CameraControlComponent* const camera_comp = scene->get_component<CameraControlComponent>(scene->active_camera);
+		if (camera_comp == nullptr)
+		{
+			// Without a camera there is nothing to cull against, so keep everything
+			out_view.plane_count = 0;
+			out_view.max_distance = 0.0f;
+			return;
+		}
+
+		SphereCullOps::set_frustum_planes(out_view, camera_comp->data.gpu_data.frustum_planes, camera_comp->data.b_distance_cull);
+		out_view.position = camera_comp->data.position;
+		out_view.max_distance = cvar_cpu_precull_max_draw_distance.get();
+	}
+
+	bool StaticMeshProcessor::build_lod_selector(class Scene* scene, MeshLODSelector& out_selector) const
+	{
+		CameraControlComponent* const camera_comp = scene->get_component<CameraControlComponent>(scene->active_camera);
+		if (camera_comp == nullptr)
+		{
+			return false;
 		}
 
-		// TODO: Only update dirtied entities instead of re-uploading the buffer every frame
-		Buffer* const entity_buffer = CACHE_FETCH(Buffer, EntityGlobals::get()->entity_data.data_buffer[current_buffered_frame]);
-		entity_buffer->copy_from(
-			gfx_context,
-			EntityGlobals::get()->entity_data.data.data(),
-			EntityGlobals::get()->entity_data.data.size() * sizeof(EntitySceneData)
-		);
+		out_selector = make_mesh_lod_selector(camera_comp->data.gpu_data.projection_matrix[1][1], cvar_lod_bias.get(), cvar_lod_hysteresis.get());
+		return true;
+	}
+
+	uint32_t StaticMeshProcessor::select_lod(MeshComponent* mesh_comp, const MeshLODSelector& selector, const glm::vec3& view_position, size_t cull_index) const
+	{
+		if (mesh_comp->lod_count <= 1)
+		{
+			return 0;
+		}
+
+		Mesh* const mesh = CACHE_FETCH(Mesh, mesh_comp->mesh);
+
+		// The cull batch already holds the scaled world bounding sphere, so reuse it for the projected size
+		const glm::vec3 center(cull_batch.center_x[cull_index], cull_batch.center_y[cull_index], cull_batch.center_z[cull_index]);
+		const float screen_size = compute_lod_screen_size(selector, view_position, center, cull_batch.radius[cull_index]);
+
+		return select_mesh_lod(mesh->lod_screen_sizes.data(), mesh_comp->lod_count, screen_size, mesh_comp->current_lod, selector.hysteresis);
+	}
+
+	void StaticMeshProcessor::declare_access(SubsystemAccess& access)
+	{
+		access.read<TransformComponent>()
+			.read<CameraControlComponent>()
+			.write<MeshComponent>()
+			.run_after<BoundsProcessor>()
+			.main_thread();
 	}
 }
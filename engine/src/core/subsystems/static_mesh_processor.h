@@ -1,6 +1,9 @@
 #pragma once
 
 #include <core/subsystem.h>
+#include <utility/simd/sphere_cull_batch.h>
+#include <graphics/resource/mesh_lod.h>
+#include <graphics/mesh_draw_list.h>
 
 namespace Sunset
 {
@@ -13,5 +16,30 @@ namespace Sunset
 		virtual void initialize(class Scene* scene) override;
 		virtual void destroy(class Scene* scene) override { };
 		virtual void update(class Scene* scene, double delta_time) override;
+		virtual void declare_access(SubsystemAccess& access) override;
+
+		// Number of mesh entities dropped by the coarse CPU cull in the last update
+		size_t get_last_culled_count() const
+		{
+			return last_culled_count;
+		}
+
+		const MeshDrawList& get_draw_list(uint32_t buffered_frame) const
+		{
+			return draw_lists[buffered_frame];
+		}
+
+	protected:
+		void build_entity_draws(MeshDrawList& draw_list, EntityID entity, struct MeshComponent* mesh_comp, uint32_t buffered_frame);
+		void build_cull_view(class Scene* scene, SphereCullView& out_view) const;
+		// Returns false when there is no view to select LODs from, in which case every mesh uses its base LOD
+		bool build_lod_selector(class Scene* scene, MeshLODSelector& out_selector) const;
+		uint32_t select_lod(struct MeshComponent* mesh_comp, const MeshLODSelector& selector, const glm::vec3& view_position, size_t cull_index) const;
+
+	protected:
+		SphereCullBatch cull_batch;
+		std::vector<EntityID> cull_entities;
+		size_t last_culled_count{ 0 };
+		MeshDrawList draw_lists[MAX_BUFFERED_FRAMES];
 	};
 }
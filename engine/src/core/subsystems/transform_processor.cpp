@@ -9,6 +9,9 @@ namespace Sunset
 {
 	void TransformProcessor::initialize(class Scene* scene)
 	{
+		transform_batch.reserve(MIN_ENTITIES);
+		batched_transforms.reserve(MIN_ENTITIES);
+
 		for (int i = 0; i < MAX_BUFFERED_FRAMES; ++i)
 		{
 			if (EntityGlobals::get()->entity_data.data_buffer[i] == 0)
@@ -27,22 +30,55 @@ namespace Sunset
 
 	void TransformProcessor::update(class Scene* scene, double delta_time)
 	{
+		ZoneScopedN("TransformProcessor::update");
+
+		EntityGlobals* const entity_globals = EntityGlobals::get();
+
+		transform_batch.clear();
+		batched_transforms.clear();
+
 		for (EntityID entity : SceneView<TransformComponent>(*scene))
 		{
 			TransformComponent* const transform_comp = scene->get_component<TransformComponent>(entity);
 
 			if (transform_comp->transform.b_dirty)
 			{
-				recalculate_transform(transform_comp);
+				const EntityIndex entity_index = get_entity_index(entity);
+				assert(entity_index < entity_globals->entity_data.data.size() && "Entity index is past the end of the GPU entity data! Increase MIN_ENTITIES.");
+
+				// Matrices are composed straight into the entity data that gets uploaded to the GPU
+				transform_batch.add(
+					transform_comp->transform.position,
+					transform_comp->transform.rotation,
+					transform_comp->transform.scale,
+					&entity_globals->entity_data[entity_index].local_transform
+				);
+				batched_transforms.push_back(transform_comp);
+
 				transform_comp->transform.b_dirty = false;
 
-				EntityGlobals::get()->entity_transform_dirty_states.set(get_entity_index(entity));
+				entity_globals->entity_transform_dirty_states.set(entity_index);
+				entity_globals->entity_data.mark_dirty(entity_index);
 			}
 		}
+
+		TransformBatchOps::compose(transform_batch);
+
+		for (size_t i = 0; i < batched_transforms.size(); ++i)
+		{
+			batched_transforms[i]->transform.local_matrix = *transform_batch.outputs[i];
+		}
 	}
 
 	void TransformProcessor::post_update(Scene* scene)
 	{
 		EntityGlobals::get()->entity_transform_dirty_states.reset();
 	}
+
+	void TransformProcessor::declare_access(SubsystemAccess& access)
+	{
+		// Writes the shared entity scene data and transform dirty states, which other subsystems also touch on the main thread
+		access.write<TransformComponent>()
+			.main_thread();
+	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <core/subsystem.h>
+#include <utility/simd/transform_batch.h>
 
 namespace Sunset
 {
@@ -13,6 +14,11 @@ namespace Sunset
 		virtual void initialize(class Scene* scene) override;
 		virtual void destroy(class Scene* scene) override { };
 		virtual void update(class Scene* scene, double delta_time) override;
+		virtual void declare_access(SubsystemAccess& access) override;
 		virtual void post_update(class Scene* scene) override;
+
+	protected:
+		TransformBatch transform_batch;
+		std::vector<struct TransformComponent*> batched_transforms;
 	};
 }
@@ -1,44 +1,29 @@
 #include <graphics/api/vulkan/vk_barrier_batcher.h>
 #include <graphics/resource/buffer.h>
 #include <graphics/resource/image.h>
+#include <graphics/graphics_context.h>
+
+#include <algorithm>
 
 namespace Sunset
 {
-	void VulkanBarrierBatcher::begin(class GraphicsContext* const gfx_context, PipelineStageType stage)
-	{
-		current_stage = stage;
-	}
-
-	void VulkanBarrierBatcher::add_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access)
+	inline VkBufferMemoryBarrier make_vulkan_buffer_barrier(Buffer* buffer, AccessFlags src_access, AccessFlags dst_access)
 	{
-		if (buffer_barriers.find(execution_id) == buffer_barriers.end())
-		{
-			buffer_barriers.insert({ execution_id, {} });
-		}
-
 		VkBufferMemoryBarrier buffer_barrier;
 		buffer_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
 		buffer_barrier.pNext = nullptr;
-		buffer_barrier.srcAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(buffer->get_access_flags());
-		buffer_barrier.dstAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(destination_access);
+		buffer_barrier.srcAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(src_access);
+		buffer_barrier.dstAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(dst_access);
 		buffer_barrier.buffer = static_cast<VkBuffer>(buffer->get());
 		buffer_barrier.offset = 0;
 		buffer_barrier.size = buffer->get_size();
 		buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 		buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-
-		buffer_barriers[execution_id].push_back(buffer_barrier);
-
-		buffer->set_access_flags(destination_access);
+		return buffer_barrier;
 	}
 
-	void VulkanBarrierBatcher::add_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout)
+	inline VkImageMemoryBarrier make_vulkan_image_barrier(Image* image, AccessFlags src_access, AccessFlags dst_access, ImageLayout final_layout)
 	{
-		if (image_barriers.find(execution_id) == image_barriers.end())
-		{
-			image_barriers.insert({ execution_id, {} });
-		}
-
 		VkImageSubresourceRange range;
 		range.aspectMask = VK_FROM_SUNSET_IMAGE_USAGE_ASPECT_FLAGS(image->get_attachment_config().flags);
 		range.baseMipLevel = 0;
@@ -49,21 +34,182 @@ namespace Sunset
 		VkImageMemoryBarrier image_barrier;
 		image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		image_barrier.pNext = nullptr;
-		image_barrier.srcAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(image->get_access_flags());
-		image_barrier.dstAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(destination_access);
+		image_barrier.srcAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(src_access);
+		image_barrier.dstAccessMask = VK_FROM_SUNSET_ACCESS_FLAGS(dst_access);
 		image_barrier.image = static_cast<VkImage>(image->get_image());
 		image_barrier.oldLayout = VK_FROM_SUNSET_IMAGE_LAYOUT_FLAGS(image->get_layout());
 		image_barrier.newLayout = VK_FROM_SUNSET_IMAGE_LAYOUT_FLAGS(final_layout);
 		image_barrier.subresourceRange = range;
 		image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 		image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		return image_barrier;
+	}
+
+	void VulkanBarrierBatcher::begin(class GraphicsContext* const gfx_context, PipelineStageType stage)
+	{
+		current_stage = stage;
+	}
+
+	void VulkanBarrierBatcher::add_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access)
+	{
+		if (buffer_barriers.find(execution_id) == buffer_barriers.end())
+		{
+			buffer_barriers.insert({ execution_id, {} });
+		}
+
+		buffer_barriers[execution_id].push_back(make_vulkan_buffer_barrier(buffer, buffer->get_access_flags(), destination_access));
+
+		buffer->set_access_flags(destination_access);
+	}
+
+	void VulkanBarrierBatcher::add_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout)
+	{
+		if (image_barriers.find(execution_id) == image_barriers.end())
+		{
+			image_barriers.insert({ execution_id, {} });
+		}
+
+		image_barriers[execution_id].push_back(make_vulkan_image_barrier(image, image->get_access_flags(), destination_access, final_layout));
+
+		image->set_access_flags(destination_access);
+		image->set_layout(final_layout);
+	}
+
+	void VulkanBarrierBatcher::add_buffer_ownership_transfer(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+	{
+		if (src_queue_family == dst_queue_family)
+		{
+			return;
+		}
+
+		if (buffer_barriers.find(execution_id) == buffer_barriers.end())
+		{
+			buffer_barriers.insert({ execution_id, {} });
+		}
+
+		// The release makes the source queue's writes available and the acquire makes them visible, so each half only carries its own access mask
+		VkBufferMemoryBarrier buffer_barrier = make_vulkan_buffer_barrier(buffer, b_acquire ? AccessFlags::None : buffer->get_access_flags(), b_acquire ? destination_access : AccessFlags::None);
+		buffer_barrier.srcQueueFamilyIndex = src_queue_family;
+		buffer_barrier.dstQueueFamilyIndex = dst_queue_family;
+
+		buffer_barriers[execution_id].push_back(buffer_barrier);
+
+		if (b_acquire)
+		{
+			buffer->set_access_flags(destination_access);
+		}
+	}
+
+	void VulkanBarrierBatcher::add_image_ownership_transfer(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+	{
+		if (src_queue_family == dst_queue_family)
+		{
+			return;
+		}
+
+		if (image_barriers.find(execution_id) == image_barriers.end())
+		{
+			image_barriers.insert({ execution_id, {} });
+		}
+
+		// Both halves have to describe the same layout transition, which is only performed once. The image's tracked layout is
+		// still the old one when the acquire is recorded because the release does not update it.
+		VkImageMemoryBarrier image_barrier = make_vulkan_image_barrier(image, b_acquire ? AccessFlags::None : image->get_access_flags(), b_acquire ? destination_access : AccessFlags::None, final_layout);
+		image_barrier.srcQueueFamilyIndex = src_queue_family;
+		image_barrier.dstQueueFamilyIndex = dst_queue_family;
 
 		image_barriers[execution_id].push_back(image_barrier);
 
+		if (b_acquire)
+		{
+			image->set_access_flags(destination_access);
+			image->set_layout(final_layout);
+		}
+	}
+
+	void VulkanBarrierBatcher::add_split_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t split)
+	{
+		VulkanSplitBarriers& barriers = split_barriers[execution_id];
+		if (std::find(barriers.splits.begin(), barriers.splits.end(), split) == barriers.splits.end())
+		{
+			barriers.splits.push_back(split);
+		}
+		barriers.buffer_barriers.push_back(make_vulkan_buffer_barrier(buffer, buffer->get_access_flags(), destination_access));
+
+		buffer->set_access_flags(destination_access);
+	}
+
+	void VulkanBarrierBatcher::add_split_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t split)
+	{
+		VulkanSplitBarriers& barriers = split_barriers[execution_id];
+		if (std::find(barriers.splits.begin(), barriers.splits.end(), split) == barriers.splits.end())
+		{
+			barriers.splits.push_back(split);
+		}
+		barriers.image_barriers.push_back(make_vulkan_image_barrier(image, image->get_access_flags(), destination_access, final_layout));
+
 		image->set_access_flags(destination_access);
 		image->set_layout(final_layout);
 	}
 
+	void VulkanBarrierBatcher::signal_split_barrier(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, uint32_t split)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+
+		while (split_events.size() <= split)
+		{
+			VkEventCreateInfo event_create_info = {};
+			event_create_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+			event_create_info.pNext = nullptr;
+			event_create_info.flags = 0;
+
+			VK_CHECK(vkCreateEvent(context_state->get_device(), &event_create_info, nullptr, &split_events.emplace_back()));
+			split_signal_stages.push_back(PipelineStageType::AllCommands);
+		}
+
+		// Batchers are per buffered frame, so the frame fence has already retired the last wait on this event. It still has to be
+		// unsignalled though, since a split is not waited on when its barriers turn out to be unnecessary.
+		VkCommandBuffer cmd = static_cast<VkCommandBuffer>(command_buffer);
+		vkCmdResetEvent(cmd, split_events[split], VK_FROM_SUNSET_PIPELINE_STAGE_TYPE(stage));
+		vkCmdSetEvent(cmd, split_events[split], VK_FROM_SUNSET_PIPELINE_STAGE_TYPE(stage));
+		split_signal_stages[split] = stage;
+	}
+
+	void VulkanBarrierBatcher::execute_split_barriers(void* command_buffer, PipelineStageType stage, VulkanSplitBarriers& barriers)
+	{
+		if (barriers.buffer_barriers.empty() && barriers.image_barriers.empty())
+		{
+			barriers.splits.clear();
+			return;
+		}
+
+		std::vector<VkEvent> events;
+		VkPipelineStageFlags src_stages = 0;
+		for (uint32_t split : barriers.splits)
+		{
+			assert(split < split_events.size() && "Split barriers have to be signalled before they are executed");
+			events.push_back(split_events[split]);
+			src_stages |= VK_FROM_SUNSET_PIPELINE_STAGE_TYPE(split_signal_stages[split]);
+		}
+
+		vkCmdWaitEvents(
+			static_cast<VkCommandBuffer>(command_buffer),
+			static_cast<uint32_t>(events.size()),
+			events.data(),
+			src_stages,
+			VK_FROM_SUNSET_PIPELINE_STAGE_TYPE(stage),
+			0, nullptr,
+			static_cast<uint32_t>(barriers.buffer_barriers.size()),
+			barriers.buffer_barriers.data(),
+			static_cast<uint32_t>(barriers.image_barriers.size()),
+			barriers.image_barriers.data()
+		);
+
+		barriers.splits.clear();
+		barriers.buffer_barriers.clear();
+		barriers.image_barriers.clear();
+	}
+
 	void VulkanBarrierBatcher::execute(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, Identity execution_id)
 	{
 		if (execution_id.computed_hash != 0)
@@ -89,6 +235,8 @@ namespace Sunset
 
 			b_barriers.clear();
 			i_barriers.clear();
+
+			execute_split_barriers(command_buffer, stage, split_barriers[execution_id]);
 		}
 		else
 		{
@@ -121,6 +269,11 @@ namespace Sunset
 
 				current_stage = stage;
 			}
+
+			for (auto& [id, barriers] : split_barriers)
+			{
+				execute_split_barriers(command_buffer, stage, barriers);
+			}
 		}
 	}
 
@@ -128,4 +281,16 @@ namespace Sunset
 	{
 		current_stage = PipelineStageType::TopOfPipe;
 	}
+
+	void VulkanBarrierBatcher::destroy(class GraphicsContext* const gfx_context)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+
+		for (VkEvent event : split_events)
+		{
+			vkDestroyEvent(context_state->get_device(), event, nullptr);
+		}
+		split_events.clear();
+		split_signal_stages.clear();
+	}
 }
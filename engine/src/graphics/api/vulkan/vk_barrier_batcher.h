@@ -5,6 +5,13 @@
 
 namespace Sunset
 {
+	struct VulkanSplitBarriers
+	{
+		std::vector<uint32_t> splits;
+		std::vector<VkBufferMemoryBarrier> buffer_barriers;
+		std::vector<VkImageMemoryBarrier> image_barriers;
+	};
+
 	class VulkanBarrierBatcher
 	{
 	public:
@@ -13,12 +20,25 @@ namespace Sunset
 		void begin(class GraphicsContext* const gfx_context, PipelineStageType stage);
 		void add_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access);
 		void add_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout);
+		void add_buffer_ownership_transfer(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire);
+		void add_image_ownership_transfer(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire);
+		void add_split_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t split);
+		void add_split_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t split);
+		void signal_split_barrier(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, uint32_t split);
 		void execute(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, Identity execution_id = "");
 		void reset();
+		void destroy(class GraphicsContext* const gfx_context);
+
+	private:
+		void execute_split_barriers(void* command_buffer, PipelineStageType stage, VulkanSplitBarriers& barriers);
 
 	private:
 		PipelineStageType current_stage;
 		phmap::flat_hash_map<Identity, std::vector<VkBufferMemoryBarrier>> buffer_barriers;
 		phmap::flat_hash_map<Identity, std::vector<VkImageMemoryBarrier>> image_barriers;
+		phmap::flat_hash_map<Identity, VulkanSplitBarriers> split_barriers;
+		// Indexed by split, created the first time a split is signalled
+		std::vector<VkEvent> split_events;
+		std::vector<PipelineStageType> split_signal_stages;
 	};
 }
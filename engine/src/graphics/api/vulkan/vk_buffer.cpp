@@ -120,7 +120,7 @@ namespace Sunset
 		vmaUnmapMemory(allocator, allocation);
 	}
 
-	void VulkanBuffer::copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, Buffer* other, size_t buffer_size, size_t buffer_offset /*= 0*/)
+	void VulkanBuffer::copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, Buffer* other, size_t buffer_size, size_t buffer_offset /*= 0*/, size_t other_buffer_offset /*= 0*/)
 	{
 		VkBuffer other_buffer = static_cast<VkBuffer>(other->get());
 		VkCommandBuffer cmd = static_cast<VkCommandBuffer>(command_buffer);
@@ -128,8 +128,8 @@ namespace Sunset
 		BufferConfig& other_config = other->get_buffer_config();
 
 		VkBufferCopy copy;
-		copy.dstOffset = 0;
-		copy.srcOffset = 0;
+		copy.dstOffset = buffer_offset;
+		copy.srcOffset = other_buffer_offset;
 		copy.size = (other_config.type & BufferType::Indirect) != BufferType::None ? buffer_size * sizeof(VulkanGPUIndirectObject) : buffer_size;
 
 		vkCmdCopyBuffer(cmd, other_buffer, buffer, 1, &copy);
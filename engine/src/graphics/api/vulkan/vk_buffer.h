@@ -33,7 +33,7 @@ namespace Sunset
 		void reallocate(class GraphicsContext* const gfx_context, const BufferConfig& config);
 		void destroy(class GraphicsContext* const gfx_context);
 		void copy_from(class GraphicsContext* const gfx_context, void* data, size_t buffer_size, size_t buffer_offset = 0, std::function<void(void*)> memcpy_op = {});
-		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0);
+		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0, size_t other_buffer_offset = 0);
 		char* map_gpu(class GraphicsContext* const gfx_context);
 		void unmap_gpu(class GraphicsContext* const gfx_context);
 		void bind(class GraphicsContext* const gfx_context, BufferType type, void* command_buffer);
@@ -1,5 +1,7 @@
 #include <graphics/api/vulkan/vk_command_queue.h>
 #include <graphics/graphics_context.h>
+#include <graphics/render_pass.h>
+#include <graphics/resource/framebuffer.h>
 
 #include <VkBootstrap.h>
 
@@ -45,6 +47,14 @@ namespace Sunset
 		{
 			new_command_pool(gfx_context_state, &data.frame_command_pool_data[frame_number].command_pool, frame_number);
 			new_command_buffers(gfx_context_state, &data.frame_command_pool_data[frame_number].command_buffer, data.frame_command_pool_data[frame_number].command_pool, 1, frame_number);
+			new_command_buffers(gfx_context_state, data.frame_command_pool_data[frame_number].submission_command_buffers, data.frame_command_pool_data[frame_number].command_pool, MAX_QUEUE_SUBMISSIONS_PER_FRAME, frame_number);
+
+			for (uint32_t slot = 0; slot < MAX_PARALLEL_RECORD_SLOTS_PER_FRAME; ++slot)
+			{
+				VkCommandPool& secondary_command_pool = data.frame_command_pool_data[frame_number].secondary_command_pools[slot];
+				new_command_pool(gfx_context_state, &secondary_command_pool, frame_number);
+				new_command_buffers(gfx_context_state, &data.frame_command_pool_data[frame_number].secondary_command_buffers[slot], secondary_command_pool, 1, frame_number, true);
+			}
 
 			new_command_pool(gfx_context_state, &data.immediate_command_data[frame_number].command_pool);
 			new_command_buffers(gfx_context_state, &data.immediate_command_data[frame_number].command_buffer, data.immediate_command_data[frame_number].command_pool);
@@ -54,6 +64,14 @@ namespace Sunset
 			VkFence render_fence = context_state->sync_pool.get_fence(data.immediate_command_data[frame_number].fence);
 			vkResetFences(context_state->get_device(), 1, &render_fence);
 		}
+
+		for (uint32_t batch_slot = 0; batch_slot < MAX_UPLOAD_BATCHES_IN_FLIGHT; ++batch_slot)
+		{
+			new_command_pool(gfx_context_state, &data.upload_command_data[batch_slot].command_pool);
+			new_command_buffers(gfx_context_state, &data.upload_command_data[batch_slot].command_buffer, data.upload_command_data[batch_slot].command_pool);
+
+			data.upload_command_data[batch_slot].fence = context_state->sync_pool.new_fence(context_state);
+		}
 	}
 
 	void VulkanCommandQueue::destroy(void* gfx_context_state)
@@ -68,6 +86,19 @@ namespace Sunset
 			vkDestroyFence(context_state->get_device(), render_fence, nullptr);
 
 			vkDestroyCommandPool(context_state->get_device(), data.frame_command_pool_data[frame_number].command_pool, nullptr);
+
+			for (uint32_t slot = 0; slot < MAX_PARALLEL_RECORD_SLOTS_PER_FRAME; ++slot)
+			{
+				vkDestroyCommandPool(context_state->get_device(), data.frame_command_pool_data[frame_number].secondary_command_pools[slot], nullptr);
+			}
+		}
+
+		for (uint32_t batch_slot = 0; batch_slot < MAX_UPLOAD_BATCHES_IN_FLIGHT; ++batch_slot)
+		{
+			vkDestroyCommandPool(context_state->get_device(), data.upload_command_data[batch_slot].command_pool, nullptr);
+
+			VkFence upload_fence = context_state->sync_pool.get_fence(data.upload_command_data[batch_slot].fence);
+			vkDestroyFence(context_state->get_device(), upload_fence, nullptr);
 		}
 	}
 
@@ -85,7 +116,7 @@ namespace Sunset
 		VK_CHECK(vkCreateCommandPool(context_state->get_device(), &command_pool_info, nullptr, static_cast<VkCommandPool*>(command_pool_ptr)));
 	}
 
-	void VulkanCommandQueue::new_command_buffers(void* gfx_context_state, void* command_buffer_ptr, void* command_pool_ptr, uint16_t count, uint16_t buffered_frame_number)
+	void VulkanCommandQueue::new_command_buffers(void* gfx_context_state, void* command_buffer_ptr, void* command_pool_ptr, uint16_t count, uint16_t buffered_frame_number, bool b_secondary)
 	{
 		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context_state);
 		VkCommandPool command_pool = static_cast<VkCommandPool>(command_pool_ptr);
@@ -96,7 +127,7 @@ namespace Sunset
 
 		cmd_allocate_info.commandPool = command_pool;
 		cmd_allocate_info.commandBufferCount = count;
-		cmd_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cmd_allocate_info.level = b_secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
 		VK_CHECK(vkAllocateCommandBuffers(context_state->get_device(), &cmd_allocate_info, static_cast<VkCommandBuffer*>(command_buffer_ptr)));
 	}
@@ -192,4 +223,188 @@ namespace Sunset
 
 		vkResetCommandPool(context_state->get_device(), data.immediate_command_data[buffered_frame_number].command_pool, 0);
 	}
-}
+
+	void* VulkanCommandQueue::begin_submission_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t submission_slot)
+	{
+		assert(submission_slot < MAX_QUEUE_SUBMISSIONS_PER_FRAME);
+		VkCommandBuffer& command_buffer = data.frame_command_pool_data[buffered_frame_number].submission_command_buffers[submission_slot];
+
+		VK_CHECK(vkResetCommandBuffer(command_buffer, 0));
+
+		VkCommandBufferBeginInfo cmd_begin_info = {};
+		cmd_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmd_begin_info.pNext = nullptr;
+		cmd_begin_info.pInheritanceInfo = nullptr;
+		cmd_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		VK_CHECK(vkBeginCommandBuffer(command_buffer, &cmd_begin_info));
+
+		return command_buffer;
+	}
+
+	void VulkanCommandQueue::end_submission_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t submission_slot)
+	{
+		assert(submission_slot < MAX_QUEUE_SUBMISSIONS_PER_FRAME);
+		VK_CHECK(vkEndCommandBuffer(data.frame_command_pool_data[buffered_frame_number].submission_command_buffers[submission_slot]));
+	}
+
+	void VulkanCommandQueue::submit_frame_submission(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, std::optional<uint32_t> submission_slot, const QueueSubmitSync& sync)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+		VulkanFrameSyncPrimitives& frame_sync = context_state->frame_sync_primitives[buffered_frame_number];
+
+		std::array<VkSemaphore, MAX_CROSS_QUEUE_SEMAPHORES + 1> wait_semaphores;
+		std::array<VkPipelineStageFlags, MAX_CROSS_QUEUE_SEMAPHORES + 1> wait_stages;
+		std::array<VkSemaphore, MAX_CROSS_QUEUE_SEMAPHORES + 1> signal_semaphores;
+		uint32_t wait_count{ 0 };
+		uint32_t signal_count{ 0 };
+
+		if (sync.b_wait_for_present)
+		{
+			wait_semaphores[wait_count] = context_state->sync_pool.get_semaphore(frame_sync.present_semaphore);
+			wait_stages[wait_count++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		}
+		// Cross queue waits guard resources handed over by the other queue, which any stage of this submission might touch
+		for (uint32_t semaphore : sync.wait_semaphores)
+		{
+			assert(semaphore < MAX_CROSS_QUEUE_SEMAPHORES);
+			wait_semaphores[wait_count] = context_state->sync_pool.get_semaphore(frame_sync.queue_semaphores[semaphore]);
+			wait_stages[wait_count++] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		}
+		for (uint32_t semaphore : sync.signal_semaphores)
+		{
+			assert(semaphore < MAX_CROSS_QUEUE_SEMAPHORES);
+			signal_semaphores[signal_count++] = context_state->sync_pool.get_semaphore(frame_sync.queue_semaphores[semaphore]);
+		}
+
+		VkFence fence = VK_NULL_HANDLE;
+		if (sync.b_signal_frame_complete)
+		{
+			signal_semaphores[signal_count++] = context_state->sync_pool.get_semaphore(frame_sync.render_semaphore);
+			fence = context_state->sync_pool.get_fence(frame_sync.render_fence);
+			context_state->has_pending_work[buffered_frame_number].store(true, std::memory_order_release);
+		}
+
+		VkSubmitInfo submit_info = {};
+		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext = nullptr;
+
+		submit_info.pWaitDstStageMask = wait_count > 0 ? wait_stages.data() : nullptr;
+		submit_info.waitSemaphoreCount = wait_count;
+		submit_info.pWaitSemaphores = wait_count > 0 ? wait_semaphores.data() : nullptr;
+		submit_info.signalSemaphoreCount = signal_count;
+		submit_info.pSignalSemaphores = signal_count > 0 ? signal_semaphores.data() : nullptr;
+		submit_info.commandBufferCount = submission_slot.has_value() ? 1 : 0;
+		submit_info.pCommandBuffers = submission_slot.has_value() ? &data.frame_command_pool_data[buffered_frame_number].submission_command_buffers[submission_slot.value()] : nullptr;
+
+		VK_CHECK(vkQueueSubmit(data.graphics_queue, 1, &submit_info, fence));
+	}
+
+	void* VulkanCommandQueue::begin_secondary_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t slot, class RenderPass* render_pass, uint32_t framebuffer_index)
+	{
+		assert(slot < MAX_PARALLEL_RECORD_SLOTS_PER_FRAME);
+		VkCommandBuffer& command_buffer = data.frame_command_pool_data[buffered_frame_number].secondary_command_buffers[slot];
+
+		VK_CHECK(vkResetCommandBuffer(command_buffer, 0));
+
+		VkCommandBufferInheritanceInfo inheritance_info = {};
+		inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance_info.pNext = nullptr;
+		inheritance_info.subpass = 0;
+
+		VkCommandBufferBeginInfo cmd_begin_info = {};
+		cmd_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmd_begin_info.pNext = nullptr;
+		cmd_begin_info.pInheritanceInfo = &inheritance_info;
+		cmd_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		if (render_pass != nullptr)
+		{
+			VulkanRenderPassData* const render_pass_data = static_cast<VulkanRenderPassData*>(render_pass->get_data());
+			inheritance_info.renderPass = render_pass_data->render_pass;
+			inheritance_info.framebuffer = static_cast<VkFramebuffer>(CACHE_FETCH(Framebuffer, render_pass_data->output_framebuffers[framebuffer_index])->get_framebuffer_handle());
+			cmd_begin_info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		}
+
+		VK_CHECK(vkBeginCommandBuffer(command_buffer, &cmd_begin_info));
+
+		return command_buffer;
+	}
+
+	void VulkanCommandQueue::end_secondary_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t slot)
+	{
+		assert(slot < MAX_PARALLEL_RECORD_SLOTS_PER_FRAME);
+		VK_CHECK(vkEndCommandBuffer(data.frame_command_pool_data[buffered_frame_number].secondary_command_buffers[slot]));
+	}
+
+	void VulkanCommandQueue::execute_secondary_records(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, void* command_buffer, uint32_t first_slot, uint32_t slot_count)
+	{
+		assert(first_slot + slot_count <= MAX_PARALLEL_RECORD_SLOTS_PER_FRAME);
+		vkCmdExecuteCommands(static_cast<VkCommandBuffer>(command_buffer), slot_count, &data.frame_command_pool_data[buffered_frame_number].secondary_command_buffers[first_slot]);
+	}
+
+	void* VulkanCommandQueue::begin_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+		VulkanImmediateCommandData& upload_data = data.upload_command_data[batch_slot];
+
+		// The caller has already waited on whatever batch last used this slot
+		VkFence upload_fence = context_state->sync_pool.get_fence(upload_data.fence);
+		VK_CHECK(vkResetFences(context_state->get_device(), 1, &upload_fence));
+		VK_CHECK(vkResetCommandPool(context_state->get_device(), upload_data.command_pool, 0));
+
+		VkCommandBufferBeginInfo cmd_begin_info = {};
+		cmd_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmd_begin_info.pNext = nullptr;
+		cmd_begin_info.pInheritanceInfo = nullptr;
+		cmd_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		VK_CHECK(vkBeginCommandBuffer(upload_data.command_buffer, &cmd_begin_info));
+
+		return upload_data.command_buffer;
+	}
+
+	void VulkanCommandQueue::submit_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+		VulkanImmediateCommandData& upload_data = data.upload_command_data[batch_slot];
+
+		// Work submitted to this queue after the batch is ordered behind this barrier, so frames can read
+		// uploaded data without waiting on the batch fence
+		VkMemoryBarrier memory_barrier = {};
+		memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memory_barrier.pNext = nullptr;
+		memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memory_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+		vkCmdPipelineBarrier(upload_data.command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+
+		VK_CHECK(vkEndCommandBuffer(upload_data.command_buffer));
+
+		VkSubmitInfo submit_info = {};
+		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext = nullptr;
+
+		submit_info.pWaitDstStageMask = nullptr;
+		submit_info.waitSemaphoreCount = 0;
+		submit_info.pWaitSemaphores = nullptr;
+		submit_info.signalSemaphoreCount = 0;
+		submit_info.pSignalSemaphores = nullptr;
+		submit_info.commandBufferCount = 1;
+		submit_info.pCommandBuffers = &upload_data.command_buffer;
+
+		VK_CHECK(vkQueueSubmit(data.graphics_queue, 1, &submit_info, context_state->sync_pool.get_fence(upload_data.fence)));
+	}
+
+	bool VulkanCommandQueue::is_upload_batch_complete(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+		return vkGetFenceStatus(context_state->get_device(), context_state->sync_pool.get_fence(data.upload_command_data[batch_slot].fence)) == VK_SUCCESS;
+	}
+
+	void VulkanCommandQueue::wait_for_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+		VK_CHECK(vkWaitForFences(context_state->get_device(), 1, &context_state->sync_pool.get_fence(data.upload_command_data[batch_slot].fence), true, 1e+10));
+	}
+}
\ No newline at end of file
@@ -11,6 +11,11 @@ namespace Sunset
 	{
 		VkCommandPool command_pool;
 		VkCommandBuffer command_buffer;
+		// Used instead of command_buffer when the render graph splits the frame into several queue submissions
+		VkCommandBuffer submission_command_buffers[MAX_QUEUE_SUBMISSIONS_PER_FRAME];
+		// Command pools are externally synchronized, so each secondary command buffer gets its own pool to be recorded from any thread
+		VkCommandPool secondary_command_pools[MAX_PARALLEL_RECORD_SLOTS_PER_FRAME];
+		VkCommandBuffer secondary_command_buffers[MAX_PARALLEL_RECORD_SLOTS_PER_FRAME];
 	};
 
 	struct VulkanImmediateCommandData
@@ -26,6 +31,7 @@ namespace Sunset
 		VkQueue graphics_queue;
 		VulkanFrameCommandPoolData frame_command_pool_data[MAX_BUFFERED_FRAMES];
 		VulkanImmediateCommandData immediate_command_data[MAX_BUFFERED_FRAMES];
+		VulkanImmediateCommandData upload_command_data[MAX_UPLOAD_BATCHES_IN_FLIGHT];
 	};
 
 	class VulkanCommandQueue
@@ -43,12 +49,27 @@ namespace Sunset
 			return &data;
 		}
 
+		uint32_t get_queue_family() const
+		{
+			return data.graphics_queue_family;
+		}
+
 		void new_command_pool(void* gfx_context_state, void* command_pool_ptr, uint16_t buffered_frame_number = 0);
-		void new_command_buffers(void* gfx_context_state, void* command_buffer_ptr, void* command_pool_ptr, uint16_t count = 1, uint16_t buffered_frame_number = 0);
+		void new_command_buffers(void* gfx_context_state, void* command_buffer_ptr, void* command_pool_ptr, uint16_t count = 1, uint16_t buffered_frame_number = 0, bool b_secondary = false);
 		void* begin_one_time_buffer_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number);
 		void end_one_time_buffer_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number);
 		void submit(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, bool b_offline = false);
 		void submit_immediate(class GraphicsContext* const gfx_context, int32_t buffered_frame_number, const std::function<void(void* cmd_buffer)>& buffer_update_fn);
+		void* begin_submission_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t submission_slot);
+		void end_submission_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t submission_slot);
+		void submit_frame_submission(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, std::optional<uint32_t> submission_slot, const QueueSubmitSync& sync);
+		void* begin_secondary_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t slot, class RenderPass* render_pass, uint32_t framebuffer_index);
+		void end_secondary_record(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, uint32_t slot);
+		void execute_secondary_records(class GraphicsContext* const gfx_context, uint32_t buffered_frame_number, void* command_buffer, uint32_t first_slot, uint32_t slot_count);
+		void* begin_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot);
+		void submit_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot);
+		bool is_upload_batch_complete(class GraphicsContext* const gfx_context, uint32_t batch_slot);
+		void wait_for_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot);
 
 	protected:
 		VulkanCommandQueueData data;
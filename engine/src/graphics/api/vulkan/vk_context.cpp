@@ -4,14 +4,20 @@
 #include <graphics/pipeline_state.h>
 #include <graphics/resource/image.h>
 #include <graphics/descriptor.h>
+#include <graphics/pipeline_cache.h>
 #include <core/common.h>
 #include <window/window.h>
+#include <utility/cvar.h>
 
 #include <SDL_vulkan.h>
 #include <spirv_reflect.h>
 
+#include <cstring>
+
 namespace Sunset
 {
+	AutoCVar_String cvar_pipeline_cache_path("ren.pipeline_cache_path", "File the Vulkan pipeline cache is loaded from on startup and saved to on shutdown. Leave empty to not persist the cache.", "pipeline_cache.bin");
+
 	void VulkanContext::initialize(const glm::vec2 resolution)
 	{
 		state.surface_resolution = resolution;
@@ -92,6 +98,10 @@ namespace Sunset
 			state.frame_sync_primitives[frame_number].render_semaphore = state.sync_pool.new_semaphore(&state);
 			state.frame_sync_primitives[frame_number].present_semaphore = state.sync_pool.new_semaphore(&state);
 			state.frame_sync_primitives[frame_number].render_fence = state.sync_pool.new_fence(&state);
+			for (uint32_t i = 0; i < MAX_CROSS_QUEUE_SEMAPHORES; ++i)
+			{
+				state.frame_sync_primitives[frame_number].queue_semaphores[i] = state.sync_pool.new_semaphore(&state);
+			}
 			state.has_pending_work[frame_number] = false;
 
 			vkResetFences(state.get_device(), 1, &state.sync_pool.get_fence(state.frame_sync_primitives[frame_number].render_fence));
@@ -101,17 +111,28 @@ namespace Sunset
 		{
 			state.queues[queue_num] = nullptr;
 		}
+
+		create_pipeline_cache();
 	}
 
 	void VulkanContext::destroy(ExecutionQueue& deletion_queue)
 	{
+		// Pipeline states wait on their pending builds when they are destroyed, so the cache has every pipeline in it once the queue is flushed
 		deletion_queue.flush();
 
+		save_pipeline_cache();
+		vkDestroyPipelineCache(state.get_device(), state.pipeline_cache, nullptr);
+
 		state.descriptor_set_allocator->destroy(state.get_device());
 		state.buffer_allocator->destroy();
 
 		for (int16_t frame_number = MAX_BUFFERED_FRAMES - 1; frame_number >= 0; --frame_number)
 		{
+			// Pool handles are indices that shift on release, so semaphores are released in reverse creation order
+			for (int32_t i = MAX_CROSS_QUEUE_SEMAPHORES - 1; i >= 0; --i)
+			{
+				state.sync_pool.release_semaphore(&state, state.frame_sync_primitives[frame_number].queue_semaphores[i]);
+			}
 			state.sync_pool.release_fence(&state, state.frame_sync_primitives[frame_number].render_fence);
 			state.sync_pool.release_semaphore(&state, state.frame_sync_primitives[frame_number].present_semaphore);
 			state.sync_pool.release_semaphore(&state, state.frame_sync_primitives[frame_number].render_semaphore);
@@ -129,6 +150,51 @@ namespace Sunset
 		}
 	}
 
+	void VulkanContext::create_pipeline_cache()
+	{
+		VkPhysicalDeviceProperties device_properties;
+		vkGetPhysicalDeviceProperties(state.get_gpu(), &device_properties);
+
+		PipelineCacheDeviceInfo device_info{ .vendor_id = device_properties.vendorID, .device_id = device_properties.deviceID };
+		std::memcpy(device_info.cache_uuid, device_properties.pipelineCacheUUID, PIPELINE_CACHE_UUID_SIZE);
+
+		std::vector<char> cache_data;
+		const std::string cache_path = cvar_pipeline_cache_path.get();
+		if (!cache_path.empty() && !load_pipeline_cache_data(cache_path, device_info, cache_data))
+		{
+			std::cout << "Vulkan pipeline cache: No pipeline cache for this device at " << cache_path << ", starting with an empty cache" << std::endl;
+		}
+
+		VkPipelineCacheCreateInfo create_info = {};
+		create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		create_info.pNext = nullptr;
+		create_info.initialDataSize = cache_data.size();
+		create_info.pInitialData = cache_data.empty() ? nullptr : cache_data.data();
+
+		VK_CHECK(vkCreatePipelineCache(state.get_device(), &create_info, nullptr, &state.pipeline_cache));
+	}
+
+	void VulkanContext::save_pipeline_cache()
+	{
+		const std::string cache_path = cvar_pipeline_cache_path.get();
+		if (cache_path.empty() || state.pipeline_cache == VK_NULL_HANDLE)
+		{
+			return;
+		}
+
+		size_t cache_size{ 0 };
+		VK_CHECK(vkGetPipelineCacheData(state.get_device(), state.pipeline_cache, &cache_size, nullptr));
+
+		std::vector<char> cache_data(cache_size);
+		VK_CHECK(vkGetPipelineCacheData(state.get_device(), state.pipeline_cache, &cache_size, cache_data.data()));
+		cache_data.resize(cache_size);
+
+		if (!save_pipeline_cache_data(cache_path, cache_data))
+		{
+			std::cout << "Vulkan pipeline cache: Failed to save pipeline cache to " << cache_path << std::endl;
+		}
+	}
+
 	void VulkanContext::wait_for_gpu()
 	{
 		const int16_t current_buffered_frame = get_buffered_frame_number();
@@ -145,9 +211,9 @@ namespace Sunset
 		vkCmdDraw(static_cast<VkCommandBuffer>(buffer), vertex_count, instance_count, 0, instance_index);
 	}
 
-	void VulkanContext::draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index /*= 0*/)
+	void VulkanContext::draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index /*= 0*/, uint32_t first_index /*= 0*/, int32_t vertex_offset /*= 0*/)
 	{
-		vkCmdDrawIndexed(static_cast<VkCommandBuffer>(buffer), index_count, instance_count, 0, 0, instance_index);
+		vkCmdDrawIndexed(static_cast<VkCommandBuffer>(buffer), index_count, instance_count, first_index, vertex_offset, instance_index);
 	}
 
 	void VulkanContext::draw_indexed_indirect(void* buffer, class Buffer* indirect_buffer, uint32_t draw_count, uint32_t draw_first /*= 0*/)
@@ -164,6 +230,12 @@ namespace Sunset
 
 	void VulkanContext::register_command_queue(DeviceQueueType queue_type)
 	{
+		// Devices without a dedicated compute family leave the compute queue unregistered, and compute work stays on the graphics queue
+		if (queue_type == DeviceQueueType::Compute && !state.device.get_queue_index(vkb::QueueType::compute).has_value())
+		{
+			return;
+		}
+
 		const int16_t queue_type_idx = static_cast<int16_t>(queue_type);
 		if (state.queues[queue_type_idx] == nullptr)
 		{
@@ -264,14 +336,14 @@ namespace Sunset
 		return state.device.physical_device.properties.limits.minUniformBufferOffsetAlignment;
 	}
 
-	void VulkanContext::update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance)
+	void VulkanContext::update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, int32_t vertex_offset, uint32_t instance_count, uint32_t first_instance)
 	{
 		VulkanGPUIndirectObject* vk_commands = static_cast<VulkanGPUIndirectObject*>(commands);
 		vk_commands[command_index].indirect_command.indexCount = index_count;
 		vk_commands[command_index].indirect_command.firstIndex = first_index;
 		vk_commands[command_index].indirect_command.instanceCount = instance_count;
 		vk_commands[command_index].indirect_command.firstInstance = first_instance;
-		vk_commands[command_index].indirect_command.vertexOffset = 0;
+		vk_commands[command_index].indirect_command.vertexOffset = vertex_offset;
 	}
 
 	Sunset::ShaderLayoutID VulkanContext::derive_layout_for_shader_stages(class GraphicsContext* const gfx_context, const std::vector<PipelineShaderStage>& stages, std::vector<DescriptorLayoutID>& out_descriptor_layouts)
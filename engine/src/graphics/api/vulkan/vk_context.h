@@ -19,6 +19,8 @@ namespace Sunset
 		VulkanSemaphoreHandle present_semaphore{ -1 };
 		VulkanSemaphoreHandle render_semaphore{ -1 };
 		VulkanFenceHandle render_fence{ -1 };
+		// Orders the frame's submissions across queues when the render graph splits work between them
+		VulkanSemaphoreHandle queue_semaphores[MAX_CROSS_QUEUE_SEMAPHORES];
 	};
 
 	struct VulkanContextState
@@ -36,6 +38,8 @@ namespace Sunset
 			class CommandQueue* queues[static_cast<int16_t>(DeviceQueueType::Num)];
 			class BufferAllocator* buffer_allocator{ nullptr };
 			class DescriptorSetAllocator* descriptor_set_allocator{ nullptr };
+			// Shared by every pipeline creation, including ones running on job threads. Persisted to disk between runs.
+			VkPipelineCache pipeline_cache{ VK_NULL_HANDLE };
 			StaticFrameAllocator<VkDescriptorBufferInfo, 16 * MAX_DESCRIPTOR_BINDINGS> vk_descriptor_buffer_infos_buffer;
 			StaticFrameAllocator<VkDescriptorImageInfo, 16 * MAX_DESCRIPTOR_BINDINGS> vk_descriptor_image_infos_buffer;
 			glm::ivec2 surface_resolution;
@@ -72,7 +76,7 @@ namespace Sunset
 			void destroy(ExecutionQueue& deletion_queue);
 			void wait_for_gpu();
 			void draw(void* buffer, uint32_t vertex_count, uint32_t instance_count, uint32_t instance_index = 0);
-			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0);
+			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0, uint32_t first_index = 0, int32_t vertex_offset = 0);
 			void draw_indexed_indirect(void* buffer, class Buffer* indirect_buffer, uint32_t draw_count, uint32_t draw_first = 0);
 			void dispatch_compute(void* buffer, uint32_t count_x, uint32_t count_y, uint32_t count_z);
 
@@ -133,9 +137,13 @@ namespace Sunset
 			void push_constants(void* buffer, PipelineStateID pipeline_state, const PushConstantPipelineData& push_constant_data);
 			void push_descriptor_writes(const std::vector<DescriptorWrite>& descriptor_writes);
 			size_t get_min_ubo_offset_alignment();
-			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance);
+			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, int32_t vertex_offset, uint32_t instance_count, uint32_t first_instance);
 			ShaderLayoutID derive_layout_for_shader_stages(class GraphicsContext* const gfx_context, const std::vector<PipelineShaderStage>& stages, std::vector<DescriptorLayoutID>& out_descriptor_layouts);
 
+		protected:
+			void create_pipeline_cache();
+			void save_pipeline_cache();
+
 		public:
 			VulkanContextState state;
 	};
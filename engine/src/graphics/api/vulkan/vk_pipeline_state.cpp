@@ -18,23 +18,52 @@ namespace Sunset
 		vkDestroyPipeline(context_state->get_device(), pipeline, nullptr);
 	}
 
-	void VulkanPipelineState::build(class GraphicsContext* const gfx_context, PipelineStateData* state_data, class RenderPass* render_pass)
+	void VulkanPipelineState::prepare_build(class GraphicsContext* const gfx_context, PipelineStateData* state_data, class RenderPass* render_pass)
 	{
-		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
 		VulkanRenderPassData* render_pass_data = static_cast<VulkanRenderPassData*>(render_pass->get_data());
-		VkPipelineLayout pipeline_layout = static_cast<VkPipelineLayout>(CACHE_FETCH(ShaderPipelineLayout, state_data->layout)->get_data());
 
-		std::vector<VkViewport> viewports(VK_FROM_SUNSET_VIEWPORT_LIST(state_data->viewports));
-		std::vector<VkRect2D> scissors(VK_FROM_SUNSET_SCISSORS_LIST(state_data->scissors));
+		build_inputs.pipeline_layout = static_cast<VkPipelineLayout>(CACHE_FETCH(ShaderPipelineLayout, state_data->layout)->get_data());
+		build_inputs.render_pass = render_pass_data->render_pass;
+		build_inputs.num_color_attachments = render_pass->get_num_color_attachments();
 
-		VkPipelineViewportStateCreateInfo viewport_state = new_viewport_state_create_info(viewports, scissors);
-
-		std::vector<VkPipelineShaderStageCreateInfo> shader_stages;
+		build_inputs.shader_stages.clear();
 		for (PipelineShaderStage& shader_stage : state_data->shader_stages)
 		{
 			VulkanShaderData* shader_data = static_cast<VulkanShaderData*>(CACHE_FETCH(Shader, shader_stage.shader_module)->get_data());
-			shader_stages.push_back(new_shader_stage_create_info(VK_FROM_SUNSET_SHADER_STAGE_TYPE(shader_stage.stage_type), shader_data->shader_module));
+			build_inputs.shader_stages.push_back(new_shader_stage_create_info(VK_FROM_SUNSET_SHADER_STAGE_TYPE(shader_stage.stage_type), shader_data->shader_module));
+		}
+	}
+
+	void VulkanPipelineState::prepare_build_compute(class GraphicsContext* const gfx_context, PipelineStateData* state_data, void* render_pass_data)
+	{
+		build_inputs.pipeline_layout = static_cast<VkPipelineLayout>(CACHE_FETCH(ShaderPipelineLayout, state_data->layout)->get_data());
+		build_inputs.render_pass = VK_NULL_HANDLE;
+		build_inputs.num_color_attachments = 0;
+
+		build_inputs.shader_stages.clear();
+		if (!state_data->shader_stages.empty())
+		{
+			PipelineShaderStage& stage = state_data->shader_stages.back();
+			VulkanShaderData* shader_data = static_cast<VulkanShaderData*>(CACHE_FETCH(Shader, stage.shader_module)->get_data());
+			build_inputs.shader_stages.push_back(new_shader_stage_create_info(VK_FROM_SUNSET_SHADER_STAGE_TYPE(stage.stage_type), shader_data->shader_module));
 		}
+	}
+
+	bool VulkanPipelineState::create(class GraphicsContext* const gfx_context, PipelineStateData* state_data)
+	{
+		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
+
+		return state_data->type == PipelineStateType::Compute
+			? create_compute(context_state->get_device(), context_state->pipeline_cache, state_data)
+			: create_graphics(context_state->get_device(), context_state->pipeline_cache, state_data);
+	}
+
+	bool VulkanPipelineState::create_graphics(VkDevice device, VkPipelineCache pipeline_cache, PipelineStateData* state_data)
+	{
+		std::vector<VkViewport> viewports(VK_FROM_SUNSET_VIEWPORT_LIST(state_data->viewports));
+		std::vector<VkRect2D> scissors(VK_FROM_SUNSET_SCISSORS_LIST(state_data->scissors));
+
+		VkPipelineViewportStateCreateInfo viewport_state = new_viewport_state_create_info(viewports, scissors);
 
 		std::vector<VkVertexInputBindingDescription> vertex_bindings(VK_FROM_SUNSET_VERTEX_BINDING_DESCRIPTION(state_data->vertex_input_description.bindings));
 		std::vector<VkVertexInputAttributeDescription> vertex_attributes(VK_FROM_SUNSET_VERTEX_ATTRIBUTE_DESCRIPTION(state_data->vertex_input_description.attributes));
@@ -49,7 +78,7 @@ namespace Sunset
 
 		VkPipelineMultisampleStateCreateInfo multisample_state = new_multisample_state_create_info(VK_FROM_SUNSET_MULTISAMPLE_COUNT(state_data->multisample_count));
 
-		const uint32_t num_attachments = render_pass->get_num_color_attachments();
+		const uint32_t num_attachments = build_inputs.num_color_attachments;
 
 		std::vector<VkPipelineColorBlendAttachmentState> color_blend_attachment_states(num_attachments);
 		if (num_attachments > 0)
@@ -71,8 +100,8 @@ namespace Sunset
 		VkGraphicsPipelineCreateInfo pipeline_create_info = {};
 		pipeline_create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 		pipeline_create_info.pNext = nullptr;
-		pipeline_create_info.stageCount = static_cast<uint32_t>(shader_stages.size());
-		pipeline_create_info.pStages = shader_stages.data();
+		pipeline_create_info.stageCount = static_cast<uint32_t>(build_inputs.shader_stages.size());
+		pipeline_create_info.pStages = build_inputs.shader_stages.data();
 		pipeline_create_info.pVertexInputState = &vertex_input_state;
 		pipeline_create_info.pInputAssemblyState = &input_assembly_state;
 		pipeline_create_info.pViewportState = &viewport_state;
@@ -80,52 +109,49 @@ namespace Sunset
 		pipeline_create_info.pMultisampleState = &multisample_state;
 		pipeline_create_info.pColorBlendState = &color_blending_state;
 		pipeline_create_info.pDepthStencilState = &depth_stencil_state;
-		pipeline_create_info.layout = pipeline_layout;
-		pipeline_create_info.renderPass = render_pass_data->render_pass;
+		pipeline_create_info.layout = build_inputs.pipeline_layout;
+		pipeline_create_info.renderPass = build_inputs.render_pass;
 		pipeline_create_info.subpass = 0;
 		pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
 
 		VkPipeline new_pipeline;
-		if (vkCreateGraphicsPipelines(context_state->get_device(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &new_pipeline) != VK_SUCCESS)
+		if (vkCreateGraphicsPipelines(device, pipeline_cache, 1, &pipeline_create_info, nullptr, &new_pipeline) != VK_SUCCESS)
 		{
 			std::cout << "Vulkan pipeline error: Failed to create graphics pipeline" << std::endl;
-			return;
+			return false;
 		}
 
 		pipeline = new_pipeline;
+
+		return true;
 	}
 
-	void VulkanPipelineState::build_compute(class GraphicsContext* const gfx_context, PipelineStateData* state_data, void* render_pass_data)
+	bool VulkanPipelineState::create_compute(VkDevice device, VkPipelineCache pipeline_cache, PipelineStateData* state_data)
 	{
-		if (state_data->shader_stages.empty())
+		if (build_inputs.shader_stages.empty())
 		{
 			std::cout << "Vulkan pipeline error: Cannot create compute pipeline without shader stages" << std::endl;
-			return;
+			return false;
 		}
 
-		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
-		VkPipelineLayout pipeline_layout = static_cast<VkPipelineLayout>(CACHE_FETCH(ShaderPipelineLayout, state_data->layout)->get_data());
-
-		PipelineShaderStage& stage = state_data->shader_stages.back();
-		VulkanShaderData* shader_data = static_cast<VulkanShaderData*>(CACHE_FETCH(Shader, stage.shader_module)->get_data());
-		VkPipelineShaderStageCreateInfo shader_stage = new_shader_stage_create_info(VK_FROM_SUNSET_SHADER_STAGE_TYPE(stage.stage_type), shader_data->shader_module);
-
 		VkComputePipelineCreateInfo pipeline_create_info = {};
 		pipeline_create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
 		pipeline_create_info.pNext = nullptr;
-		pipeline_create_info.stage = shader_stage;
-		pipeline_create_info.layout = pipeline_layout;
+		pipeline_create_info.stage = build_inputs.shader_stages.back();
+		pipeline_create_info.layout = build_inputs.pipeline_layout;
 		
 		pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
 
 		VkPipeline new_pipeline;
-		if (vkCreateComputePipelines(context_state->get_device(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &new_pipeline) != VK_SUCCESS)
+		if (vkCreateComputePipelines(device, pipeline_cache, 1, &pipeline_create_info, nullptr, &new_pipeline) != VK_SUCCESS)
 		{
 			std::cout << "Vulkan pipeline error: Failed to create compute pipeline" << std::endl;
-			return;
+			return false;
 		}
 
 		pipeline = new_pipeline;
+
+		return true;
 	}
 
 	void VulkanPipelineState::bind(class GraphicsContext* const gfx_context, PipelineStateType type, void* buffer)
@@ -161,13 +161,23 @@ namespace Sunset
 		return vk_blend_state;
 	}
 
+	// Handles resolved from resource caches ahead of pipeline creation, so creation itself can run on any thread
+	struct VulkanPipelineBuildInputs
+	{
+		VkPipelineLayout pipeline_layout{ VK_NULL_HANDLE };
+		std::vector<VkPipelineShaderStageCreateInfo> shader_stages;
+		VkRenderPass render_pass{ VK_NULL_HANDLE };
+		uint32_t num_color_attachments{ 0 };
+	};
+
 	class VulkanPipelineState
 	{
 	public:
 		void initialize(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data);
 		void destroy(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data);
-		void build(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, class RenderPass* render_pass);
-		void build_compute(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, void* render_pass_data);
+		void prepare_build(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, class RenderPass* render_pass);
+		void prepare_build_compute(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, void* render_pass_data);
+		bool create(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data);
 		void bind(class GraphicsContext* const gfx_context, PipelineStateType type, void* buffer);
 
 		void* get_handle()
@@ -176,6 +186,9 @@ namespace Sunset
 		}
 
 	protected:
+		bool create_graphics(VkDevice device, VkPipelineCache pipeline_cache, struct PipelineStateData* state_data);
+		bool create_compute(VkDevice device, VkPipelineCache pipeline_cache, struct PipelineStateData* state_data);
+
 		VkPipelineViewportStateCreateInfo new_viewport_state_create_info(const std::vector<VkViewport>& viewports, const std::vector<VkRect2D>& scissors);
 		VkPipelineShaderStageCreateInfo new_shader_stage_create_info(VkShaderStageFlagBits stage, VkShaderModule shader);
 		VkPipelineVertexInputStateCreateInfo new_vertex_input_state_create_info(const std::vector<VkVertexInputBindingDescription>& bindings, const std::vector<VkVertexInputAttributeDescription>& attributes);
@@ -188,5 +201,6 @@ namespace Sunset
 
 	protected:
 		VkPipeline pipeline{ nullptr };
+		VulkanPipelineBuildInputs build_inputs;
 	};
 }
@@ -147,7 +147,7 @@ namespace Sunset
 		vkDestroyRenderPass(context_state->get_device(), data.render_pass, nullptr);
 	}
 
-	void VulkanRenderPass::begin_pass(GraphicsContext* const gfx_context, uint32_t frambuffer_index, void* command_buffer, const RenderPassConfig& pass_config)
+	void VulkanRenderPass::begin_pass(GraphicsContext* const gfx_context, uint32_t frambuffer_index, void* command_buffer, const RenderPassConfig& pass_config, bool b_secondary_contents)
 	{
 		VulkanContextState* context_state = static_cast<VulkanContextState*>(gfx_context->get_state());
 		Framebuffer* const framebuffer = CACHE_FETCH(Framebuffer, data.output_framebuffers[frambuffer_index]);
@@ -193,7 +193,7 @@ namespace Sunset
 		rp_begin_info.clearValueCount = clear_values.size();
 		rp_begin_info.pClearValues = clear_values.data();
 
-		vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(command_buffer), &rp_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBeginRenderPass(static_cast<VkCommandBuffer>(command_buffer), &rp_begin_info, b_secondary_contents ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
 	}
 
 
@@ -40,7 +40,7 @@ namespace Sunset
 			data.output_framebuffers = framebuffers;
 		}
 
-		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer, const RenderPassConfig& pass_config);
+		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer, const RenderPassConfig& pass_config, bool b_secondary_contents = false);
 		void end_pass(class GraphicsContext* const gfx_context, void* command_buffer, const RenderPassConfig& pass_config);
 		uint32_t get_num_color_attachments(const RenderPassConfig& config);
 
@@ -36,6 +36,35 @@ namespace Sunset
 			batcher_policy.add_image_barrier(gfx_context, image, execution_id, destination_access, final_layout);
 		}
 
+		// Queue ownership transfers are recorded twice, as a release on the source queue and then as an acquire on the destination queue.
+		// Only the acquire updates the resource's tracked access and layout. Transfers within a single queue family are dropped.
+		void add_buffer_ownership_transfer(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+		{
+			batcher_policy.add_buffer_ownership_transfer(gfx_context, buffer, execution_id, destination_access, src_queue_family, dst_queue_family, b_acquire);
+		}
+
+		void add_image_ownership_transfer(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+		{
+			batcher_policy.add_image_ownership_transfer(gfx_context, image, execution_id, destination_access, final_layout, src_queue_family, dst_queue_family, b_acquire);
+		}
+
+		// Split barriers are executed along with the other barriers for execution_id, but only wait on the work recorded before the
+		// matching signal_split_barrier call instead of on everything recorded so far
+		void add_split_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t split)
+		{
+			batcher_policy.add_split_buffer_barrier(gfx_context, buffer, execution_id, destination_access, split);
+		}
+
+		void add_split_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t split)
+		{
+			batcher_policy.add_split_image_barrier(gfx_context, image, execution_id, destination_access, final_layout, split);
+		}
+
+		void signal_split_barrier(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, uint32_t split)
+		{
+			batcher_policy.signal_split_barrier(gfx_context, command_buffer, stage, split);
+		}
+
 		void execute(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, Identity execution_id = "")
 		{
 			batcher_policy.execute(gfx_context, command_buffer, stage, execution_id);
@@ -46,6 +75,11 @@ namespace Sunset
 			batcher_policy.reset();
 		}
 
+		void destroy(class GraphicsContext* const gfx_context)
+		{
+			batcher_policy.destroy(gfx_context);
+		}
+
 	private:
 		Policy batcher_policy;
 	};
@@ -58,17 +92,35 @@ namespace Sunset
 		void begin(class GraphicsContext* const gfx_context, PipelineStageType stage)
 		{ }
 
-		void add_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, AccessFlags destination_access, PipelineStageType destination_stage)
+		void add_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access)
+		{ }
+
+		void add_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout)
+		{ }
+
+		void add_buffer_ownership_transfer(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+		{ }
+
+		void add_image_ownership_transfer(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t src_queue_family, uint32_t dst_queue_family, bool b_acquire)
+		{ }
+
+		void add_split_buffer_barrier(class GraphicsContext* const gfx_context, class Buffer* buffer, Identity execution_id, AccessFlags destination_access, uint32_t split)
+		{ }
+
+		void add_split_image_barrier(class GraphicsContext* const gfx_context, class Image* image, Identity execution_id, AccessFlags destination_access, ImageLayout final_layout, uint32_t split)
 		{ }
 
-		void add_image_barrier(class GraphicsContext* const gfx_context, class Image* image, AccessFlags destination_access, PipelineStageType destination_stage, ImageLayout final_layout)
+		void signal_split_barrier(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, uint32_t split)
 		{ }
 
-		void execute(class GraphicsContext* const gfx_context, void* command_buffer, Identity execution_id = "")
+		void execute(class GraphicsContext* const gfx_context, void* command_buffer, PipelineStageType stage, Identity execution_id = "")
 		{ }
 
 		void reset()
 		{ }
+
+		void destroy(class GraphicsContext* const gfx_context)
+		{ }
 	};
 
 #if USE_VULKAN_GRAPHICS
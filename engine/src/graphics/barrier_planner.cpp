@@ -0,0 +1,126 @@
+#include <graphics/barrier_planner.h>
+
+#include <algorithm>
+
+namespace Sunset
+{
+	struct BarrierMipState
+	{
+		AccessFlags access{ AccessFlags::None };
+		ImageLayout layout{ ImageLayout::Undefined };
+		uint32_t last_pass{ 0 };
+		bool b_used{ false };
+	};
+
+	inline bool can_combine_barriers(const PlannedBarrier& a, const PlannedBarrier& b)
+	{
+		return a.resource == b.resource && a.pass == b.pass && a.release_pass == b.release_pass
+			&& a.src_access == b.src_access && a.dst_access == b.dst_access
+			&& a.old_layout == b.old_layout && a.new_layout == b.new_layout
+			&& a.base_mip + a.mip_count == b.base_mip;
+	}
+
+	void plan_barriers(const BarrierPlanInput& input, BarrierPlan& out_plan)
+	{
+		ZoneScopedN("plan_barriers");
+
+		out_plan.barriers.clear();
+		out_plan.unoptimized_barrier_count = 0;
+		out_plan.split_barrier_count = 0;
+
+		std::vector<BarrierMipState> mip_states;
+		std::vector<BarrierMipState> unoptimized_mip_states;
+
+		for (uint32_t resource = 0; resource < input.resources.size(); ++resource)
+		{
+			const BarrierPlanResource& plan_resource = input.resources[resource];
+			const std::vector<BarrierResourceUse>& uses = plan_resource.uses;
+
+			const BarrierMipState initial_state{ .access = plan_resource.initial_access, .layout = plan_resource.initial_layout };
+			mip_states.assign(plan_resource.mip_count, initial_state);
+			unoptimized_mip_states.assign(plan_resource.mip_count, initial_state);
+
+			for (uint32_t use_index = 0; use_index < uses.size(); ++use_index)
+			{
+				const BarrierResourceUse& use = uses[use_index];
+				assert(use_index == 0 || uses[use_index - 1].pass <= use.pass && "Barrier plan resource uses must be sorted by pass");
+				assert(use.base_mip + use.mip_count <= plan_resource.mip_count && "Barrier plan resource use is out of the resource's mip range");
+
+				for (uint32_t mip = use.base_mip; mip < use.base_mip + use.mip_count; ++mip)
+				{
+					BarrierMipState& unoptimized_state = unoptimized_mip_states[mip];
+					if (unoptimized_state.access != use.access || unoptimized_state.layout != use.layout)
+					{
+						++out_plan.unoptimized_barrier_count;
+						unoptimized_state.access = use.access;
+						unoptimized_state.layout = use.layout;
+					}
+
+					BarrierMipState& state = mip_states[mip];
+					if (resource_state_needs_barrier(state.access, state.layout, use.access, use.layout))
+					{
+						// Make the mip visible to every read up to its next write or layout change, so those reads need no barrier of their own
+						AccessFlags dst_access = use.access;
+						if (is_read_only_access(use.access))
+						{
+							for (uint32_t next_index = use_index + 1; next_index < uses.size(); ++next_index)
+							{
+								const BarrierResourceUse& next_use = uses[next_index];
+								if (mip < next_use.base_mip || mip >= next_use.base_mip + next_use.mip_count)
+								{
+									continue;
+								}
+								if (!is_read_only_access(next_use.access) || next_use.layout != use.layout)
+								{
+									break;
+								}
+								dst_access |= next_use.access;
+							}
+						}
+
+						const bool b_split = state.b_used && input.split_min_distance > 0 && use.pass - state.last_pass >= input.split_min_distance;
+
+						const PlannedBarrier barrier
+						{
+							.resource = resource,
+							.pass = use.pass,
+							.release_pass = b_split ? state.last_pass : use.pass,
+							.src_access = state.access,
+							.dst_access = dst_access,
+							.old_layout = state.layout,
+							.new_layout = use.layout,
+							.base_mip = mip,
+							.mip_count = 1
+						};
+
+						// Uses are walked in pass and mip order, so a neighbouring mip's transition is always the last one planned
+						if (!out_plan.barriers.empty() && can_combine_barriers(out_plan.barriers.back(), barrier))
+						{
+							++out_plan.barriers.back().mip_count;
+						}
+						else
+						{
+							out_plan.barriers.push_back(barrier);
+						}
+
+						state.access = dst_access;
+						state.layout = use.layout;
+					}
+
+					state.last_pass = use.pass;
+					state.b_used = true;
+				}
+			}
+		}
+
+		std::stable_sort(out_plan.barriers.begin(), out_plan.barriers.end(), [](const PlannedBarrier& a, const PlannedBarrier& b)
+		{
+			return a.pass < b.pass;
+		});
+
+		out_plan.split_barrier_count = static_cast<uint32_t>(std::count_if(out_plan.barriers.begin(), out_plan.barriers.end(), [](const PlannedBarrier& barrier)
+		{
+			return barrier.is_split();
+		}));
+	}
+}
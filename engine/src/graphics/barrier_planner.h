@@ -0,0 +1,87 @@
+#pragma once
+
+#include <minimal.h>
+
+namespace Sunset
+{
+	inline bool is_read_only_access(AccessFlags access)
+	{
+		const AccessFlags write_access = AccessFlags::ShaderWrite | AccessFlags::ColorAttachmentWrite | AccessFlags::DepthStencilAttachmentWrite
+			| AccessFlags::TransferWrite | AccessFlags::HostWrite | AccessFlags::MemoryWrite;
+		return (access & write_access) == AccessFlags::None;
+	}
+
+	// A resource already in a read-only state does not need another barrier for reads that state already made visible
+	inline bool resource_state_needs_barrier(AccessFlags current_access, ImageLayout current_layout, AccessFlags access, ImageLayout layout)
+	{
+		if (current_layout != layout)
+		{
+			return true;
+		}
+		if (current_access == access)
+		{
+			return false;
+		}
+		return !is_read_only_access(current_access) || !is_read_only_access(access) || (current_access & access) != access;
+	}
+
+	// One pass using a range of a resource's mips. Buffers use a single mip and leave the layout undefined.
+	struct BarrierResourceUse
+	{
+		uint32_t pass{ 0 };
+		AccessFlags access{ AccessFlags::None };
+		ImageLayout layout{ ImageLayout::Undefined };
+		uint32_t base_mip{ 0 };
+		uint32_t mip_count{ 1 };
+	};
+
+	// Uses are sorted by pass. A mip should only be used once per pass.
+	struct BarrierPlanResource
+	{
+		std::vector<BarrierResourceUse> uses;
+		uint32_t mip_count{ 1 };
+		AccessFlags initial_access{ AccessFlags::None };
+		ImageLayout initial_layout{ ImageLayout::Undefined };
+	};
+
+	struct BarrierPlanInput
+	{
+		std::vector<BarrierPlanResource> resources;
+		// Barriers whose previous use is at least this many passes away are split. Zero never splits.
+		uint32_t split_min_distance{ 0 };
+	};
+
+	// Transition of a range of mips ahead of 'pass'. Split barriers are released right after 'release_pass' and acquired
+	// before 'pass', so the work in between does not have to wait on the transition.
+	struct PlannedBarrier
+	{
+		uint32_t resource{ 0 };
+		uint32_t pass{ 0 };
+		uint32_t release_pass{ 0 };
+		AccessFlags src_access{ AccessFlags::None };
+		AccessFlags dst_access{ AccessFlags::None };
+		ImageLayout old_layout{ ImageLayout::Undefined };
+		ImageLayout new_layout{ ImageLayout::Undefined };
+		uint32_t base_mip{ 0 };
+		uint32_t mip_count{ 1 };
+
+		bool is_split() const
+		{
+			return release_pass != pass;
+		}
+	};
+
+	struct BarrierPlan
+	{
+		// Sorted by pass, then by resource and mip
+		std::vector<PlannedBarrier> barriers;
+		// Barriers needed when every change of state gets its own barrier for every mip
+		uint32_t unoptimized_barrier_count{ 0 };
+		uint32_t split_barrier_count{ 0 };
+	};
+
+	// Plans the barriers each resource needs between its uses. Consecutive reads in the same layout are merged into the first
+	// one's barrier so the later reads need none, transitions of neighbouring mips with the same states are combined into one
+	// range and barriers far enough from the previous use are split.
+	void plan_barriers(const BarrierPlanInput& input, BarrierPlan& out_plan);
+}
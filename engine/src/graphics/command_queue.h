@@ -56,6 +56,64 @@ namespace Sunset
 			queue_policy.submit_immediate(gfx_context, buffered_frame_number, buffer_update_fn);
 		}
 
+		uint32_t get_queue_family() const
+		{
+			return queue_policy.get_queue_family();
+		}
+
+		void* begin_submission_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t submission_slot)
+		{
+			return queue_policy.begin_submission_record(gfx_context, buffered_frame_number, submission_slot);
+		}
+
+		void end_submission_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t submission_slot)
+		{
+			queue_policy.end_submission_record(gfx_context, buffered_frame_number, submission_slot);
+		}
+
+		// Submits one of the frame's per-submission command buffers, or no command buffer at all if the slot is empty
+		void submit_frame_submission(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, std::optional<uint32_t> submission_slot, const QueueSubmitSync& sync)
+		{
+			queue_policy.submit_frame_submission(gfx_context, buffered_frame_number, submission_slot, sync);
+		}
+
+		// Secondary command buffers are recorded from job threads, so every slot has its own command pool. Chunks of a graphics pass
+		// continue the pass's render pass instance, compute chunks pass a null render pass.
+		void* begin_secondary_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t slot, class RenderPass* render_pass, uint32_t framebuffer_index)
+		{
+			return queue_policy.begin_secondary_record(gfx_context, buffered_frame_number, slot, render_pass, framebuffer_index);
+		}
+
+		void end_secondary_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t slot)
+		{
+			queue_policy.end_secondary_record(gfx_context, buffered_frame_number, slot);
+		}
+
+		void execute_secondary_records(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, void* command_buffer, uint32_t first_slot, uint32_t slot_count)
+		{
+			queue_policy.execute_secondary_records(gfx_context, buffered_frame_number, command_buffer, first_slot, slot_count);
+		}
+
+		void* begin_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			return queue_policy.begin_upload_batch(gfx_context, batch_slot);
+		}
+
+		void submit_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			queue_policy.submit_upload_batch(gfx_context, batch_slot);
+		}
+
+		bool is_upload_batch_complete(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			return queue_policy.is_upload_batch_complete(gfx_context, batch_slot);
+		}
+
+		void wait_for_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			queue_policy.wait_for_upload_batch(gfx_context, batch_slot);
+		}
+
 	private:
 		Policy queue_policy;
 	};
@@ -99,6 +157,49 @@ namespace Sunset
 
 		void submit_immediate(class GraphicsContext* const gfx_context, int32_t buffered_frame_number, const std::function<void(void* cmd_buffer)>& buffer_update_fn)
 		{ }
+
+		uint32_t get_queue_family() const
+		{
+			return 0;
+		}
+
+		void* begin_submission_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t submission_slot)
+		{
+			return nullptr;
+		}
+
+		void end_submission_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t submission_slot)
+		{ }
+
+		void submit_frame_submission(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, std::optional<uint32_t> submission_slot, const QueueSubmitSync& sync)
+		{ }
+
+		void* begin_secondary_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t slot, class RenderPass* render_pass, uint32_t framebuffer_index)
+		{
+			return nullptr;
+		}
+
+		void end_secondary_record(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, uint32_t slot)
+		{ }
+
+		void execute_secondary_records(class GraphicsContext* const gfx_context, uint16_t buffered_frame_number, void* command_buffer, uint32_t first_slot, uint32_t slot_count)
+		{ }
+
+		void* begin_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			return nullptr;
+		}
+
+		void submit_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{ }
+
+		bool is_upload_batch_complete(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			return true;
+		}
+
+		void wait_for_upload_batch(class GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{ }
 	};
 
 #if USE_VULKAN_GRAPHICS
@@ -4,6 +4,14 @@
 
 namespace Sunset
 {
+	constexpr uint32_t MAX_UPLOAD_BATCHES_IN_FLIGHT = 4;
+	// Limits on how finely a frame can be split up across queues
+	constexpr uint32_t MAX_QUEUE_SUBMISSIONS_PER_FRAME = 8;
+	constexpr uint32_t MAX_CROSS_QUEUE_SEMAPHORES = 16;
+	// Secondary command buffers a frame can record render graph passes into from job threads
+	constexpr uint32_t MAX_PARALLEL_RECORD_SLOTS_PER_FRAME = 32;
+	constexpr uint32_t QUEUE_FAMILY_IGNORED = ~0u;
+
 	enum class DeviceQueueType : uint8_t
 	{
 		None = 0,
@@ -12,4 +20,15 @@ namespace Sunset
 		Transfer = 3,
 		Num = Transfer
 	};
+
+	// Sync for one of a frame's queue submissions. Semaphores index the frame's cross queue semaphores.
+	struct QueueSubmitSync
+	{
+		std::vector<uint32_t> wait_semaphores;
+		std::vector<uint32_t> signal_semaphores;
+		// Waits for the swapchain image before writing color attachments
+		bool b_wait_for_present{ false };
+		// Signals the frame's render semaphore and fence, so only the frame's last submission should set this
+		bool b_signal_frame_complete{ false };
+	};
 }
\ No newline at end of file
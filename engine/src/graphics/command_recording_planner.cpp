@@ -0,0 +1,114 @@
+#include <graphics/command_recording_planner.h>
+#include <job_system/job_scheduler.h>
+
+namespace Sunset
+{
+	void plan_command_recording(const CommandRecordingInput& input, CommandRecordingPlan& out_plan)
+	{
+		ZoneScopedN("plan_command_recording");
+
+		const uint32_t pass_count = static_cast<uint32_t>(input.passes.size());
+
+		out_plan.batches.clear();
+		out_plan.pass_first_slots.assign(pass_count, COMMAND_RECORDING_INLINE_PASS);
+		out_plan.pass_chunk_counts.assign(pass_count, 1);
+		out_plan.slot_count = 0;
+		out_plan.inlined_pass_count = 0;
+
+		for (uint32_t pass = 0; pass < pass_count; ++pass)
+		{
+			const CommandRecordingPassInput& pass_input = input.passes[pass];
+			if (!pass_input.b_parallel)
+			{
+				continue;
+			}
+
+			const uint32_t chunk_count = std::max(pass_input.chunk_count, 1u);
+			if (out_plan.slot_count + chunk_count > input.max_slots)
+			{
+				++out_plan.inlined_pass_count;
+				continue;
+			}
+
+			out_plan.pass_first_slots[pass] = out_plan.slot_count;
+			out_plan.pass_chunk_counts[pass] = chunk_count;
+
+			// Only passes right next to each other share a batch, anything recorded inline in between has to see the earlier passes stitched first
+			const bool b_extends_batch = !out_plan.batches.empty() && out_plan.batches.back().first_pass + out_plan.batches.back().pass_count == pass;
+			if (!b_extends_batch)
+			{
+				out_plan.batches.push_back({ .first_pass = pass, .first_slot = out_plan.slot_count });
+			}
+
+			CommandRecordingBatch& batch = out_plan.batches.back();
+			++batch.pass_count;
+			batch.slot_count += chunk_count;
+
+			out_plan.slot_count += chunk_count;
+		}
+	}
+
+	void record_command_stream(const CommandRecordingPlan& plan, const CommandRecordingCallbacks& callbacks, bool b_parallel)
+	{
+		ZoneScopedN("record_command_stream");
+
+		const bool b_can_run_parallel = b_parallel && JobScheduler::get()->has_available_threads();
+
+		const auto chunk_job = [&callbacks](uint32_t pass, uint32_t chunk, uint32_t slot) -> ThreadedJob<>
+		{
+			callbacks.record_chunk(pass, chunk, slot);
+			co_return;
+		};
+
+		const uint32_t pass_count = static_cast<uint32_t>(plan.pass_first_slots.size());
+		uint32_t pass{ 0 };
+
+		for (const CommandRecordingBatch& batch : plan.batches)
+		{
+			for (; pass < batch.first_pass; ++pass)
+			{
+				callbacks.record_pass(pass);
+			}
+
+			const uint32_t batch_end = batch.first_pass + batch.pass_count;
+
+			// Pass setup creates and caches resources, so all of it is done before any chunk starts recording
+			for (uint32_t batch_pass = batch.first_pass; batch_pass < batch_end; ++batch_pass)
+			{
+				callbacks.prepare_pass(batch_pass, plan.pass_first_slots[batch_pass]);
+			}
+
+			JobBatcher<ThreadedJob<>> jobs(b_can_run_parallel ? batch.slot_count : 0);
+			for (uint32_t batch_pass = batch.first_pass; batch_pass < batch_end; ++batch_pass)
+			{
+				const uint32_t first_slot = plan.pass_first_slots[batch_pass];
+				for (uint32_t chunk = 0; chunk < plan.pass_chunk_counts[batch_pass]; ++chunk)
+				{
+					if (b_can_run_parallel)
+					{
+						jobs.add(chunk_job(batch_pass, chunk, first_slot + chunk), first_slot + chunk - batch.first_slot);
+					}
+					else
+					{
+						callbacks.record_chunk(batch_pass, chunk, first_slot + chunk);
+					}
+				}
+			}
+
+			{
+				ZoneScopedN("record_command_stream: wait_on_all");
+				jobs.wait_on_all();
+			}
+
+			for (; pass < batch_end; ++pass)
+			{
+				callbacks.execute_pass(pass, plan.pass_first_slots[pass]);
+			}
+		}
+
+		for (; pass < pass_count; ++pass)
+		{
+			callbacks.record_pass(pass);
+		}
+	}
+}
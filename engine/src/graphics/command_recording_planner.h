@@ -0,0 +1,83 @@
+#pragma once
+
+#include <minimal.h>
+#include <command_queue_types.h>
+
+#include <functional>
+
+namespace Sunset
+{
+	constexpr uint32_t COMMAND_RECORDING_INLINE_PASS = ~0u;
+
+	struct CommandRecordingPassInput
+	{
+		// Parallel passes have their executors recorded into secondary command buffers on job threads, one per chunk
+		bool b_parallel{ false };
+		uint32_t chunk_count{ 1 };
+	};
+
+	struct CommandRecordingInput
+	{
+		// In submission order
+		std::vector<CommandRecordingPassInput> passes;
+		// Secondary command buffers available to the frame. Parallel passes that do not fit are recorded inline instead.
+		uint32_t max_slots{ MAX_PARALLEL_RECORD_SLOTS_PER_FRAME };
+	};
+
+	// A run of consecutive parallel passes. Every pass in the batch is prepared and has its chunks recorded before the
+	// batch is stitched into the primary command stream.
+	struct CommandRecordingBatch
+	{
+		uint32_t first_pass{ 0 };
+		uint32_t pass_count{ 0 };
+		uint32_t first_slot{ 0 };
+		uint32_t slot_count{ 0 };
+	};
+
+	struct CommandRecordingPlan
+	{
+		// Sorted by first pass
+		std::vector<CommandRecordingBatch> batches;
+		// First secondary command buffer slot of each pass, or COMMAND_RECORDING_INLINE_PASS for passes recorded straight into the primary stream
+		std::vector<uint32_t> pass_first_slots;
+		std::vector<uint32_t> pass_chunk_counts;
+		uint32_t slot_count{ 0 };
+		// Parallel passes that had to be recorded inline because the frame ran out of slots
+		uint32_t inlined_pass_count{ 0 };
+	};
+
+	void plan_command_recording(const CommandRecordingInput& input, CommandRecordingPlan& out_plan);
+
+	// Items [begin, end) that a chunk of a parallel pass records. Chunks of the same pass cover every item exactly once and differ in size by at most one.
+	struct CommandRecordingChunkRange
+	{
+		uint32_t begin{ 0 };
+		uint32_t end{ 0 };
+	};
+
+	inline CommandRecordingChunkRange get_command_recording_chunk_range(uint32_t item_count, uint32_t chunk, uint32_t chunk_count)
+	{
+		assert(chunk < chunk_count);
+		return
+		{
+			.begin = static_cast<uint32_t>(static_cast<uint64_t>(item_count) * chunk / chunk_count),
+			.end = static_cast<uint32_t>(static_cast<uint64_t>(item_count) * (chunk + 1) / chunk_count)
+		};
+	}
+
+	struct CommandRecordingCallbacks
+	{
+		// Records an inline pass into the primary stream. Called on the recording thread.
+		std::function<void(uint32_t pass)> record_pass;
+		// Does the pass's setup and begins its chunks' command buffers. Called on the recording thread, in pass order, before any chunk of the pass's batch is recorded.
+		std::function<void(uint32_t pass, uint32_t first_slot)> prepare_pass;
+		// Records one chunk of a parallel pass into its slot's command buffer and ends it. Called on any thread while the recording thread waits, including the recording thread itself if it is a job thread.
+		std::function<void(uint32_t pass, uint32_t chunk, uint32_t slot)> record_chunk;
+		// Stitches a parallel pass's recorded chunks into the primary stream. Called on the recording thread once all of the pass's chunks are recorded.
+		std::function<void(uint32_t pass, uint32_t first_slot)> execute_pass;
+	};
+
+	// Records every pass of the plan. Primary stream callbacks always run on the calling thread in pass order, so the stream
+	// matches a serial recording. Chunks run on job threads if b_parallel is set and the job scheduler has threads.
+	void record_command_stream(const CommandRecordingPlan& plan, const CommandRecordingCallbacks& callbacks, bool b_parallel);
+}
@@ -18,7 +18,8 @@ namespace Sunset
 		uint32_t instance_count,
 		const PushConstantPipelineData& push_constants)
 	{
-		CACHE_FETCH(ResourceState, resource_state)->bind(gfx_context, command_buffer);
+		ResourceState* const state = CACHE_FETCH(ResourceState, resource_state);
+		state->bind(gfx_context, command_buffer);
 
 		if (push_constants.data != nullptr)
 		{
@@ -27,9 +28,11 @@ namespace Sunset
 
 		gfx_context->draw_indexed(
 			command_buffer,
-			static_cast<uint32_t>(CACHE_FETCH(ResourceState, resource_state)->state_data.index_count),
+			static_cast<uint32_t>(state->state_data.index_count),
 			instance_count,
-			0);
+			0,
+			state->state_data.index_start,
+			state->state_data.vertex_offset);
 	}
 
 	void DebugDrawState::initialize()
@@ -103,6 +106,12 @@ namespace Sunset
 
 	void submit_requested_debug_draws(GraphicsContext* const gfx_context, void* command_buffer, PipelineStateID pipeline_state, int32_t buffered_frame_number)
 	{
+		PipelineState* const debug_pipeline_state = CACHE_FETCH(PipelineState, pipeline_state);
+		if (!debug_pipeline_state->is_ready())
+		{
+			return;
+		}
+
 		const uint32_t primitive_data_count = DebugDrawState::get()->requested_primitive_datas[buffered_frame_number].size();
 
 		Buffer* const debug_draws_buffer = CACHE_FETCH(Buffer, DebugDrawState::get()->primitive_data_buffers[buffered_frame_number]);
@@ -118,11 +127,13 @@ namespace Sunset
 		static ResourceStateID line_resource_state = ResourceStateBuilder::create()
 			.set_vertex_buffer(line_mesh->vertex_buffer)
 			.set_index_buffer(line_mesh->sections[0].index_buffer)
+			.set_index_start(line_mesh->sections[0].index_allocation.offset)
+			.set_vertex_offset(line_mesh->vertex_allocation.offset)
 			.set_vertex_count(line_mesh->vertices.size())
 			.set_index_count(line_mesh->sections[0].indices.size())
 			.finish();
 
-		CACHE_FETCH(PipelineState, pipeline_state)->bind(gfx_context, command_buffer);
+		debug_pipeline_state->bind(gfx_context, command_buffer);
 
 		{
 			static DebugDrawExecutor draw_executor;
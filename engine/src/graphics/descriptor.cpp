@@ -141,8 +141,13 @@ namespace Sunset
 
 	void DescriptorHelpers::write_bindless_descriptors(class GraphicsContext* const gfx_context, const std::vector<DescriptorBindlessWrite>& descriptor_writes, BindingTableHandle* out_binding_table_handles)
 	{
-		std::vector<DescriptorWrite> writes;
+		DescriptorWriteBatch batch;
+		queue_bindless_descriptors(descriptor_writes, out_binding_table_handles, batch);
+		batch.flush(gfx_context);
+	}
 
+	void DescriptorHelpers::queue_bindless_descriptors(const std::vector<DescriptorBindlessWrite>& descriptor_writes, BindingTableHandle* out_binding_table_handles, DescriptorWriteBatch& batch)
+	{
 		for (uint32_t i = 0; i < descriptor_writes.size(); ++i)
 		{
 			const DescriptorBindlessWrite& bindless_write = descriptor_writes[i];
@@ -152,7 +157,7 @@ namespace Sunset
 				out_binding_table_handles[i] = bindless_write.set->get_free_bindless_index(bindless_write.slot);
 			}
 
-			DescriptorWrite& write = writes.emplace_back();
+			DescriptorWrite write;
 			write.slot = bindless_write.slot;
 			write.count = 1;
 			write.array_index = 0x0000ffff & out_binding_table_handles[i];
@@ -160,9 +165,8 @@ namespace Sunset
 			write.buffer_desc.buffer = bindless_write.buffer;
 			write.buffer_desc.buffer_offset = bindless_write.level;
 			write.set = bindless_write.set;
+			batch.add(write);
 		}
-
-		gfx_context->push_descriptor_writes(writes);
 	}
 
 	void DescriptorHelpers::free_bindless_image_descriptors(class GraphicsContext* const gfx_context, DescriptorSet* descriptor_set, const std::vector<BindingTableHandle> handles)
@@ -253,14 +257,16 @@ namespace Sunset
 	{
 		assert(binding_table.contains(slot));
 
-		if (binding_table[slot].free_indices.empty())
+		BindingTableEntry& entry = binding_table[slot];
+		if (entry.free_indices.empty())
 		{
 			return -1;
 		}
 
-		int32_t new_index = binding_table[slot].free_indices.back();
-		binding_table[slot].free_indices.pop_back();
-		binding_table[slot].bound_indices.push_back(new_index);
+		const int32_t new_index = entry.free_indices.back();
+		entry.free_indices.pop_back();
+		entry.bound_indices[new_index] = true;
+		++entry.bound_count;
 
 		BindingTableHandle handle = (((int64_t)slot) << 32) | (int64_t)new_index;
 
@@ -274,15 +280,12 @@ namespace Sunset
 
 		assert(binding_table.contains(slot));
 
-		// TODO: Consider keeping fetched handles in an unordered_set so we don't have to do a costly linear search for existing slot indices,
-		// but only if index allocations at any given time start becoming numerous
-		if (std::find(binding_table[slot].bound_indices.begin(), binding_table[slot].bound_indices.end(), index) != binding_table[slot].bound_indices.end())
+		BindingTableEntry& entry = binding_table[slot];
+		if (index < entry.bound_indices.size() && entry.bound_indices[index])
 		{
-			binding_table[slot].free_indices.push_back(index);
-			binding_table[slot].bound_indices.erase(
-				std::remove(binding_table[slot].bound_indices.begin(), binding_table[slot].bound_indices.end(), index),
-				binding_table[slot].bound_indices.end()
-			);
+			entry.bound_indices[index] = false;
+			entry.free_indices.push_back(index);
+			--entry.bound_count;
 		}
 	}
 
@@ -290,16 +293,56 @@ namespace Sunset
 	{
 		assert(binding_table.contains(slot));
 
-		binding_table[slot].free_indices.clear();
-		binding_table[slot].bound_indices.clear();
+		BindingTableEntry& entry = binding_table[slot];
+
+		entry.free_indices.clear();
+		entry.bound_indices.assign(entry.total_bindings_count, false);
+		entry.bound_count = 0;
 
-		binding_table[slot].free_indices.reserve(binding_table[slot].total_bindings_count);
-		for (int32_t i = binding_table[slot].total_bindings_count - 1; i >= 0; --i)
+		entry.free_indices.reserve(entry.total_bindings_count);
+		for (int32_t i = entry.total_bindings_count - 1; i >= 0; --i)
 		{
-			binding_table[slot].free_indices.push_back(i);
+			entry.free_indices.push_back(i);
 		}
 	}
 
+	uint32_t DescriptorBindingTable::get_bound_count(uint32_t slot) const
+	{
+		const auto entry_it = binding_table.find(slot);
+		return entry_it != binding_table.end() ? entry_it->second.bound_count : 0;
+	}
+
+	void DescriptorWriteBatch::add(const DescriptorWrite& write)
+	{
+		++stats.queued_write_count;
+
+		// Array writes are keyed by their first element, bindless writes always write a single element
+		const DescriptorWriteKey key{ .set = write.set, .slot = write.slot, .array_index = write.array_index };
+		if (auto index_it = write_indices.find(key); index_it != write_indices.end())
+		{
+			writes[index_it->second] = write;
+			++stats.deduplicated_write_count;
+			return;
+		}
+
+		write_indices.insert({ key, static_cast<uint32_t>(writes.size()) });
+		writes.push_back(write);
+	}
+
+	void DescriptorWriteBatch::add(const std::vector<DescriptorWrite>& new_writes)
+	{
+		for (const DescriptorWrite& write : new_writes)
+		{
+			add(write);
+		}
+	}
+
+	void DescriptorWriteBatch::clear()
+	{
+		writes.clear();
+		write_indices.clear();
+	}
+
 	Sunset::DescriptorLayoutID DescriptorLayoutFactory::create(class GraphicsContext* const gfx_context, const std::vector<DescriptorBinding>& bindings)
 	{
 		Identity cache_id;
@@ -6,6 +6,9 @@
 
 namespace Sunset
 {
+	template<class Policy>
+	class GenericGraphicsContext;
+
 	// Binding table is mostly used for bindless descriptor sets, so that we have a simple interface
 	// for pooling array descriptors.
 	struct DescriptorBindingTable
@@ -13,8 +16,11 @@ namespace Sunset
 		struct BindingTableEntry
 		{
 			uint32_t total_bindings_count;
+			// Popped from the back, so both allocating and freeing an index are constant time
 			std::vector<int32_t> free_indices;
-			std::vector<int32_t> bound_indices;
+			// Membership of each index, so freeing an index that is not bound is caught without searching
+			std::vector<bool> bound_indices;
+			uint32_t bound_count{ 0 };
 		};
 		phmap::flat_hash_map<uint32_t, BindingTableEntry> binding_table;
 
@@ -23,6 +29,57 @@ namespace Sunset
 		BindingTableHandle get_new(uint32_t slot);
 		void free(BindingTableHandle handle);
 		void reset(uint32_t slot);
+		uint32_t get_bound_count(uint32_t slot) const;
+	};
+
+	struct DescriptorWriteBatchStats
+	{
+		// Writes added to the batch
+		uint32_t queued_write_count{ 0 };
+		// Writes dropped because a later write to the same descriptor replaced them
+		uint32_t deduplicated_write_count{ 0 };
+		// Writes pushed through the GPI
+		uint32_t pushed_write_count{ 0 };
+		// Calls into the GPI to push writes
+		uint32_t update_call_count{ 0 };
+	};
+
+	// Collects descriptor writes from many sources (e.g. every material updated this frame) and pushes them through the GPI
+	// in a single update. Each descriptor array element is written at most once per flush, the last write to it wins.
+	class DescriptorWriteBatch
+	{
+	public:
+		void add(const DescriptorWrite& write);
+		void add(const std::vector<DescriptorWrite>& writes);
+
+		template<class ContextPolicy>
+		void flush(GenericGraphicsContext<ContextPolicy>* const gfx_context)
+		{
+			if (!writes.empty())
+			{
+				gfx_context->push_descriptor_writes(writes);
+				stats.pushed_write_count += static_cast<uint32_t>(writes.size());
+				++stats.update_call_count;
+			}
+			clear();
+		}
+
+		void clear();
+
+		size_t size() const
+		{
+			return writes.size();
+		}
+
+		const DescriptorWriteBatchStats& get_stats() const
+		{
+			return stats;
+		}
+
+	protected:
+		std::vector<DescriptorWrite> writes;
+		phmap::flat_hash_map<DescriptorWriteKey, uint32_t> write_indices;
+		DescriptorWriteBatchStats stats;
 	};
 
 	// BEGIN - Descriptor Set Layout
@@ -294,6 +351,8 @@ namespace Sunset
 		static DescriptorSet* new_descriptor_set_with_layout(class GraphicsContext* const gfx_context, DescriptorLayoutID descriptor_layout);
 		static void write_descriptors(class GraphicsContext* const gfx_context, DescriptorSet* descriptor_set, std::vector<DescriptorWrite>& descriptor_writes);
 		static void write_bindless_descriptors(class GraphicsContext* const gfx_context, const std::vector<DescriptorBindlessWrite>& descriptor_writes, BindingTableHandle* out_binding_table_handles);
+		// Same as write_bindless_descriptors, but leaves the writes in the batch to be pushed with others
+		static void queue_bindless_descriptors(const std::vector<DescriptorBindlessWrite>& descriptor_writes, BindingTableHandle* out_binding_table_handles, DescriptorWriteBatch& batch);
 		static void free_bindless_image_descriptors(class GraphicsContext* const gfx_context, DescriptorSet* descriptor_set, const std::vector<BindingTableHandle> indices);
 		static std::vector<DescriptorBindlessWrite> new_descriptor_image_bindless_writes(class DescriptorSet* set, ImageID image, bool b_split_image_mips = true);
 	};
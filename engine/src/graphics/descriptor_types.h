@@ -84,6 +84,19 @@ namespace Sunset
 		class DescriptorSet* set{ nullptr };
 	};
 
+	// Identifies the descriptor array element a write lands in
+	struct DescriptorWriteKey
+	{
+		class DescriptorSet* set{ nullptr };
+		uint16_t slot{ 0 };
+		int32_t array_index{ 0 };
+
+		bool operator==(const DescriptorWriteKey& other) const
+		{
+			return set == other.set && slot == other.slot && array_index == other.array_index;
+		}
+	};
+
 	struct DescriptorBindlessWrite
 	{
 		uint16_t slot{ 0 };
@@ -135,4 +148,15 @@ struct std::hash<Sunset::DescriptorBinding>
 	}
 };
 
+template<>
+struct std::hash<Sunset::DescriptorWriteKey>
+{
+	std::size_t operator()(const Sunset::DescriptorWriteKey& key) const
+	{
+		std::size_t hash = Sunset::Maths::cantor_pair_hash(static_cast<int32_t>(key.slot), key.array_index);
+		hash = Sunset::Maths::cantor_pair_hash(hash, reinterpret_cast<uintptr_t>(key.set));
+		return hash;
+	}
+};
+
 #pragma warning( pop ) 
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include <graphics/geometry_heap_allocator.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace Sunset
+{
+	GeometryHeapAllocator::GeometryHeapAllocator(uint32_t capacity)
+	{
+		reset(capacity);
+	}
+
+	void GeometryHeapAllocator::reset(uint32_t new_capacity)
+	{
+		capacity = new_capacity;
+		used_size = 0;
+		allocation_count = 0;
+		free_region_count = 0;
+		first_level_mask = 0;
+		std::fill(std::begin(second_level_masks), std::end(second_level_masks), 0);
+		std::fill(std::begin(bin_heads), std::end(bin_heads), GEOMETRY_HEAP_INVALID_NODE);
+		nodes.clear();
+		free_nodes.clear();
+
+		first_node = new_node(0, capacity);
+		if (capacity > 0)
+		{
+			insert_free_node(first_node);
+		}
+	}
+
+	GeometryHeapAllocation GeometryHeapAllocator::allocate(uint32_t size)
+	{
+		if (size == 0 || size > capacity - used_size)
+		{
+			return {};
+		}
+
+		// Rounding up means any region in the found bin fits, so the bin's head can be taken without searching it
+		const uint32_t min_bin = size_to_bin_round_up(size);
+		const uint32_t bin = min_bin < BIN_COUNT ? find_free_bin(min_bin) : GEOMETRY_HEAP_INVALID_NODE;
+
+		uint32_t node{ GEOMETRY_HEAP_INVALID_NODE };
+		if (bin != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			node = bin_heads[bin];
+		}
+		else
+		{
+			// The bin the size rounds down to can still hold a region that fits (e.g. an exact fit), which matters once the heap is nearly full
+			for (uint32_t candidate = bin_heads[size_to_bin_round_down(size)]; candidate != GEOMETRY_HEAP_INVALID_NODE; candidate = nodes[candidate].bin_next)
+			{
+				if (nodes[candidate].size >= size)
+				{
+					node = candidate;
+					break;
+				}
+			}
+
+			if (node == GEOMETRY_HEAP_INVALID_NODE)
+			{
+				return {};
+			}
+		}
+
+		remove_free_node(node);
+
+		if (nodes[node].size > size)
+		{
+			// The rest of the region goes back into the bins as its own free region
+			const uint32_t remainder = new_node(nodes[node].offset + size, nodes[node].size - size);
+			nodes[remainder].neighbor_prev = node;
+			nodes[remainder].neighbor_next = nodes[node].neighbor_next;
+			if (nodes[node].neighbor_next != GEOMETRY_HEAP_INVALID_NODE)
+			{
+				nodes[nodes[node].neighbor_next].neighbor_prev = remainder;
+			}
+			nodes[node].neighbor_next = remainder;
+			nodes[node].size = size;
+			insert_free_node(remainder);
+		}
+
+		nodes[node].b_used = true;
+		used_size += size;
+		++allocation_count;
+
+		return { .offset = nodes[node].offset, .size = size, .node = node };
+	}
+
+	void GeometryHeapAllocator::free(const GeometryHeapAllocation& allocation)
+	{
+		if (!allocation.is_valid())
+		{
+			return;
+		}
+
+		uint32_t node = allocation.node;
+		assert(node < nodes.size() && nodes[node].b_used && "Freeing a geometry heap allocation that is not live");
+
+		nodes[node].b_used = false;
+		used_size -= nodes[node].size;
+		--allocation_count;
+
+		// Merge with free neighbors so free space never sits in two adjacent regions
+		const uint32_t prev = nodes[node].neighbor_prev;
+		if (prev != GEOMETRY_HEAP_INVALID_NODE && !nodes[prev].b_used)
+		{
+			remove_free_node(prev);
+			nodes[prev].size += nodes[node].size;
+			nodes[prev].neighbor_next = nodes[node].neighbor_next;
+			if (nodes[node].neighbor_next != GEOMETRY_HEAP_INVALID_NODE)
+			{
+				nodes[nodes[node].neighbor_next].neighbor_prev = prev;
+			}
+			release_node(node);
+			node = prev;
+		}
+
+		const uint32_t next = nodes[node].neighbor_next;
+		if (next != GEOMETRY_HEAP_INVALID_NODE && !nodes[next].b_used)
+		{
+			remove_free_node(next);
+			nodes[node].size += nodes[next].size;
+			nodes[node].neighbor_next = nodes[next].neighbor_next;
+			if (nodes[next].neighbor_next != GEOMETRY_HEAP_INVALID_NODE)
+			{
+				nodes[nodes[next].neighbor_next].neighbor_prev = node;
+			}
+			release_node(next);
+		}
+
+		insert_free_node(node);
+	}
+
+	void GeometryHeapAllocator::defragment(std::vector<GeometryHeapMove>& out_moves)
+	{
+		ZoneScopedN("GeometryHeapAllocator::defragment");
+
+		out_moves.clear();
+
+		// Without free space there are no gaps to close
+		if (free_region_count == 0)
+		{
+			return;
+		}
+
+		uint32_t packed_offset{ 0 };
+		uint32_t last_used_node{ GEOMETRY_HEAP_INVALID_NODE };
+		uint32_t new_first_node{ GEOMETRY_HEAP_INVALID_NODE };
+
+		uint32_t node = first_node;
+		while (node != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			const uint32_t next = nodes[node].neighbor_next;
+
+			if (nodes[node].b_used)
+			{
+				if (nodes[node].offset != packed_offset)
+				{
+					out_moves.push_back({ .node = node, .src_offset = nodes[node].offset, .dst_offset = packed_offset, .size = nodes[node].size });
+					nodes[node].offset = packed_offset;
+				}
+
+				nodes[node].neighbor_prev = last_used_node;
+				if (last_used_node != GEOMETRY_HEAP_INVALID_NODE)
+				{
+					nodes[last_used_node].neighbor_next = node;
+				}
+				else
+				{
+					new_first_node = node;
+				}
+
+				last_used_node = node;
+				packed_offset += nodes[node].size;
+			}
+			else
+			{
+				remove_free_node(node);
+				release_node(node);
+			}
+
+			node = next;
+		}
+
+		// Everything past the packed allocations becomes a single free region
+		const uint32_t free_node = new_node(packed_offset, capacity - packed_offset);
+		nodes[free_node].neighbor_prev = last_used_node;
+		if (last_used_node != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			nodes[last_used_node].neighbor_next = free_node;
+		}
+		else
+		{
+			new_first_node = free_node;
+		}
+		insert_free_node(free_node);
+
+		first_node = new_first_node;
+	}
+
+	GeometryHeapStats GeometryHeapAllocator::get_stats() const
+	{
+		GeometryHeapStats stats
+		{
+			.capacity = capacity,
+			.used_size = used_size,
+			.allocation_count = allocation_count,
+			.free_region_count = free_region_count
+		};
+
+		// The largest region is in the highest non-empty bin, but regions in a bin can differ in size
+		if (first_level_mask != 0)
+		{
+			const uint32_t first_level = 31 - std::countl_zero(first_level_mask);
+			const uint32_t second_level = 31 - std::countl_zero(static_cast<uint32_t>(second_level_masks[first_level]));
+			for (uint32_t node = bin_heads[first_level * SECOND_LEVEL_COUNT + second_level]; node != GEOMETRY_HEAP_INVALID_NODE; node = nodes[node].bin_next)
+			{
+				stats.largest_free_region = std::max(stats.largest_free_region, nodes[node].size);
+			}
+		}
+
+		return stats;
+	}
+
+	uint32_t GeometryHeapAllocator::size_to_bin_round_down(uint32_t size)
+	{
+		// Small sizes get a bin each, larger ones are split into SECOND_LEVEL_COUNT bins per power of two
+		if (size < SECOND_LEVEL_COUNT)
+		{
+			return size;
+		}
+
+		const uint32_t shift = (31 - std::countl_zero(size)) - SECOND_LEVEL_BITS;
+		const uint32_t mantissa = (size >> shift) & (SECOND_LEVEL_COUNT - 1);
+		return ((shift + 1) << SECOND_LEVEL_BITS) | mantissa;
+	}
+
+	uint32_t GeometryHeapAllocator::size_to_bin_round_up(uint32_t size)
+	{
+		const uint32_t bin = size_to_bin_round_down(size);
+		return bin_to_size(bin) < size ? bin + 1 : bin;
+	}
+
+	uint32_t GeometryHeapAllocator::bin_to_size(uint32_t bin)
+	{
+		if (bin < SECOND_LEVEL_COUNT)
+		{
+			return bin;
+		}
+
+		const uint32_t shift = (bin >> SECOND_LEVEL_BITS) - 1;
+		const uint32_t mantissa = bin & (SECOND_LEVEL_COUNT - 1);
+		return (SECOND_LEVEL_COUNT | mantissa) << shift;
+	}
+
+	uint32_t GeometryHeapAllocator::new_node(uint32_t offset, uint32_t size)
+	{
+		uint32_t node;
+		if (!free_nodes.empty())
+		{
+			node = free_nodes.back();
+			free_nodes.pop_back();
+			nodes[node] = Node{};
+		}
+		else
+		{
+			node = static_cast<uint32_t>(nodes.size());
+			nodes.emplace_back();
+		}
+
+		nodes[node].offset = offset;
+		nodes[node].size = size;
+		return node;
+	}
+
+	void GeometryHeapAllocator::release_node(uint32_t node)
+	{
+		free_nodes.push_back(node);
+	}
+
+	void GeometryHeapAllocator::insert_free_node(uint32_t node)
+	{
+		const uint32_t bin = size_to_bin_round_down(nodes[node].size);
+
+		nodes[node].bin_prev = GEOMETRY_HEAP_INVALID_NODE;
+		nodes[node].bin_next = bin_heads[bin];
+		if (bin_heads[bin] != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			nodes[bin_heads[bin]].bin_prev = node;
+		}
+		bin_heads[bin] = node;
+
+		const uint32_t first_level = bin >> SECOND_LEVEL_BITS;
+		second_level_masks[first_level] |= 1 << (bin & (SECOND_LEVEL_COUNT - 1));
+		first_level_mask |= 1u << first_level;
+
+		++free_region_count;
+	}
+
+	void GeometryHeapAllocator::remove_free_node(uint32_t node)
+	{
+		const uint32_t bin = size_to_bin_round_down(nodes[node].size);
+
+		if (nodes[node].bin_prev != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			nodes[nodes[node].bin_prev].bin_next = nodes[node].bin_next;
+		}
+		else
+		{
+			bin_heads[bin] = nodes[node].bin_next;
+		}
+
+		if (nodes[node].bin_next != GEOMETRY_HEAP_INVALID_NODE)
+		{
+			nodes[nodes[node].bin_next].bin_prev = nodes[node].bin_prev;
+		}
+
+		nodes[node].bin_prev = GEOMETRY_HEAP_INVALID_NODE;
+		nodes[node].bin_next = GEOMETRY_HEAP_INVALID_NODE;
+
+		if (bin_heads[bin] == GEOMETRY_HEAP_INVALID_NODE)
+		{
+			const uint32_t first_level = bin >> SECOND_LEVEL_BITS;
+			second_level_masks[first_level] &= ~(1 << (bin & (SECOND_LEVEL_COUNT - 1)));
+			if (second_level_masks[first_level] == 0)
+			{
+				first_level_mask &= ~(1u << first_level);
+			}
+		}
+
+		--free_region_count;
+	}
+
+	uint32_t GeometryHeapAllocator::find_free_bin(uint32_t min_bin) const
+	{
+		uint32_t first_level = min_bin >> SECOND_LEVEL_BITS;
+
+		const uint32_t second_level_mask = second_level_masks[first_level] & (~0u << (min_bin & (SECOND_LEVEL_COUNT - 1)));
+		if (second_level_mask != 0)
+		{
+			return first_level * SECOND_LEVEL_COUNT + std::countr_zero(second_level_mask);
+		}
+
+		// Nothing left at this level, so the smallest bin of the next non-empty level fits
+		const uint32_t first_level_candidates = first_level + 1 < 32 ? first_level_mask & (~0u << (first_level + 1)) : 0;
+		if (first_level_candidates == 0)
+		{
+			return GEOMETRY_HEAP_INVALID_NODE;
+		}
+
+		first_level = std::countr_zero(first_level_candidates);
+		return first_level * SECOND_LEVEL_COUNT + std::countr_zero(static_cast<uint32_t>(second_level_masks[first_level]));
+	}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <minimal.h>
+
+namespace Sunset
+{
+	constexpr uint32_t GEOMETRY_HEAP_INVALID_NODE = ~0u;
+
+	// Offsets and sizes are in elements (vertices or indices), so they can be used as draw offsets directly
+	struct GeometryHeapAllocation
+	{
+		uint32_t offset{ 0 };
+		uint32_t size{ 0 };
+		uint32_t node{ GEOMETRY_HEAP_INVALID_NODE };
+
+		bool is_valid() const
+		{
+			return node != GEOMETRY_HEAP_INVALID_NODE;
+		}
+	};
+
+	// Relocation of a live allocation done by GeometryHeapAllocator::defragment
+	struct GeometryHeapMove
+	{
+		uint32_t node{ GEOMETRY_HEAP_INVALID_NODE };
+		uint32_t src_offset{ 0 };
+		uint32_t dst_offset{ 0 };
+		uint32_t size{ 0 };
+	};
+
+	struct GeometryHeapStats
+	{
+		uint32_t capacity{ 0 };
+		uint32_t used_size{ 0 };
+		uint32_t allocation_count{ 0 };
+		uint32_t free_region_count{ 0 };
+		uint32_t largest_free_region{ 0 };
+
+		uint32_t get_free_size() const
+		{
+			return capacity - used_size;
+		}
+
+		// 0 when all free space is in one region, approaching 1 as it gets split into more and smaller regions
+		float get_fragmentation() const
+		{
+			const uint32_t free_size = get_free_size();
+			return free_size > 0 ? 1.0f - static_cast<float>(largest_free_region) / static_cast<float>(free_size) : 0.0f;
+		}
+	};
+
+	// Two level segregated fit (TLSF) offset allocator over a fixed range. Free regions are kept in size class bins
+	// with a bitmask per level, so allocating and freeing are constant time. Freed regions are merged with their free
+	// neighbors straight away, and defragment packs every live allocation to the start of the range.
+	class GeometryHeapAllocator
+	{
+	public:
+		static constexpr uint32_t SECOND_LEVEL_BITS = 3;
+		static constexpr uint32_t SECOND_LEVEL_COUNT = 1 << SECOND_LEVEL_BITS;
+		static constexpr uint32_t FIRST_LEVEL_COUNT = 32 - SECOND_LEVEL_BITS + 1;
+		static constexpr uint32_t BIN_COUNT = FIRST_LEVEL_COUNT * SECOND_LEVEL_COUNT;
+
+		explicit GeometryHeapAllocator(uint32_t capacity = 0);
+		~GeometryHeapAllocator() = default;
+
+		// Forgets every allocation
+		void reset(uint32_t new_capacity);
+
+		// Returns an invalid allocation if no free region can fit the size
+		GeometryHeapAllocation allocate(uint32_t size);
+		void free(const GeometryHeapAllocation& allocation);
+
+		// Packs live allocations to the start of the range in offset order, so all free space ends up in one region at the
+		// end. Moves are in ascending destination order and never move an allocation to a higher offset, so they can be
+		// copied in order within the same buffer as long as overlapping ranges are handled.
+		void defragment(std::vector<GeometryHeapMove>& out_moves);
+
+		// Current offset of an allocation, which changes when the allocator is defragmented
+		uint32_t get_offset(uint32_t node) const
+		{
+			return nodes[node].offset;
+		}
+
+		uint32_t get_capacity() const
+		{
+			return capacity;
+		}
+
+		uint32_t get_used_size() const
+		{
+			return used_size;
+		}
+
+		GeometryHeapStats get_stats() const;
+
+		// Size class bin a free region of this size is stored in
+		static uint32_t size_to_bin_round_down(uint32_t size);
+		// Lowest bin whose regions are all at least this size
+		static uint32_t size_to_bin_round_up(uint32_t size);
+		// Smallest region size stored in a bin
+		static uint32_t bin_to_size(uint32_t bin);
+
+	protected:
+		struct Node
+		{
+			uint32_t offset{ 0 };
+			uint32_t size{ 0 };
+			// Free regions in the same bin
+			uint32_t bin_prev{ GEOMETRY_HEAP_INVALID_NODE };
+			uint32_t bin_next{ GEOMETRY_HEAP_INVALID_NODE };
+			// Regions right before and after this one in the range
+			uint32_t neighbor_prev{ GEOMETRY_HEAP_INVALID_NODE };
+			uint32_t neighbor_next{ GEOMETRY_HEAP_INVALID_NODE };
+			bool b_used{ false };
+		};
+
+		uint32_t new_node(uint32_t offset, uint32_t size);
+		void release_node(uint32_t node);
+		void insert_free_node(uint32_t node);
+		void remove_free_node(uint32_t node);
+		uint32_t find_free_bin(uint32_t min_bin) const;
+
+	protected:
+		uint32_t capacity{ 0 };
+		uint32_t used_size{ 0 };
+		uint32_t allocation_count{ 0 };
+		uint32_t free_region_count{ 0 };
+		// Node at the start of the range
+		uint32_t first_node{ GEOMETRY_HEAP_INVALID_NODE };
+		uint32_t first_level_mask{ 0 };
+		uint8_t second_level_masks[FIRST_LEVEL_COUNT]{ 0 };
+		uint32_t bin_heads[BIN_COUNT];
+		std::vector<Node> nodes;
+		std::vector<uint32_t> free_nodes;
+	};
+}
@@ -0,0 +1,93 @@
+#include <graphics/gpu_shared_data_types.h>
+#include <utility/cvar.h>
+
+#include <bit>
+
+namespace Sunset
+{
+	AutoCVar_Int cvar_gpu_shared_data_merge_gap("ren.gpu_shared_data.merge_gap", "Clean elements allowed between two dirty ranges of GPU shared data before they are uploaded as separate copies", 8);
+
+	GPUSharedDataDirtyState::GPUSharedDataDirtyState(uint32_t element_count)
+		: element_count(element_count)
+	{
+		const uint32_t word_count = (element_count + 63) / 64;
+		for (uint32_t i = 0; i < MAX_BUFFERED_FRAMES; ++i)
+		{
+			dirty_words[i].resize(word_count, 0);
+			dirty_word_begin[i] = word_count;
+			dirty_word_end[i] = 0;
+		}
+	}
+
+	void GPUSharedDataDirtyState::mark_dirty(uint32_t index)
+	{
+		for (uint32_t i = 0; i < MAX_BUFFERED_FRAMES; ++i)
+		{
+			mark_dirty(index, i);
+		}
+	}
+
+	void GPUSharedDataDirtyState::mark_dirty(uint32_t index, uint32_t buffered_frame)
+	{
+		assert(index < element_count && "Cannot mark out of bounds shared data as dirty");
+		const uint32_t word = index / 64;
+		dirty_words[buffered_frame][word] |= uint64_t(1) << (index % 64);
+		dirty_word_begin[buffered_frame] = std::min(dirty_word_begin[buffered_frame], word);
+		dirty_word_end[buffered_frame] = std::max(dirty_word_end[buffered_frame], word + 1);
+	}
+
+	void GPUSharedDataDirtyState::mark_all_dirty()
+	{
+		for (uint32_t index = 0; index < element_count; ++index)
+		{
+			mark_dirty(index);
+		}
+	}
+
+	bool GPUSharedDataDirtyState::is_dirty(uint32_t index, uint32_t buffered_frame) const
+	{
+		assert(index < element_count && "Cannot query out of bounds shared data");
+		return (dirty_words[buffered_frame][index / 64] >> (index % 64)) & 1;
+	}
+
+	void GPUSharedDataDirtyState::consume_dirty_ranges(uint32_t buffered_frame, uint32_t merge_gap, std::vector<GPUSharedDataRange>& out_ranges)
+	{
+		ZoneScopedN("GPUSharedDataDirtyState::consume_dirty_ranges");
+
+		out_ranges.clear();
+
+		std::vector<uint64_t>& words = dirty_words[buffered_frame];
+		for (uint32_t word_index = dirty_word_begin[buffered_frame]; word_index < dirty_word_end[buffered_frame]; ++word_index)
+		{
+			uint64_t word = words[word_index];
+			while (word != 0)
+			{
+				// Take the whole run of set bits at once rather than one element at a time
+				const uint32_t bit = std::countr_zero(word);
+				const uint32_t run = std::countr_one(word >> bit);
+				const uint32_t first = word_index * 64 + bit;
+
+				if (!out_ranges.empty() && first - (out_ranges.back().first + out_ranges.back().count) <= merge_gap)
+				{
+					out_ranges.back().count = first + run - out_ranges.back().first;
+				}
+				else
+				{
+					out_ranges.push_back({ .first = first, .count = run });
+				}
+
+				const uint64_t run_mask = run == 64 ? ~uint64_t(0) : ((uint64_t(1) << run) - 1) << bit;
+				word &= ~run_mask;
+			}
+			words[word_index] = 0;
+		}
+
+		dirty_word_begin[buffered_frame] = static_cast<uint32_t>(words.size());
+		dirty_word_end[buffered_frame] = 0;
+	}
+
+	uint32_t gpu_shared_data_upload_merge_gap()
+	{
+		return static_cast<uint32_t>(std::max(cvar_gpu_shared_data_merge_gap.get(), 0));
+	}
+}
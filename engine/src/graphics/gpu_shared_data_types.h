@@ -7,17 +7,109 @@
 // GPU visible buffers at any given time
 namespace Sunset
 {
+	struct GPUSharedDataRange
+	{
+		uint32_t first{ 0 };
+		uint32_t count{ 0 };
+	};
+
+	struct GPUSharedDataUploadStats
+	{
+		uint32_t range_count{ 0 };
+		size_t uploaded_bytes{ 0 };
+	};
+
+	// Tracks which shared data elements were written since each buffered frame's buffer last received them.
+	// Dirty bits are kept per frame, so a write made while one frame uploads still reaches the other frames' buffers.
+	class GPUSharedDataDirtyState
+	{
+	public:
+		explicit GPUSharedDataDirtyState(uint32_t element_count);
+		~GPUSharedDataDirtyState() = default;
+
+		// Marks the element dirty in every buffered frame
+		void mark_dirty(uint32_t index);
+		void mark_dirty(uint32_t index, uint32_t buffered_frame);
+		void mark_all_dirty();
+
+		bool is_dirty(uint32_t index, uint32_t buffered_frame) const;
+
+		// Coalesces the frame's dirty elements into contiguous ranges and clears them. Ranges separated by
+		// merge_gap clean elements or fewer are joined, trading a few redundant bytes for fewer copies.
+		void consume_dirty_ranges(uint32_t buffered_frame, uint32_t merge_gap, std::vector<GPUSharedDataRange>& out_ranges);
+
+	protected:
+		uint32_t element_count{ 0 };
+		std::vector<uint64_t> dirty_words[MAX_BUFFERED_FRAMES];
+		// Dirty word bounds, so a few scattered writes don't scan every word
+		uint32_t dirty_word_begin[MAX_BUFFERED_FRAMES];
+		uint32_t dirty_word_end[MAX_BUFFERED_FRAMES];
+	};
+
+	// Clean elements allowed between two dirty ranges before they are uploaded separately
+	uint32_t gpu_shared_data_upload_merge_gap();
+
+	// Copies each range of elements to the same offset in the buffer, under a single buffer mapping
+	template<class BufferType>
+	GPUSharedDataUploadStats upload_gpu_shared_data_ranges(class GraphicsContext* const gfx_context, BufferType* buffer, const char* data, size_t element_size, const std::vector<GPUSharedDataRange>& ranges)
+	{
+		GPUSharedDataUploadStats stats;
+		if (ranges.empty())
+		{
+			return stats;
+		}
+
+		buffer->copy_from(gfx_context, nullptr, 0, 0, [data, element_size, &ranges](void* mapped_memory)
+		{
+			char* const mapped_bytes = static_cast<char*>(mapped_memory);
+			for (const GPUSharedDataRange& range : ranges)
+			{
+				std::copy_n(data + range.first * element_size, range.count * element_size, mapped_bytes + range.first * element_size);
+			}
+		});
+
+		for (const GPUSharedDataRange& range : ranges)
+		{
+			stats.uploaded_bytes += range.count * element_size;
+		}
+		stats.range_count = static_cast<uint32_t>(ranges.size());
+
+		return stats;
+	}
+
 	template<class DataType, int SharedDataCount = 512>
 	struct GPUSharedData
 	{
 		BufferID data_buffer[MAX_BUFFERED_FRAMES];
 		FreeListArray<DataType> data{ SharedDataCount };
+		GPUSharedDataDirtyState dirty_state{ SharedDataCount };
+		GPUSharedDataUploadStats upload_stats[MAX_BUFFERED_FRAMES];
+		std::vector<GPUSharedDataRange> upload_ranges;
 
 		DataType& operator[](uint32_t index)
 		{
 			return data[index];
 		}
+
+		void mark_dirty(uint32_t index)
+		{
+			dirty_state.mark_dirty(index);
+		}
+
+		void mark_dirty(uint32_t index, uint32_t buffered_frame)
+		{
+			dirty_state.mark_dirty(index, buffered_frame);
+		}
+
+		// Uploads the elements written since this frame's buffer was last uploaded
+		template<class BufferType>
+		GPUSharedDataUploadStats upload(class GraphicsContext* const gfx_context, BufferType* buffer, uint32_t buffered_frame, uint32_t merge_gap = gpu_shared_data_upload_merge_gap())
+		{
+			dirty_state.consume_dirty_ranges(buffered_frame, merge_gap, upload_ranges);
+			upload_stats[buffered_frame] = upload_gpu_shared_data_ranges(gfx_context, buffer, reinterpret_cast<const char*>(data.data()), sizeof(DataType), upload_ranges);
+			return upload_stats[buffered_frame];
+		}
 	};
 
 	#define DECLARE_GPU_SHARED_DATA(Type, Count) using Type##Shared = GPUSharedData<Type, Count>
-}
\ No newline at end of file
+}
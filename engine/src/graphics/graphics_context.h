@@ -37,9 +37,9 @@ namespace Sunset
 				graphics_policy.draw(buffer, vertex_count, instance_count, instance_index);
 			}
 
-			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0)
+			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0, uint32_t first_index = 0, int32_t vertex_offset = 0)
 			{
-				graphics_policy.draw_indexed(buffer, index_count, instance_count, instance_index);
+				graphics_policy.draw_indexed(buffer, index_count, instance_count, instance_index, first_index, vertex_offset);
 			}
 
 			void draw_indexed_indirect(void* buffer, class Buffer* indirect_buffer, uint32_t draw_count, uint32_t draw_first = 0)
@@ -137,9 +137,9 @@ namespace Sunset
 				return graphics_policy.get_min_ubo_offset_alignment();
 			}
 
-			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance)
+			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, int32_t vertex_offset, uint32_t instance_count, uint32_t first_instance)
 			{
-				graphics_policy.update_indirect_draw_command(commands, command_index, index_count, first_index, instance_count, first_instance);
+				graphics_policy.update_indirect_draw_command(commands, command_index, index_count, first_index, vertex_offset, instance_count, first_instance);
 			}
 
 			ShaderLayoutID derive_layout_for_shader_stages(class GraphicsContext* const gfx_context, const std::vector<PipelineShaderStage>& stages, std::vector<DescriptorLayoutID>& out_descriptor_layouts)
@@ -172,7 +172,7 @@ namespace Sunset
 			void draw(void* buffer, uint32_t vertex_count, uint32_t instance_count, uint32_t instance_index = 0)
 			{ }
 
-			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0)
+			void draw_indexed(void* buffer, uint32_t index_count, uint32_t instance_count, uint32_t instance_index = 0, uint32_t first_index = 0, int32_t vertex_offset = 0)
 			{ }
 
 			void draw_indexed_indirect(void* buffer, class Buffer* indirect_buffer, uint32_t draw_count, uint32_t draw_first = 0)
@@ -247,7 +247,7 @@ namespace Sunset
 				return 0;
 			}
 
-			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance)
+			void update_indirect_draw_command(void* commands, uint32_t command_index, uint32_t index_count, uint32_t first_index, int32_t vertex_offset, uint32_t instance_count, uint32_t first_instance)
 			{ }
 
 			ShaderLayoutID derive_layout_for_shader_stages(class GraphicsContext* const gfx_context, const std::vector<PipelineShaderStage>& stages, std::vector<DescriptorLayoutID>& out_descriptor_layouts)
@@ -0,0 +1,245 @@
+#include <graphics/mesh_draw_list.h>
+
+namespace Sunset
+{
+	void MeshDrawList::begin_frame()
+	{
+		std::fill(entity_states.begin(), entity_states.end(), EntityState::Absent);
+	}
+
+	bool MeshDrawList::is_entity_current(EntityID entity, uint32_t revision) const
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		return entity_index < entity_draws.size()
+			&& entity_draws[entity_index].entity == entity
+			&& entity_draws[entity_index].revision == revision;
+	}
+
+	void MeshDrawList::set_entity_draws(EntityID entity, uint32_t revision, const MeshDrawDesc* new_draws, uint32_t draw_count)
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		if (entity_index >= entity_draws.size())
+		{
+			entity_draws.resize(entity_index + 1);
+			entity_states.resize(entity_index + 1, EntityState::Absent);
+		}
+
+		EntityDraws& owned_draws = entity_draws[entity_index];
+		if (owned_draws.slot_count != draw_count)
+		{
+			if (owned_draws.slot_count > 0)
+			{
+				release_slots(owned_draws.first_slot, owned_draws.slot_count);
+			}
+			owned_draws.first_slot = draw_count > 0 ? allocate_slots(draw_count) : 0;
+			owned_draws.slot_count = draw_count;
+		}
+
+		for (uint32_t i = 0; i < draw_count; ++i)
+		{
+			const uint32_t slot = owned_draws.first_slot + i;
+			MeshRenderTask& draw = draws[slot];
+			draw.setup(new_draws[i].material, new_draws[i].resource_state, 0)
+				->set_entity(entity_index)
+				->set_material_index(new_draws[i].material_index);
+			draw.sort_key = make_sort_key(draw, b_keys_material_agnostic);
+			mark_slot_dirty(slot);
+		}
+
+		owned_draws.entity = entity;
+		owned_draws.revision = revision;
+		patched_draw_count += draw_count;
+	}
+
+	void MeshDrawList::remove_entity_draws(EntityID entity)
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		if (entity_index >= entity_draws.size() || entity_draws[entity_index].entity != entity)
+		{
+			return;
+		}
+
+		EntityDraws& owned_draws = entity_draws[entity_index];
+		if (owned_draws.slot_count > 0)
+		{
+			release_slots(owned_draws.first_slot, owned_draws.slot_count);
+		}
+		owned_draws = EntityDraws();
+	}
+
+	void MeshDrawList::set_entity_visible(EntityID entity, bool b_visible)
+	{
+		const EntityIndex entity_index = get_entity_index(entity);
+		assert(entity_index < entity_states.size() && "Cannot set visibility of an entity without draws");
+		entity_states[entity_index] = b_visible ? EntityState::Visible : EntityState::Culled;
+	}
+
+	void MeshDrawList::submit(MeshTaskQueue& queue, bool b_material_agnostic)
+	{
+		ZoneScopedN("MeshDrawList::submit");
+
+		// Entities that weren't reported this frame were destroyed or lost their mesh component
+		for (EntityIndex entity_index = 0; entity_index < entity_draws.size(); ++entity_index)
+		{
+			if (entity_states[entity_index] == EntityState::Absent && entity_draws[entity_index].entity != INVALID_ENTITY)
+			{
+				remove_entity_draws(entity_draws[entity_index].entity);
+			}
+		}
+
+		update_sorted_slots(b_material_agnostic);
+
+		for (const uint32_t slot : sorted_slots)
+		{
+			MeshRenderTask& draw = draws[slot];
+			if (entity_states[draw.entity] == EntityState::Visible)
+			{
+				queue.add(&draw);
+			}
+		}
+
+		queue.set_presorted(b_material_agnostic);
+
+		stats.patched_draw_count = patched_draw_count;
+		patched_draw_count = 0;
+	}
+
+	void MeshDrawList::clear()
+	{
+		draws.clear();
+		slot_states.clear();
+		free_spans.clear();
+		entity_draws.clear();
+		entity_states.clear();
+		sorted_slots.clear();
+		dirty_slots.clear();
+		b_slots_released = false;
+		sort_key_ranks = MeshSortKeyRanks();
+		live_draw_count = 0;
+		patched_draw_count = 0;
+		stats = MeshDrawListStats();
+	}
+
+	uint32_t MeshDrawList::allocate_slots(uint32_t count)
+	{
+		live_draw_count += count;
+
+		std::vector<uint32_t>& free_list = free_spans[count];
+		if (!free_list.empty())
+		{
+			const uint32_t first_slot = free_list.back();
+			free_list.pop_back();
+			return first_slot;
+		}
+
+		const uint32_t first_slot = static_cast<uint32_t>(draws.size());
+		draws.resize(draws.size() + count);
+		slot_states.resize(slot_states.size() + count, SlotState::Free);
+		return first_slot;
+	}
+
+	void MeshDrawList::release_slots(uint32_t first_slot, uint32_t count)
+	{
+		std::fill_n(slot_states.begin() + first_slot, count, SlotState::Free);
+		free_spans[count].push_back(first_slot);
+		live_draw_count -= count;
+		b_slots_released = true;
+	}
+
+	void MeshDrawList::mark_slot_dirty(uint32_t slot)
+	{
+		if (slot_states[slot] != SlotState::Dirty)
+		{
+			slot_states[slot] = SlotState::Dirty;
+			dirty_slots.push_back(slot);
+		}
+	}
+
+	void MeshDrawList::update_sorted_slots(bool b_material_agnostic)
+	{
+		stats.b_resorted = false;
+
+		if (b_material_agnostic != b_keys_material_agnostic)
+		{
+			// The rank order flips with the batching mode, so every key has to be repacked
+			b_keys_material_agnostic = b_material_agnostic;
+			rekey_live_draws();
+		}
+		else if (should_rebuild_sort_key_ranks())
+		{
+			// Ids of released draws keep their ranks, so drop them once they pile up
+			sort_key_ranks = MeshSortKeyRanks();
+			rekey_live_draws();
+		}
+
+		if (dirty_slots.empty() && !b_slots_released)
+		{
+			return;
+		}
+
+		ZoneScopedN("MeshDrawList::update_sorted_slots");
+
+		stats.b_resorted = true;
+
+		// Drop the old positions of rewritten and released draws
+		std::erase_if(sorted_slots, [this](uint32_t slot)
+		{
+			return slot_states[slot] != SlotState::Live;
+		});
+
+		// A slot can be rewritten, released and handed out again before a submit, so dedupe and skip released ones
+		std::sort(dirty_slots.begin(), dirty_slots.end());
+		dirty_slots.erase(std::unique(dirty_slots.begin(), dirty_slots.end()), dirty_slots.end());
+		std::erase_if(dirty_slots, [this](uint32_t slot)
+		{
+			return slot_states[slot] == SlotState::Free;
+		});
+
+		const auto slot_order = [this](uint32_t first, uint32_t second)
+		{
+			return std::tie(draws[first].sort_key, first) < std::tie(draws[second].sort_key, second);
+		};
+
+		std::sort(dirty_slots.begin(), dirty_slots.end(), slot_order);
+
+		merge_scratch.resize(sorted_slots.size() + dirty_slots.size());
+		std::merge(sorted_slots.begin(), sorted_slots.end(), dirty_slots.begin(), dirty_slots.end(), merge_scratch.begin(), slot_order);
+		sorted_slots.swap(merge_scratch);
+
+		for (const uint32_t slot : dirty_slots)
+		{
+			slot_states[slot] = SlotState::Live;
+		}
+		dirty_slots.clear();
+		b_slots_released = false;
+	}
+
+	void MeshDrawList::rekey_live_draws()
+	{
+		for (uint32_t slot = 0; slot < draws.size(); ++slot)
+		{
+			if (slot_states[slot] != SlotState::Free)
+			{
+				draws[slot].sort_key = make_sort_key(draws[slot], b_keys_material_agnostic);
+				mark_slot_dirty(slot);
+			}
+		}
+	}
+
+	bool MeshDrawList::should_rebuild_sort_key_ranks() const
+	{
+		// Each live draw holds at most one rank in each map, so a rebuild frees at least the slack and its cost is
+		// paid for by the new ids that had to be ranked since the last one
+		const size_t max_rank_count = live_draw_count + MESH_DRAW_LIST_RANK_SLACK;
+		return sort_key_ranks.resource_states.size() > max_rank_count || sort_key_ranks.materials.size() > max_rank_count;
+	}
+
+	uint64_t MeshDrawList::make_sort_key(const MeshRenderTask& draw, bool b_material_agnostic)
+	{
+		return MeshSortKey::pack(
+			sort_key_ranks.get_resource_state_rank(draw.resource_state),
+			sort_key_ranks.get_material_rank(draw.material),
+			b_material_agnostic
+		);
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <minimal.h>
+#include <graphics/mesh_render_task.h>
+#include <graphics/mesh_task_queue.h>
+
+namespace Sunset
+{
+	// Ranked ids allowed beyond the live draw count before the ranks are rebuilt from the live draws
+	constexpr size_t MESH_DRAW_LIST_RANK_SLACK = 1024;
+
+	struct MeshDrawDesc
+	{
+		MaterialID material{ 0 };
+		uint32_t material_index{ 0 };
+		ResourceStateID resource_state{ 0 };
+	};
+
+	struct MeshDrawListStats
+	{
+		// Draws rewritten since the last submit
+		uint32_t patched_draw_count{ 0 };
+		// Whether the sorted order had to be touched at all during the last submit
+		bool b_resorted{ false };
+	};
+
+	// Retained render tasks for mesh entities, kept in sort key order across frames. Entities only rewrite their
+	// draws when their revision changes, and changed draws are merged back into the sorted order on submit,
+	// so a static scene costs a visibility filtered walk over the draws each frame.
+	class MeshDrawList
+	{
+	public:
+		enum class EntityState : uint8_t
+		{
+			// Not reported since begin_frame, its draws get dropped on submit
+			Absent,
+			Culled,
+			Visible
+		};
+
+		MeshDrawList() = default;
+		~MeshDrawList() = default;
+
+		// Marks every entity absent until it is reported again with set_entity_visible
+		void begin_frame();
+
+		bool is_entity_current(EntityID entity, uint32_t revision) const;
+		// Replaces every draw owned by the entity, one per mesh section
+		void set_entity_draws(EntityID entity, uint32_t revision, const MeshDrawDesc* draws, uint32_t draw_count);
+		void remove_entity_draws(EntityID entity);
+		void set_entity_visible(EntityID entity, bool b_visible);
+
+		// Drops draws of absent entities, merges changed draws back into the sorted order and
+		// adds the draws of visible entities to the queue in that order
+		void submit(MeshTaskQueue& queue, bool b_material_agnostic);
+
+		void clear();
+
+		size_t size() const
+		{
+			return live_draw_count;
+		}
+
+		const MeshDrawListStats& get_stats() const
+		{
+			return stats;
+		}
+
+		const std::vector<uint32_t>& get_sorted_slots() const
+		{
+			return sorted_slots;
+		}
+
+		const MeshRenderTask& get_draw(uint32_t slot) const
+		{
+			return draws[slot];
+		}
+
+		const MeshSortKeyRanks& get_sort_key_ranks() const
+		{
+			return sort_key_ranks;
+		}
+
+	protected:
+		enum class SlotState : uint8_t
+		{
+			Free,
+			Live,
+			// Rewritten since the last submit and waiting to be merged into the sorted order
+			Dirty
+		};
+
+		struct EntityDraws
+		{
+			EntityID entity{ INVALID_ENTITY };
+			uint32_t revision{ 0 };
+			uint32_t first_slot{ 0 };
+			uint32_t slot_count{ 0 };
+		};
+
+		uint32_t allocate_slots(uint32_t count);
+		void release_slots(uint32_t first_slot, uint32_t count);
+		void mark_slot_dirty(uint32_t slot);
+		void update_sorted_slots(bool b_material_agnostic);
+		void rekey_live_draws();
+		bool should_rebuild_sort_key_ranks() const;
+		uint64_t make_sort_key(const MeshRenderTask& draw, bool b_material_agnostic);
+
+	protected:
+		std::vector<MeshRenderTask> draws;
+		std::vector<SlotState> slot_states;
+		// Released slot spans bucketed by their size, since entities rarely change section count
+		phmap::flat_hash_map<uint32_t, std::vector<uint32_t>> free_spans;
+
+		std::vector<EntityDraws> entity_draws;
+		std::vector<EntityState> entity_states;
+
+		std::vector<uint32_t> sorted_slots;
+		std::vector<uint32_t> dirty_slots;
+		std::vector<uint32_t> merge_scratch;
+		bool b_slots_released{ false };
+
+		MeshSortKeyRanks sort_key_ranks;
+		bool b_keys_material_agnostic{ true };
+		size_t live_draw_count{ 0 };
+		uint32_t patched_draw_count{ 0 };
+		MeshDrawListStats stats;
+	};
+}
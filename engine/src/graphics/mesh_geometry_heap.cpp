@@ -0,0 +1,179 @@
+#include <graphics/mesh_geometry_heap.h>
+#include <graphics/graphics_context.h>
+#include <graphics/renderer.h>
+#include <graphics/resource/buffer.h>
+#include <graphics/resource/mesh.h>
+
+namespace Sunset
+{
+	void MeshGeometryHeap::initialize(class GraphicsContext* const gfx_context, uint32_t vertex_capacity, uint32_t index_capacity)
+	{
+		vertex_allocator.reset(vertex_capacity);
+		index_allocator.reset(index_capacity);
+
+		vertex_buffer = BufferFactory::create(
+			gfx_context,
+			{
+				.name = "mesh_geometry_heap_vertex",
+				.buffer_size = static_cast<size_t>(vertex_capacity) * sizeof(Vertex),
+				.type = BufferType::Vertex | BufferType::TransferDestination,
+				.memory_usage = MemoryUsageType::OnlyGPU
+			},
+			false
+		);
+
+		index_buffer = BufferFactory::create(
+			gfx_context,
+			{
+				.name = "mesh_geometry_heap_index",
+				.buffer_size = static_cast<size_t>(index_capacity) * sizeof(uint32_t),
+				.type = BufferType::Index | BufferType::TransferDestination,
+				.memory_usage = MemoryUsageType::OnlyGPU
+			},
+			false
+		);
+	}
+
+	void MeshGeometryHeap::destroy(class GraphicsContext* const gfx_context)
+	{
+		std::scoped_lock lock(mutex);
+
+		retired_allocations.clear();
+
+		if (vertex_buffer != 0)
+		{
+			CACHE_DELETE(Buffer, vertex_buffer, gfx_context);
+			vertex_buffer = 0;
+		}
+
+		if (index_buffer != 0)
+		{
+			CACHE_DELETE(Buffer, index_buffer, gfx_context);
+			index_buffer = 0;
+		}
+
+		vertex_allocator.reset(0);
+		index_allocator.reset(0);
+	}
+
+	void MeshGeometryHeap::begin_frame(uint64_t completed_fence_value)
+	{
+		std::scoped_lock lock(mutex);
+
+		std::erase_if(retired_allocations, [this, completed_fence_value](const RetiredAllocation& retired)
+		{
+			if (retired.fence_value > completed_fence_value)
+			{
+				return false;
+			}
+			(retired.b_index ? index_allocator : vertex_allocator).free(retired.allocation);
+			return true;
+		});
+	}
+
+	void MeshGeometryHeap::end_frame(uint64_t fence_value)
+	{
+		std::scoped_lock lock(mutex);
+
+		for (RetiredAllocation& retired : retired_allocations)
+		{
+			retired.fence_value = std::min(retired.fence_value, fence_value);
+		}
+	}
+
+	GeometryHeapAllocation MeshGeometryHeap::upload_vertices(class GraphicsContext* const gfx_context, const Vertex* vertices, uint32_t vertex_count)
+	{
+		GeometryHeapAllocation allocation;
+		{
+			std::scoped_lock lock(mutex);
+			allocation = vertex_allocator.allocate(vertex_count);
+		}
+
+		if (allocation.is_valid())
+		{
+			upload(gfx_context, vertex_buffer, vertices, static_cast<size_t>(vertex_count) * sizeof(Vertex), static_cast<size_t>(allocation.offset) * sizeof(Vertex));
+		}
+
+		return allocation;
+	}
+
+	GeometryHeapAllocation MeshGeometryHeap::upload_indices(class GraphicsContext* const gfx_context, const uint32_t* indices, uint32_t index_count)
+	{
+		GeometryHeapAllocation allocation;
+		{
+			std::scoped_lock lock(mutex);
+			allocation = index_allocator.allocate(index_count);
+		}
+
+		if (allocation.is_valid())
+		{
+			upload(gfx_context, index_buffer, indices, static_cast<size_t>(index_count) * sizeof(uint32_t), static_cast<size_t>(allocation.offset) * sizeof(uint32_t));
+		}
+
+		return allocation;
+	}
+
+	void MeshGeometryHeap::free_vertices(const GeometryHeapAllocation& allocation)
+	{
+		if (allocation.is_valid())
+		{
+			std::scoped_lock lock(mutex);
+			retired_allocations.push_back({ .allocation = allocation, .b_index = false });
+		}
+	}
+
+	void MeshGeometryHeap::free_indices(const GeometryHeapAllocation& allocation)
+	{
+		if (allocation.is_valid())
+		{
+			std::scoped_lock lock(mutex);
+			retired_allocations.push_back({ .allocation = allocation, .b_index = true });
+		}
+	}
+
+	GeometryHeapStats MeshGeometryHeap::get_vertex_stats()
+	{
+		std::scoped_lock lock(mutex);
+		return vertex_allocator.get_stats();
+	}
+
+	GeometryHeapStats MeshGeometryHeap::get_index_stats()
+	{
+		std::scoped_lock lock(mutex);
+		return index_allocator.get_stats();
+	}
+
+	void MeshGeometryHeap::upload(class GraphicsContext* const gfx_context, BufferID buffer, const void* data, size_t data_size, size_t buffer_offset)
+	{
+		Identity staging_buffer_name("mesh_geometry_heap_staging");
+		{
+			std::scoped_lock lock(mutex);
+			staging_buffer_name.computed_hash += ++upload_count;
+		}
+
+		const BufferID staging_buffer_id = BufferFactory::create(
+			gfx_context,
+			{
+				.name = staging_buffer_name,
+				.buffer_size = data_size,
+				.type = BufferType::TransferSource,
+				.memory_usage = MemoryUsageType::OnlyCPU
+			},
+			false
+		);
+		Buffer* const staging_buffer = CACHE_FETCH(Buffer, staging_buffer_id);
+
+		staging_buffer->copy_from(gfx_context, const_cast<void*>(data), data_size);
+
+		Renderer::get()->get_upload_scheduler().enqueue(
+			[buffer, gfx_context, staging_buffer, data_size, buffer_offset](void* command_buffer)
+			{
+				CACHE_FETCH(Buffer, buffer)->copy_buffer(gfx_context, command_buffer, staging_buffer, data_size, buffer_offset);
+			},
+			[gfx_context, staging_buffer_id]()
+			{
+				CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
+			}
+		);
+	}
+}
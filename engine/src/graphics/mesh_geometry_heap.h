@@ -0,0 +1,71 @@
+#pragma once
+
+#include <minimal.h>
+#include <graphics/geometry_heap_allocator.h>
+
+#include <mutex>
+
+namespace Sunset
+{
+	constexpr uint32_t MESH_GEOMETRY_HEAP_VERTEX_CAPACITY = 1024 * 1024;
+	constexpr uint32_t MESH_GEOMETRY_HEAP_INDEX_CAPACITY = 4 * 1024 * 1024;
+
+	// Shared vertex and index buffers that meshes are suballocated from, so draws of different meshes only differ in
+	// their first index and vertex offset and can go out without rebinding buffers. Freed ranges are held until the
+	// frames that may still draw from them are done on the GPU.
+	class MeshGeometryHeap
+	{
+	public:
+		MeshGeometryHeap() = default;
+		~MeshGeometryHeap() = default;
+
+		void initialize(class GraphicsContext* const gfx_context, uint32_t vertex_capacity = MESH_GEOMETRY_HEAP_VERTEX_CAPACITY, uint32_t index_capacity = MESH_GEOMETRY_HEAP_INDEX_CAPACITY);
+		void destroy(class GraphicsContext* const gfx_context);
+
+		// Frees ranges released before the frame guarded by completed_fence_value, which the caller must have waited on
+		void begin_frame(uint64_t completed_fence_value);
+		void end_frame(uint64_t fence_value);
+
+		// Copies the data into the heap with the next upload batch. Returns an invalid allocation if the heap has no room,
+		// in which case the caller should fall back to a dedicated buffer.
+		GeometryHeapAllocation upload_vertices(class GraphicsContext* const gfx_context, const struct Vertex* vertices, uint32_t vertex_count);
+		GeometryHeapAllocation upload_indices(class GraphicsContext* const gfx_context, const uint32_t* indices, uint32_t index_count);
+
+		void free_vertices(const GeometryHeapAllocation& allocation);
+		void free_indices(const GeometryHeapAllocation& allocation);
+
+		BufferID get_vertex_buffer() const
+		{
+			return vertex_buffer;
+		}
+
+		BufferID get_index_buffer() const
+		{
+			return index_buffer;
+		}
+
+		GeometryHeapStats get_vertex_stats();
+		GeometryHeapStats get_index_stats();
+
+	protected:
+		struct RetiredAllocation
+		{
+			GeometryHeapAllocation allocation;
+			bool b_index{ false };
+			// Set when the frame that freed the allocation ends
+			uint64_t fence_value{ std::numeric_limits<uint64_t>::max() };
+		};
+
+		void upload(class GraphicsContext* const gfx_context, BufferID buffer, const void* data, size_t data_size, size_t buffer_offset);
+
+	protected:
+		std::mutex mutex;
+		GeometryHeapAllocator vertex_allocator;
+		GeometryHeapAllocator index_allocator;
+		BufferID vertex_buffer{ 0 };
+		BufferID index_buffer{ 0 };
+		std::vector<RetiredAllocation> retired_allocations;
+		// Keeps staging buffer names unique while their uploads are in flight
+		uint64_t upload_count{ 0 };
+	};
+}
@@ -24,7 +24,8 @@ namespace Sunset
 
 	void MeshRenderTaskExecutor::reset()
 	{
-		cached_material = 0;
 		cached_resource_state = 0;
+		cached_vertex_buffer = 0;
+		cached_index_buffer = 0;
 	}
 }
@@ -7,7 +7,6 @@
 #include <graphics/descriptor_types.h>
 #include <graphics/pipeline_types.h>
 #include <graphics/mesh_task_queue.h>
-#include <memory/allocators/stack_allocator.h>
 
 namespace Sunset
 {
@@ -44,10 +43,10 @@ namespace Sunset
 		uint32_t material_index{ 0 };
 		ResourceStateID resource_state{ 0 };
 		uint32_t render_depth{ 0 };
+		// Filled in by MeshTaskQueue::assign_sort_keys, see MeshSortKey
+		uint64_t sort_key{ 0 };
 		PushConstantPipelineData push_constants;
 	};
-
-	using MeshRenderTaskFrameAllocator = StaticFrameAllocator<MeshRenderTask, 65536>;
 }
 
 
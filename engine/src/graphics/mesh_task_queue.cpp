@@ -1,35 +1,54 @@
 #include <graphics/mesh_task_queue.h>
 #include <graphics/renderer.h>
 #include <graphics/graphics_context.h>
+#include <graphics/descriptor.h>
 #include <graphics/resource/buffer.h>
 #include <graphics/resource/mesh.h>
 #include <graphics/pipeline_state.h>
 #include <graphics/resource_state.h>
 #include <graphics/mesh_render_task.h>
+#include <graphics/command_recording_planner.h>
 #include <utility/cvar.h>
 
 namespace Sunset
 {
 	AutoCVar_Bool cvar_enable_debug_bounds_draw("ren.enable_debug_bounds_draw", "Whether or not to draw mesh object bounds", false);
+	AutoCVar_Bool cvar_material_agnostic_batching("ren.material_agnostic_batching", "Whether or not mesh draws sharing a resource state are batched together regardless of material. Instances select their material in the shader.", true);
 
 	void MeshTaskQueue::sort_and_batch(class GraphicsContext* const gfx_context)
 	{
-		std::sort(queue.begin(), queue.end(), [](MeshRenderTask* const first, MeshRenderTask* const second) -> bool
+		const bool b_material_agnostic = use_material_agnostic_batching();
+
+		// Sort by resource state (i.e. vertex buffer) and material, ordered by whether material changes split batches.
+		// Tasks with equal keys keep their submission order
+		if (!b_presorted || b_presorted_material_agnostic != b_material_agnostic)
 		{
-			// Sort by pipeline state first (i.e. pipeline settings, blending modes, shaders, etc.)
-			// then sort by resource state (i.e. vertex buffer)
-			// then sort by world z-depth to minimize overdraw
-			return first->material < second->material ||
-				(first->material == second->material && first->resource_state < second->resource_state) ||
-				(first->resource_state == second->resource_state && first->render_depth < second->render_depth);
-		});
-
-		indirect_draw_data.indirect_draws = batch_indirect_draws(gfx_context);
+			ZoneScopedN("MeshTaskQueue::sort_and_batch: sort");
+
+			assign_sort_keys(queue, b_material_agnostic);
+
+			sort_items.resize(queue.size());
+			for (uint32_t i = 0; i < queue.size(); ++i)
+			{
+				sort_items[i] = { .key = queue[i]->sort_key, .index = i };
+			}
+
+			RadixSort::sort_parallel(sort_items, sort_scratch);
+
+			sorted_queue.resize(queue.size());
+			for (uint32_t i = 0; i < sort_items.size(); ++i)
+			{
+				sorted_queue[i] = queue[sort_items[i].index];
+			}
+			queue.swap(sorted_queue);
+		}
+
+		indirect_draw_data.indirect_draws = batch_indirect_draws(gfx_context, b_material_agnostic);
 	}
 
-	void MeshTaskQueue::submit_compute_cull(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number, ExecutionQueue* deletion_queue)
+	void MeshTaskQueue::submit_compute_cull(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number)
 	{
-		update_indirect_draw_buffers(gfx_context, command_buffer, buffered_frame_number, deletion_queue);
+		update_indirect_draw_buffers(gfx_context, command_buffer, buffered_frame_number);
 
 		gfx_context->dispatch_compute(command_buffer, static_cast<uint32_t>(queue.size() + 255) / 256, 1, 1);
 
@@ -48,50 +67,94 @@ namespace Sunset
 
 	void MeshTaskQueue::submit_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, DescriptorSet* descriptor_set, PipelineStateID pipeline_state, int32_t buffered_frame_number, bool b_use_draw_push_constants /*= true*/, bool b_flush /*= true*/)
 	{
-		for (uint32_t i = 0; i < indirect_draw_data.indirect_draws.size(); ++i)
+		prepare_draws(gfx_context, render_pass, descriptor_set, buffered_frame_number);
+
+		record_draws(gfx_context, command_buffer, render_pass, pipeline_state, buffered_frame_number, b_use_draw_push_constants);
+
+		if (b_flush)
+		{
+			flush();
+		}
+	}
+
+	void MeshTaskQueue::prepare_draws(class GraphicsContext* const gfx_context, RenderPassID render_pass, DescriptorSet* descriptor_set, int32_t buffered_frame_number)
+	{
+		// Batches can span several materials, so every queued material is brought up to date before any draws
+		if (descriptor_set != nullptr)
+		{
+			// Materials only queue writes for textures that changed since they were last updated for this frame, and all of them go out in one update
+			DescriptorWriteBatch descriptor_writes;
+			for (const MaterialID material : queued_materials)
+			{
+				material_update(gfx_context, material, descriptor_set, buffered_frame_number, descriptor_writes);
+			}
+			descriptor_writes.flush(gfx_context);
+			material_upload_dirty_data(gfx_context, buffered_frame_number);
+		}
+
+		if (cvar_enable_debug_bounds_draw.get())
+		{
+			setup_bounds_debug_draws(gfx_context, render_pass);
+		}
+	}
+
+	void MeshTaskQueue::record_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, PipelineStateID pipeline_state, int32_t buffered_frame_number, bool b_use_draw_push_constants, uint32_t chunk, uint32_t chunk_count) const
+	{
+		const CommandRecordingChunkRange batch_range = get_command_recording_chunk_range(static_cast<uint32_t>(indirect_draw_data.indirect_draws.size()), chunk, chunk_count);
+
+		Buffer* const draw_indirect_buffer = CACHE_FETCH(Buffer, indirect_draw_buffers.draw_indirect_buffer);
+
+		// Each chunk records into its own command buffer, which starts out with nothing bound
+		MeshRenderTaskExecutor draw_executor;
+		for (uint32_t i = batch_range.begin; i < batch_range.end; ++i)
 		{
-			IndirectDrawBatch& draw = indirect_draw_data.indirect_draws[i];
+			const IndirectDrawBatch& draw = indirect_draw_data.indirect_draws[i];
 
 			draw_executor(
 				gfx_context,
 				command_buffer,
 				render_pass,
-				descriptor_set,
 				draw,
 				i,
-				CACHE_FETCH(Buffer, indirect_draw_buffers.draw_indirect_buffer),
+				draw_indirect_buffer,
 				pipeline_state,
 				buffered_frame_number,
 				b_use_draw_push_constants ? draw.push_constants : PushConstantPipelineData()
 			);
 		}
 
-		if (cvar_enable_debug_bounds_draw.get())
+		// Bounds are drawn over the whole queue, so only the last chunk records them
+		if (cvar_enable_debug_bounds_draw.get() && chunk == chunk_count - 1)
 		{
-			submit_bounds_debug_draws(gfx_context, command_buffer, render_pass, buffered_frame_number);
+			record_bounds_debug_draws(gfx_context, command_buffer, render_pass, buffered_frame_number);
 		}
+	}
 
-		if (b_flush)
-		{
-			queue.clear();
-			draw_executor.reset();
-		}
+	void MeshTaskQueue::flush()
+	{
+		queue.clear();
+		queued_materials.clear();
+		b_presorted = false;
 	}
 
-	void MeshTaskQueue::submit_bounds_debug_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, int32_t buffered_frame_number)
+	void MeshTaskQueue::setup_bounds_debug_draws(class GraphicsContext* const gfx_context, RenderPassID render_pass)
 	{
-		static MeshID sphere_mesh_id = MeshFactory::create_sphere(gfx_context, glm::ivec2(8, 8), 1.0f);
-		Mesh* const sphere_mesh = CACHE_FETCH(Mesh, sphere_mesh_id);
-
-		static ResourceStateID sphere_resource_state = ResourceStateBuilder::create()
-			.set_vertex_buffer(sphere_mesh->vertex_buffer)
-			.set_index_buffer(sphere_mesh->sections[0].index_buffer)
-			.set_vertex_count(sphere_mesh->vertices.size())
-			.set_index_count(sphere_mesh->sections[0].indices.size())
-			.finish();
-
-		static PipelineStateID pipeline_state;
-		if (pipeline_state == 0)
+		if (bounds_debug_resource_state == 0)
+		{
+			const MeshID sphere_mesh_id = MeshFactory::create_sphere(gfx_context, glm::ivec2(8, 8), 1.0f);
+			Mesh* const sphere_mesh = CACHE_FETCH(Mesh, sphere_mesh_id);
+
+			bounds_debug_resource_state = ResourceStateBuilder::create()
+				.set_vertex_buffer(sphere_mesh->vertex_buffer)
+				.set_index_buffer(sphere_mesh->sections[0].index_buffer)
+				.set_index_start(sphere_mesh->sections[0].index_allocation.offset)
+				.set_vertex_offset(sphere_mesh->vertex_allocation.offset)
+				.set_vertex_count(sphere_mesh->vertices.size())
+				.set_index_count(sphere_mesh->sections[0].indices.size())
+				.finish();
+		}
+
+		if (bounds_debug_pipeline_state == 0)
 		{
 			PipelineGraphicsStateBuilder state_builder = PipelineGraphicsStateBuilder::create_default(gfx_context->get_surface_resolution())
 				.clear_shader_stages()
@@ -115,68 +178,149 @@ namespace Sunset
 				state_builder.derive_shader_layout(descriptor_layouts);
 			}
 
-			pipeline_state = state_builder.finish();
+			bounds_debug_pipeline_state = state_builder.finish();
 		}
+	}
 
-		CACHE_FETCH(PipelineState, pipeline_state)->bind(gfx_context, command_buffer);
+	void MeshTaskQueue::record_bounds_debug_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, int32_t buffered_frame_number) const
+	{
+		PipelineState* const bounds_pipeline_state = CACHE_FETCH(PipelineState, bounds_debug_pipeline_state);
+		if (bounds_pipeline_state == nullptr || !bounds_pipeline_state->is_ready())
+		{
+			return;
+		}
+
+		bounds_pipeline_state->bind(gfx_context, command_buffer);
 
+		Buffer* const draw_indirect_buffer = CACHE_FETCH(Buffer, indirect_draw_buffers.draw_indirect_buffer);
+
+		MeshRenderTaskExecutor draw_executor;
 		for (uint32_t i = 0; i < indirect_draw_data.indirect_draws.size(); ++i)
 		{
-			IndirectDrawBatch& draw = indirect_draw_data.indirect_draws[i];
-
-			draw.resource_state = sphere_resource_state;
+			// Other chunks may still be reading the queue's batches, so the sphere is swapped in on a copy
+			IndirectDrawBatch draw = indirect_draw_data.indirect_draws[i];
+			draw.resource_state = bounds_debug_resource_state;
 
 			draw_executor(
 				gfx_context,
 				command_buffer,
 				render_pass,
-				nullptr,
 				draw,
 				i,
-				CACHE_FETCH(Buffer, indirect_draw_buffers.draw_indirect_buffer),
-				pipeline_state,
+				draw_indirect_buffer,
+				bounds_debug_pipeline_state,
 				buffered_frame_number
 			);
 		}
 	}
 
-	std::vector<Sunset::IndirectDrawBatch> MeshTaskQueue::batch_indirect_draws(class GraphicsContext* const gfx_context)
+	std::vector<Sunset::IndirectDrawBatch> MeshTaskQueue::batch_indirect_draws(class GraphicsContext* const gfx_context, bool b_material_agnostic)
 	{
 		std::vector<IndirectDrawBatch> indirect_draws;
 
-		for (int i = 0; i < queue.size(); ++i)
+		batch_tasks(queue, b_material_agnostic, indirect_draws, batching_stats);
+
+		// Indirect draw data buffers are recreated each frame so lets force this refresh for now
+		indirect_draw_data.b_needs_refresh = !queue.empty();
+
+		for (IndirectDrawBatch& draw_batch : indirect_draws)
+		{
+			ResourceState* const resource_state = CACHE_FETCH(ResourceState, draw_batch.resource_state);
+			draw_batch.section_index_count = resource_state->state_data.index_count;
+			draw_batch.section_index_start = resource_state->state_data.index_start;
+			draw_batch.section_vertex_offset = resource_state->state_data.vertex_offset;
+		}
+
+		queued_materials.clear();
+		for (MeshRenderTask* const task : queue)
+		{
+			queued_materials.push_back(task->material);
+		}
+		std::sort(queued_materials.begin(), queued_materials.end());
+		queued_materials.erase(std::unique(queued_materials.begin(), queued_materials.end()), queued_materials.end());
+
+		return indirect_draws;
+	}
+
+	bool MeshTaskQueue::use_material_agnostic_batching()
+	{
+		return cvar_material_agnostic_batching.get();
+	}
+
+	void MeshTaskQueue::assign_sort_keys(const std::vector<MeshRenderTask*>& tasks, bool b_material_agnostic)
+	{
+		MeshSortKeyRanks ranks;
+
+		// Tasks for the same mesh tend to be submitted back to back, so reuse the previous task's ranks before hashing
+		ResourceStateID last_resource_state{ 0 };
+		MaterialID last_material{ 0 };
+		uint32_t resource_state_rank{ 0 };
+		uint32_t material_rank{ 0 };
+
+		for (uint32_t i = 0; i < tasks.size(); ++i)
 		{
-			MeshRenderTask* const task = queue[i];
+			MeshRenderTask* const task = tasks[i];
 
-			// Indirect draw data buffers are recreated each frame so lets force this refresh for now
-			indirect_draw_data.b_needs_refresh = true;
+			if (i == 0 || task->resource_state != last_resource_state)
+			{
+				resource_state_rank = ranks.get_resource_state_rank(task->resource_state);
+				last_resource_state = task->resource_state;
+			}
 
-			const bool b_same_resource = !indirect_draws.empty() && task->resource_state == indirect_draws.back().resource_state;
-			const bool b_same_material = !indirect_draws.empty() && task->material == indirect_draws.back().material;
+			if (i == 0 || task->material != last_material)
+			{
+				material_rank = ranks.get_material_rank(task->material);
+				last_material = task->material;
+			}
 
-			if (b_same_resource && b_same_material)
+			task->sort_key = MeshSortKey::pack(resource_state_rank, material_rank, b_material_agnostic);
+		}
+	}
+
+	void MeshTaskQueue::batch_tasks(const std::vector<MeshRenderTask*>& tasks, bool b_material_agnostic, std::vector<IndirectDrawBatch>& out_batches, MeshBatchingStats& out_stats)
+	{
+		out_batches.clear();
+		out_stats = MeshBatchingStats{ .task_count = static_cast<uint32_t>(tasks.size()) };
+
+		const uint32_t batch_shift = MeshSortKey::batch_shift(b_material_agnostic);
+
+		for (uint32_t i = 0; i < tasks.size(); ++i)
+		{
+			MeshRenderTask* const task = tasks[i];
+
+			// The key is made of both ranks regardless of their order
+			const uint64_t previous_key = i > 0 ? tasks[i - 1]->sort_key : 0;
+			const bool b_same_material_batch = i > 0 && task->sort_key == previous_key;
+			const bool b_same_batch = i > 0 && (task->sort_key >> batch_shift) == (previous_key >> batch_shift);
+
+			if (!b_same_material_batch)
+			{
+				++out_stats.material_batch_count;
+			}
+
+			if (b_same_batch)
 			{
-				indirect_draws.back().count++;
+				out_batches.back().count++;
 			}
 			else
 			{
-				ResourceState* const resource_state = CACHE_FETCH(ResourceState, task->resource_state);
-
-				IndirectDrawBatch& new_draw_batch = indirect_draws.emplace_back();
+				IndirectDrawBatch& new_draw_batch = out_batches.emplace_back();
 				new_draw_batch.resource_state = task->resource_state;
+				// With material agnostic batching this is only the first instance's material, instances carry their own
 				new_draw_batch.material = task->material;
 				new_draw_batch.push_constants = task->push_constants;
 				new_draw_batch.first = i;
 				new_draw_batch.count = 1;
-				new_draw_batch.section_index_count = resource_state->state_data.index_count;
+				new_draw_batch.section_index_count = 0;
 				new_draw_batch.section_index_start = 0;
+				new_draw_batch.section_vertex_offset = 0;
 			}
 		}
 
-		return indirect_draws;
+		out_stats.batch_count = static_cast<uint32_t>(out_batches.size());
 	}
 
-	void MeshTaskQueue::update_indirect_draw_buffers(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number, ExecutionQueue* deletion_queue)
+	void MeshTaskQueue::update_indirect_draw_buffers(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number)
 	{
 		// This refresh check is unnecessary given that we are now recreating these buffers each frame in order to (hopefully) alias some memory
 		// later on as part of each render graph run, but leaving them here in case we decide to make these buffers persistent in the future
@@ -194,6 +338,7 @@ namespace Sunset
 						i,
 						indirect_draw_data.indirect_draws[i].section_index_count,
 						indirect_draw_data.indirect_draws[i].section_index_start,
+						indirect_draw_data.indirect_draws[i].section_vertex_offset,
 						0,
 						indirect_draw_data.indirect_draws[i].first
 					);
@@ -211,30 +356,11 @@ namespace Sunset
 
 			// Re-upload object instance buffer data to GPU
 			{
-				const BufferID staging_buffer = BufferFactory::create(
-					gfx_context,
-					{
-						.name = "staging_object_instance_buffer" + buffered_frame_number,
-						.buffer_size = queue.size() * sizeof(GPUObjectInstance),
-						.type = BufferType::TransferSource | BufferType::StorageBuffer,
-						.memory_usage = MemoryUsageType::CPUToGPU
-					},
-					false
-				);
-				
-				if (deletion_queue != nullptr)
-				{
-					deletion_queue->push_execution([gfx_context, staging_buffer]()
-						{
-							CACHE_DELETE(Buffer, staging_buffer, gfx_context);
-						}
-					);
-				}
+				const size_t object_data_size = queue.size() * sizeof(GPUObjectInstance);
+				const UploadAllocation staging = Renderer::get()->get_upload_ring().allocate(gfx_context, object_data_size, alignof(GPUObjectInstance));
 
 				{
-					ScopedGPUBufferMapping scoped_mapping(gfx_context, CACHE_FETCH(Buffer, staging_buffer));
-
-					GPUObjectInstance* object_data = static_cast<GPUObjectInstance*>((void*)scoped_mapping.mapped_memory);
+					GPUObjectInstance* object_data = reinterpret_cast<GPUObjectInstance*>(staging.memory);
 
 					int32_t object_data_idx = 0;
 					for (int i = 0; i < indirect_draw_data.indirect_draws.size(); ++i)
@@ -252,7 +378,7 @@ namespace Sunset
 
 				Buffer* const object_instance_buffer = CACHE_FETCH(Buffer, indirect_draw_buffers.object_instance_buffer);
 
-				object_instance_buffer->copy_buffer(gfx_context, command_buffer, CACHE_FETCH(Buffer, staging_buffer), queue.size() * sizeof(GPUObjectInstance));
+				object_instance_buffer->copy_buffer(gfx_context, command_buffer, staging.buffer, object_data_size, 0, staging.offset);
 
 				object_instance_buffer->barrier(
 					gfx_context,
@@ -281,29 +407,27 @@ namespace Sunset
 		// TODO: Given that most of our resources will go through descriptors, this resource state will likely get deprecated.
 		// Only using it to store vertex buffer info at the moment, but this can be moved to a global merged vertex descriptor buffer
 		// that we can index from the vertex shader using some push constant object ID.
-		if (cached_resource_state != resource_state)
-		{
-			CACHE_FETCH(ResourceState, resource_state)->bind(gfx_context, command_buffer);
-			cached_resource_state = resource_state;
-		}
+		bind_resource_state(gfx_context, command_buffer, resource_state);
 
 		if (push_constants.data != nullptr)
 		{
 			gfx_context->push_constants(command_buffer, pipeline_state, push_constants);
 		}
 
+		const ResourceStateData& state_data = CACHE_FETCH(ResourceState, resource_state)->state_data;
 		gfx_context->draw_indexed(
 			command_buffer,
-			static_cast<uint32_t>(CACHE_FETCH(ResourceState, resource_state)->state_data.index_count),
+			static_cast<uint32_t>(state_data.index_count),
 			instance_count,
-			0);
+			0,
+			state_data.index_start,
+			state_data.vertex_offset);
 	}
 
 	void MeshRenderTaskExecutor::operator()(
 		class GraphicsContext* const gfx_context,
 		void* command_buffer,
 		RenderPassID render_pass,
-		DescriptorSet* descriptor_set,
 		const IndirectDrawBatch& indirect_draw,
 		uint32_t indirect_draw_index,
 		class Buffer* indirect_buffer,
@@ -311,24 +435,10 @@ namespace Sunset
 		int32_t buffered_frame_number,
 		const PushConstantPipelineData& push_constants)
 	{
-		if (cached_material != indirect_draw.material)
-		{
-			cached_material = indirect_draw.material;
-		}
-
-		if (descriptor_set != nullptr)
-		{
-			material_update(gfx_context, cached_material, descriptor_set, buffered_frame_number);
-		}
-
 		// TODO: Given that most of our resources will go through descriptors, this resource state will likely get deprecated.
 		// Only using it to store vertex buffer info at the moment, but this can be moved to a global merged vertex descriptor buffer
 		// that we can index from the vertex shader using some push constant object ID.
-		if (cached_resource_state != indirect_draw.resource_state)
-		{
-			CACHE_FETCH(ResourceState, indirect_draw.resource_state)->bind(gfx_context, command_buffer);
-			cached_resource_state = indirect_draw.resource_state;
-		}
+		bind_resource_state(gfx_context, command_buffer, indirect_draw.resource_state);
 
 		if (push_constants.is_valid())
 		{
@@ -343,6 +453,24 @@ namespace Sunset
 		);
 	}
 
+	void MeshRenderTaskExecutor::bind_resource_state(class GraphicsContext* const gfx_context, void* command_buffer, ResourceStateID resource_state)
+	{
+		if (cached_resource_state == resource_state)
+		{
+			return;
+		}
+
+		ResourceState* const state = CACHE_FETCH(ResourceState, resource_state);
+		if (state->state_data.vertex_buffer != cached_vertex_buffer || state->state_data.index_buffer != cached_index_buffer)
+		{
+			state->bind(gfx_context, command_buffer);
+			cached_vertex_buffer = state->state_data.vertex_buffer;
+			cached_index_buffer = state->state_data.index_buffer;
+		}
+
+		cached_resource_state = resource_state;
+	}
+
 	void MeshComputeCullTaskExecutor::operator()(
 		class GraphicsContext* const gfx_context,
 		void* command_buffer,
@@ -3,6 +3,7 @@
 #include <minimal.h>
 #include <graphics/resource/material.h>
 #include <graphics/renderer_types.h>
+#include <utility/radix_sort.h>
 
 namespace Sunset
 {
@@ -14,11 +15,16 @@ namespace Sunset
 
 		void reset();
 		void operator()(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, ResourceStateID resource_state, PipelineStateID pipeline_state, int32_t buffered_frame_number, uint32_t instance_count = 1, const PushConstantPipelineData& push_constants = {});
-		void operator()(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, DescriptorSet* descriptor_set, const IndirectDrawBatch& indirect_draw, uint32_t indirect_draw_index, class Buffer* indirect_buffer, PipelineStateID pipeline_state, int32_t buffered_frame_number, const PushConstantPipelineData& push_constants = {});
+		void operator()(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, const IndirectDrawBatch& indirect_draw, uint32_t indirect_draw_index, class Buffer* indirect_buffer, PipelineStateID pipeline_state, int32_t buffered_frame_number, const PushConstantPipelineData& push_constants = {});
+
+	private:
+		// Meshes in the geometry heap share their vertex and index buffers, so moving between their resource states needs no rebind
+		void bind_resource_state(class GraphicsContext* const gfx_context, void* command_buffer, ResourceStateID resource_state);
 
 	private:
-		MaterialID cached_material{ 0 };
 		ResourceStateID cached_resource_state{ 0 };
+		BufferID cached_vertex_buffer{ 0 };
+		BufferID cached_index_buffer{ 0 };
 	};
 
 	class MeshComputeCullTaskExecutor
@@ -30,6 +36,55 @@ namespace Sunset
 		void operator()(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, PipelineStateID pipeline_state, const PushConstantPipelineData& push_constants = {}, const std::vector<DescriptorLayoutID>& descriptor_layouts = {});
 	};
 
+	// Tasks in a queue share the pass pipeline, so a task's order is packed from its resource state and material ranks.
+	// With material agnostic batching the resource state rank occupies the top bits, otherwise the material rank does.
+	// Batches are runs of keys that match above batch_shift. View depth is left out since retained draws keep their
+	// sorted order across frames, and tasks with equal keys stay in submission order.
+	namespace MeshSortKey
+	{
+		constexpr uint32_t RANK_BITS = 32;
+		constexpr uint32_t MAX_RANK = std::numeric_limits<uint32_t>::max();
+
+		inline uint64_t pack(uint32_t resource_state_rank, uint32_t material_rank, bool b_material_agnostic)
+		{
+			const uint64_t high_rank = b_material_agnostic ? resource_state_rank : material_rank;
+			const uint64_t low_rank = b_material_agnostic ? material_rank : resource_state_rank;
+			return (high_rank << RANK_BITS) | low_rank;
+		}
+
+		inline uint32_t batch_shift(bool b_material_agnostic)
+		{
+			return b_material_agnostic ? RANK_BITS : 0;
+		}
+	}
+
+	// Dense ranks for resource state and material ids, handed out in the order the ids are first seen
+	struct MeshSortKeyRanks
+	{
+		phmap::flat_hash_map<ResourceStateID, uint32_t> resource_states;
+		phmap::flat_hash_map<MaterialID, uint32_t> materials;
+
+		uint32_t get_resource_state_rank(ResourceStateID resource_state)
+		{
+			assert(resource_states.size() <= MeshSortKey::MAX_RANK && "Too many unique resource states to pack into mesh sort keys");
+			return resource_states.try_emplace(resource_state, static_cast<uint32_t>(resource_states.size())).first->second;
+		}
+
+		uint32_t get_material_rank(MaterialID material)
+		{
+			assert(materials.size() <= MeshSortKey::MAX_RANK && "Too many unique materials to pack into mesh sort keys");
+			return materials.try_emplace(material, static_cast<uint32_t>(materials.size())).first->second;
+		}
+	};
+
+	struct MeshBatchingStats
+	{
+		uint32_t task_count{ 0 };
+		// Batches that would be needed if every material change split a batch
+		uint32_t material_batch_count{ 0 };
+		uint32_t batch_count{ 0 };
+	};
+
 	class MeshTaskQueue
 	{
 		public:
@@ -59,6 +114,14 @@ namespace Sunset
 				indirect_draw_data = data;
 			}
 
+			// Marks queued tasks as already in sort key order, with keys packed for the given batching mode,
+			// so sort_and_batch can skip straight to batching
+			void set_presorted(bool b_material_agnostic)
+			{
+				b_presorted = true;
+				b_presorted_material_agnostic = b_material_agnostic;
+			}
+
 			void set_is_deferred_rendering(bool b_is_deferred = true)
 			{
 				b_is_deferred_rendering = b_is_deferred;
@@ -89,21 +152,56 @@ namespace Sunset
 				return b_is_deferred_rendering;
 			}
 
+			const MeshBatchingStats& get_batching_stats() const
+			{
+				return batching_stats;
+			}
+
+			static bool use_material_agnostic_batching();
+
+			// Packs each task's sort key, ranking resource states and materials in the order they first appear
+			static void assign_sort_keys(const std::vector<class MeshRenderTask*>& tasks, bool b_material_agnostic);
+
+			// Groups runs of tasks sorted by their keys into indirect draw batches. Instances index their material from GPUObjectInstance,
+			// so with b_material_agnostic set only resource state changes start a new batch. Section index ranges are left
+			// for the caller to fill in from the batch resource states.
+			static void batch_tasks(const std::vector<class MeshRenderTask*>& tasks, bool b_material_agnostic, std::vector<IndirectDrawBatch>& out_batches, MeshBatchingStats& out_stats);
+
 			void sort_and_batch(class GraphicsContext* const gfx_context);
-			void submit_compute_cull(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number, ExecutionQueue* deletion_queue = nullptr);
+			void submit_compute_cull(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number);
+			// Prepares, records and optionally flushes the draws in one go, for passes recorded on a single thread
 			void submit_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, DescriptorSet* descriptor_set, PipelineStateID pipeline_state, int32_t buffered_frame_number, bool b_use_draw_push_constants = true, bool b_flush = true);
-			void submit_bounds_debug_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, int32_t buffered_frame_number);
+
+			// Brings every queued material up to date and creates the debug draw resources. Touches shared caches and upload
+			// memory, so it runs on the recording thread before any of the pass's draws are recorded.
+			void prepare_draws(class GraphicsContext* const gfx_context, RenderPassID render_pass, DescriptorSet* descriptor_set, int32_t buffered_frame_number);
+			// Records the indirect draws for one chunk of the queued batches. Only reads the queue, so chunks can be recorded
+			// on job threads at the same time once prepare_draws has run.
+			void record_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, PipelineStateID pipeline_state, int32_t buffered_frame_number, bool b_use_draw_push_constants = true, uint32_t chunk = 0, uint32_t chunk_count = 1) const;
+			// Clears the queued tasks once every pass that draws them has been recorded
+			void flush();
 
 		private:
-			std::vector<IndirectDrawBatch> batch_indirect_draws(class GraphicsContext* const gfx_context);
-			void update_indirect_draw_buffers(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number, ExecutionQueue* deletion_queue = nullptr);
+			std::vector<IndirectDrawBatch> batch_indirect_draws(class GraphicsContext* const gfx_context, bool b_material_agnostic);
+			void update_indirect_draw_buffers(class GraphicsContext* const gfx_context, void* command_buffer, int32_t buffered_frame_number);
+			void setup_bounds_debug_draws(class GraphicsContext* const gfx_context, RenderPassID render_pass);
+			void record_bounds_debug_draws(class GraphicsContext* const gfx_context, void* command_buffer, RenderPassID render_pass, int32_t buffered_frame_number) const;
 
 		private:
 			std::vector<class MeshRenderTask*> queue;
-			MeshRenderTaskExecutor draw_executor;
+			std::vector<class MeshRenderTask*> sorted_queue;
+			std::vector<SortKeyIndex> sort_items;
+			std::vector<SortKeyIndex> sort_scratch;
 			MeshRenderTaskExecutor compute_cull_executor;
+			ResourceStateID bounds_debug_resource_state{ 0 };
+			PipelineStateID bounds_debug_pipeline_state{ 0 };
 			IndirectDrawData indirect_draw_data{};
+			MeshBatchingStats batching_stats{};
+			// Unique materials referenced by the queued tasks, updated once per submit instead of once per batch
+			std::vector<MaterialID> queued_materials;
 			GPUDrawIndirectBuffers indirect_draw_buffers{};
 			bool b_is_deferred_rendering{ false };
+			bool b_presorted{ false };
+			bool b_presorted_material_agnostic{ false };
 	};
 }
@@ -0,0 +1,77 @@
+#include <graphics/pipeline_cache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace Sunset
+{
+	bool is_pipeline_cache_data_valid(const std::vector<char>& data, const PipelineCacheDeviceInfo& device_info)
+	{
+		if (data.size() < sizeof(PipelineCacheHeader))
+		{
+			return false;
+		}
+
+		PipelineCacheHeader header;
+		std::memcpy(&header, data.data(), sizeof(PipelineCacheHeader));
+
+		return header.header_size >= sizeof(PipelineCacheHeader)
+			&& header.header_size <= data.size()
+			&& header.header_version == PIPELINE_CACHE_HEADER_VERSION
+			&& header.vendor_id == device_info.vendor_id
+			&& header.device_id == device_info.device_id
+			&& std::memcmp(header.cache_uuid, device_info.cache_uuid, PIPELINE_CACHE_UUID_SIZE) == 0;
+	}
+
+	bool load_pipeline_cache_data(const std::string& path, const PipelineCacheDeviceInfo& device_info, std::vector<char>& out_data)
+	{
+		ZoneScopedN("load_pipeline_cache_data");
+
+		out_data.clear();
+
+		std::ifstream in_file(path, std::ios::ate | std::ios::binary);
+		if (!in_file.is_open())
+		{
+			return false;
+		}
+
+		const size_t file_size = static_cast<size_t>(in_file.tellg());
+
+		std::vector<char> data(file_size);
+		in_file.seekg(0);
+		in_file.read(data.data(), file_size);
+
+		if (!in_file || !is_pipeline_cache_data_valid(data, device_info))
+		{
+			return false;
+		}
+
+		out_data = std::move(data);
+		return true;
+	}
+
+	bool save_pipeline_cache_data(const std::string& path, const std::vector<char>& data)
+	{
+		ZoneScopedN("save_pipeline_cache_data");
+
+		// Written next to the old cache and swapped in, so a crash mid-write never leaves a truncated cache behind
+		const std::string temp_path = path + ".tmp";
+		{
+			std::ofstream out_file(temp_path, std::ios::binary | std::ios::out | std::ios::trunc);
+			if (!out_file.is_open())
+			{
+				return false;
+			}
+
+			out_file.write(data.data(), data.size());
+			if (!out_file)
+			{
+				return false;
+			}
+		}
+
+		std::remove(path.c_str());
+		return std::rename(temp_path.c_str(), path.c_str()) == 0;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <minimal.h>
+
+#include <string>
+
+namespace Sunset
+{
+	constexpr uint32_t PIPELINE_CACHE_UUID_SIZE = 16;
+	// Only header version the driver writes today (VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+	constexpr uint32_t PIPELINE_CACHE_HEADER_VERSION = 1;
+
+	// Layout of the header drivers write at the start of pipeline cache data
+	struct PipelineCacheHeader
+	{
+		uint32_t header_size{ 0 };
+		uint32_t header_version{ 0 };
+		uint32_t vendor_id{ 0 };
+		uint32_t device_id{ 0 };
+		uint8_t cache_uuid[PIPELINE_CACHE_UUID_SIZE];
+	};
+
+	// Identifies the device and driver that pipeline cache data was written by
+	struct PipelineCacheDeviceInfo
+	{
+		uint32_t vendor_id{ 0 };
+		uint32_t device_id{ 0 };
+		uint8_t cache_uuid[PIPELINE_CACHE_UUID_SIZE];
+	};
+
+	// Cache data written by a different device or driver version is ignored by the driver at best, so it is checked before being handed over
+	bool is_pipeline_cache_data_valid(const std::vector<char>& data, const PipelineCacheDeviceInfo& device_info);
+
+	// Returns false and leaves out_data empty if there is no cache file or it was not written for this device
+	bool load_pipeline_cache_data(const std::string& path, const PipelineCacheDeviceInfo& device_info, std::vector<char>& out_data);
+	bool save_pipeline_cache_data(const std::string& path, const std::vector<char>& data);
+}
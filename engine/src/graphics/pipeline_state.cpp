@@ -4,9 +4,12 @@
 #include <graphics/renderer.h>
 #include <window/window.h>
 #include <graphics/resource/mesh.h>
+#include <utility/cvar.h>
 
 namespace Sunset
 {
+	AutoCVar_Bool cvar_async_pipeline_creation("ren.async_pipeline_creation", "Whether or not new pipeline states are created on job threads. Draws using a pipeline state are skipped until it is ready.", true);
+
 
 	Sunset::PipelineGraphicsStateBuilder PipelineGraphicsStateBuilder::create()
 	{
@@ -174,7 +177,14 @@ namespace Sunset
 			new_pipeline_state->initialize(context, state_data);
 
 			RenderPass* const render_pass = CACHE_FETCH(RenderPass, state_data.render_pass);
-			new_pipeline_state->build(context, render_pass);
+			if (cvar_async_pipeline_creation.get())
+			{
+				new_pipeline_state->build_async(context, render_pass);
+			}
+			else
+			{
+				new_pipeline_state->build(context, render_pass);
+			}
 		}
 		return new_pipeline_state_id;
 	}
@@ -255,7 +265,14 @@ namespace Sunset
 		{
 			PipelineState* const new_pipeline_state = CACHE_FETCH(PipelineState, new_pipeline_state_id);
 			new_pipeline_state->initialize(context, state_data);
-			new_pipeline_state->build_compute(context, nullptr);
+			if (cvar_async_pipeline_creation.get())
+			{
+				new_pipeline_state->build_compute_async(context, nullptr);
+			}
+			else
+			{
+				new_pipeline_state->build_compute(context, nullptr);
+			}
 		}
 		return new_pipeline_state_id;
 	}
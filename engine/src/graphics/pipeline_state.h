@@ -6,6 +6,10 @@
 #include <graphics/resource/shader.h>
 #include <graphics/resource/shader_pipeline_layout.h>
 #include <graphics/resource/resource_cache.h>
+#include <job_system/job_scheduler.h>
+
+#include <atomic>
+#include <thread>
 
 namespace Sunset
 {
@@ -28,17 +32,52 @@ namespace Sunset
 
 		void destroy(class GraphicsContext* const gfx_context)
 		{
+			wait_for_build();
 			pipeline_state_policy.destroy(gfx_context, &state_data);
+			build_status.store(PipelineBuildStatus::Unbuilt, std::memory_order_relaxed);
 		}
 
 		void build(class GraphicsContext* const gfx_context, class RenderPass* render_pass)
 		{
-			pipeline_state_policy.build(gfx_context, &state_data, render_pass);
+			pipeline_state_policy.prepare_build(gfx_context, &state_data, render_pass);
+			create(gfx_context);
 		}
 
 		void build_compute(class GraphicsContext* const gfx_context, void* render_pass_data)
 		{
-			pipeline_state_policy.build_compute(gfx_context, &state_data, render_pass_data);
+			pipeline_state_policy.prepare_build_compute(gfx_context, &state_data, render_pass_data);
+			create(gfx_context);
+		}
+
+		// Creates the pipeline on a job thread. Cache lookups are done up front on the calling thread, so only the API pipeline creation runs on the job.
+		void build_async(class GraphicsContext* const gfx_context, class RenderPass* render_pass)
+		{
+			pipeline_state_policy.prepare_build(gfx_context, &state_data, render_pass);
+			create_async(gfx_context);
+		}
+
+		void build_compute_async(class GraphicsContext* const gfx_context, void* render_pass_data)
+		{
+			pipeline_state_policy.prepare_build_compute(gfx_context, &state_data, render_pass_data);
+			create_async(gfx_context);
+		}
+
+		PipelineBuildStatus get_build_status() const
+		{
+			return build_status.load(std::memory_order_acquire);
+		}
+
+		bool is_ready() const
+		{
+			return get_build_status() == PipelineBuildStatus::Ready;
+		}
+
+		void wait_for_build() const
+		{
+			while (get_build_status() == PipelineBuildStatus::Pending)
+			{
+				std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+			}
 		}
 
 		void bind(class GraphicsContext* const gfx_context, void* buffer)
@@ -145,9 +184,38 @@ namespace Sunset
 			state_data.compare_op = compare_op;
 		}
 
+	protected:
+		void create(class GraphicsContext* const gfx_context)
+		{
+			assert(get_build_status() != PipelineBuildStatus::Pending && "Cannot build a pipeline state while a previous build is still pending");
+			build_status.store(pipeline_state_policy.create(gfx_context, &state_data) ? PipelineBuildStatus::Ready : PipelineBuildStatus::Failed, std::memory_order_release);
+		}
+
+		void create_async(class GraphicsContext* const gfx_context)
+		{
+			// A job queued before the scheduler has started its worker threads would never run, leaving the build pending forever
+			if (!JobScheduler::get()->has_available_threads())
+			{
+				create(gfx_context);
+				return;
+			}
+
+			assert(get_build_status() != PipelineBuildStatus::Pending && "Cannot build a pipeline state while a previous build is still pending");
+			build_status.store(PipelineBuildStatus::Pending, std::memory_order_relaxed);
+
+			[](GenericPipelineState* pipeline_state, class GraphicsContext* const gfx_context) -> ThreadedJob<>
+			{
+				ZoneScopedN("GenericPipelineState::create_async");
+				const bool b_created = pipeline_state->pipeline_state_policy.create(gfx_context, &pipeline_state->state_data);
+				pipeline_state->build_status.store(b_created ? PipelineBuildStatus::Ready : PipelineBuildStatus::Failed, std::memory_order_release);
+				co_return;
+			}(this, gfx_context);
+		}
+
 	private:
 		Policy pipeline_state_policy;
 		PipelineStateData state_data;
+		std::atomic<PipelineBuildStatus> build_status{ PipelineBuildStatus::Unbuilt };
 	};
 
 	class NoopPipelineState
@@ -161,12 +229,17 @@ namespace Sunset
 		void destroy(class GraphicsContext* const gfx_context, PipelineStateData* state_data)
 		{ }
 
-		void build(class GraphicsContext* const gfx_context, PipelineStateData* state_data, class RenderPass* render_pass)
+		void prepare_build(class GraphicsContext* const gfx_context, PipelineStateData* state_data, class RenderPass* render_pass)
 		{ }
 
-		void build_compute(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, void* render_pass_data)
+		void prepare_build_compute(class GraphicsContext* const gfx_context, struct PipelineStateData* state_data, void* render_pass_data)
 		{ }
 
+		bool create(class GraphicsContext* const gfx_context, PipelineStateData* state_data)
+		{
+			return true;
+		}
+
 		void bind(class GraphicsContext* const gfx_context, PipelineStateType type, void* buffer)
 		{ }
 
@@ -19,6 +19,15 @@ namespace Sunset
 		Compute = 2
 	};
 
+	enum class PipelineBuildStatus : uint8_t
+	{
+		Unbuilt = 0,
+		// Being created on a job thread, draws using the pipeline are skipped until it is ready
+		Pending,
+		Ready,
+		Failed
+	};
+
 	enum class PipelineShaderStageType : uint16_t
 	{
 		Vertex = 0x0001,
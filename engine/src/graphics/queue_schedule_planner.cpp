@@ -0,0 +1,360 @@
+#include <graphics/queue_schedule_planner.h>
+
+#include <algorithm>
+
+namespace Sunset
+{
+	constexpr size_t QUEUE_TYPE_COUNT = static_cast<size_t>(DeviceQueueType::Num) + 1;
+	constexpr uint32_t QUEUE_SCHEDULE_NO_SUBMISSION = ~0u;
+
+	inline size_t queue_schedule_index(DeviceQueueType queue)
+	{
+		return static_cast<size_t>(queue);
+	}
+
+	struct QueueScheduleBuilder
+	{
+		// Submissions in the order they were opened, they get sorted into close order once planning is done
+		std::vector<QueueSubmission> submissions;
+		std::vector<uint32_t> close_order;
+		std::vector<std::vector<uint32_t>> pass_acquires;
+		std::vector<std::vector<uint32_t>> pass_releases;
+		std::vector<uint32_t> frame_start_releases;
+		std::vector<uint32_t> frame_end_acquires;
+		std::array<uint32_t, QUEUE_TYPE_COUNT> open_submissions;
+		std::array<uint32_t, QUEUE_TYPE_COUNT> submission_counts;
+		// Latest submission of the second queue that the first queue has waited on
+		std::array<std::array<uint32_t, QUEUE_TYPE_COUNT>, QUEUE_TYPE_COUNT> waited_submissions;
+		uint32_t frame_start_submission{ QUEUE_SCHEDULE_NO_SUBMISSION };
+		uint32_t frame_end_submission{ QUEUE_SCHEDULE_NO_SUBMISSION };
+
+		uint32_t open(DeviceQueueType queue)
+		{
+			const uint32_t submission = static_cast<uint32_t>(submissions.size());
+			submissions.push_back({ .queue = queue });
+			open_submissions[queue_schedule_index(queue)] = submission;
+			++submission_counts[queue_schedule_index(queue)];
+			return submission;
+		}
+
+		void close(DeviceQueueType queue)
+		{
+			uint32_t& submission = open_submissions[queue_schedule_index(queue)];
+			if (submission != QUEUE_SCHEDULE_NO_SUBMISSION)
+			{
+				close_order.push_back(submission);
+				submission = QUEUE_SCHEDULE_NO_SUBMISSION;
+			}
+		}
+
+		bool has_waited_on(DeviceQueueType queue, uint32_t submission) const
+		{
+			const uint32_t waited = waited_submissions[queue_schedule_index(queue)][queue_schedule_index(submissions[submission].queue)];
+			return waited != QUEUE_SCHEDULE_NO_SUBMISSION && waited >= submission;
+		}
+
+		void wait(uint32_t waiting_submission, uint32_t signalling_submission, uint32_t& semaphore_count)
+		{
+			const uint32_t semaphore = semaphore_count++;
+			submissions[signalling_submission].signal_semaphores.push_back(semaphore);
+			submissions[waiting_submission].wait_semaphores.push_back(semaphore);
+			waited_submissions[queue_schedule_index(submissions[waiting_submission].queue)][queue_schedule_index(submissions[signalling_submission].queue)] = signalling_submission;
+		}
+	};
+
+	void emit_queue_schedule_commands(const QueueScheduleBuilder& builder, QueueSchedule& out_schedule)
+	{
+		out_schedule.submissions.reserve(builder.close_order.size());
+
+		const auto emit = [&out_schedule](QueueCommandType type, DeviceQueueType queue, uint32_t index)
+		{
+			out_schedule.commands.push_back({ .type = type, .queue = queue, .submission = static_cast<uint32_t>(out_schedule.submissions.size() - 1), .index = index });
+		};
+
+		std::array<uint32_t, QUEUE_TYPE_COUNT> queue_slots;
+		queue_slots.fill(0);
+
+		for (const uint32_t submission_id : builder.close_order)
+		{
+			QueueSubmission& submission = out_schedule.submissions.emplace_back(builder.submissions[submission_id]);
+			submission.queue_slot = queue_slots[queue_schedule_index(submission.queue)]++;
+
+			emit(QueueCommandType::BeginSubmission, submission.queue, 0);
+			for (const uint32_t semaphore : submission.wait_semaphores)
+			{
+				emit(QueueCommandType::WaitSemaphore, submission.queue, semaphore);
+			}
+			if (submission_id == builder.frame_start_submission)
+			{
+				for (const uint32_t transfer : builder.frame_start_releases)
+				{
+					emit(QueueCommandType::ReleaseOwnership, submission.queue, transfer);
+				}
+			}
+			for (const uint32_t pass : submission.passes)
+			{
+				for (const uint32_t transfer : builder.pass_acquires[pass])
+				{
+					emit(QueueCommandType::AcquireOwnership, submission.queue, transfer);
+				}
+				emit(QueueCommandType::ExecutePass, submission.queue, pass);
+				for (const uint32_t transfer : builder.pass_releases[pass])
+				{
+					emit(QueueCommandType::ReleaseOwnership, submission.queue, transfer);
+				}
+			}
+			if (submission_id == builder.frame_end_submission)
+			{
+				for (const uint32_t transfer : builder.frame_end_acquires)
+				{
+					emit(QueueCommandType::AcquireOwnership, submission.queue, transfer);
+				}
+			}
+			for (const uint32_t semaphore : submission.signal_semaphores)
+			{
+				emit(QueueCommandType::SignalSemaphore, submission.queue, semaphore);
+			}
+			emit(QueueCommandType::EndSubmission, submission.queue, 0);
+		}
+	}
+
+	bool plan_multi_queue_schedule(const QueueScheduleInput& input, QueueSchedule& out_schedule)
+	{
+		const uint32_t pass_count = static_cast<uint32_t>(input.passes.size());
+
+		uint32_t resource_count = static_cast<uint32_t>(input.external_resources.size());
+		for (const QueueScheduledPass& pass : input.passes)
+		{
+			for (const uint32_t resource : pass.resources)
+			{
+				resource_count = std::max(resource_count, resource + 1);
+			}
+		}
+
+		QueueScheduleBuilder builder;
+		builder.pass_acquires.resize(pass_count);
+		builder.pass_releases.resize(pass_count);
+		builder.open_submissions.fill(QUEUE_SCHEDULE_NO_SUBMISSION);
+		builder.submission_counts.fill(0);
+		for (std::array<uint32_t, QUEUE_TYPE_COUNT>& waited : builder.waited_submissions)
+		{
+			waited.fill(QUEUE_SCHEDULE_NO_SUBMISSION);
+		}
+
+		// Secondary queues start their frame behind everything already submitted to the graphics queue, uploads included
+		builder.frame_start_submission = builder.open(DeviceQueueType::Graphics);
+		builder.close(DeviceQueueType::Graphics);
+
+		std::vector<DeviceQueueType> last_queues(resource_count, DeviceQueueType::None);
+		std::vector<uint32_t> last_passes(resource_count, QUEUE_SCHEDULE_FRAME_BOUNDARY);
+		std::vector<uint32_t> last_submissions(resource_count, QUEUE_SCHEDULE_NO_SUBMISSION);
+		std::vector<uint32_t> visiting_pass(resource_count, QUEUE_SCHEDULE_FRAME_BOUNDARY);
+		for (uint32_t resource = 0; resource < input.external_resources.size(); ++resource)
+		{
+			if (input.external_resources[resource])
+			{
+				last_queues[resource] = DeviceQueueType::Graphics;
+				last_submissions[resource] = builder.frame_start_submission;
+			}
+		}
+
+		std::array<uint32_t, QUEUE_TYPE_COUNT> dependencies;
+		for (uint32_t pass = 0; pass < pass_count; ++pass)
+		{
+			const DeviceQueueType queue = input.passes[pass].queue;
+			assert(queue != DeviceQueueType::None && "Scheduled passes need a queue");
+
+			// Only the latest submission per queue matters, waiting on it covers everything submitted to that queue before it
+			dependencies.fill(QUEUE_SCHEDULE_NO_SUBMISSION);
+			const auto depend_on = [&dependencies, &builder, queue](uint32_t submission)
+			{
+				uint32_t& dependency = dependencies[queue_schedule_index(builder.submissions[submission].queue)];
+				if (!builder.has_waited_on(queue, submission) && (dependency == QUEUE_SCHEDULE_NO_SUBMISSION || dependency < submission))
+				{
+					dependency = submission;
+				}
+			};
+
+			for (const uint32_t resource : input.passes[pass].resources)
+			{
+				if (visiting_pass[resource] == pass)
+				{
+					continue;
+				}
+				visiting_pass[resource] = pass;
+
+				if (last_queues[resource] == DeviceQueueType::None || last_queues[resource] == queue)
+				{
+					continue;
+				}
+
+				const uint32_t transfer = static_cast<uint32_t>(out_schedule.transfers.size());
+				out_schedule.transfers.push_back({ .resource = resource, .src_queue = last_queues[resource], .dst_queue = queue, .src_pass = last_passes[resource], .dst_pass = pass });
+				if (last_passes[resource] == QUEUE_SCHEDULE_FRAME_BOUNDARY)
+				{
+					builder.frame_start_releases.push_back(transfer);
+				}
+				else
+				{
+					builder.pass_releases[last_passes[resource]].push_back(transfer);
+				}
+				builder.pass_acquires[pass].push_back(transfer);
+
+				depend_on(last_submissions[resource]);
+			}
+
+			if (queue != DeviceQueueType::Graphics && builder.submission_counts[queue_schedule_index(queue)] == 0)
+			{
+				depend_on(builder.frame_start_submission);
+			}
+
+			const bool b_needs_wait = std::any_of(dependencies.begin(), dependencies.end(), [](uint32_t dependency) { return dependency != QUEUE_SCHEDULE_NO_SUBMISSION; });
+			uint32_t submission = builder.open_submissions[queue_schedule_index(queue)];
+			if (submission == QUEUE_SCHEDULE_NO_SUBMISSION || b_needs_wait)
+			{
+				// Waits apply to a whole submission, so work that did not need them goes out ahead in its own submission
+				builder.close(queue);
+				for (const uint32_t dependency : dependencies)
+				{
+					if (dependency != QUEUE_SCHEDULE_NO_SUBMISSION && builder.open_submissions[queue_schedule_index(builder.submissions[dependency].queue)] == dependency)
+					{
+						builder.close(builder.submissions[dependency].queue);
+					}
+				}
+
+				submission = builder.open(queue);
+				for (const uint32_t dependency : dependencies)
+				{
+					if (dependency != QUEUE_SCHEDULE_NO_SUBMISSION)
+					{
+						builder.wait(submission, dependency, out_schedule.semaphore_count);
+					}
+				}
+			}
+
+			builder.submissions[submission].passes.push_back(pass);
+			for (const uint32_t resource : input.passes[pass].resources)
+			{
+				last_queues[resource] = queue;
+				last_passes[resource] = pass;
+				last_submissions[resource] = submission;
+			}
+		}
+
+		// Hand external resources back to the graphics queue and have it wait on the last work of every other queue, so the
+		// frame is only complete once all of its queues are
+		bool b_needs_frame_end = false;
+		for (uint32_t resource = 0; resource < input.external_resources.size(); ++resource)
+		{
+			if (input.external_resources[resource] && last_queues[resource] != DeviceQueueType::Graphics)
+			{
+				const uint32_t transfer = static_cast<uint32_t>(out_schedule.transfers.size());
+				out_schedule.transfers.push_back({ .resource = resource, .src_queue = last_queues[resource], .dst_queue = DeviceQueueType::Graphics, .src_pass = last_passes[resource] });
+				builder.pass_releases[last_passes[resource]].push_back(transfer);
+				builder.frame_end_acquires.push_back(transfer);
+				b_needs_frame_end = true;
+			}
+		}
+
+		std::array<uint32_t, QUEUE_TYPE_COUNT> last_queue_submissions;
+		last_queue_submissions.fill(QUEUE_SCHEDULE_NO_SUBMISSION);
+		for (uint32_t submission = 0; submission < builder.submissions.size(); ++submission)
+		{
+			last_queue_submissions[queue_schedule_index(builder.submissions[submission].queue)] = submission;
+		}
+		for (size_t queue = 0; queue < QUEUE_TYPE_COUNT; ++queue)
+		{
+			const uint32_t last_submission = last_queue_submissions[queue];
+			if (queue != queue_schedule_index(DeviceQueueType::Graphics) && last_submission != QUEUE_SCHEDULE_NO_SUBMISSION)
+			{
+				b_needs_frame_end |= !builder.has_waited_on(DeviceQueueType::Graphics, last_submission);
+			}
+		}
+
+		for (size_t queue = 0; queue < QUEUE_TYPE_COUNT; ++queue)
+		{
+			if (queue != queue_schedule_index(DeviceQueueType::Graphics))
+			{
+				builder.close(static_cast<DeviceQueueType>(queue));
+			}
+		}
+		builder.close(DeviceQueueType::Graphics);
+
+		if (b_needs_frame_end)
+		{
+			builder.frame_end_submission = builder.open(DeviceQueueType::Graphics);
+			for (size_t queue = 0; queue < QUEUE_TYPE_COUNT; ++queue)
+			{
+				const uint32_t last_submission = last_queue_submissions[queue];
+				if (queue != queue_schedule_index(DeviceQueueType::Graphics) && last_submission != QUEUE_SCHEDULE_NO_SUBMISSION && !builder.has_waited_on(DeviceQueueType::Graphics, last_submission))
+				{
+					builder.wait(builder.frame_end_submission, last_submission, out_schedule.semaphore_count);
+				}
+			}
+			builder.close(DeviceQueueType::Graphics);
+		}
+
+		const bool b_within_limits = out_schedule.semaphore_count <= MAX_CROSS_QUEUE_SEMAPHORES
+			&& std::all_of(builder.submission_counts.begin(), builder.submission_counts.end(), [](uint32_t count) { return count <= MAX_QUEUE_SUBMISSIONS_PER_FRAME; });
+		if (!b_within_limits)
+		{
+			return false;
+		}
+
+		emit_queue_schedule_commands(builder, out_schedule);
+		return true;
+	}
+
+	void plan_single_queue_schedule(const QueueScheduleInput& input, QueueSchedule& out_schedule)
+	{
+		QueueSubmission& submission = out_schedule.submissions.emplace_back();
+		submission.queue = DeviceQueueType::Graphics;
+		submission.passes.resize(input.passes.size());
+		for (uint32_t pass = 0; pass < input.passes.size(); ++pass)
+		{
+			submission.passes[pass] = pass;
+		}
+
+		out_schedule.commands.push_back({ .type = QueueCommandType::BeginSubmission });
+		for (const uint32_t pass : submission.passes)
+		{
+			out_schedule.commands.push_back({ .type = QueueCommandType::ExecutePass, .index = pass });
+		}
+		out_schedule.commands.push_back({ .type = QueueCommandType::EndSubmission });
+	}
+
+	void plan_queue_schedule(const QueueScheduleInput& input, QueueSchedule& out_schedule)
+	{
+		ZoneScopedN("plan_queue_schedule");
+
+		out_schedule.submissions.clear();
+		out_schedule.transfers.clear();
+		out_schedule.commands.clear();
+		out_schedule.semaphore_count = 0;
+		out_schedule.b_fell_back_to_single_queue = false;
+
+		if (input.passes.empty())
+		{
+			return;
+		}
+
+		const bool b_uses_secondary_queues = std::any_of(input.passes.begin(), input.passes.end(), [](const QueueScheduledPass& pass)
+		{
+			return pass.queue != DeviceQueueType::Graphics;
+		});
+
+		if (b_uses_secondary_queues)
+		{
+			if (plan_multi_queue_schedule(input, out_schedule))
+			{
+				return;
+			}
+
+			out_schedule.transfers.clear();
+			out_schedule.semaphore_count = 0;
+			out_schedule.b_fell_back_to_single_queue = true;
+		}
+
+		plan_single_queue_schedule(input, out_schedule);
+	}
+}
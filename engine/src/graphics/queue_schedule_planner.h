@@ -0,0 +1,86 @@
+#pragma once
+
+#include <minimal.h>
+#include <command_queue_types.h>
+
+namespace Sunset
+{
+	constexpr uint32_t QUEUE_SCHEDULE_FRAME_BOUNDARY = ~0u;
+
+	// A pass in execution order, the queue it should run on and the (dense) ids of every resource it reads or writes
+	struct QueueScheduledPass
+	{
+		DeviceQueueType queue{ DeviceQueueType::Graphics };
+		std::vector<uint32_t> resources;
+	};
+
+	// External resources carry their contents across frames, so they start every frame owned by the graphics queue and are
+	// handed back to it by the end of the frame
+	struct QueueScheduleInput
+	{
+		std::vector<QueueScheduledPass> passes;
+		std::vector<uint8_t> external_resources;
+	};
+
+	// Moves a resource between queues. src_pass or dst_pass is QUEUE_SCHEDULE_FRAME_BOUNDARY when the transfer happens at the
+	// start or end of the frame rather than next to a pass.
+	struct QueueOwnershipTransfer
+	{
+		uint32_t resource{ 0 };
+		DeviceQueueType src_queue{ DeviceQueueType::Graphics };
+		DeviceQueueType dst_queue{ DeviceQueueType::Graphics };
+		uint32_t src_pass{ QUEUE_SCHEDULE_FRAME_BOUNDARY };
+		uint32_t dst_pass{ QUEUE_SCHEDULE_FRAME_BOUNDARY };
+	};
+
+	// One batch of work for a single queue. The batch waits on every wait semaphore before it starts and signals every signal
+	// semaphore once it is done. Semaphores are frame local and each is signalled and waited on exactly once.
+	struct QueueSubmission
+	{
+		DeviceQueueType queue{ DeviceQueueType::Graphics };
+		// Position among the frame's submissions to the same queue, which picks the queue's command buffer for this submission
+		uint32_t queue_slot{ 0 };
+		std::vector<uint32_t> passes;
+		std::vector<uint32_t> wait_semaphores;
+		std::vector<uint32_t> signal_semaphores;
+	};
+
+	enum class QueueCommandType : uint8_t
+	{
+		BeginSubmission,
+		WaitSemaphore,
+		AcquireOwnership,
+		ExecutePass,
+		ReleaseOwnership,
+		SignalSemaphore,
+		EndSubmission
+	};
+
+	// A flat stream of everything the schedule asks the queues to do, in submission order
+	struct QueueCommand
+	{
+		QueueCommandType type{ QueueCommandType::BeginSubmission };
+		DeviceQueueType queue{ DeviceQueueType::Graphics };
+		uint32_t submission{ 0 };
+		// Pass for ExecutePass, semaphore for Wait/SignalSemaphore and transfer index for Acquire/ReleaseOwnership
+		uint32_t index{ 0 };
+	};
+
+	struct QueueSchedule
+	{
+		// Stored in the order the submissions have to be handed to their queues
+		std::vector<QueueSubmission> submissions;
+		std::vector<QueueOwnershipTransfer> transfers;
+		std::vector<QueueCommand> commands;
+		uint32_t semaphore_count{ 0 };
+		// Set when the schedule went over the submission or semaphore limits and everything was moved to the graphics queue
+		bool b_fell_back_to_single_queue{ false };
+	};
+
+	// Splits passes into per-queue submissions. A pass that touches a resource last used on another queue waits on that queue's
+	// submission through a semaphore and acquires the resource after the other queue releases it. Submissions are only split
+	// where a wait is needed, waits that an earlier wait already covers are dropped, and work on secondary queues is joined
+	// back into the graphics queue at the start and end of the frame. With every pass on the graphics queue the schedule is
+	// a single submission and no sync at all.
+	void plan_queue_schedule(const QueueScheduleInput& input, QueueSchedule& out_schedule);
+}
@@ -1,4 +1,5 @@
 #include <graphics/render_graph.h>
+#include <graphics/renderer.h>
 #include <graphics/render_pass.h>
 #include <graphics/graphics_context.h>
 #include <graphics/command_queue.h>
@@ -8,15 +9,66 @@
 #include <graphics/descriptor.h>
 #include <graphics/resource/shader_pipeline_layout.h>
 #include <graphics/pipeline_state.h>
+#include <utility/cvar.h>
 
 namespace Sunset
 {
+	AutoCVar_Bool cvar_render_graph_compile_cache("ren.render_graph.compile_cache", "Whether or not render graph compilation is reused across frames that declare the same graph structure", true);
+	AutoCVar_Int cvar_render_graph_transient_pool_max_unused_frames("ren.render_graph.transient_pool_max_unused_frames", "Number of frames a pooled transient image or buffer can go unused before it is destroyed", DEFAULT_TRANSIENT_POOL_MAX_UNUSED_FRAMES);
+	AutoCVar_Int cvar_render_graph_split_barrier_min_distance("ren.render_graph.split_barrier_min_distance", "Number of passes between a resource's previous use and a barrier before the barrier is split around the passes in between. 0 disables split barriers", 2);
+	AutoCVar_Bool cvar_render_graph_async_compute("ren.render_graph.async_compute", "Whether or not compute passes flagged as AsyncCompute run on the async compute queue when the device has one", true);
+	AutoCVar_Bool cvar_render_graph_parallel_record("ren.render_graph.parallel_record", "Whether or not passes flagged as ParallelRecord are recorded on job threads", true);
+
+	// Ownership barriers are not tied to a pass, so they are batched under their own id and flushed before the next pass or the end of the submission
+	const Identity RG_QUEUE_OWNERSHIP_BARRIER_ID = "rg_queue_ownership";
+
+	void RGResourceTable::reset(std::pmr::memory_resource* const arena)
+	{
+		handles = std::pmr::vector<RGResourceHandle>(arena);
+		images = std::pmr::vector<RGImageResource*>(arena);
+		buffers = std::pmr::vector<RGBufferResource*>(arena);
+		reference_counts = std::pmr::vector<int32_t>(arena);
+		first_users = std::pmr::vector<RGPassHandle>(arena);
+		last_users = std::pmr::vector<RGPassHandle>(arena);
+		physical_ids = std::pmr::vector<size_t>(arena);
+		persistent_flags = std::pmr::vector<uint8_t>(arena);
+		bindless_flags = std::pmr::vector<uint8_t>(arena);
+		producers = std::pmr::vector<std::pmr::vector<RGPassHandle>>(arena);
+		consumers = std::pmr::vector<std::pmr::vector<RGPassHandle>>(arena);
+		access_flags = std::pmr::vector<std::pmr::vector<AccessFlags>>(arena);
+		layouts = std::pmr::vector<std::pmr::vector<ImageLayout>>(arena);
+	}
+
+	RGResourceHandle RGResourceTable::add(ResourceType type)
+	{
+		const RGResourceHandle handle = create_graph_resource_handle(static_cast<RGResourceIndex>(handles.size()), static_cast<RGResourceType>(type), 1);
+
+		// Nested vectors pick up the arena through uses-allocator construction
+		handles.push_back(handle);
+		images.push_back(nullptr);
+		buffers.push_back(nullptr);
+		reference_counts.push_back(0);
+		first_users.push_back(-1);
+		last_users.push_back(-1);
+		physical_ids.push_back(0);
+		persistent_flags.push_back(0);
+		bindless_flags.push_back(0);
+		producers.emplace_back();
+		consumers.emplace_back();
+		access_flags.emplace_back();
+		layouts.emplace_back();
+
+		return handle;
+	}
+
 	void RenderGraph::initialize(GraphicsContext* const gfx_context)
 	{
 		for (uint32_t i = 0; i < MAX_BUFFERED_FRAMES; ++i)
 		{
 			pass_cache.global_descriptor_set[i] = nullptr;
 		}
+
+		b_async_compute_queue_available = gfx_context->get_command_queue(DeviceQueueType::Compute) != nullptr;
 	}
 
 	void RenderGraph::destroy(GraphicsContext* const gfx_context)
@@ -25,13 +77,20 @@ namespace Sunset
 		{
 			reset(gfx_context, i);
 			registries[i].resource_deletion_queue.flush();
+			registries[i].barrier_batcher.destroy(gfx_context);
 		}
+		transient_image_pool.destroy(gfx_context);
+		transient_buffer_pool.destroy(gfx_context);
 	}
 
 	void RenderGraph::begin(GraphicsContext* const gfx_context)
 	{
 		ZoneScopedN("RenderGraph::begin");
 		reset(gfx_context, gfx_context->get_buffered_frame_number());
+
+		const uint32_t max_unused_frames = static_cast<uint32_t>(std::max(cvar_render_graph_transient_pool_max_unused_frames.get(), 0));
+		transient_image_pool.begin_frame(gfx_context, gfx_context->get_frame_number(), max_unused_frames);
+		transient_buffer_pool.begin_frame(gfx_context, gfx_context->get_frame_number(), max_unused_frames);
 	}
 
 	Sunset::RGResourceHandle RenderGraph::create_image(class GraphicsContext* const gfx_context, const AttachmentConfig& config, int32_t buffered_frame_number)
@@ -41,14 +100,12 @@ namespace Sunset
 		new_image_resource->config.flags |= ImageFlags::Transient;
 
 		{
-			RenderGraphRegistry& registry = registries[buffered_frame_number];
-			const uint32_t index = registry.image_resources.size();
-			registry.image_resources.push_back(new_image_resource);
-			new_image_resource->handle = create_graph_resource_handle(index, static_cast<RGResourceType>(ResourceType::Image), 1);
+			RGResourceTable& resources = registries[buffered_frame_number].resources;
+			new_image_resource->handle = resources.add(ResourceType::Image);
 
-			registry.all_resource_handles.push_back(new_image_resource->handle);
-			registry.resource_metadata.insert({ new_image_resource->handle, {} });
-			registry.resource_metadata[new_image_resource->handle].b_is_bindless = config.is_bindless;
+			const RGResourceIndex index = get_graph_resource_index(new_image_resource->handle);
+			resources.images[index] = new_image_resource;
+			resources.bindless_flags[index] = config.is_bindless;
 		}
 
 		return new_image_resource->handle;
@@ -61,16 +118,14 @@ namespace Sunset
 		new_image_resource->config = image_obj->get_attachment_config();
 
 		{
-			RenderGraphRegistry& registry = registries[buffered_frame_number];
-			const uint32_t index = registry.image_resources.size();
-			registry.image_resources.push_back(new_image_resource);
-			new_image_resource->handle = create_graph_resource_handle(index, static_cast<RGResourceType>(ResourceType::Image), 1);
-
-			registry.all_resource_handles.push_back(new_image_resource->handle);
-			registry.resource_metadata.insert({ new_image_resource->handle, {} });
-			registry.resource_metadata[new_image_resource->handle].physical_id = image;
-			registry.resource_metadata[new_image_resource->handle].b_is_persistent = true;
-			registry.resource_metadata[new_image_resource->handle].b_is_bindless = new_image_resource->config.is_bindless;
+			RGResourceTable& resources = registries[buffered_frame_number].resources;
+			new_image_resource->handle = resources.add(ResourceType::Image);
+
+			const RGResourceIndex index = get_graph_resource_index(new_image_resource->handle);
+			resources.images[index] = new_image_resource;
+			resources.physical_ids[index] = image;
+			resources.persistent_flags[index] = true;
+			resources.bindless_flags[index] = new_image_resource->config.is_bindless;
 		}
 
 		return new_image_resource->handle;
@@ -83,14 +138,12 @@ namespace Sunset
 		new_buffer_resource->config.type |= BufferType::Transient;
 
 		{
-			RenderGraphRegistry& registry = registries[buffered_frame_number];
-			const uint32_t index = registry.buffer_resources.size();
-			registry.buffer_resources.push_back(new_buffer_resource);
-			new_buffer_resource->handle = create_graph_resource_handle(index, static_cast<RGResourceType>(ResourceType::Buffer), 1);
+			RGResourceTable& resources = registries[buffered_frame_number].resources;
+			new_buffer_resource->handle = resources.add(ResourceType::Buffer);
 
-			registry.all_resource_handles.push_back(new_buffer_resource->handle);
-			registry.resource_metadata.insert({ new_buffer_resource->handle, {} });
-			registry.resource_metadata[new_buffer_resource->handle].b_is_bindless = config.b_is_bindless;
+			const RGResourceIndex index = get_graph_resource_index(new_buffer_resource->handle);
+			resources.buffers[index] = new_buffer_resource;
+			resources.bindless_flags[index] = config.b_is_bindless;
 		}
 
 		return new_buffer_resource->handle;
@@ -103,16 +156,14 @@ namespace Sunset
 		new_buffer_resource->config = buffer_obj->get_buffer_config();
 
 		{
-			RenderGraphRegistry& registry = registries[buffered_frame_number];
-			const uint32_t index = registry.buffer_resources.size();
-			registry.buffer_resources.push_back(new_buffer_resource);
-			new_buffer_resource->handle = create_graph_resource_handle(index, static_cast<RGResourceType>(ResourceType::Buffer), 1);
-
-			registry.all_resource_handles.push_back(new_buffer_resource->handle);
-			registry.resource_metadata.insert({ new_buffer_resource->handle, {} });
-			registry.resource_metadata[new_buffer_resource->handle].physical_id = buffer;
-			registry.resource_metadata[new_buffer_resource->handle].b_is_persistent = true;
-			registry.resource_metadata[new_buffer_resource->handle].b_is_bindless = new_buffer_resource->config.b_is_bindless;
+			RGResourceTable& resources = registries[buffered_frame_number].resources;
+			new_buffer_resource->handle = resources.add(ResourceType::Buffer);
+
+			const RGResourceIndex index = get_graph_resource_index(new_buffer_resource->handle);
+			resources.buffers[index] = new_buffer_resource;
+			resources.physical_ids[index] = buffer;
+			resources.persistent_flags[index] = true;
+			resources.bindless_flags[index] = new_buffer_resource->config.b_is_bindless;
 		}
 
 		return new_buffer_resource->handle;
@@ -131,6 +182,8 @@ namespace Sunset
 		pass->pass_config = { .name = pass_name, .flags = pass_type };
 		pass->parameters = params;
 		pass->executor = execution_callback;
+		// Pass objects are pooled, so clear the count left over from the last frame that used this one
+		pass->reference_count = 0;
 
 		uint32_t index{ 0 };
 		{
@@ -159,6 +212,7 @@ namespace Sunset
 
 		RGPass* const pass = render_pass_allocator[buffered_frame_number].get_new();
 		pass->pass_config = { .name = pass_name, .flags = pass_type };
+		pass->parameters = {};
 		pass->executor = execution_callback;
 
 		uint32_t index{ 0 };
@@ -179,27 +233,27 @@ namespace Sunset
 	{
 		RenderGraphRegistry& registry = registries[buffered_frame_number];
 
-		if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+		if (registry.resources.contains(resource))
 		{
-			RGResourceMetadata& metadata = (*it).second;
-
-			const ResourceType resource_type = static_cast<ResourceType>(get_graph_resource_type(resource));
+			const RGResourceIndex index = get_graph_resource_index(resource);
 
 			if (RGPass* const pass_obj = registry.render_passes[pass])
 			{
 				const size_t num_passes = registry.render_passes.size();
 
-				if (metadata.access_flags.size() < num_passes)
+				std::pmr::vector<AccessFlags>& access_flags = registry.resources.access_flags[index];
+				std::pmr::vector<ImageLayout>& layouts = registry.resources.layouts[index];
+				if (access_flags.size() < num_passes)
 				{
-					metadata.access_flags.resize(registry.render_passes.size(), AccessFlags::None);
+					access_flags.resize(num_passes, AccessFlags::None);
 				}
-				if (metadata.layouts.size() < num_passes)
+				if (layouts.size() < num_passes)
 				{
-					metadata.layouts.resize(registry.render_passes.size(), ImageLayout::Undefined);
+					layouts.resize(num_passes, ImageLayout::Undefined);
 				}
 
-				metadata.access_flags[pass] = dst_access;
-				metadata.layouts[pass] = dst_layout;
+				access_flags[pass] = dst_access;
+				layouts[pass] = dst_layout;
 			}
 		}
 	}
@@ -209,10 +263,9 @@ namespace Sunset
 		pass->reference_count += pass->parameters.outputs.size();
 		for (RGResourceHandle resource : pass->parameters.inputs)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (registry.resources.contains(resource))
 			{
-				RGResourceMetadata& metadata = (*it).second;
-				metadata.reference_count += 1;
+				registry.resources.reference_counts[get_graph_resource_index(resource)] += 1;
 			}
 		}
 	}
@@ -221,18 +274,16 @@ namespace Sunset
 	{
 		for (RGResourceHandle resource : pass->parameters.inputs)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (registry.resources.contains(resource))
 			{
-				RGResourceMetadata& metadata = (*it).second;
-				metadata.consumers.push_back(pass->handle);
+				registry.resources.consumers[get_graph_resource_index(resource)].push_back(pass->handle);
 			}
 		}
 		for (RGResourceHandle resource : pass->parameters.outputs)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (registry.resources.contains(resource))
 			{
-				RGResourceMetadata& metadata = (*it).second;
-				metadata.producers.push_back(pass->handle);
+				registry.resources.producers[get_graph_resource_index(resource)].push_back(pass->handle);
 			}
 		}
 	}
@@ -246,15 +297,29 @@ namespace Sunset
 
 	void RenderGraph::cull_graph_passes(class GraphicsContext* const gfx_context, int32_t buffered_frame_number)
 	{
-		std::unordered_set<RGPassHandle> passes_to_cull;
-		std::vector<RGResourceHandle> unused_stack;
-
 		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		RGResourceTable& resources = registry.resources;
 
-		// Lambda to cull a producer pass when it is no longer referenced and pop its inputs onto the unused stack
-		auto update_producer_and_subresource_ref_counts = [this, &registry, &unused_stack, &passes_to_cull](const std::vector<RGPassHandle> producers)
+		registry.culled_passes.assign(registry.render_passes.size(), false);
+		std::pmr::vector<RGResourceIndex> unused_stack(&registry.frame_arena);
+
+		// Go through all resources and push any resources that are not referenced onto the unused stack
+		for (RGResourceIndex i = 0; i < static_cast<RGResourceIndex>(resources.size()); ++i)
 		{
-			for (RGPassHandle pass_handle : producers)
+			if (resources.reference_counts[i] == 0)
+			{
+				unused_stack.push_back(i);
+			}
+		}
+
+		// Keep processing unused resources and updating their producer pass ref counts. A producer that is no longer
+		// referenced gets culled and its inputs lose a reference in turn.
+		while (!unused_stack.empty())
+		{
+			const RGResourceIndex unused_resource = unused_stack.back();
+			unused_stack.pop_back();
+
+			for (RGPassHandle pass_handle : resources.producers[unused_resource])
 			{
 				RGPass* const producer_pass = registry.render_passes[pass_handle];
 
@@ -270,100 +335,60 @@ namespace Sunset
 				{
 					producer_pass->reference_count = 0;
 
-					passes_to_cull.insert(pass_handle);
+					registry.culled_passes[pass_handle] = true;
 
 					for (RGResourceHandle resource : producer_pass->parameters.inputs)
 					{
-						if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+						if (resources.contains(resource))
 						{
-							RGResourceMetadata& metadata = (*it).second;
-							metadata.reference_count -= 1;
-							if (metadata.reference_count == 0)
+							const RGResourceIndex index = get_graph_resource_index(resource);
+							resources.reference_counts[index] -= 1;
+							if (resources.reference_counts[index] == 0)
 							{
-								unused_stack.push_back(resource);
+								unused_stack.push_back(index);
 							}
 						}
 					}
 				}
 			}
-		};
-
-		// Go through all resources and push any resources that are not referenced onto the unused stack
-		for (RGResourceHandle resource : registry.all_resource_handles)
-		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
-			{
-				if ((*it).second.reference_count == 0)
-				{
-					unused_stack.push_back(resource);
-				}
-			}
-		}
-
-		// Keep processing unused resources and updating their producer pass ref counts
-		while (!unused_stack.empty())
-		{
-			RGResourceHandle unused_resource = unused_stack.back();
-			unused_stack.pop_back();
-
-			if (auto it = registry.resource_metadata.find(unused_resource); it != registry.resource_metadata.end())
-			{
-				update_producer_and_subresource_ref_counts((*it).second.producers);
-			}
 		}
 
-		// Take all the culled passes and remove them from our primary nonculled_passes array.
-		// This may constantly shuffle array items if a lot of passes are culled so maybe think about
-		// using a flag instead to indicate if a pass is active or not.
-		for (int i = nonculled_passes[buffered_frame_number].size() - 1; i >= 0; --i)
+		std::vector<RGPassHandle>& passes = nonculled_passes[buffered_frame_number];
+		passes.clear();
+		for (RGPassHandle pass = 0; pass < static_cast<RGPassHandle>(registry.render_passes.size()); ++pass)
 		{
-			RGPassHandle pass = nonculled_passes[buffered_frame_number][i];
-			if (passes_to_cull.find(pass) != passes_to_cull.end())
+			if (!registry.culled_passes[pass])
 			{
-				nonculled_passes[buffered_frame_number].erase(nonculled_passes[buffered_frame_number].begin() + i);
+				passes.push_back(pass);
 			}
 		}
 	}
 
 	void RenderGraph::compute_resource_first_and_last_users(class GraphicsContext* const gfx_context, int32_t buffered_frame_number)
 	{
-		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		RGResourceTable& resources = registries[buffered_frame_number].resources;
 
-		for (RGResourceHandle resource : registry.all_resource_handles)
+		for (RGResourceIndex i = 0; i < static_cast<RGResourceIndex>(resources.size()); ++i)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (resources.reference_counts[i] == 0)
 			{
-				RGResourceMetadata& metadata = (*it).second;
-				if (metadata.reference_count == 0)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				metadata.first_user = std::numeric_limits<uint32_t>::max();
-				metadata.last_user = std::numeric_limits<uint32_t>::min();
-				for (RGPassHandle pass : metadata.producers)
-				{
-					if (pass < metadata.first_user)
-					{
-						metadata.first_user = pass;
-					}
-					if (pass > metadata.last_user)
-					{
-						metadata.last_user = pass;
-					}
-				}
-				for (RGPassHandle pass : metadata.consumers)
-				{
-					if (pass < metadata.first_user)
-					{
-						metadata.first_user = pass;
-					}
-					if (pass > metadata.last_user)
-					{
-						metadata.last_user = pass;
-					}
-				}
+			RGPassHandle first_user = std::numeric_limits<RGPassHandle>::max();
+			RGPassHandle last_user = std::numeric_limits<RGPassHandle>::min();
+			for (RGPassHandle pass : resources.producers[i])
+			{
+				first_user = std::min(first_user, pass);
+				last_user = std::max(last_user, pass);
+			}
+			for (RGPassHandle pass : resources.consumers[i])
+			{
+				first_user = std::min(first_user, pass);
+				last_user = std::max(last_user, pass);
 			}
+			resources.first_users[i] = first_user;
+			resources.last_users[i] = last_user;
 		}
 	}
 
@@ -371,11 +396,11 @@ namespace Sunset
 	{
 		RenderGraphRegistry& registry = registries[buffered_frame_number];
 
-		const auto get_access_flags_for_resource_and_pass_type = [=](RGResourceHandle resource, ResourceType resource_type, RenderPassFlags pass_flags, bool b_input_resource)
+		const auto get_access_flags_for_resource_and_pass_type = [&registry](RGResourceHandle resource, ResourceType resource_type, RenderPassFlags pass_flags, bool b_input_resource)
 		{
 			const RGResourceIndex resource_index = get_graph_resource_index(resource);
-			RGImageResource* const image_resource = registry.image_resources[resource_index];
-			const bool b_is_depth_stencil = (image_resource->config.flags & ImageFlags::DepthStencil) != ImageFlags::None;
+			RGImageResource* const image_resource = resource_type == ResourceType::Image ? registry.resources.images[resource_index] : nullptr;
+			const bool b_is_depth_stencil = image_resource != nullptr && (image_resource->config.flags & ImageFlags::DepthStencil) != ImageFlags::None;
 			const bool b_is_depth_stencil_load = b_is_depth_stencil && !image_resource->config.attachment_clear;
 
 			if (!b_input_resource && !b_is_depth_stencil_load)
@@ -392,11 +417,11 @@ namespace Sunset
 			return AccessFlags::ShaderRead;
 		};
 
-		const auto get_image_layout_for_resource_and_pass_type = [=](RGResourceHandle resource, ResourceType resource_type, RenderPassFlags pass_flags, bool b_input_resource)
+		const auto get_image_layout_for_resource_and_pass_type = [&registry](RGResourceHandle resource, ResourceType resource_type, RenderPassFlags pass_flags, bool b_input_resource)
 		{
 			const RGResourceIndex resource_index = get_graph_resource_index(resource);
-			RGImageResource* const image_resource = registry.image_resources[resource_index];
-			const bool b_is_depth_stencil = (image_resource->config.flags & ImageFlags::DepthStencil) != ImageFlags::None;
+			RGImageResource* const image_resource = resource_type == ResourceType::Image ? registry.resources.images[resource_index] : nullptr;
+			const bool b_is_depth_stencil = image_resource != nullptr && (image_resource->config.flags & ImageFlags::DepthStencil) != ImageFlags::None;
 			const bool b_is_depth_stencil_load = b_is_depth_stencil && !image_resource->config.attachment_clear;
 
 			if (!b_input_resource && !b_is_depth_stencil_load)
@@ -414,62 +439,442 @@ namespace Sunset
 		};
 
 		const size_t num_passes = registry.render_passes.size();
+		RGResourceTable& resources = registry.resources;
+		std::pmr::vector<RGPassHandle> all_users(&registry.frame_arena);
 		// For each resource we compute the per-pass access masks and image layouts. We can then diff these
 		// when executing passes based on prev -> current in order to determine whether the resource needs
 		// a memory barrier.
-		for (RGResourceHandle resource : registry.all_resource_handles)
+		for (RGResourceIndex i = 0; i < static_cast<RGResourceIndex>(resources.size()); ++i)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (resources.reference_counts[i] == 0)
 			{
-				RGResourceMetadata& metadata = (*it).second;
-				if (metadata.reference_count == 0)
+				continue;
+			}
+
+			const RGResourceHandle resource = resources.handles[i];
+			const ResourceType resource_type = static_cast<ResourceType>(get_graph_resource_type(resource));
+			const std::pmr::vector<RGPassHandle>& producers = resources.producers[i];
+			std::pmr::vector<AccessFlags>& access_flags = resources.access_flags[i];
+			std::pmr::vector<ImageLayout>& layouts = resources.layouts[i];
+
+			all_users.clear();
+			all_users.insert(all_users.end(), producers.begin(), producers.end());
+			all_users.insert(all_users.end(), resources.consumers[i].begin(), resources.consumers[i].end());
+			std::sort(all_users.begin(), all_users.end());
+
+			for (RGPassHandle pass : all_users)
+			{
+				if (pass < resources.first_users[i] || pass > resources.last_users[i])
 				{
 					continue;
 				}
 
-				const ResourceType resource_type = static_cast<ResourceType>(get_graph_resource_type(resource));
+				RGPass* const pass_obj = registry.render_passes[pass];
+
+				if (access_flags.size() < num_passes)
+				{
+					access_flags.resize(num_passes, AccessFlags::None);
+				}
+				if (layouts.size() < num_passes)
+				{
+					layouts.resize(num_passes, ImageLayout::Undefined);
+				}
+
+				// Do not touch access/layout metadata that has already been set as this has most likely been done manually via a call to add_pass_resource_barrier
+				if (access_flags[pass] == AccessFlags::None && layouts[pass] == ImageLayout::Undefined)
+				{
+					const bool b_is_input_for_pass = std::find(producers.begin(), producers.end(), pass) == producers.end();
+					access_flags[pass] = get_access_flags_for_resource_and_pass_type(resource, resource_type, pass_obj->pass_config.flags, b_is_input_for_pass);
+					layouts[pass] = get_image_layout_for_resource_and_pass_type(resource, resource_type, pass_obj->pass_config.flags, b_is_input_for_pass);
+				}
+			}
+		}
+	}
 
-				std::vector<RGPassHandle> all_users;
-				all_users.insert(all_users.end(), metadata.producers.begin(), metadata.producers.end());
-				all_users.insert(all_users.end(), metadata.consumers.begin(), metadata.consumers.end());
-				std::sort(all_users.begin(), all_users.end());
+	void RenderGraph::plan_resource_barriers(int32_t buffered_frame_number)
+	{
+		ZoneScopedN("RenderGraph::plan_resource_barriers");
 
-				for (RGPassHandle pass : all_users)
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		RGResourceTable& resources = registry.resources;
+		const std::vector<RGPassHandle>& passes = nonculled_passes[buffered_frame_number];
+
+		// The graph only tracks whole resources, so every resource is planned as a single subresource
+		BarrierPlanInput input;
+		input.resources.resize(resources.size());
+		input.split_min_distance = static_cast<uint32_t>(std::max(cvar_render_graph_split_barrier_min_distance.get(), 0));
+
+		for (uint32_t position = 0; position < passes.size(); ++position)
+		{
+			const RGPassHandle pass_handle = passes[position];
+			RGPass* const pass = registry.render_passes[pass_handle];
+
+			for (const std::vector<RGResourceHandle>* const params : { &pass->parameters.inputs, &pass->parameters.outputs })
+			{
+				for (RGResourceHandle resource : *params)
 				{
-					if (pass < metadata.first_user || pass > metadata.last_user)
+					if (!resources.contains(resource))
 					{
 						continue;
 					}
 
-					RGPass* const pass_obj = registry.render_passes[pass];
-
-					if (metadata.access_flags.size() < num_passes)
+					const RGResourceIndex resource_index = get_graph_resource_index(resource);
+					if (static_cast<size_t>(pass_handle) >= resources.access_flags[resource_index].size())
 					{
-						metadata.access_flags.resize(registry.render_passes.size(), AccessFlags::None);
+						continue;
 					}
-					if (metadata.layouts.size() < num_passes)
+
+					// Resources that are both read and written by a pass only have one state for it
+					std::vector<BarrierResourceUse>& uses = input.resources[resource_index].uses;
+					if (!uses.empty() && uses.back().pass == position)
 					{
-						metadata.layouts.resize(registry.render_passes.size(), ImageLayout::Undefined);
+						continue;
 					}
 
-					// Do not touch access/layout metadata that has already been set as this has most likely been done manually via a call to add_pass_resource_barrier
-					if (metadata.access_flags[pass] == AccessFlags::None && metadata.layouts[pass] == ImageLayout::Undefined)
+					const bool b_is_image = get_graph_resource_type(resource) == static_cast<RGResourceType>(ResourceType::Image);
+					uses.push_back({
+						.pass = position,
+						.access = resources.access_flags[resource_index][pass_handle],
+						.layout = b_is_image ? resources.layouts[resource_index][pass_handle] : ImageLayout::Undefined
+					});
+				}
+			}
+		}
+
+		plan_barriers(input, registry.barrier_plan);
+
+		registry.split_barrier_acquires.clear();
+		registry.split_barrier_releases.clear();
+
+		// Merged reads go back into the per-pass state, so the first read's barrier covers the reads after it at execution time
+		phmap::flat_hash_map<uint64_t, uint32_t> splits;
+		for (const PlannedBarrier& barrier : registry.barrier_plan.barriers)
+		{
+			const RGPassHandle pass_handle = passes[barrier.pass];
+			resources.access_flags[barrier.resource][pass_handle] = barrier.dst_access;
+
+			if (barrier.is_split())
+			{
+				// Barriers released and acquired around the same passes share one split
+				const uint64_t split_key = (static_cast<uint64_t>(barrier.release_pass) << 32) | barrier.pass;
+				const auto [split_it, b_new_split] = splits.insert({ split_key, static_cast<uint32_t>(splits.size()) });
+				if (b_new_split)
+				{
+					registry.split_barrier_releases[passes[barrier.release_pass]].push_back(split_it->second);
+				}
+				registry.split_barrier_acquires[(static_cast<uint64_t>(barrier.resource) << 32) | static_cast<uint32_t>(pass_handle)] = split_it->second;
+			}
+		}
+	}
+
+	void RenderGraph::plan_transient_resource_aliasing(int32_t buffered_frame_number)
+	{
+		ZoneScopedN("RenderGraph::plan_transient_resource_aliasing");
+
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+
+		std::vector<TransientResourceLifetime> lifetimes;
+		registry.transient_resources.clear();
+
+		const RGResourceTable& resources = registry.resources;
+		for (RGResourceIndex resource_index = 0; resource_index < static_cast<RGResourceIndex>(resources.size()); ++resource_index)
+		{
+			if (resources.reference_counts[resource_index] == 0 || resources.first_users[resource_index] < 0)
+			{
+				continue;
+			}
+
+			const RGResourceHandle resource = resources.handles[resource_index];
+			TransientResourceLifetime lifetime{ .first_pass = resources.first_users[resource_index], .last_pass = resources.last_users[resource_index] };
+
+			if (get_graph_resource_type(resource) == static_cast<RGResourceType>(ResourceType::Image))
+			{
+				const AttachmentConfig& config = resources.images[resource_index]->config;
+				// Registered images and images that load their previous contents cannot share memory
+				if ((config.flags & ImageFlags::Transient) == ImageFlags::None || (config.flags & ImageFlags::LocalLoad) != ImageFlags::None)
+				{
+					continue;
+				}
+
+				const size_t width = std::max(static_cast<size_t>(config.extent.x), size_t(1));
+				const size_t height = std::max(static_cast<size_t>(config.extent.y), size_t(1));
+				const size_t depth = std::max(static_cast<size_t>(config.extent.z), size_t(1));
+				for (uint32_t mip = 0; mip < config.mip_count; ++mip)
+				{
+					lifetime.size += std::max(width >> mip, size_t(1)) * std::max(height >> mip, size_t(1)) * std::max(depth >> mip, size_t(1));
+				}
+				lifetime.size *= static_cast<size_t>(get_format_pixel_size(config.format)) * config.array_count;
+				lifetime.alignment = RG_TRANSIENT_IMAGE_ALIGNMENT;
+			}
+			else
+			{
+				const BufferConfig& config = resources.buffers[resource_index]->config;
+				if ((config.type & BufferType::Transient) == BufferType::None)
+				{
+					continue;
+				}
+
+				lifetime.size = config.buffer_size;
+				lifetime.alignment = RG_TRANSIENT_BUFFER_ALIGNMENT;
+			}
+
+			if (lifetime.size == 0)
+			{
+				continue;
+			}
+
+			lifetimes.push_back(lifetime);
+			registry.transient_resources.push_back(resource);
+		}
+
+		plan_transient_aliasing(lifetimes, registry.transient_aliasing_plan);
+	}
+
+	void RenderGraph::ensure_transient_resource_aliasing(int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		if (!registry.b_transient_aliasing_planned)
+		{
+			plan_transient_resource_aliasing(buffered_frame_number);
+			registry.b_transient_aliasing_planned = true;
+		}
+	}
+
+	void RenderGraph::schedule_pass_queues(int32_t buffered_frame_number)
+	{
+		ZoneScopedN("RenderGraph::schedule_pass_queues");
+
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const RGResourceTable& resources = registry.resources;
+		const bool b_use_async_compute = b_async_compute_queue_available && cvar_render_graph_async_compute.get();
+
+		QueueScheduleInput input;
+		input.external_resources.assign(resources.persistent_flags.begin(), resources.persistent_flags.end());
+		input.passes.reserve(nonculled_passes[buffered_frame_number].size());
+
+		for (RGPassHandle pass_handle : nonculled_passes[buffered_frame_number])
+		{
+			RGPass* const pass = registry.render_passes[pass_handle];
+			const RenderPassFlags flags = pass->pass_config.flags;
+			const bool b_is_async_compute = (flags & RenderPassFlags::Compute) != RenderPassFlags::None && (flags & RenderPassFlags::AsyncCompute) != RenderPassFlags::None;
+
+			QueueScheduledPass& scheduled_pass = input.passes.emplace_back();
+			scheduled_pass.queue = b_use_async_compute && b_is_async_compute ? DeviceQueueType::Compute : DeviceQueueType::Graphics;
+			scheduled_pass.resources.reserve(pass->parameters.inputs.size() + pass->parameters.outputs.size());
+
+			for (const std::vector<RGResourceHandle>* const params : { &pass->parameters.inputs, &pass->parameters.outputs })
+			{
+				for (RGResourceHandle resource : *params)
+				{
+					if (resources.contains(resource))
 					{
-						const bool b_is_input_for_pass = std::find(metadata.producers.begin(), metadata.producers.end(), pass) == metadata.producers.end();
-						metadata.access_flags[pass] = get_access_flags_for_resource_and_pass_type(resource, resource_type, pass_obj->pass_config.flags, b_is_input_for_pass);
-						metadata.layouts[pass] = get_image_layout_for_resource_and_pass_type(resource, resource_type, pass_obj->pass_config.flags, b_is_input_for_pass);
+						scheduled_pass.resources.push_back(static_cast<uint32_t>(get_graph_resource_index(resource)));
 					}
 				}
 			}
 		}
+
+		plan_queue_schedule(input, registry.queue_schedule);
+	}
+
+	size_t RenderGraph::compute_graph_structure_hash(int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+
+		std::vector<size_t>& structure_key = graph_structure_keys[buffered_frame_number];
+		structure_key.clear();
+
+		// Only state read by compilation goes into the key. Pass names and resource descriptions beyond the flags below
+		// do not change which passes are culled or what barriers get computed.
+		structure_key.push_back(registry.render_passes.size());
+		for (RGPass* const pass : registry.render_passes)
+		{
+			structure_key.push_back(static_cast<size_t>(pass->pass_config.flags));
+			structure_key.push_back(static_cast<size_t>(pass->parameters.b_force_keep_pass));
+			structure_key.push_back(static_cast<size_t>(pass->reference_count));
+			structure_key.push_back(pass->parameters.inputs.size());
+			for (RGResourceHandle resource : pass->parameters.inputs)
+			{
+				structure_key.push_back(static_cast<size_t>(resource));
+			}
+			structure_key.push_back(pass->parameters.outputs.size());
+			for (RGResourceHandle resource : pass->parameters.outputs)
+			{
+				structure_key.push_back(static_cast<size_t>(resource));
+			}
+		}
+
+		const RGResourceTable& resources = registry.resources;
+		structure_key.push_back(resources.size());
+		for (RGResourceIndex resource_index = 0; resource_index < static_cast<RGResourceIndex>(resources.size()); ++resource_index)
+		{
+			structure_key.push_back(static_cast<size_t>(resources.handles[resource_index]));
+
+			if (const RGImageResource* const image_resource = resources.images[resource_index])
+			{
+				structure_key.push_back(static_cast<size_t>((image_resource->config.flags & ImageFlags::DepthStencil) != ImageFlags::None));
+				structure_key.push_back(static_cast<size_t>(image_resource->config.attachment_clear));
+			}
+
+			// Barriers added through add_pass_resource_barrier before compilation
+			const std::pmr::vector<AccessFlags>& access_flags = resources.access_flags[resource_index];
+			structure_key.push_back(access_flags.size());
+			for (uint32_t i = 0; i < access_flags.size(); ++i)
+			{
+				structure_key.push_back(static_cast<size_t>(access_flags[i]));
+			}
+			const std::pmr::vector<ImageLayout>& layouts = resources.layouts[resource_index];
+			structure_key.push_back(layouts.size());
+			for (uint32_t i = 0; i < layouts.size(); ++i)
+			{
+				structure_key.push_back(static_cast<size_t>(layouts[i]));
+			}
+		}
+
+		size_t seed = structure_key.size();
+		for (size_t value : structure_key)
+		{
+			seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+
+		return seed;
+	}
+
+	bool RenderGraph::apply_compiled_graph(size_t structure_hash, int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+
+		auto it = compiled_graph_cache.find(structure_hash);
+		if (it == compiled_graph_cache.end())
+		{
+			return false;
+		}
+
+		RGCompiledGraph& compiled_graph = (*it).second;
+		if (compiled_graph.structure_key != graph_structure_keys[buffered_frame_number])
+		{
+			return false;
+		}
+
+		compiled_graph.last_used = ++compiled_graph_cache_clock;
+
+		nonculled_passes[buffered_frame_number] = compiled_graph.nonculled_passes;
+
+		for (uint32_t i = 0; i < registry.render_passes.size(); ++i)
+		{
+			registry.render_passes[i]->reference_count = compiled_graph.pass_reference_counts[i];
+		}
+
+		RGResourceTable& resources = registry.resources;
+		for (uint32_t i = 0; i < resources.size(); ++i)
+		{
+			const RGCompiledResource& compiled_resource = compiled_graph.resources[i];
+			resources.reference_counts[i] = compiled_resource.reference_count;
+			resources.first_users[i] = compiled_resource.first_user;
+			resources.last_users[i] = compiled_resource.last_user;
+			resources.access_flags[i].assign(compiled_resource.access_flags.begin(), compiled_resource.access_flags.end());
+			resources.layouts[i].assign(compiled_resource.layouts.begin(), compiled_resource.layouts.end());
+		}
+
+		return true;
+	}
+
+	void RenderGraph::plan_pass_recording(int32_t buffered_frame_number)
+	{
+		ZoneScopedN("RenderGraph::plan_pass_recording");
+
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const std::vector<RGPassHandle>& passes = nonculled_passes[buffered_frame_number];
+
+		CommandRecordingInput input;
+		input.passes.reserve(passes.size());
+		for (RGPassHandle pass_handle : passes)
+		{
+			const RGPass* const pass = registry.render_passes[pass_handle];
+			// Graph local passes run on the CPU and have no command buffer work to split up
+			const bool b_parallel = (pass->pass_config.flags & RenderPassFlags::ParallelRecord) != RenderPassFlags::None
+				&& (pass->pass_config.flags & RenderPassFlags::GraphLocal) == RenderPassFlags::None;
+			input.passes.push_back({ .b_parallel = b_parallel, .chunk_count = pass->parameters.record_chunk_count });
+		}
+
+		plan_command_recording(input, registry.recording_plan);
+	}
+
+	void RenderGraph::store_compiled_graph(size_t structure_hash, int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+
+		// Evict the least recently used variant, so a graph that keeps producing new structures can't push out the ones used every frame
+		if (compiled_graph_cache.size() >= MAX_COMPILED_GRAPH_CACHE_SIZE && compiled_graph_cache.find(structure_hash) == compiled_graph_cache.end())
+		{
+			auto oldest = compiled_graph_cache.begin();
+			for (auto it = compiled_graph_cache.begin(); it != compiled_graph_cache.end(); ++it)
+			{
+				if ((*it).second.last_used < (*oldest).second.last_used)
+				{
+					oldest = it;
+				}
+			}
+			compiled_graph_cache.erase(oldest);
+		}
+
+		// A colliding hash replaces the older entry, which is fine since the key check keeps it from ever being misapplied
+		RGCompiledGraph& compiled_graph = compiled_graph_cache[structure_hash];
+		compiled_graph.structure_key = graph_structure_keys[buffered_frame_number];
+		compiled_graph.last_used = ++compiled_graph_cache_clock;
+		compiled_graph.nonculled_passes = nonculled_passes[buffered_frame_number];
+
+		compiled_graph.pass_reference_counts.resize(registry.render_passes.size());
+		for (uint32_t i = 0; i < registry.render_passes.size(); ++i)
+		{
+			compiled_graph.pass_reference_counts[i] = registry.render_passes[i]->reference_count;
+		}
+
+		const RGResourceTable& resources = registry.resources;
+		compiled_graph.resources.resize(resources.size());
+		for (uint32_t i = 0; i < resources.size(); ++i)
+		{
+			compiled_graph.resources[i] = {
+				.reference_count = resources.reference_counts[i],
+				.first_user = resources.first_users[i],
+				.last_user = resources.last_users[i],
+				.access_flags = std::vector<AccessFlags>(resources.access_flags[i].begin(), resources.access_flags[i].end()),
+				.layouts = std::vector<ImageLayout>(resources.layouts[i].begin(), resources.layouts[i].end())
+			};
+		}
 	}
 
 	void RenderGraph::compile(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number)
 	{
+		ZoneScopedN("RenderGraph::compile");
+
+		const bool b_use_compile_cache = cvar_render_graph_compile_cache.get();
+		const size_t structure_hash = b_use_compile_cache ? compute_graph_structure_hash(buffered_frame_number) : 0;
+
+		if (b_use_compile_cache && apply_compiled_graph(structure_hash, buffered_frame_number))
+		{
+			++compile_stats.cache_hits;
+			plan_resource_barriers(buffered_frame_number);
+			// Resource sizes are not part of the graph structure, so the aliasing plan is rebuilt the next time it is asked for
+			registries[buffered_frame_number].b_transient_aliasing_planned = false;
+			schedule_pass_queues(buffered_frame_number);
+			plan_pass_recording(buffered_frame_number);
+			return;
+		}
+
 		cull_graph_passes(gfx_context, buffered_frame_number);
 		compute_resource_first_and_last_users(gfx_context, buffered_frame_number);
 		compute_resource_barriers(gfx_context, buffered_frame_number);
-		// TODO: Not entirely sure how to do this yet (with VMA?) but walk resource lifetimes to account for how much GPU memory should be allocated up front for aliasing
+		plan_resource_barriers(buffered_frame_number);
+		registries[buffered_frame_number].b_transient_aliasing_planned = false;
+		schedule_pass_queues(buffered_frame_number);
+		plan_pass_recording(buffered_frame_number);
+
+		if (b_use_compile_cache)
+		{
+			++compile_stats.cache_misses;
+			store_compiled_graph(structure_hash, buffered_frame_number);
+		}
 	}
 
 	void RenderGraph::submit(GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number, bool b_offline)
@@ -483,9 +888,18 @@ namespace Sunset
 			return;
 		}
 
+		reset_skipped_passes(buffered_frame_number);
+
+		// Frames that only use the graphics queue keep recording into the queue's single frame command buffer
+		if (registry.queue_schedule.submissions.size() > 1)
+		{
+			submit_queue_schedule(gfx_context, swapchain, buffered_frame_number, b_offline);
+			release_pooled_resources(buffered_frame_number);
+			return;
+		}
+
 		registry.barrier_batcher.begin(gfx_context, PipelineStageType::AllCommands);
 
-		// TODO: switch the queue based on the pass type
 		void* cmd_buffer = gfx_context->get_command_queue(DeviceQueueType::Graphics)->begin_one_time_buffer_record(gfx_context, buffered_frame_number);
 
 		{
@@ -496,16 +910,230 @@ namespace Sunset
 				.resource_deletion_queue = &registry.resource_deletion_queue
 			};
 
-			for (RGPassHandle pass_handle : nonculled_passes[buffered_frame_number])
-			{
-				execute_pass(gfx_context, swapchain, registry.render_passes[pass_handle], frame_data, cmd_buffer);
-			}
+			record_passes(gfx_context, swapchain, frame_data, cmd_buffer);
 		}
 
-		// TODO: switch the queue based on the pass type
 		gfx_context->get_command_queue(DeviceQueueType::Graphics)->end_one_time_buffer_record(gfx_context, buffered_frame_number);
-		// TODO: switch the queue based on the pass type
+		// Asset uploads queued before or during recording have to be submitted ahead of the frame that uses them
+		Renderer::get()->get_upload_scheduler().flush(gfx_context);
+
 		gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit(gfx_context, buffered_frame_number, b_offline);
+
+		release_pooled_resources(buffered_frame_number);
+	}
+
+	void RenderGraph::submit_queue_schedule(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number, bool b_offline)
+	{
+		ZoneScopedN("RenderGraph::submit_queue_schedule");
+
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const QueueSchedule& schedule = registry.queue_schedule;
+		const std::vector<RGPassHandle>& passes = nonculled_passes[buffered_frame_number];
+
+		RGFrameData frame_data
+		{
+			.gfx_context = gfx_context,
+			.buffered_frame_number = buffered_frame_number,
+			.resource_deletion_queue = &registry.resource_deletion_queue
+		};
+
+		// Events only order work within one queue, so split barriers are recorded as regular barriers here
+		registry.split_barrier_acquires.clear();
+		registry.split_barrier_releases.clear();
+
+		CommandQueue* queue{ nullptr };
+		void* cmd_buffer{ nullptr };
+
+		// Submissions are recorded in the order they are submitted, which keeps the tracked resource states valid across queues
+		for (const QueueCommand& command : schedule.commands)
+		{
+			switch (command.type)
+			{
+			case QueueCommandType::BeginSubmission:
+				queue = gfx_context->get_command_queue(command.queue);
+				cmd_buffer = queue->begin_submission_record(gfx_context, buffered_frame_number, schedule.submissions[command.submission].queue_slot);
+				registry.barrier_batcher.begin(gfx_context, PipelineStageType::AllCommands);
+				break;
+			case QueueCommandType::AcquireOwnership:
+			case QueueCommandType::ReleaseOwnership:
+				record_queue_ownership_transfer(gfx_context, schedule.transfers[command.index], buffered_frame_number, command.type == QueueCommandType::AcquireOwnership);
+				break;
+			case QueueCommandType::ExecutePass:
+				registry.barrier_batcher.execute(gfx_context, cmd_buffer, PipelineStageType::AllCommands, RG_QUEUE_OWNERSHIP_BARRIER_ID);
+				execute_pass(gfx_context, swapchain, registry.render_passes[passes[command.index]], frame_data, cmd_buffer);
+				break;
+			case QueueCommandType::EndSubmission:
+				registry.barrier_batcher.execute(gfx_context, cmd_buffer, PipelineStageType::AllCommands, RG_QUEUE_OWNERSHIP_BARRIER_ID);
+				queue->end_submission_record(gfx_context, buffered_frame_number, schedule.submissions[command.submission].queue_slot);
+				break;
+			default:
+				// Semaphores are attached when the submissions are handed to their queues
+				break;
+			}
+		}
+
+		// Asset uploads queued before or during recording have to be submitted ahead of the frame that uses them
+		Renderer::get()->get_upload_scheduler().flush(gfx_context);
+
+		// Only graphics work writes to the swapchain, so the first graphics submission that runs passes waits for the image
+		uint32_t present_wait_submission = static_cast<uint32_t>(schedule.submissions.size()) - 1;
+		for (uint32_t i = 0; i < schedule.submissions.size(); ++i)
+		{
+			if (schedule.submissions[i].queue == DeviceQueueType::Graphics && !schedule.submissions[i].passes.empty())
+			{
+				present_wait_submission = i;
+				break;
+			}
+		}
+
+		for (uint32_t i = 0; i < schedule.submissions.size(); ++i)
+		{
+			const QueueSubmission& submission = schedule.submissions[i];
+			const QueueSubmitSync sync
+			{
+				.wait_semaphores = submission.wait_semaphores,
+				.signal_semaphores = submission.signal_semaphores,
+				.b_wait_for_present = !b_offline && i == present_wait_submission,
+				.b_signal_frame_complete = i == schedule.submissions.size() - 1
+			};
+			gfx_context->get_command_queue(submission.queue)->submit_frame_submission(gfx_context, buffered_frame_number, submission.queue_slot, sync);
+		}
+	}
+
+	void RenderGraph::record_passes(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGFrameData& frame_data, void* command_buffer)
+	{
+		ZoneScopedN("RenderGraph::record_passes");
+
+		const int32_t buffered_frame_number = frame_data.buffered_frame_number;
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const std::vector<RGPassHandle>& passes = nonculled_passes[buffered_frame_number];
+		const CommandRecordingPlan& plan = registry.recording_plan;
+		CommandQueue* const queue = gfx_context->get_command_queue(DeviceQueueType::Graphics);
+
+		// The recording thread moves on to prepare the batch's next pass while chunks are pending, so every chunk keeps its own copy of its pass's frame data
+		std::vector<RGFrameData> chunk_frame_data(plan.slot_count);
+		std::vector<void*> chunk_command_buffers(plan.slot_count, nullptr);
+
+		const auto get_framebuffer_index = [swapchain, buffered_frame_number](RGPass* pass) -> uint32_t
+		{
+			return pass->pass_config.b_is_present_pass ? swapchain->get_current_image_index(buffered_frame_number) : 0;
+		};
+
+		const CommandRecordingCallbacks callbacks
+		{
+			.record_pass = [&](uint32_t position)
+			{
+				RGPass* const pass = registry.render_passes[passes[position]];
+				execute_pass(gfx_context, swapchain, pass, frame_data, command_buffer);
+				signal_split_barrier_releases(gfx_context, pass, buffered_frame_number, command_buffer);
+			},
+			.prepare_pass = [&](uint32_t position, uint32_t first_slot)
+			{
+				RGPass* const pass = registry.render_passes[passes[position]];
+				prepare_pass(gfx_context, swapchain, pass, frame_data);
+
+				// Decided here on the recording thread, since passes have to be visited in order to find the readers of skipped passes
+				skip_pass_executor(pass->handle, is_pass_pipeline_ready(pass), buffered_frame_number);
+
+				const bool b_is_compute_pass = (pass->pass_config.flags & RenderPassFlags::Compute) != RenderPassFlags::None;
+				RenderPass* const physical_pass = b_is_compute_pass ? nullptr : CACHE_FETCH(RenderPass, pass->physical_id);
+
+				const uint32_t chunk_count = plan.pass_chunk_counts[position];
+				for (uint32_t chunk = 0; chunk < chunk_count; ++chunk)
+				{
+					const uint32_t slot = first_slot + chunk;
+
+					chunk_frame_data[slot] = frame_data;
+					chunk_frame_data[slot].record_chunk = chunk;
+					chunk_frame_data[slot].record_chunk_count = chunk_count;
+
+					// Secondary command buffers do not inherit bound state, so each chunk binds the pass's pipeline and descriptors again
+					chunk_command_buffers[slot] = queue->begin_secondary_record(gfx_context, buffered_frame_number, slot, physical_pass, get_framebuffer_index(pass));
+					bind_pass_state(gfx_context, pass, chunk_frame_data[slot], chunk_command_buffers[slot]);
+				}
+			},
+			.record_chunk = [&](uint32_t position, uint32_t chunk, uint32_t slot)
+			{
+				ZoneScopedN("RenderGraph::record_passes: record_chunk");
+
+				RGPass* const pass = registry.render_passes[passes[position]];
+				if (!registry.skipped_passes[pass->handle])
+				{
+					pass->executor(*this, chunk_frame_data[slot], chunk_command_buffers[slot]);
+				}
+				queue->end_secondary_record(gfx_context, buffered_frame_number, slot);
+			},
+			.execute_pass = [&](uint32_t position, uint32_t first_slot)
+			{
+				RGPass* const pass = registry.render_passes[passes[position]];
+				const uint32_t chunk_count = plan.pass_chunk_counts[position];
+
+				execute_pass_barriers(gfx_context, pass, buffered_frame_number, command_buffer);
+
+				if ((pass->pass_config.flags & RenderPassFlags::Compute) != RenderPassFlags::None)
+				{
+					queue->execute_secondary_records(gfx_context, buffered_frame_number, command_buffer, first_slot, chunk_count);
+				}
+				else
+				{
+					RenderPass* const physical_pass = CACHE_FETCH(RenderPass, pass->physical_id);
+					physical_pass->begin_pass(gfx_context, get_framebuffer_index(pass), command_buffer, true);
+					queue->execute_secondary_records(gfx_context, buffered_frame_number, command_buffer, first_slot, chunk_count);
+					physical_pass->end_pass(gfx_context, command_buffer);
+				}
+
+				finish_pass(pass, chunk_frame_data[first_slot]);
+
+				update_transient_resources(gfx_context, pass, buffered_frame_number);
+				signal_split_barrier_releases(gfx_context, pass, buffered_frame_number, command_buffer);
+			}
+		};
+
+		record_command_stream(plan, callbacks, cvar_render_graph_parallel_record.get());
+	}
+
+	void RenderGraph::signal_split_barrier_releases(class GraphicsContext* const gfx_context, RGPass* pass, int32_t buffered_frame_number, void* command_buffer)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		if (auto split_it = registry.split_barrier_releases.find(pass->handle); split_it != registry.split_barrier_releases.end())
+		{
+			for (uint32_t split : split_it->second)
+			{
+				registry.barrier_batcher.signal_split_barrier(gfx_context, command_buffer, PipelineStageType::AllCommands, split);
+			}
+		}
+	}
+
+	void RenderGraph::record_queue_ownership_transfer(class GraphicsContext* const gfx_context, const QueueOwnershipTransfer& transfer, int32_t buffered_frame_number, bool b_acquire)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const RGResourceTable& resources = registry.resources;
+		const uint32_t src_queue_family = gfx_context->get_command_queue(transfer.src_queue)->get_queue_family();
+		const uint32_t dst_queue_family = gfx_context->get_command_queue(transfer.dst_queue)->get_queue_family();
+
+		const uint32_t resource_index = transfer.resource;
+		const size_t physical_id = resources.physical_ids[resource_index];
+		assert(physical_id != 0 && "Resources are always backed by the time they change queues");
+
+		// Both halves of the transfer move the resource straight into the state its next user on the destination queue expects
+		const std::pmr::vector<AccessFlags>& resource_access_flags = resources.access_flags[resource_index];
+		const std::pmr::vector<ImageLayout>& resource_layouts = resources.layouts[resource_index];
+		const bool b_has_dst_pass_state = transfer.dst_pass != QUEUE_SCHEDULE_FRAME_BOUNDARY && !resource_access_flags.empty() && !resource_layouts.empty();
+		const RGPassHandle dst_pass = b_has_dst_pass_state ? nonculled_passes[buffered_frame_number][transfer.dst_pass] : -1;
+
+		if (static_cast<ResourceType>(get_graph_resource_type(resources.handles[resource_index])) == ResourceType::Buffer)
+		{
+			Buffer* const buffer = CACHE_FETCH(Buffer, physical_id);
+			const AccessFlags access_flags = b_has_dst_pass_state ? resource_access_flags[dst_pass] : buffer->get_access_flags();
+			registry.barrier_batcher.add_buffer_ownership_transfer(gfx_context, buffer, RG_QUEUE_OWNERSHIP_BARRIER_ID, access_flags, src_queue_family, dst_queue_family, b_acquire);
+		}
+		else
+		{
+			Image* const image = CACHE_FETCH(Image, physical_id);
+			const AccessFlags access_flags = b_has_dst_pass_state ? resource_access_flags[dst_pass] : image->get_access_flags();
+			const ImageLayout layout = b_has_dst_pass_state ? resource_layouts[dst_pass] : image->get_layout();
+			registry.barrier_batcher.add_image_ownership_transfer(gfx_context, image, RG_QUEUE_OWNERSHIP_BARRIER_ID, access_flags, layout, src_queue_family, dst_queue_family, b_acquire);
+		}
 	}
 
 	void RenderGraph::queue_global_descriptor_writes(class GraphicsContext* const gfx_context, uint32_t buffered_frame, const std::initializer_list<DescriptorBufferDesc>& buffers)
@@ -518,29 +1146,60 @@ namespace Sunset
 	{
 		RenderGraphRegistry& registry = registries[buffered_frame_number];
 
-		if (registry.resource_metadata.find(resource) != registry.resource_metadata.end())
+		if (registry.resources.contains(resource))
 		{
-			return registry.resource_metadata[resource].physical_id;
+			return registry.resources.physical_ids[get_graph_resource_index(resource)];
 		}
 
 		return 0;
 	}
 
+	std::optional<RGResourceMetadata> RenderGraph::get_resource_metadata(RGResourceHandle resource, int32_t buffered_frame_number) const
+	{
+		const RGResourceTable& resources = registries[buffered_frame_number].resources;
+
+		if (!resources.contains(resource))
+		{
+			return std::nullopt;
+		}
+
+		const RGResourceIndex index = get_graph_resource_index(resource);
+		return RGResourceMetadata{
+			.reference_count = resources.reference_counts[index],
+			.physical_id = resources.physical_ids[index],
+			.first_user = resources.first_users[index],
+			.last_user = resources.last_users[index],
+			.access_flags = std::vector<AccessFlags>(resources.access_flags[index].begin(), resources.access_flags[index].end()),
+			.layouts = std::vector<ImageLayout>(resources.layouts[index].begin(), resources.layouts[index].end()),
+			.producers = std::vector<RGPassHandle>(resources.producers[index].begin(), resources.producers[index].end()),
+			.consumers = std::vector<RGPassHandle>(resources.consumers[index].begin(), resources.consumers[index].end()),
+			.b_is_persistent = static_cast<bool>(resources.persistent_flags[index]),
+			.b_is_bindless = static_cast<bool>(resources.bindless_flags[index])
+		};
+	}
+
 	void RenderGraph::reset(class GraphicsContext* const gfx_context, int32_t current_buffered_frame)
 	{
 		free_physical_resources(gfx_context, current_buffered_frame);
 
 		nonculled_passes[current_buffered_frame].clear();
 
+		release_pooled_resources(current_buffered_frame);
+
 		{
 			RenderGraphRegistry* const registry = &registries[current_buffered_frame];
-			registry->all_resource_handles.clear();
-			registry->buffer_resources.clear();
-			registry->image_resources.clear();
 			registry->all_bindless_resource_handles.clear();
 			registry->render_passes.clear();
-			registry->resource_metadata.clear();
+			registry->transient_resources.clear();
+			registry->b_transient_aliasing_planned = false;
 			registry->b_global_set_bound = false;
+
+			// Everything allocated from the frame arena goes away in one go
+			registry->resources.reset(&registry->frame_arena);
+			registry->culled_passes = std::pmr::vector<uint8_t>(&registry->frame_arena);
+			registry->skipped_passes = std::pmr::vector<uint8_t>(&registry->frame_arena);
+			registry->unwritten_resources = std::pmr::vector<uint8_t>(&registry->frame_arena);
+			registry->frame_arena.release();
 		}
 
 		image_resource_allocator[current_buffered_frame].reset();
@@ -556,45 +1215,145 @@ namespace Sunset
 		{
 			frame_data.global_descriptor_set = pass_cache.global_descriptor_set[frame_data.buffered_frame_number];
 
-			pass->executor(*this, frame_data, command_buffer);
+			if (!skip_pass_executor(pass->handle, true, frame_data.buffered_frame_number))
+			{
+				pass->executor(*this, frame_data, command_buffer);
+			}
 		}
 		else
 		{
-			setup_physical_pass_and_resources(gfx_context, swapchain, pass, frame_data, command_buffer);
+			prepare_pass(gfx_context, swapchain, pass, frame_data);
 
-			{
-				const uint32_t pass_type_index = static_cast<uint32_t>(DescriptorSetType::Pass);
+			bind_pass_state(gfx_context, pass, frame_data, command_buffer);
 
-				DescriptorDataList& descriptor_data_list = pass_cache.descriptors[frame_data.buffered_frame_number][pass->pass_config.name];
-				if (pass_type_index < descriptor_data_list.descriptor_sets.size())
-				{
-					frame_data.pass_descriptor_set = descriptor_data_list.descriptor_sets[pass_type_index];
-				}
-			}
+			execute_pass_barriers(gfx_context, pass, frame_data.buffered_frame_number, command_buffer);
 
-			frame_data.pass_pipeline_state = pass->pipeline_state_id;
+			// Skipped passes still begin and end their render pass, so their attachments are cleared and transitioned as usual
+			const bool b_skip_executor = skip_pass_executor(pass->handle, is_pass_pipeline_ready(pass), frame_data.buffered_frame_number);
 
 			if ((pass->pass_config.flags & RenderPassFlags::Compute) != RenderPassFlags::None)
 			{
-				pass->executor(*this, frame_data, command_buffer);
+				if (!b_skip_executor)
+				{
+					pass->executor(*this, frame_data, command_buffer);
+				}
 			}
 			else
 			{
 				RenderPass* const physical_pass = CACHE_FETCH(RenderPass, pass->physical_id);
-				assert(physical_pass != nullptr);
-
-				frame_data.current_pass = pass->physical_id;
-
 				physical_pass->begin_pass(gfx_context, pass->pass_config.b_is_present_pass ? swapchain->get_current_image_index(frame_data.buffered_frame_number) : 0, command_buffer);
-				pass->executor(*this, frame_data, command_buffer);
+				if (!b_skip_executor)
+				{
+					pass->executor(*this, frame_data, command_buffer);
+				}
 				physical_pass->end_pass(gfx_context, command_buffer);
 			}
 
+			finish_pass(pass, frame_data);
+
 			update_transient_resources(gfx_context, pass, frame_data.buffered_frame_number);
 		}
 	}
 
-	void RenderGraph::setup_physical_pass_and_resources(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data, void* command_buffer)
+	void RenderGraph::prepare_pass(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data)
+	{
+		setup_physical_pass_and_resources(gfx_context, swapchain, pass, frame_data);
+
+		{
+			const uint32_t pass_type_index = static_cast<uint32_t>(DescriptorSetType::Pass);
+
+			DescriptorDataList& descriptor_data_list = pass_cache.descriptors[frame_data.buffered_frame_number][pass->pass_config.name];
+			if (pass_type_index < descriptor_data_list.descriptor_sets.size())
+			{
+				frame_data.pass_descriptor_set = descriptor_data_list.descriptor_sets[pass_type_index];
+			}
+		}
+
+		frame_data.pass_pipeline_state = pass->pipeline_state_id;
+
+		if ((pass->pass_config.flags & RenderPassFlags::Compute) == RenderPassFlags::None)
+		{
+			assert(CACHE_FETCH(RenderPass, pass->physical_id) != nullptr);
+			frame_data.current_pass = pass->physical_id;
+		}
+
+		if (pass->parameters.record_setup)
+		{
+			pass->parameters.record_setup(*this, frame_data);
+		}
+	}
+
+	void RenderGraph::finish_pass(RGPass* pass, RGFrameData& frame_data)
+	{
+		if (pass->parameters.record_finish)
+		{
+			pass->parameters.record_finish(*this, frame_data);
+		}
+	}
+
+	bool RenderGraph::is_pass_pipeline_ready(RGPass* pass) const
+	{
+		return pass->pipeline_state_id == 0 || CACHE_FETCH(PipelineState, pass->pipeline_state_id)->is_ready();
+	}
+
+	void RenderGraph::reset_skipped_passes(int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		registry.skipped_passes.assign(registry.render_passes.size(), false);
+		registry.unwritten_resources.assign(registry.resources.size(), false);
+	}
+
+	bool RenderGraph::skip_pass_executor(RGPassHandle pass_handle, bool b_pipeline_ready, int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+		const RGPass* const pass = registry.render_passes[pass_handle];
+
+		// A pass whose pipeline is still being created leaves its outputs unwritten, so anything reading them later in the
+		// frame (i.e. draws reading a skipped cull pass' indirect arguments) has to be skipped as well
+		bool b_skip = !b_pipeline_ready;
+		for (RGResourceHandle resource : pass->parameters.inputs)
+		{
+			const RGResourceIndex resource_index = get_graph_resource_index(resource);
+			b_skip = b_skip || (static_cast<size_t>(resource_index) < registry.unwritten_resources.size() && registry.unwritten_resources[resource_index]);
+		}
+
+		for (RGResourceHandle resource : pass->parameters.outputs)
+		{
+			const RGResourceIndex resource_index = get_graph_resource_index(resource);
+			if (static_cast<size_t>(resource_index) < registry.unwritten_resources.size())
+			{
+				registry.unwritten_resources[resource_index] = b_skip;
+			}
+		}
+
+		registry.skipped_passes[pass_handle] = b_skip;
+		return b_skip;
+	}
+
+	void RenderGraph::bind_pass_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer)
+	{
+		if (pass->pipeline_state_id != 0 && CACHE_FETCH(PipelineState, pass->pipeline_state_id)->is_ready())
+		{
+			CACHE_FETCH(PipelineState, pass->pipeline_state_id)->bind(gfx_context, command_buffer);
+		}
+
+		bind_pass_descriptors(gfx_context, pass, frame_data, command_buffer);
+
+		push_pass_constants(gfx_context, pass, command_buffer);
+	}
+
+	void RenderGraph::execute_pass_barriers(class GraphicsContext* const gfx_context, RGPass* pass, int32_t buffered_frame_number, void* command_buffer)
+	{
+		// Terribly weak synchronization here, but render graph barriers are meant to coarsely cover synch cases since we can't know exactly what access and layout states
+		// resources will be in, and therefore we have no guarantees we can use to guard against using incompatible access masks for a given stage. More specific synch should
+		// be handled by the application.
+		PipelineStageType barrier_execution_stage = (pass->pass_config.flags & RenderPassFlags::Compute) != RenderPassFlags::None
+			? PipelineStageType::AllCommands
+			: PipelineStageType::AllGraphics;
+		registries[buffered_frame_number].barrier_batcher.execute(gfx_context, command_buffer, barrier_execution_stage, pass->pass_config.name);
+	}
+
+	void RenderGraph::setup_physical_pass_and_resources(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data)
 	{
 		RenderGraphRegistry& registry = registries[frame_data.buffered_frame_number];
 
@@ -602,7 +1361,7 @@ namespace Sunset
 
 		const auto setup_resource = [this, gfx_context, swapchain, pass, &frame_data, &registry, b_is_graphics_pass](RGResourceHandle resource, uint32_t resource_params_index, bool b_is_input_resource)
 		{
-			if (auto it = registry.resource_metadata.find(resource); it != registry.resource_metadata.end())
+			if (registry.resources.contains(resource))
 			{
 				setup_physical_resource(gfx_context, swapchain, pass, resource, frame_data, b_is_graphics_pass, b_is_input_resource);
 				if (b_is_graphics_pass)
@@ -634,21 +1393,9 @@ namespace Sunset
 
 		// Setup render pass pipeline state if render pass-level shader stages were provided. Otherwise, pipeline state should be handled
 		// and bound by render pass callbacks.
-		setup_pass_pipeline_state(gfx_context, pass, frame_data, command_buffer);
-
-		setup_pass_descriptors(gfx_context, pass, frame_data, command_buffer);
-
-		bind_pass_descriptors(gfx_context, pass, frame_data, command_buffer);
+		setup_pass_pipeline_state(gfx_context, pass, frame_data);
 
-		push_pass_constants(gfx_context, pass, command_buffer);
-
-		// Terribly weak synchronization here, but render graph barriers are meant to coarsely cover synch cases since we can't know exactly what access and layout states
-		// resources will be in, and therefore we have no guarantees we can use to guard against using incompatible access masks for a given stage. More specific synch should
-		// be handled by the application.
-		PipelineStageType barrier_execution_stage = (pass->pass_config.flags & RenderPassFlags::Compute) != RenderPassFlags::None
-			? PipelineStageType::AllCommands
-			: PipelineStageType::AllGraphics;
-		registry.barrier_batcher.execute(gfx_context, command_buffer, barrier_execution_stage, pass->pass_config.name);
+		setup_pass_descriptors(gfx_context, pass, frame_data);
 	}
 
 	void RenderGraph::setup_physical_resource(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGResourceHandle resource, RGFrameData& frame_data, bool b_is_graphics_pass, bool b_is_input_resource)
@@ -657,87 +1404,89 @@ namespace Sunset
 
 		const ResourceType resource_type = static_cast<ResourceType>(get_graph_resource_type(resource));
 		const RGResourceIndex resource_index = get_graph_resource_index(resource);
+		const uint64_t split_barrier_key = (static_cast<uint64_t>(resource_index) << 32) | static_cast<uint32_t>(pass->handle);
 		if (resource_type == ResourceType::Buffer)
 		{
-			RGBufferResource* const buffer_resource = registry.buffer_resources[resource_index];
+			RGBufferResource* const buffer_resource = registry.resources.buffers[resource_index];
+			size_t& physical_id = registry.resources.physical_ids[resource_index];
 			// We check for an empty ID first because registered external resources would have already had this field populated
-			if (registry.resource_metadata[resource].physical_id == 0)
+			if (physical_id == 0)
 			{
-				buffer_resource->config.name.computed_hash += frame_data.buffered_frame_number;
-
-				registry.resource_metadata[resource].physical_id = BufferFactory::create(gfx_context, buffer_resource->config, false);
-
-				if (!registry.resource_metadata[resource].b_is_persistent)
-				{
-					registry.resource_deletion_queue.remove_execution(registry.resource_metadata[resource].physical_id);
-					registry.resource_deletion_queue.push_execution([gfx_context, physical_id = registry.resource_metadata[resource].physical_id]()
-						{
-							CACHE_DELETE(Buffer, physical_id, gfx_context);
-						},
-						registry.resource_metadata[resource].physical_id,
-						registry.resource_metadata[resource].max_frame_lifetime
-					);
-				}
+				physical_id = transient_buffer_pool.acquire(gfx_context, buffer_resource->config);
+				registry.pooled_buffers.push_back(physical_id);
 			}
 
 			// Add a buffer barrier if the requested access flags seem different than the current buffer state
-			if (!registry.resource_metadata[resource].access_flags.empty())
+			const std::pmr::vector<AccessFlags>& resource_access_flags = registry.resources.access_flags[resource_index];
+			if (!resource_access_flags.empty())
 			{
-				Buffer* const buffer = CACHE_FETCH(Buffer, registry.resource_metadata[resource].physical_id);
-				const AccessFlags access_flags = registry.resource_metadata[resource].access_flags[pass->handle];
-				if (buffer->get_access_flags() != access_flags)
+				Buffer* const buffer = CACHE_FETCH(Buffer, physical_id);
+				const AccessFlags access_flags = resource_access_flags[pass->handle];
+				if (resource_state_needs_barrier(buffer->get_access_flags(), ImageLayout::Undefined, access_flags, ImageLayout::Undefined))
 				{
-					registry.barrier_batcher.add_buffer_barrier(
-						gfx_context,
-						buffer,
-						pass->pass_config.name,
-						access_flags
-					);
+					if (const auto split_it = registry.split_barrier_acquires.find(split_barrier_key); split_it != registry.split_barrier_acquires.end())
+					{
+						registry.barrier_batcher.add_split_buffer_barrier(gfx_context, buffer, pass->pass_config.name, access_flags, split_it->second);
+					}
+					else
+					{
+						registry.barrier_batcher.add_buffer_barrier(
+							gfx_context,
+							buffer,
+							pass->pass_config.name,
+							access_flags
+						);
+					}
 				}
 			}
 		}
 		else if (resource_type == ResourceType::Image)
 		{
-			RGImageResource* const image_resource = registry.image_resources[resource_index];
+			RGImageResource* const image_resource = registry.resources.images[resource_index];
+			size_t& physical_id = registry.resources.physical_ids[resource_index];
 			const bool b_is_local_load = (image_resource->config.flags & ImageFlags::LocalLoad) != ImageFlags::None;
 			const bool b_is_persistent = b_is_graphics_pass && (!b_is_input_resource || b_is_local_load);
 			// We check for an empty ID first because registered external resources would have already had this field populated
-			if (registry.resource_metadata[resource].physical_id == 0)
+			if (physical_id == 0)
 			{
-				registry.resource_metadata[resource].b_is_persistent |= b_is_persistent;
-
-				image_resource->config.name.computed_hash += frame_data.buffered_frame_number;
+				registry.resources.persistent_flags[resource_index] |= static_cast<uint8_t>(b_is_persistent);
 
-				registry.resource_metadata[resource].physical_id = ImageFactory::create(gfx_context, image_resource->config, b_is_persistent);
-
-				if (!registry.resource_metadata[resource].b_is_persistent)
+				if (registry.resources.persistent_flags[resource_index])
 				{
-					registry.resource_deletion_queue.remove_execution(registry.resource_metadata[resource].physical_id);
-					registry.resource_deletion_queue.push_execution([gfx_context, physical_id = registry.resource_metadata[resource].physical_id]()
-						{
-							CACHE_DELETE(Image, physical_id, gfx_context);
-						},
-						registry.resource_metadata[resource].physical_id,
-						registry.resource_metadata[resource].max_frame_lifetime
-					);
+					image_resource->config.name.computed_hash += frame_data.buffered_frame_number;
+					physical_id = ImageFactory::create(gfx_context, image_resource->config, b_is_persistent);
+				}
+				else
+				{
+					physical_id = transient_image_pool.acquire(gfx_context, image_resource->config);
+					registry.pooled_images.push_back(physical_id);
 				}
 			}
 
 			// Add an image barrier if the requested access flags and image layout seem different than the current image state
-			if (!registry.resource_metadata[resource].access_flags.empty() && !registry.resource_metadata[resource].layouts.empty())
+			const std::pmr::vector<AccessFlags>& resource_access_flags = registry.resources.access_flags[resource_index];
+			const std::pmr::vector<ImageLayout>& resource_layouts = registry.resources.layouts[resource_index];
+			if (!resource_access_flags.empty() && !resource_layouts.empty())
 			{
-				Image* const image = CACHE_FETCH(Image, registry.resource_metadata[resource].physical_id);
-				const AccessFlags access_flags = registry.resource_metadata[resource].access_flags[pass->handle];
-				const ImageLayout layout = registry.resource_metadata[resource].layouts[pass->handle];
-				if (image->get_access_flags() != access_flags || image->get_layout() != layout)
+				Image* const image = CACHE_FETCH(Image, physical_id);
+				const AccessFlags access_flags = resource_access_flags[pass->handle];
+				const ImageLayout layout = resource_layouts[pass->handle];
+				if (resource_state_needs_barrier(image->get_access_flags(), image->get_layout(), access_flags, layout))
 				{
-					registry.barrier_batcher.add_image_barrier(
-						gfx_context,
-						image,
-						pass->pass_config.name,
-						access_flags,
-						layout
-					);
+					if (const auto split_it = registry.split_barrier_acquires.find(split_barrier_key); split_it != registry.split_barrier_acquires.end())
+					{
+						registry.barrier_batcher.add_split_image_barrier(gfx_context, image, pass->pass_config.name, access_flags, layout, split_it->second);
+					}
+					else
+					{
+						registry.barrier_batcher.add_image_barrier(
+							gfx_context,
+							image,
+							pass->pass_config.name,
+							access_flags,
+							layout
+						);
+					}
 				}
 			}
 		}
@@ -751,12 +1500,12 @@ namespace Sunset
 		const RGResourceIndex resource_index = get_graph_resource_index(resource);
 		if (resource_type == ResourceType::Image)
 		{
-			RGImageResource* const image_resource = registry.image_resources[resource_index];
+			RGImageResource* const image_resource = registry.resources.images[resource_index];
 			const bool b_is_local_load = (image_resource->config.flags & ImageFlags::LocalLoad) != ImageFlags::None;
 			if (!b_is_input_resource || b_is_local_load)
 			{
 				const uint32_t image_view_index = pass->parameters.output_views.size() > resource_params_index ? pass->parameters.output_views[resource_params_index] : 0;
-				pass->pass_config.attachments.push_back({ .image = registry.resource_metadata[resource].physical_id, .image_view_index = image_view_index, .b_image_view_considers_layer_split = static_cast<bool>(image_resource->config.split_array_layer_views) });
+				pass->pass_config.attachments.push_back({ .image = registry.resources.physical_ids[resource_index], .image_view_index = image_view_index, .b_image_view_considers_layer_split = static_cast<bool>(image_resource->config.split_array_layer_views) });
 			}
 		}
 	}
@@ -769,7 +1518,7 @@ namespace Sunset
 		const RGResourceIndex resource_index = get_graph_resource_index(resource);
 		if (resource_type == ResourceType::Image)
 		{
-			RGImageResource* const image_resource = registry.image_resources[resource_index];
+			RGImageResource* const image_resource = registry.resources.images[resource_index];
 			if (image_resource->config.is_bindless)
 			{
 				pass->parameters.bindless_inputs.push_back(resource);
@@ -781,7 +1530,7 @@ namespace Sunset
 		}
 		else if (resource_type == ResourceType::Buffer)
 		{
-			RGBufferResource* const buffer_resource = registry.buffer_resources[resource_index];
+			RGBufferResource* const buffer_resource = registry.resources.buffers[resource_index];
 			if (buffer_resource->config.b_is_bindless)
 			{
 				pass->parameters.bindless_inputs.push_back(resource);
@@ -793,14 +1542,13 @@ namespace Sunset
 		}
 	}
 
-	void RenderGraph::setup_pass_pipeline_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer)
+	void RenderGraph::setup_pass_pipeline_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data)
 	{
 		// We don't "need" the additional pipeline state caching here since internally pipeline states are already cached
 		// based on the builder config, but this'll keep us from doing unnecessary per-frame calculations on pipeline state setup
 		if (pass_cache.pipeline_states[frame_data.buffered_frame_number].find(pass->pass_config.name) != pass_cache.pipeline_states[frame_data.buffered_frame_number].end())
 		{
 			pass->pipeline_state_id = pass_cache.pipeline_states[frame_data.buffered_frame_number][pass->pass_config.name];
-			CACHE_FETCH(PipelineState, pass->pipeline_state_id)->bind(gfx_context, command_buffer);
 			return;
 		}
 
@@ -888,7 +1636,6 @@ namespace Sunset
 
 		if (pass->pipeline_state_id != 0)
 		{
-			CACHE_FETCH(PipelineState, pass->pipeline_state_id)->bind(gfx_context, command_buffer);
 			pass_cache.pipeline_states[frame_data.buffered_frame_number][pass->pass_config.name] = pass->pipeline_state_id;
 		}
 
@@ -896,7 +1643,7 @@ namespace Sunset
 		pass_cache.descriptors[frame_data.buffered_frame_number][pass->pass_config.name].descriptor_sets.resize(descriptor_layouts.size(), nullptr);
 	}
 
-	void RenderGraph::setup_pass_descriptors(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer)
+	void RenderGraph::setup_pass_descriptors(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data)
 	{
 		RenderGraphRegistry& registry = registries[frame_data.buffered_frame_number];
 
@@ -948,7 +1695,7 @@ namespace Sunset
 					const ResourceType resource_type = static_cast<ResourceType>(get_graph_resource_type(resource));
 					if (resource_type == ResourceType::Image)
 					{
-						std::vector<DescriptorBindlessWrite> image_writes = DescriptorHelpers::new_descriptor_image_bindless_writes(pass_cache.global_descriptor_set[frame_data.buffered_frame_number], registry.resource_metadata[resource].physical_id, pass->parameters.b_split_input_image_mips);
+						std::vector<DescriptorBindlessWrite> image_writes = DescriptorHelpers::new_descriptor_image_bindless_writes(pass_cache.global_descriptor_set[frame_data.buffered_frame_number], registry.resources.physical_ids[get_graph_resource_index(resource)], pass->parameters.b_split_input_image_mips);
 						bindless_writes.insert(
 							bindless_writes.end(),
 							image_writes.begin(),
@@ -995,8 +1742,8 @@ namespace Sunset
 							std::vector<DescriptorWrite> descriptor_writes;
 							for (uint32_t j = 0; j < descriptor_bindings.size(); ++j)
 							{
-								const RGResourceHandle corresponding_binding_resource = pass->parameters.pass_inputs[j];
-								if (registry.resource_metadata[corresponding_binding_resource].b_is_persistent == b_persistent_resources)
+								const RGResourceIndex corresponding_binding_resource = get_graph_resource_index(pass->parameters.pass_inputs[j]);
+								if (static_cast<bool>(registry.resources.persistent_flags[corresponding_binding_resource]) == b_persistent_resources)
 								{
 									DescriptorWrite& new_write = descriptor_writes.emplace_back();
 									new_write.slot = descriptor_bindings[j].slot;
@@ -1005,12 +1752,12 @@ namespace Sunset
 
 									if (new_write.type == DescriptorType::Image || new_write.type == DescriptorType::StorageImage)
 									{
-										Image* const image = CACHE_FETCH(Image, registry.resource_metadata[corresponding_binding_resource].physical_id);
+										Image* const image = CACHE_FETCH(Image, registry.resources.physical_ids[corresponding_binding_resource]);
 										new_write.buffer_desc.buffer = image;
 									}
 									else
 									{
-										Buffer* const buffer = CACHE_FETCH(Buffer, registry.resource_metadata[corresponding_binding_resource].physical_id);
+										Buffer* const buffer = CACHE_FETCH(Buffer, registry.resources.physical_ids[corresponding_binding_resource]);
 										new_write.buffer_desc.buffer = buffer->get();
 										new_write.buffer_desc.buffer_range = buffer->get_size();
 										new_write.buffer_desc.buffer_size = buffer->get_size();
@@ -1108,22 +1855,39 @@ namespace Sunset
 		// TODO: Look into aliasing memory for expired resources as opposed to just flat out deleting them (though that should also be done)
 		for (RGResourceHandle input_resource : pass->parameters.inputs)
 		{
-			RGResourceMetadata& resource_meta = registry.resource_metadata[input_resource];
-			if (resource_meta.physical_id != 0 && resource_meta.last_user == pass->handle && !resource_meta.b_is_persistent)
+			const RGResourceIndex index = get_graph_resource_index(input_resource);
+			if (registry.resources.physical_ids[index] != 0 && registry.resources.last_users[index] == pass->handle && !registry.resources.persistent_flags[index])
 			{
 				// TODO: Transient resource memory aliasing
 			}
 		}
 		for (RGResourceHandle output_resource : pass->parameters.outputs)
 		{
-			RGResourceMetadata& resource_meta = registry.resource_metadata[output_resource];
-			if (resource_meta.physical_id != 0 && resource_meta.last_user == pass->handle && !resource_meta.b_is_persistent)
+			const RGResourceIndex index = get_graph_resource_index(output_resource);
+			if (registry.resources.physical_ids[index] != 0 && registry.resources.last_users[index] == pass->handle && !registry.resources.persistent_flags[index])
 			{
 				// TODO: Transient resource memory aliasing
 			}
 		}
 	}
 
+	void RenderGraph::release_pooled_resources(int32_t buffered_frame_number)
+	{
+		RenderGraphRegistry& registry = registries[buffered_frame_number];
+
+		for (const ImageID image : registry.pooled_images)
+		{
+			transient_image_pool.release(image);
+		}
+		registry.pooled_images.clear();
+
+		for (const BufferID buffer : registry.pooled_buffers)
+		{
+			transient_buffer_pool.release(buffer);
+		}
+		registry.pooled_buffers.clear();
+	}
+
 	void RenderGraph::free_physical_resources(class GraphicsContext* const gfx_context, int32_t current_buffered_frame)
 	{
 		ZoneScopedN("RenderGraph::free_physical_resources");
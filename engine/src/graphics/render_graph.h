@@ -3,12 +3,17 @@
 #include <common.h>
 
 #include <graphics/barrier_batcher.h>
+#include <graphics/barrier_planner.h>
+#include <graphics/command_recording_planner.h>
 #include <graphics/resource/image_types.h>
 #include <graphics/resource/buffer_types.h>
 #include <graphics/render_pass_types.h>
+#include <graphics/queue_schedule_planner.h>
+#include <graphics/transient_aliasing_planner.h>
+#include <graphics/transient_resource_pool.h>
 #include <memory/allocators/stack_allocator.h>
 
-#include <unordered_set>
+#include <memory_resource>
 
 namespace Sunset
 {
@@ -63,19 +68,19 @@ namespace Sunset
 		friend class RenderGraph;
 	};
 
+	// Snapshot of one resource's per-frame data, for inspecting a compiled graph
 	struct RGResourceMetadata
 	{
 		int32_t reference_count{ 0 };
 		size_t physical_id{ 0 };
-		RGPassHandle first_user;
-		RGPassHandle last_user;
+		RGPassHandle first_user{ -1 };
+		RGPassHandle last_user{ -1 };
 		std::vector<AccessFlags> access_flags;
 		std::vector<ImageLayout> layouts;
 		std::vector<RGPassHandle> producers;
 		std::vector<RGPassHandle> consumers;
 		bool b_is_persistent{ false };
 		bool b_is_bindless{ false };
-		uint32_t max_frame_lifetime{ 2 };
 	};
 
 	struct RGFrameData
@@ -88,6 +93,9 @@ namespace Sunset
 		PipelineStateID pass_pipeline_state{ 0 };
 		ExecutionQueue* resource_deletion_queue{ nullptr };
 		DescriptorBindlessResourceIndices pass_bindless_resources;
+		// Chunk of a ParallelRecord pass being recorded, executors draw their share of the pass's work for it
+		uint32_t record_chunk{ 0 };
+		uint32_t record_chunk_count{ 1 };
 	};
 
 	struct RGShaderDataSetup
@@ -125,6 +133,12 @@ namespace Sunset
 		bool b_split_input_image_mips{ false };
 		// Whether or not prevent this pass from getting culled during render graph compilation. 
 		bool b_force_keep_pass{ false };
+		// Number of chunks a ParallelRecord pass's executor is split into. Every chunk is recorded into its own command buffer on a job thread.
+		uint32_t record_chunk_count{ 1 };
+		// Optional, run on the recording thread once the pass is set up and before any of its executor chunks, for work that touches shared state
+		std::function<void(class RenderGraph&, RGFrameData&)> record_setup;
+		// Optional, run on the recording thread after every executor chunk of the pass has been recorded
+		std::function<void(class RenderGraph&, RGFrameData&)> record_finish;
 	};
 
 	struct RGPassCache
@@ -147,9 +161,78 @@ namespace Sunset
 		int32_t reference_count{ 0 };
 	};
 
-	using ImageResourceFrameAllocator = StaticFrameAllocator<RGImageResource, 256>;
-	using BufferResourceFrameAllocator = StaticFrameAllocator<RGBufferResource, 256>;
-	using RenderPassFrameAllocator = StaticFrameAllocator<RGPass, 128>;
+	struct RGCompiledResource
+	{
+		int32_t reference_count{ 0 };
+		RGPassHandle first_user{ -1 };
+		RGPassHandle last_user{ -1 };
+		std::vector<AccessFlags> access_flags;
+		std::vector<ImageLayout> layouts;
+	};
+
+	// Output of graph compilation for one graph structure. Stored per resource in the same order as the registry's resource handles.
+	struct RGCompiledGraph
+	{
+		// Everything the structure hash was computed from, so a hash collision can't hand back another graph's output
+		std::vector<size_t> structure_key;
+		// Compile cache clock value of the last compile that used this entry, for least recently used eviction
+		uint64_t last_used{ 0 };
+		std::vector<RGPassHandle> nonculled_passes;
+		std::vector<int32_t> pass_reference_counts;
+		std::vector<RGCompiledResource> resources;
+	};
+
+	struct RGCompileStats
+	{
+		uint64_t cache_hits{ 0 };
+		uint64_t cache_misses{ 0 };
+	};
+
+	constexpr size_t MAX_COMPILED_GRAPH_CACHE_SIZE = 16;
+	// Conservative placement alignments for transient memory, large enough for any image or buffer on desktop GPUs
+	constexpr size_t RG_TRANSIENT_IMAGE_ALIGNMENT = 64 * 1024;
+	constexpr size_t RG_TRANSIENT_BUFFER_ALIGNMENT = 256;
+
+	using ImageResourceFrameAllocator = StaticFrameAllocator<RGImageResource, 1024>;
+	using BufferResourceFrameAllocator = StaticFrameAllocator<RGBufferResource, 1024>;
+	using RenderPassFrameAllocator = StaticFrameAllocator<RGPass, 256>;
+
+	constexpr size_t RG_FRAME_ARENA_INITIAL_SIZE = 64 * 1024;
+
+	// Per-resource data for one frame, stored as parallel arrays indexed by get_graph_resource_index(handle). Everything is
+	// allocated from the registry's frame arena, so it is dropped in one go when the registry is reset.
+	struct RGResourceTable
+	{
+		std::pmr::vector<RGResourceHandle> handles;
+		// Only the entry matching the resource's type is set
+		std::pmr::vector<RGImageResource*> images;
+		std::pmr::vector<RGBufferResource*> buffers;
+		std::pmr::vector<int32_t> reference_counts;
+		std::pmr::vector<RGPassHandle> first_users;
+		std::pmr::vector<RGPassHandle> last_users;
+		std::pmr::vector<size_t> physical_ids;
+		std::pmr::vector<uint8_t> persistent_flags;
+		std::pmr::vector<uint8_t> bindless_flags;
+		std::pmr::vector<std::pmr::vector<RGPassHandle>> producers;
+		std::pmr::vector<std::pmr::vector<RGPassHandle>> consumers;
+		// Indexed by pass handle once set, empty until a barrier is computed or added for the resource
+		std::pmr::vector<std::pmr::vector<AccessFlags>> access_flags;
+		std::pmr::vector<std::pmr::vector<ImageLayout>> layouts;
+
+		void reset(std::pmr::memory_resource* const arena);
+		RGResourceHandle add(ResourceType type);
+
+		bool contains(RGResourceHandle handle) const
+		{
+			const RGResourceIndex index = get_graph_resource_index(handle);
+			return index >= 0 && static_cast<size_t>(index) < handles.size() && handles[index] == handle;
+		}
+
+		size_t size() const
+		{
+			return handles.size();
+		}
+	};
 
 	// All render graph registry resources (aside from render passes) should be transient and therefore do not need serious caching.
 	// For this reason the pass cache is the only thing we don't clear out per-frame. Any resource that need to survive multiple frames
@@ -157,12 +240,38 @@ namespace Sunset
 	class RenderGraphRegistry
 	{
 		friend class RenderGraph;
+	public:
+		RenderGraphRegistry()
+		{
+			resources.reset(&frame_arena);
+		}
+
 	protected:
-		std::vector<RGImageResource*> image_resources;
-		std::vector<RGBufferResource*> buffer_resources;
+		std::pmr::monotonic_buffer_resource frame_arena{ RG_FRAME_ARENA_INITIAL_SIZE };
 		std::vector<RGPass*> render_passes;
-		std::vector<RGResourceHandle> all_resource_handles;
-		phmap::flat_hash_map<RGResourceHandle, RGResourceMetadata> resource_metadata;
+		RGResourceTable resources;
+		// Set for passes removed by culling, indexed by pass handle
+		std::pmr::vector<uint8_t> culled_passes{ &frame_arena };
+		// Set for passes whose executor is skipped while recording, indexed by pass handle
+		std::pmr::vector<uint8_t> skipped_passes{ &frame_arena };
+		// Set for resources whose last writer so far this frame was skipped, indexed by dense resource index
+		std::pmr::vector<uint8_t> unwritten_resources{ &frame_arena };
+		// Graph created resources that are used this frame, in the same order as the aliasing plan's placements
+		std::vector<RGResourceHandle> transient_resources;
+		TransientAliasingPlan transient_aliasing_plan;
+		bool b_transient_aliasing_planned{ false };
+		// Pass and resource indices in the schedule refer to positions in the frame's nonculled passes and to dense resource indices
+		QueueSchedule queue_schedule;
+		// Indexed the same way as the queue schedule
+		BarrierPlan barrier_plan;
+		// Split barriers by the (resource index, pass handle) they are acquired at, and the splits released after each pass
+		phmap::flat_hash_map<uint64_t, uint32_t> split_barrier_acquires;
+		phmap::flat_hash_map<RGPassHandle, std::vector<uint32_t>> split_barrier_releases;
+		// Indexed by position in the frame's nonculled passes
+		CommandRecordingPlan recording_plan;
+		// Physical resources taken from the transient pools this frame, returned once the frame is submitted
+		std::vector<ImageID> pooled_images;
+		std::vector<BufferID> pooled_buffers;
 		BarrierBatcher barrier_batcher;
 		std::vector<BindingTableHandle> all_bindless_resource_handles;
 		ExecutionQueue resource_deletion_queue;
@@ -228,6 +337,67 @@ namespace Sunset
 
 		size_t get_physical_resource(RGResourceHandle resource, int32_t buffered_frame_number);
 
+		// Culls passes and computes resource lifetimes and barriers. Reuses a previous compilation if the graph has the same structure.
+		void compile(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number);
+
+		const std::vector<RGPassHandle>& get_nonculled_passes(int32_t buffered_frame_number) const
+		{
+			return nonculled_passes[buffered_frame_number];
+		}
+
+		std::optional<RGResourceMetadata> get_resource_metadata(RGResourceHandle resource, int32_t buffered_frame_number) const;
+
+		// Whether the pass's executor was skipped in the frame recorded last, see skip_pass_executor
+		bool is_pass_skipped(RGPassHandle pass, int32_t buffered_frame_number) const
+		{
+			const RenderGraphRegistry& registry = registries[buffered_frame_number];
+			return pass >= 0 && static_cast<size_t>(pass) < registry.skipped_passes.size() && registry.skipped_passes[pass];
+		}
+
+		const RGCompileStats& get_compile_stats() const
+		{
+			return compile_stats;
+		}
+
+		// The aliasing plan is only built when asked for after a compile, since nothing binds transients to it yet and image
+		// sizes are estimated from their configs rather than taken from the backend's memory requirements
+		const std::vector<RGResourceHandle>& get_transient_resources(int32_t buffered_frame_number)
+		{
+			ensure_transient_resource_aliasing(buffered_frame_number);
+			return registries[buffered_frame_number].transient_resources;
+		}
+
+		const TransientAliasingPlan& get_transient_aliasing_plan(int32_t buffered_frame_number)
+		{
+			ensure_transient_resource_aliasing(buffered_frame_number);
+			return registries[buffered_frame_number].transient_aliasing_plan;
+		}
+
+		const BarrierPlan& get_barrier_plan(int32_t buffered_frame_number) const
+		{
+			return registries[buffered_frame_number].barrier_plan;
+		}
+
+		const QueueSchedule& get_queue_schedule(int32_t buffered_frame_number) const
+		{
+			return registries[buffered_frame_number].queue_schedule;
+		}
+
+		const CommandRecordingPlan& get_recording_plan(int32_t buffered_frame_number) const
+		{
+			return registries[buffered_frame_number].recording_plan;
+		}
+
+		const TransientResourcePoolStats& get_transient_image_pool_stats() const
+		{
+			return transient_image_pool.get_stats();
+		}
+
+		const TransientResourcePoolStats& get_transient_buffer_pool_stats() const
+		{
+			return transient_buffer_pool.get_stats();
+		}
+
 	protected:
 		void update_reference_counts(RGPass* pass, RenderGraphRegistry& registry);
 		void update_resource_param_producers_and_consumers(RGPass* pass, RenderGraphRegistry& registry);
@@ -235,20 +405,40 @@ namespace Sunset
 		void cull_graph_passes(class GraphicsContext* const gfx_context, int32_t buffered_frame_number);
 		void compute_resource_first_and_last_users(class GraphicsContext* const gfx_context, int32_t buffered_frame_number);
 		void compute_resource_barriers(class GraphicsContext* const gfx_context, int32_t buffered_frame_number);
-		void compile(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number);
+		void plan_resource_barriers(int32_t buffered_frame_number);
+		void plan_transient_resource_aliasing(int32_t buffered_frame_number);
+		void ensure_transient_resource_aliasing(int32_t buffered_frame_number);
+		void schedule_pass_queues(int32_t buffered_frame_number);
+		void plan_pass_recording(int32_t buffered_frame_number);
+		size_t compute_graph_structure_hash(int32_t buffered_frame_number);
+		bool apply_compiled_graph(size_t structure_hash, int32_t buffered_frame_number);
+		void store_compiled_graph(size_t structure_hash, int32_t buffered_frame_number);
+
+		void submit_queue_schedule(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, int32_t buffered_frame_number, bool b_offline);
+		void record_queue_ownership_transfer(class GraphicsContext* const gfx_context, const QueueOwnershipTransfer& transfer, int32_t buffered_frame_number, bool b_acquire);
+		void record_passes(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGFrameData& frame_data, void* command_buffer);
+		void signal_split_barrier_releases(class GraphicsContext* const gfx_context, RGPass* pass, int32_t buffered_frame_number, void* command_buffer);
 
 		void execute_pass(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
-
-		void setup_physical_pass_and_resources(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
+		void prepare_pass(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data);
+		void finish_pass(RGPass* pass, RGFrameData& frame_data);
+		bool is_pass_pipeline_ready(RGPass* pass) const;
+		void reset_skipped_passes(int32_t buffered_frame_number);
+		bool skip_pass_executor(RGPassHandle pass_handle, bool b_pipeline_ready, int32_t buffered_frame_number);
+		void bind_pass_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
+		void execute_pass_barriers(class GraphicsContext* const gfx_context, RGPass* pass, int32_t buffered_frame_number, void* command_buffer);
+
+		void setup_physical_pass_and_resources(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGFrameData& frame_data);
 		void setup_physical_resource(class GraphicsContext* const gfx_context, class Swapchain* const swapchain, RGPass* pass, RGResourceHandle resource, RGFrameData& frame_data, bool b_is_graphics_pass = true, bool b_is_input_resource = false);
 		void tie_resource_to_pass_config_attachments(class GraphicsContext* const gfx_context, RGResourceHandle resource, RGPass* pass, int32_t buffered_frame_number, uint32_t resource_params_index, bool b_is_input_resource = false);
 		void setup_pass_input_resource_bindless_type(class GraphicsContext* const gfx_context, RGResourceHandle resource, RGPass* pass, int32_t buffered_frame_number);
-		void setup_pass_pipeline_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
-		void setup_pass_descriptors(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
+		void setup_pass_pipeline_state(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data);
+		void setup_pass_descriptors(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data);
 		void bind_pass_descriptors(class GraphicsContext* const gfx_context, RGPass* pass, RGFrameData& frame_data, void* command_buffer);
 		void push_pass_constants(class GraphicsContext* const gfx_context, RGPass* pass, void* command_buffer);
 		void update_transient_resources(class GraphicsContext* const gfx_context, RGPass* pass, int32_t buffered_frame_number);
 		void free_physical_resources(class GraphicsContext* const gfx_context, int32_t current_buffered_frame);
+		void release_pooled_resources(int32_t buffered_frame_number);
 
 		void reset(class GraphicsContext* const gfx_context, int32_t current_buffered_frame);
 
@@ -264,5 +454,15 @@ namespace Sunset
 		std::vector<RGPassHandle> nonculled_passes[MAX_BUFFERED_FRAMES];
 
 		std::vector<DescriptorBufferDesc> queued_buffer_global_writes[MAX_BUFFERED_FRAMES];
+
+		phmap::flat_hash_map<size_t, RGCompiledGraph> compiled_graph_cache;
+		std::vector<size_t> graph_structure_keys[MAX_BUFFERED_FRAMES];
+		uint64_t compiled_graph_cache_clock{ 0 };
+		RGCompileStats compile_stats;
+
+		TransientImagePool transient_image_pool;
+		TransientBufferPool transient_buffer_pool;
+
+		bool b_async_compute_queue_available{ false };
 	};
 }
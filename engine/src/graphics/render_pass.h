@@ -38,9 +38,10 @@ namespace Sunset
 			render_pass_policy.set_output_framebuffers(std::forward<std::vector<class Framebuffer*>>(framebuffers));
 		}
 
-		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer)
+		// Passes begun with secondary contents can only be recorded through secondary command buffers until they end
+		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer, bool b_secondary_contents = false)
 		{
-			render_pass_policy.begin_pass(gfx_context, framebuffer_index, command_buffer, pass_config);
+			render_pass_policy.begin_pass(gfx_context, framebuffer_index, command_buffer, pass_config, b_secondary_contents);
 		}
 
 		void end_pass(class GraphicsContext* const gfx_context, void* command_buffer)
@@ -82,7 +83,7 @@ namespace Sunset
 		void set_output_framebuffers(std::vector<class Framebuffer*>&& framebuffers)
 		{ }
 
-		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer, const RenderPassConfig& pass_config)
+		void begin_pass(class GraphicsContext* const gfx_context, uint32_t framebuffer_index, void* command_buffer, const RenderPassConfig& pass_config, bool b_secondary_contents)
 		{ }
 
 		void end_pass(class GraphicsContext* const gfx_context, void* command_buffer, const RenderPassConfig& pass_config)
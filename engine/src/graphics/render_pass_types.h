@@ -12,7 +12,9 @@ namespace Sunset
 		Compute = 0x00000001,
 		Graphics = 0x00000002,
 		Present = 0x00000004,
-		GraphLocal = 0x00000008 // For graph passes that should run locally, without creating and executing an actual GPU pass
+		GraphLocal = 0x00000008, // For graph passes that should run locally, without creating and executing an actual GPU pass
+		AsyncCompute = 0x00000010, // For compute passes that may run on the async compute queue when the device has one
+		ParallelRecord = 0x00000020 // For passes whose executor only records commands, so it can be recorded on a job thread alongside other passes
 	};
 
 	inline RenderPassFlags operator|(RenderPassFlags lhs, RenderPassFlags rhs)
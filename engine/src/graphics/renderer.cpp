@@ -31,6 +31,12 @@ namespace Sunset
 		});
 
 		render_graph.initialize(graphics_context.get());
+
+		upload_ring.initialize(graphics_context.get());
+
+		upload_scheduler.initialize(graphics_context->get_command_queue(DeviceQueueType::Graphics));
+
+		mesh_geometry_heap.initialize(graphics_context.get());
 	}
 
 	void Renderer::destroy()
@@ -43,8 +49,14 @@ namespace Sunset
 			graphics_context->advance_frame();
 		}
 
+		upload_scheduler.destroy(graphics_context.get());
+
+		mesh_geometry_heap.destroy(graphics_context.get());
+
 		render_graph.destroy(graphics_context.get());
 
+		upload_ring.destroy(graphics_context.get());
+
 		PipelineStateCache::get()->destroy(graphics_context.get());
 		ResourceStateCache::get()->destroy(graphics_context.get());
 
@@ -64,17 +76,22 @@ namespace Sunset
 		static ResourceStateID fullscreen_quad_resource_state = ResourceStateBuilder::create()
 			.set_vertex_buffer(fullscreen_quad->vertex_buffer)
 			.set_index_buffer(fullscreen_quad->sections[0].index_buffer)
+			.set_index_start(fullscreen_quad->sections[0].index_allocation.offset)
+			.set_vertex_offset(fullscreen_quad->vertex_allocation.offset)
 			.set_vertex_count(fullscreen_quad->vertices.size())
 			.set_index_count(fullscreen_quad->sections[0].indices.size())
 			.finish();
 
-		CACHE_FETCH(ResourceState, fullscreen_quad_resource_state)->bind(graphics_context.get(), command_buffer);
+		ResourceState* const resource_state = CACHE_FETCH(ResourceState, fullscreen_quad_resource_state);
+		resource_state->bind(graphics_context.get(), command_buffer);
 
 		graphics_context->draw_indexed(
 			command_buffer,
-			static_cast<uint32_t>(CACHE_FETCH(ResourceState, fullscreen_quad_resource_state)->state_data.index_count),
+			static_cast<uint32_t>(resource_state->state_data.index_count),
 			1,
-			0);
+			0,
+			resource_state->state_data.index_start,
+			resource_state->state_data.vertex_offset);
 	}
 
 	void Renderer::draw_unit_sphere(void* command_buffer)
@@ -85,17 +102,22 @@ namespace Sunset
 		static ResourceStateID unit_sphere_resource_state = ResourceStateBuilder::create()
 			.set_vertex_buffer(unit_sphere->vertex_buffer)
 			.set_index_buffer(unit_sphere->sections[0].index_buffer)
+			.set_index_start(unit_sphere->sections[0].index_allocation.offset)
+			.set_vertex_offset(unit_sphere->vertex_allocation.offset)
 			.set_vertex_count(unit_sphere->vertices.size())
 			.set_index_count(unit_sphere->sections[0].indices.size())
 			.finish();
 
-		CACHE_FETCH(ResourceState, unit_sphere_resource_state)->bind(graphics_context.get(), command_buffer);
+		ResourceState* const resource_state = CACHE_FETCH(ResourceState, unit_sphere_resource_state);
+		resource_state->bind(graphics_context.get(), command_buffer);
 
 		graphics_context->draw_indexed(
 			command_buffer,
-			static_cast<uint32_t>(CACHE_FETCH(ResourceState, unit_sphere_resource_state)->state_data.index_count),
+			static_cast<uint32_t>(resource_state->state_data.index_count),
 			1,
-			0);
+			0,
+			resource_state->state_data.index_start,
+			resource_state->state_data.vertex_offset);
 	}
 
 	void Renderer::draw_unit_cube(void* command_buffer)
@@ -106,17 +128,22 @@ namespace Sunset
 		static ResourceStateID unit_cube_resource_state = ResourceStateBuilder::create()
 			.set_vertex_buffer(unit_cube->vertex_buffer)
 			.set_index_buffer(unit_cube->sections[0].index_buffer)
+			.set_index_start(unit_cube->sections[0].index_allocation.offset)
+			.set_vertex_offset(unit_cube->vertex_allocation.offset)
 			.set_vertex_count(unit_cube->vertices.size())
 			.set_index_count(unit_cube->sections[0].indices.size())
 			.finish();
 
-		CACHE_FETCH(ResourceState, unit_cube_resource_state)->bind(graphics_context.get(), command_buffer);
+		ResourceState* const resource_state = CACHE_FETCH(ResourceState, unit_cube_resource_state);
+		resource_state->bind(graphics_context.get(), command_buffer);
 
 		graphics_context->draw_indexed(
 			command_buffer,
-			static_cast<uint32_t>(CACHE_FETCH(ResourceState, unit_cube_resource_state)->state_data.index_count),
+			static_cast<uint32_t>(resource_state->state_data.index_count),
 			1,
-			0);
+			0,
+			resource_state->state_data.index_start,
+			resource_state->state_data.vertex_offset);
 	}
 
 	void Renderer::wait_for_command_list_build()
@@ -135,11 +162,27 @@ namespace Sunset
 		wait_for_command_list_build();
 		wait_for_gpu();
 
-		task_allocator[graphics_context->get_buffered_frame_number()].reset();
-
 		render_graph.begin(graphics_context.get());
 	}
 
+	void Renderer::begin_upload_frame(uint32_t buffered_frame)
+	{
+		// begin_frame waited on this buffered frame's fence, so uploads from the last time it was drawn are done
+		upload_ring.begin_frame(graphics_context.get(), upload_frame_fence_values[buffered_frame]);
+		mesh_geometry_heap.begin_frame(upload_frame_fence_values[buffered_frame]);
+
+		upload_scheduler.retire(graphics_context.get());
+		// Submitted before recording so image layouts tracked on the CPU already reflect the uploads
+		upload_scheduler.flush(graphics_context.get());
+	}
+
+	void Renderer::end_upload_frame(uint32_t buffered_frame)
+	{
+		upload_frame_fence_values[buffered_frame] = ++last_upload_fence_value;
+		upload_ring.end_frame(upload_frame_fence_values[buffered_frame]);
+		mesh_geometry_heap.end_frame(upload_frame_fence_values[buffered_frame]);
+	}
+
 	void Renderer::queue_graph_command(Identity name, std::function<void(class RenderGraph&, RGFrameData&, void*)> command_callback)
 	{
 		render_graph.add_pass(
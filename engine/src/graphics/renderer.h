@@ -6,6 +6,9 @@
 #include <graphics/render_graph.h>
 #include <graphics/mesh_task_queue.h>
 #include <graphics/mesh_render_task.h>
+#include <graphics/upload_ring_buffer.h>
+#include <graphics/upload_scheduler.h>
+#include <graphics/mesh_geometry_heap.h>
 #include <graphics/resource/swapchain.h>
 
 namespace Sunset
@@ -33,8 +36,12 @@ namespace Sunset
 					swapchain->request_next_image(graphics_context.get(), buffered_frame);
 				}
 
+				begin_upload_frame(buffered_frame);
+
 				b_last_work_submitted = strategy.render(graphics_context.get(), render_graph, swapchain, buffered_frame, b_offline);
 
+				end_upload_frame(buffered_frame);
+
 				if (!b_offline && b_last_work_submitted)
 				{
 					swapchain->present(graphics_context.get(), DeviceQueueType::Graphics, buffered_frame);
@@ -64,9 +71,19 @@ namespace Sunset
 				return mesh_task_queue[buffered_frame_number];
 			}
 
-			inline MeshRenderTask* fresh_rendertask()
+			inline UploadRingBuffer& get_upload_ring()
+			{
+				return upload_ring;
+			}
+
+			inline UploadScheduler& get_upload_scheduler()
+			{
+				return upload_scheduler;
+			}
+
+			inline MeshGeometryHeap& get_mesh_geometry_heap()
 			{
-				return task_allocator[graphics_context->get_buffered_frame_number()].get_new();
+				return mesh_geometry_heap;
 			}
 
 			inline DrawCullData& get_draw_cull_data(int32_t buffered_frame_number)
@@ -92,6 +109,8 @@ namespace Sunset
 
 			void wait_for_command_list_build();
 			void begin_frame();
+			void begin_upload_frame(uint32_t buffered_frame);
+			void end_upload_frame(uint32_t buffered_frame);
 			void queue_graph_command(Identity name, std::function<void(class RenderGraph&, RGFrameData&, void*)> command_callback);
 			void register_persistent_image(Identity id, ImageID image);
 			ImageID get_persistent_image(Identity id, uint32_t buffered_frame = 0);
@@ -107,11 +126,16 @@ namespace Sunset
 			std::unique_ptr<GraphicsContext> graphics_context;
 			class Swapchain* swapchain;
 
-			MeshRenderTaskFrameAllocator task_allocator[MAX_BUFFERED_FRAMES];
 			MeshTaskQueue mesh_task_queue[MAX_BUFFERED_FRAMES];
 			DrawCullData current_draw_cull_data[MAX_BUFFERED_FRAMES];
 			RenderGraph render_graph;
 			phmap::parallel_flat_hash_map<Identity, ImageID> persistent_image_map;
+			UploadRingBuffer upload_ring;
+			UploadScheduler upload_scheduler;
+			MeshGeometryHeap mesh_geometry_heap;
+			// Fence value of the last upload frame recorded for each buffered frame
+			uint64_t upload_frame_fence_values[MAX_BUFFERED_FRAMES]{ 0 };
+			uint64_t last_upload_fence_value{ 0 };
 
 			bool b_last_work_submitted{ true };
 			std::atomic_bool building_command_list[MAX_BUFFERED_FRAMES];
@@ -15,6 +15,7 @@ namespace Sunset
 		uint32_t count;
 		uint32_t section_index_start;
 		uint32_t section_index_count;
+		int32_t section_vertex_offset;
 	};
 
 	struct IndirectDrawData
@@ -54,9 +54,9 @@ namespace Sunset
 			buffer_policy.copy_from(gfx_context, data, buffer_size, buffer_offset, memcpy_op);
 		}
 
-		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0)
+		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0, size_t other_buffer_offset = 0)
 		{
-			buffer_policy.copy_buffer(gfx_context, command_buffer, other, buffer_size, buffer_offset);
+			buffer_policy.copy_buffer(gfx_context, command_buffer, other, buffer_size, buffer_offset, other_buffer_offset);
 		}
 
 		char* map_gpu(class GraphicsContext* const gfx_context)
@@ -131,29 +131,46 @@ namespace Sunset
 		}
 	};
 
+	// Keeps a CPU copy of everything written to it, so uploads can be checked without a graphics device
 	class NoopBuffer
 	{
 	public:
 		NoopBuffer() = default;
 
 		void initialize(class GraphicsContext* const gfx_context, const BufferConfig& config)
-		{ }
+		{
+			memory.resize(config.buffer_size, 0);
+		}
 
 		void reallocate(class GraphicsContext* const gfx_context, const BufferConfig& config)
-		{ }
+		{
+			memory.resize(config.buffer_size, 0);
+		}
 
 		void destroy(class GraphicsContext* const gfx_context)
-		{ }
+		{
+			memory.clear();
+		}
 
 		void copy_from(class GraphicsContext* const gfx_context, void* data, size_t buffer_size, size_t buffer_offset = 0, std::function<void(void*)> memcpy_op = {})
-		{ }
+		{
+			assert(buffer_offset + buffer_size <= memory.size() && "Cannot copy past the end of a buffer");
+			if (memcpy_op)
+			{
+				memcpy_op(memory.data() + buffer_offset);
+			}
+			else
+			{
+				std::copy_n(static_cast<const char*>(data), buffer_size, memory.data() + buffer_offset);
+			}
+		}
 
-		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0)
+		void copy_buffer(class GraphicsContext* const gfx_context, void* command_buffer, class Buffer* other, size_t buffer_size, size_t buffer_offset = 0, size_t other_buffer_offset = 0)
 		{ }
 
 		char* map_gpu(class GraphicsContext* const gfx_context)
 		{
-			return nullptr;
+			return memory.data();
 		}
 
 		void unmap_gpu(class GraphicsContext* const gfx_context)
@@ -167,7 +184,7 @@ namespace Sunset
 
 		void* get()
 		{
-			return nullptr;
+			return memory.data();
 		}
 
 		AccessFlags get_access_flags() const
@@ -177,11 +194,14 @@ namespace Sunset
 
 		size_t get_size() const
 		{
-			return 0;
+			return memory.size();
 		}
 
 		void set_access_flags(AccessFlags access)
 		{ }
+
+	private:
+		std::vector<char> memory;
 	};
 
 #if USE_VULKAN_GRAPHICS
@@ -105,21 +105,23 @@ namespace Sunset
 				image_config.mip_count = image_info.mips;
 				image->initialize(gfx_context, image_config);
 
-				{
-					ZoneScopedN("ImageFactory::load: copy_from_buffer");
-					gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit_immediate(gfx_context, 0, [image, image_info, staging_buffer, gfx_context, mip_count = image_config.mip_count](void* command_buffer)
+				Renderer::get()->get_upload_scheduler().enqueue(
+					[image, image_info, staging_buffer, gfx_context, mip_count = image_config.mip_count](void* command_buffer)
 					{
+						ZoneScopedN("ImageFactory::load: copy_from_buffer");
 						size_t current_buffer_offset = 0;
 						for (uint32_t mip = 0; mip < mip_count; ++mip)
 						{
 							image->copy_from_buffer(gfx_context, command_buffer, staging_buffer, current_buffer_offset, mip);
 							current_buffer_offset += image_info.mip_buffer_start_indices[mip];
 						}
-					});
-				}
+					},
+					[gfx_context, staging_buffer_id]()
+					{
+						CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
+					}
+				);
 			}
-
-			CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
 		}
 
 		return image_id;
@@ -203,25 +205,29 @@ namespace Sunset
 			image_config.array_count = 6;
 			image->initialize(gfx_context, image_config);
 
-			gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit_immediate(gfx_context, 0, [image, staging_buffer, mip_buffer_offsets, image_config, gfx_context](void* command_buffer)
-			{
-				for (uint32_t i = 0; i < image_config.mip_count; ++i)
+			Renderer::get()->get_upload_scheduler().enqueue(
+				[image, staging_buffer, mip_buffer_offsets, image_config, gfx_context](void* command_buffer)
 				{
-					image->copy_from_buffer(gfx_context, command_buffer, staging_buffer, mip_buffer_offsets[i], i, 0, 6);
-					image->barrier(
-						gfx_context,
-						command_buffer,
-						AccessFlags::ShaderRead,
-						AccessFlags::None,
-						ImageLayout::ShaderReadOnly,
-						ImageLayout::TransferDestination,
-						PipelineStageType::FragmentShader,
-						PipelineStageType::TopOfPipe
-					);
+					for (uint32_t i = 0; i < image_config.mip_count; ++i)
+					{
+						image->copy_from_buffer(gfx_context, command_buffer, staging_buffer, mip_buffer_offsets[i], i, 0, 6);
+						image->barrier(
+							gfx_context,
+							command_buffer,
+							AccessFlags::ShaderRead,
+							AccessFlags::None,
+							ImageLayout::ShaderReadOnly,
+							ImageLayout::TransferDestination,
+							PipelineStageType::FragmentShader,
+							PipelineStageType::TopOfPipe
+						);
+					}
+				},
+				[gfx_context, staging_buffer_id]()
+				{
+					CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
 				}
-			});
-
-			CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
+			);
 		}
 
 		return image_id;
@@ -21,6 +21,58 @@ namespace Sunset
 		MirroredEdgeClamp
 	};
 
+	inline uint32_t get_format_pixel_size(Format format)
+	{
+		switch (format)
+		{
+			case Format::Int8:
+			case Format::Uint8:
+				return 1;
+			case Format::Float16:
+			case Format::Int16:
+			case Format::Uint16:
+			case Format::Int2x8:
+			case Format::Uint2x8:
+				return 2;
+			case Format::Int3x8:
+			case Format::Uint3x8:
+				return 3;
+			case Format::Float32:
+			case Format::Int32:
+			case Format::Uint32:
+			case Format::Float2x16:
+			case Format::Int2x16:
+			case Format::Uint2x16:
+			case Format::Int4x8:
+			case Format::Uint4x8:
+			case Format::FloatDepth32:
+			case Format::SRGB8x4:
+			case Format::UNorm4x8:
+				return 4;
+			case Format::Float3x16:
+			case Format::Int3x16:
+			case Format::Uint3x16:
+				return 6;
+			case Format::Float2x32:
+			case Format::Int2x32:
+			case Format::Uint2x32:
+			case Format::Float4x16:
+			case Format::Int4x16:
+			case Format::Uint4x16:
+				return 8;
+			case Format::Float3x32:
+			case Format::Int3x32:
+			case Format::Uint3x32:
+				return 12;
+			case Format::Float4x32:
+			case Format::Int4x32:
+			case Format::Uint4x32:
+				return 16;
+			default:
+				return 0;
+		}
+	}
+
 	struct AttachmentConfig // About 30 bytes per config. Could probably be slimmed down by removing members we don't need frequent access to on the CPU.
 	{
 		Identity name;
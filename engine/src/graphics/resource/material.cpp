@@ -81,7 +81,7 @@ namespace Sunset
 		material_set_uniform_emissive(gfx_context, material, material_ptr->description.uniform_emissive);
 	}
 
-	void material_update(class GraphicsContext* const gfx_context, MaterialID material, class DescriptorSet* descriptor_set, int32_t buffered_frame_number)
+	void material_update(class GraphicsContext* const gfx_context, MaterialID material, class DescriptorSet* descriptor_set, int32_t buffered_frame_number, DescriptorWriteBatch& descriptor_writes)
 	{
 		Material* const material_ptr = CACHE_FETCH(Material, material);
 		assert(material_ptr != nullptr && "Cannot load material textures for a null material!");
@@ -108,7 +108,7 @@ namespace Sunset
 
 			const uint32_t bound_texture_handles_offset = buffered_frame_number * MAX_MATERIAL_TEXTURES;
 
-			DescriptorHelpers::write_bindless_descriptors(gfx_context, bindless_writes, material_ptr->bound_texture_handles.data() + bound_texture_handles_offset);
+			DescriptorHelpers::queue_bindless_descriptors(bindless_writes, material_ptr->bound_texture_handles.data() + bound_texture_handles_offset, descriptor_writes);
 
 			for (uint32_t i = 0; i < MAX_MATERIAL_TEXTURES; ++i)
 			{
@@ -125,19 +125,22 @@ namespace Sunset
 
 		if (material_ptr->b_dirty[buffered_frame_number])
 		{
-			// Update mapped SSBO data
-			Buffer* const material_buffer = CACHE_FETCH(Buffer, MaterialGlobals::get()->material_data.data_buffer[buffered_frame_number]);
-			material_buffer->copy_from(
-				gfx_context,
-				material_ptr->gpu_data[buffered_frame_number],
-				sizeof(MaterialData),
-				sizeof(MaterialData) * material_ptr->gpu_data_buffer_offset[buffered_frame_number]
-			);
+			// Each frame has its own data slot, which gets copied with the other dirty slots in material_upload_dirty_data
+			MaterialGlobals::get()->material_data.mark_dirty(material_ptr->gpu_data_buffer_offset[buffered_frame_number], buffered_frame_number);
 
 			material_ptr->b_dirty[buffered_frame_number] = false;
 		}
 	}
 
+	void material_upload_dirty_data(class GraphicsContext* const gfx_context, int32_t buffered_frame_number)
+	{
+		ZoneScopedN("material_upload_dirty_data");
+
+		MaterialDataShared& material_data = MaterialGlobals::get()->material_data;
+		Buffer* const material_buffer = CACHE_FETCH(Buffer, material_data.data_buffer[buffered_frame_number]);
+		material_data.upload(gfx_context, material_buffer, buffered_frame_number);
+	}
+
 	void material_set_texture_tiling(class GraphicsContext* const gfx_context, MaterialID material, uint32_t texture_index, float texture_tiling)
 	{
 		Material* const material_ptr = CACHE_FETCH(Material, material);
@@ -58,7 +58,10 @@ namespace Sunset
 
 	void material_load_textures(class GraphicsContext* const gfx_context, MaterialID material);
 	void material_set_gpu_params(class GraphicsContext* const gfx_context, MaterialID material);
-	void material_update(class GraphicsContext* const gfx_context, MaterialID material, class DescriptorSet* descriptor_set, int32_t buffered_frame_number);
+	// Texture descriptor writes are queued into the batch rather than pushed, so the caller can flush every material's writes at once
+	void material_update(class GraphicsContext* const gfx_context, MaterialID material, class DescriptorSet* descriptor_set, int32_t buffered_frame_number, class DescriptorWriteBatch& descriptor_writes);
+	// Copies material data updated for this frame into the frame's material buffer
+	void material_upload_dirty_data(class GraphicsContext* const gfx_context, int32_t buffered_frame_number);
 	void material_set_texture_tiling(class GraphicsContext* const gfx_context, MaterialID material, uint32_t texture_index, float texture_tiling);
 	void material_set_color(class GraphicsContext* const gfx_context, MaterialID material, glm::vec3 color);
 	void material_set_uniform_roughness(class GraphicsContext* const gfx_context, MaterialID material, float roughness);
@@ -1,4 +1,5 @@
 #include <graphics/resource/mesh.h>
+#include <graphics/resource/mesh_lod.h>
 #include <graphics/graphics_context.h>
 #include <graphics/resource/buffer.h>
 #include <graphics/asset_pool.h>
@@ -10,8 +11,16 @@ namespace Sunset
 {
 	void upload_mesh(GraphicsContext* const gfx_context, Mesh* mesh)
 	{
+		MeshGeometryHeap& geometry_heap = Renderer::get()->get_mesh_geometry_heap();
+
+		mesh->vertex_allocation = geometry_heap.upload_vertices(gfx_context, mesh->vertices.data(), static_cast<uint32_t>(mesh->vertices.size()));
+		if (mesh->vertex_allocation.is_valid())
+		{
+			mesh->vertex_buffer = geometry_heap.get_vertex_buffer();
+		}
+		else
 		{
-			// Upload vertex buffer
+			// Upload to a dedicated vertex buffer when the heap is out of room
 			const size_t vertex_data_size = mesh->vertices.size() * sizeof(Vertex);
 
 			std::string buffer_name = std::to_string(mesh->name.computed_hash);
@@ -42,20 +51,31 @@ namespace Sunset
 				}
 			);
 
-			gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit_immediate(gfx_context, 0, [mesh, gfx_context, vertex_staging_buffer, vertex_data_size](void* command_buffer)
-			{
-				Buffer* const vertex_buffer_obj = CACHE_FETCH(Buffer, mesh->vertex_buffer);
-				vertex_buffer_obj->copy_buffer(gfx_context, command_buffer, vertex_staging_buffer, vertex_data_size);
-			});
-
-			CACHE_DELETE(Buffer, vertex_staging_buffer_id, gfx_context);
+			Renderer::get()->get_upload_scheduler().enqueue(
+				[vertex_buffer = mesh->vertex_buffer, gfx_context, vertex_staging_buffer, vertex_data_size](void* command_buffer)
+				{
+					Buffer* const vertex_buffer_obj = CACHE_FETCH(Buffer, vertex_buffer);
+					vertex_buffer_obj->copy_buffer(gfx_context, command_buffer, vertex_staging_buffer, vertex_data_size);
+				},
+				[gfx_context, vertex_staging_buffer_id]()
+				{
+					CACHE_DELETE(Buffer, vertex_staging_buffer_id, gfx_context);
+				}
+			);
 		}
 
 		for (uint32_t i = 0; i < mesh->sections.size(); ++i)
 		{
 			MeshSection& section = mesh->sections[i];
 
-			// Upload index buffer
+			section.index_allocation = geometry_heap.upload_indices(gfx_context, section.indices.data(), static_cast<uint32_t>(section.indices.size()));
+			if (section.index_allocation.is_valid())
+			{
+				section.index_buffer = geometry_heap.get_index_buffer();
+				continue;
+			}
+
+			// Upload to a dedicated index buffer when the heap is out of room
 			const size_t index_data_size = section.indices.size() * sizeof(uint32_t);
 
 			std::string buffer_name = std::to_string(mesh->name.computed_hash);
@@ -86,18 +106,32 @@ namespace Sunset
 				}
 			);
 
-			gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit_immediate(gfx_context, 0, [&section, gfx_context, index_staging_buffer, index_data_size](void* command_buffer)
-			{
-				Buffer* const index_buffer_obj = CACHE_FETCH(Buffer, section.index_buffer);
-				index_buffer_obj->copy_buffer(gfx_context, command_buffer, index_staging_buffer, index_data_size);
-			});
-
-			CACHE_DELETE(Buffer, index_staging_buffer_id, gfx_context);
+			Renderer::get()->get_upload_scheduler().enqueue(
+				[index_buffer = section.index_buffer, gfx_context, index_staging_buffer, index_data_size](void* command_buffer)
+				{
+					Buffer* const index_buffer_obj = CACHE_FETCH(Buffer, index_buffer);
+					index_buffer_obj->copy_buffer(gfx_context, command_buffer, index_staging_buffer, index_data_size);
+				},
+				[gfx_context, index_staging_buffer_id]()
+				{
+					CACHE_DELETE(Buffer, index_staging_buffer_id, gfx_context);
+				}
+			);
 		}
 	}
 
 	void destroy_mesh(GraphicsContext* const gfx_context, Mesh* mesh)
 	{
+		MeshGeometryHeap& geometry_heap = Renderer::get()->get_mesh_geometry_heap();
+
+		geometry_heap.free_vertices(mesh->vertex_allocation);
+		mesh->vertex_allocation = {};
+
+		for (MeshSection& section : mesh->sections)
+		{
+			geometry_heap.free_indices(section.index_allocation);
+			section.index_allocation = {};
+		}
 	}
 
 	Bounds calculate_mesh_bounds(Mesh* mesh, const glm::mat4& transform)
@@ -162,6 +196,49 @@ namespace Sunset
 		}
 	}
 
+	void add_mesh_lod(Mesh* mesh, float screen_size, const std::vector<std::vector<uint32_t>>& section_indices)
+	{
+		assert(mesh != nullptr && "Cannot add LOD to a null mesh");
+		assert(section_indices.size() == mesh->sections.size() && "Mesh LODs need an index list for every mesh section");
+		assert(get_mesh_lod_count(mesh) < MAX_MESH_LODS && "Mesh has too many LODs");
+
+		if (mesh->lod_screen_sizes.empty())
+		{
+			// The existing indices become the base LOD
+			mesh->lod_screen_sizes.push_back(std::numeric_limits<float>::max());
+			for (MeshSection& section : mesh->sections)
+			{
+				section.lods.push_back({ .first_index = 0, .index_count = static_cast<uint32_t>(section.indices.size()) });
+			}
+		}
+
+		assert(screen_size < mesh->lod_screen_sizes.back() && "Mesh LOD screen sizes must be in descending order");
+		mesh->lod_screen_sizes.push_back(screen_size);
+
+		for (uint32_t i = 0; i < mesh->sections.size(); ++i)
+		{
+			MeshSection& section = mesh->sections[i];
+			assert(section.index_buffer == 0 && "Mesh LODs must be added before the mesh is uploaded");
+
+			section.lods.push_back({ .first_index = static_cast<uint32_t>(section.indices.size()), .index_count = static_cast<uint32_t>(section_indices[i].size()) });
+			section.indices.insert(section.indices.end(), section_indices[i].begin(), section_indices[i].end());
+		}
+	}
+
+	uint32_t get_mesh_lod_count(const Mesh* mesh)
+	{
+		return std::max(static_cast<uint32_t>(mesh->lod_screen_sizes.size()), 1u);
+	}
+
+	MeshLOD get_mesh_section_lod(const MeshSection& section, uint32_t lod)
+	{
+		if (section.lods.empty())
+		{
+			return { .first_index = 0, .index_count = static_cast<uint32_t>(section.indices.size()) };
+		}
+		return section.lods[std::min(lod, static_cast<uint32_t>(section.lods.size()) - 1)];
+	}
+
 	Sunset::Bounds get_mesh_bounds(MeshID mesh)
 	{
 		assert(mesh != 0 && "Cannot fetch bounds on null mesh!");
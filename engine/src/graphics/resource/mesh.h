@@ -2,6 +2,7 @@
 
 #include <common.h>
 #include <graphics/resource/resource_cache.h>
+#include <graphics/geometry_heap_allocator.h>
 
 namespace Sunset
 {
@@ -17,10 +18,20 @@ namespace Sunset
 		static PipelineVertexInputDescription get_description();
 	};
 
+	struct MeshLOD
+	{
+		uint32_t first_index{ 0 };
+		uint32_t index_count{ 0 };
+	};
+
 	struct MeshSection
 	{
 		std::vector<uint32_t> indices;
-		BufferID index_buffer;
+		BufferID index_buffer{ 0 };
+		// Range of the mesh geometry heap's index buffer holding the indices. Invalid, with a zero offset, if the section has its own index buffer.
+		GeometryHeapAllocation index_allocation;
+		// Ranges into indices for each LOD, empty when the section only has its base LOD
+		std::vector<MeshLOD> lods;
 	};
 
 	struct Mesh
@@ -31,8 +42,12 @@ namespace Sunset
 		Identity name;
 		Bounds local_bounds;
 		BufferID vertex_buffer;
+		// Range of the mesh geometry heap's vertex buffer holding the vertices. Invalid, with a zero offset, if the mesh has its own vertex buffer.
+		GeometryHeapAllocation vertex_allocation;
 		std::vector<Vertex> vertices;
 		std::vector<MeshSection> sections;
+		// Projected screen size below which each LOD is drawn, see select_mesh_lod. Empty for single LOD meshes.
+		std::vector<float> lod_screen_sizes;
 
 		void destroy(class GraphicsContext* gfx_context) { }
 	};
@@ -42,6 +57,11 @@ namespace Sunset
 	Bounds calculate_mesh_bounds(Mesh* mesh, const glm::mat4& transform);
 	void update_mesh_tangent_bitangents(Mesh* mesh);
 
+	// Appends a coarser LOD, with one index list per section, to a mesh that hasn't been uploaded yet
+	void add_mesh_lod(Mesh* mesh, float screen_size, const std::vector<std::vector<uint32_t>>& section_indices);
+	uint32_t get_mesh_lod_count(const Mesh* mesh);
+	MeshLOD get_mesh_section_lod(const MeshSection& section, uint32_t lod);
+
 	Bounds get_mesh_bounds(MeshID mesh);
 
 	class MeshFactory
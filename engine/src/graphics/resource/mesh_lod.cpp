@@ -0,0 +1,40 @@
+#include <graphics/resource/mesh_lod.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sunset
+{
+	MeshLODSelector make_mesh_lod_selector(float projection_y_scale, float bias, float hysteresis)
+	{
+		MeshLODSelector selector;
+		// Projection matrices may be flipped on y, only the magnitude matters for size
+		selector.screen_size_scale = std::abs(projection_y_scale) * std::exp2(-bias);
+		selector.hysteresis = std::clamp(hysteresis, 0.0f, 0.99f);
+		return selector;
+	}
+
+	uint32_t select_mesh_lod(const float* lod_screen_sizes, uint32_t lod_count, float screen_size, uint32_t current_lod, float hysteresis)
+	{
+		if (lod_count <= 1)
+		{
+			return 0;
+		}
+
+		uint32_t lod = std::min(current_lod, lod_count - 1);
+
+		// Drop to coarser LODs once the size is clearly below their switch points
+		while (lod + 1 < lod_count && screen_size < lod_screen_sizes[lod + 1] * (1.0f - hysteresis))
+		{
+			++lod;
+		}
+
+		// Return to finer LODs once the size is clearly above the current LOD's switch point
+		while (lod > 0 && screen_size > lod_screen_sizes[lod] * (1.0f + hysteresis))
+		{
+			--lod;
+		}
+
+		return lod;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <minimal.h>
+
+#include <limits>
+
+namespace Sunset
+{
+	constexpr uint32_t MAX_MESH_LODS = 8;
+
+	// Per view inputs to LOD selection, built once per frame and shared by every entity
+	struct MeshLODSelector
+	{
+		// Maps radius / distance to the fraction of the screen height a bounding sphere covers, with the LOD bias folded in
+		float screen_size_scale{ 1.0f };
+		// Fraction a switch point is widened by in either direction, so meshes sitting on a threshold don't flicker
+		float hysteresis{ 0.0f };
+	};
+
+	// projection_y_scale is the [1][1] entry of the projection matrix. Each unit of positive bias halves
+	// the projected screen size, pushing meshes towards coarser LODs.
+	MeshLODSelector make_mesh_lod_selector(float projection_y_scale, float bias, float hysteresis);
+
+	inline float compute_lod_screen_size(const MeshLODSelector& selector, const glm::vec3& view_position, const glm::vec3& center, float radius)
+	{
+		const glm::vec3 delta = center - view_position;
+		const float distance_sq = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+		// Views inside the sphere always get the finest LOD
+		if (distance_sq <= radius * radius)
+		{
+			return std::numeric_limits<float>::max();
+		}
+		return radius * selector.screen_size_scale / std::sqrt(distance_sq);
+	}
+
+	// lod_screen_sizes holds, in descending order, the projected screen size below which each LOD is drawn (the entry
+	// for LOD 0 is ignored). Moving away from current_lod requires crossing a switch point by the selector's hysteresis.
+	uint32_t select_mesh_lod(const float* lod_screen_sizes, uint32_t lod_count, float screen_size, uint32_t current_lod, float hysteresis);
+}
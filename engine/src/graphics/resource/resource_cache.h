@@ -42,9 +42,11 @@ namespace Sunset
 			return resource_id;
 		}
 
+		// Lookups never insert, so passes recorded on job threads can fetch resources at the same time
 		ResourceType* fetch(ResourceIDType id)
 		{
-			return cache[id];
+			const auto it = cache.find(id);
+			return it != cache.end() ? it->second : nullptr;
 		}
 
 		void remove(ResourceIDType id)
@@ -44,17 +44,47 @@ namespace Sunset
 		return *this;
 	}
 
+	Sunset::ResourceStateBuilder& ResourceStateBuilder::set_index_start(uint32_t start)
+	{
+		state_data.index_start = start;
+		return *this;
+	}
+
+	Sunset::ResourceStateBuilder& ResourceStateBuilder::set_vertex_offset(int32_t offset)
+	{
+		state_data.vertex_offset = offset;
+		return *this;
+	}
+
 	Sunset::ResourceStateID ResourceStateBuilder::finish()
 	{
-		bool b_state_added{ false };
-		Identity cache_id = std::hash<ResourceStateData>{}(state_data);
-		ResourceStateID resource_state_id = ResourceStateCache::get()->fetch_or_add(cache_id, context, b_state_added);
-		if (b_state_added)
+		// Cache IDs are 32 bits, so different states can land on the same ID. Those are told apart by comparing the
+		// cached state and probing the following IDs until a match or a free one turns up.
+		const size_t state_hash = std::hash<ResourceStateData>{}(state_data);
+		Identity cache_id = static_cast<uint32_t>(state_hash ^ (state_hash >> 32));
+		while (true)
 		{
+			// ID 0 is the null resource state
+			if (cache_id.computed_hash == 0)
+			{
+				++cache_id.computed_hash;
+			}
+
+			bool b_state_added{ false };
+			const ResourceStateID resource_state_id = ResourceStateCache::get()->fetch_or_add(cache_id, context, b_state_added);
 			ResourceState* const resource_state = CACHE_FETCH(ResourceState, resource_state_id);
-			resource_state->initialize(context, state_data);
+			if (b_state_added)
+			{
+				resource_state->initialize(context, state_data);
+				return resource_state_id;
+			}
+			if (resource_state->state_data == state_data)
+			{
+				return resource_state_id;
+			}
+
+			++cache_id.computed_hash;
 		}
-		return resource_state_id;
 	}
 
 	void ResourceState::bind(class GraphicsContext* const gfx_context, void* buffer)
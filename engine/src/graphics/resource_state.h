@@ -35,6 +35,8 @@ namespace Sunset
 		ResourceStateBuilder& set_index_buffer(BufferID buffer);
 		ResourceStateBuilder& set_vertex_count(uint32_t count);
 		ResourceStateBuilder& set_index_count(uint32_t count);
+		ResourceStateBuilder& set_index_start(uint32_t start);
+		ResourceStateBuilder& set_vertex_offset(int32_t offset);
 
 		ResourceStateID finish();
 
@@ -15,11 +15,16 @@ namespace Sunset
 		BufferID index_buffer{ 0 };
 		uint32_t vertex_count{ 0 };
 		uint32_t index_count{ 0 };
+		// First index into the index buffer, so mesh LODs can share a single index buffer
+		uint32_t index_start{ 0 };
+		// Added to each index, so meshes in the geometry heap can share a single vertex buffer
+		int32_t vertex_offset{ 0 };
 
 		bool operator==(const ResourceStateData& other) const
 		{
 			return vertex_buffer == other.vertex_buffer && index_buffer == other.index_buffer 
-				&& vertex_count == other.vertex_count && index_count == other.index_count;
+				&& vertex_count == other.vertex_count && index_count == other.index_count && index_start == other.index_start
+				&& vertex_offset == other.vertex_offset;
 		}
 	};
 }
@@ -33,8 +38,18 @@ struct std::hash<Sunset::ResourceStateData>
 {
 	std::size_t operator()(const Sunset::ResourceStateData& psd) const
 	{
-		std::size_t seed = static_cast<int32_t>(psd.vertex_buffer);
-		seed = Sunset::Maths::cantor_pair_hash(static_cast<int32_t>(seed), static_cast<int32_t>(psd.index_buffer));
+		std::size_t seed = 0;
+		const auto hash_combine = [&seed](std::size_t hash)
+		{
+			seed ^= hash + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+		};
+
+		hash_combine(std::hash<Sunset::BufferID>{}(psd.vertex_buffer));
+		hash_combine(std::hash<Sunset::BufferID>{}(psd.index_buffer));
+		hash_combine(psd.vertex_count);
+		hash_combine(psd.index_count);
+		hash_combine(psd.index_start);
+		hash_combine(static_cast<uint32_t>(psd.vertex_offset));
 		return seed;
 	}
 };
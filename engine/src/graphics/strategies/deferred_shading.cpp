@@ -22,6 +22,9 @@ namespace Sunset
 	AutoCVar_Bool cvar_use_skybox("ren.use_skybox", "Whether or not to render a skybox (supplied to the scene as a cubemap texture) instead of using the preetham skydome shader.", false);
 
 	AutoCVar_Int cvar_shadow_map_resolution("ren.shadows.resolution", "Resolution for our CSM image", 4096);
+	AutoCVar_Int cvar_shadow_record_chunks("ren.shadows.record_chunks", "Number of command buffers each shadow cascade's mesh draws are split across when recorded on job threads", 2);
+
+	AutoCVar_Int cvar_gbuffer_record_chunks("ren.gbuffer.record_chunks", "Number of command buffers the G-Buffer pass's mesh draws are split across when recorded on job threads", 4);
 
 	AutoCVar_Bool cvar_ssao_enabled("ren.ssao.enable", "Whether or not to do screen space ambient occlusion", true);
 	AutoCVar_Float cvar_ssao_strength("ren.ssao.strength", "The strength of the SSAO contribution applied to ambient lighting calculations", 3.0f);
@@ -276,8 +279,7 @@ namespace Sunset
 					Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).submit_compute_cull(
 						gfx_context,
 						command_buffer,
-						buffered_frame_number,
-						frame_data.resource_deletion_queue
+						buffered_frame_number
 					);
 				}
 			);
@@ -330,13 +332,23 @@ namespace Sunset
 				RGPassHandle csm_pass_handle = render_graph.add_pass(
 					gfx_context,
 					cascade_pass_name.c_str(),
-					RenderPassFlags::Graphics,
+					RenderPassFlags::Graphics | RenderPassFlags::ParallelRecord,
 					buffered_frame_number,
 					{
 						.shader_setup = shader_setup,
 						.inputs = { entity_data_buffer_desc, compacted_object_instance_buffer_desc, draw_indirect_buffer_desc },
 						.outputs = { shadow_map_desc },
-						.output_views = { cascade }
+						.output_views = { cascade },
+						.record_chunk_count = static_cast<uint32_t>(std::max(cvar_shadow_record_chunks.get(), 1)),
+						.record_setup = [=](RenderGraph& graph, RGFrameData& frame_data)
+						{
+							Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).prepare_draws(
+								gfx_context,
+								frame_data.current_pass,
+								frame_data.global_descriptor_set,
+								frame_data.buffered_frame_number
+							);
+						}
 					},
 					[=](RenderGraph& graph, RGFrameData& frame_data, void* command_buffer)
 					{
@@ -350,16 +362,15 @@ namespace Sunset
 						}
 
 						const bool b_use_draw_push_constants = false;
-						const bool b_flush = false;
-						Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).submit_draws(
+						Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).record_draws(
 							gfx_context,
 							command_buffer,
 							frame_data.current_pass,
-							frame_data.global_descriptor_set,
 							frame_data.pass_pipeline_state,
 							frame_data.buffered_frame_number,
 							b_use_draw_push_constants,
-							b_flush
+							frame_data.record_chunk,
+							frame_data.record_chunk_count
 						);
 					}
 				);
@@ -475,7 +486,7 @@ namespace Sunset
 			RGPassHandle base_pass_handle = render_graph.add_pass(
 				gfx_context,
 				"gbuffer_base_pass",
-				RenderPassFlags::Graphics,
+				RenderPassFlags::Graphics | RenderPassFlags::ParallelRecord,
 				buffered_frame_number,
 				{
 					.shader_setup = shader_setup,
@@ -483,17 +494,35 @@ namespace Sunset
 								compacted_object_instance_buffer_desc,
 								draw_indirect_buffer_desc },
 					.outputs = { main_albedo_image_desc, main_depth_image_desc, main_smra_image_desc, main_cc_image_desc,
-								 main_normal_image_desc, main_position_image_desc }
+								 main_normal_image_desc, main_position_image_desc },
+					.record_chunk_count = static_cast<uint32_t>(std::max(cvar_gbuffer_record_chunks.get(), 1)),
+					.record_setup = [=](RenderGraph& graph, RGFrameData& frame_data)
+					{
+						Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).prepare_draws(
+							gfx_context,
+							frame_data.current_pass,
+							frame_data.global_descriptor_set,
+							frame_data.buffered_frame_number
+						);
+					},
+					// The shadow passes draw the same queue, and are recorded before this one
+					.record_finish = [](RenderGraph& graph, RGFrameData& frame_data)
+					{
+						Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).flush();
+					}
 				},
 				[=](RenderGraph& graph, RGFrameData& frame_data, void* command_buffer)
 				{
-					Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).submit_draws(
+					const bool b_use_draw_push_constants = true;
+					Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).record_draws(
 						gfx_context,
 						command_buffer,
 						frame_data.current_pass,
-						frame_data.global_descriptor_set,
 						frame_data.pass_pipeline_state,
-						frame_data.buffered_frame_number
+						frame_data.buffered_frame_number,
+						b_use_draw_push_constants,
+						frame_data.record_chunk,
+						frame_data.record_chunk_count
 					);
 				}
 			);
@@ -1708,16 +1737,22 @@ namespace Sunset
 					16 * sizeof(glm::vec4)
 				);
 
-				for (uint32_t i = 0; i < MAX_BUFFERED_FRAMES; ++i)
-				{
-					gfx_context->get_command_queue(DeviceQueueType::Graphics)->submit_immediate(Renderer::get()->context(), i, [ssao_noise_staging_buffer, gfx_context, i](void* command_buffer)
+				Renderer::get()->get_upload_scheduler().enqueue(
+					[ssao_noise_staging_buffer, gfx_context](void* command_buffer)
 					{
-						const ImageID ssao_noise_image = Renderer::get()->get_persistent_image("ssao_noise", i);
-						CACHE_FETCH(Image, ssao_noise_image)->copy_from_buffer(gfx_context, command_buffer, ssao_noise_staging_buffer);
-					});
-				}
-
-				CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
+						for (uint32_t i = 0; i < MAX_BUFFERED_FRAMES; ++i)
+						{
+							const ImageID ssao_noise_image = Renderer::get()->get_persistent_image("ssao_noise", i);
+							CACHE_FETCH(Image, ssao_noise_image)->copy_from_buffer(gfx_context, command_buffer, ssao_noise_staging_buffer);
+						}
+					},
+					[gfx_context, staging_buffer_id]()
+					{
+						CACHE_DELETE(Buffer, staging_buffer_id, gfx_context);
+					}
+				);
+				// This runs mid frame on the render thread, ahead of the graph that samples the noise image
+				Renderer::get()->get_upload_scheduler().flush(gfx_context);
 			}
 
 			{
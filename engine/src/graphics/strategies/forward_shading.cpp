@@ -150,8 +150,7 @@ namespace Sunset
 					Renderer::get()->get_mesh_task_queue(frame_data.buffered_frame_number).submit_compute_cull(
 						gfx_context,
 						command_buffer,
-						buffered_frame_number,
-						frame_data.resource_deletion_queue
+						buffered_frame_number
 					);
 				}
 			);
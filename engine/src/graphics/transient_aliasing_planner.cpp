@@ -0,0 +1,164 @@
+#include <graphics/transient_aliasing_planner.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace Sunset
+{
+	inline size_t align_transient_offset(size_t offset, size_t alignment)
+	{
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	inline bool transient_lifetimes_overlap(const TransientResourceLifetime& a, const TransientResourceLifetime& b)
+	{
+		return a.first_pass <= b.last_pass && b.first_pass <= a.last_pass;
+	}
+
+	inline bool transient_memory_overlaps(size_t offset_a, size_t size_a, size_t offset_b, size_t size_b)
+	{
+		return offset_a < offset_b + size_b && offset_b < offset_a + size_a;
+	}
+
+	void plan_transient_aliasing(const std::vector<TransientResourceLifetime>& lifetimes, TransientAliasingPlan& out_plan)
+	{
+		ZoneScopedN("plan_transient_aliasing");
+
+		out_plan.heap_sizes.clear();
+		out_plan.placements.clear();
+		out_plan.placements.resize(lifetimes.size());
+		out_plan.barriers.clear();
+		out_plan.unaliased_bytes = 0;
+		out_plan.aliased_bytes = 0;
+		out_plan.peak_live_bytes = 0;
+
+		// Largest first, so that each heap gets sized by its first resource and smaller ones fill in the gaps
+		std::vector<uint32_t> placement_order(lifetimes.size());
+		std::iota(placement_order.begin(), placement_order.end(), 0);
+		std::stable_sort(placement_order.begin(), placement_order.end(), [&lifetimes](uint32_t a, uint32_t b)
+		{
+			return lifetimes[a].size > lifetimes[b].size;
+		});
+
+		std::vector<std::vector<uint32_t>> heap_resources;
+		std::vector<std::pair<size_t, size_t>> occupied_ranges;
+
+		for (const uint32_t resource : placement_order)
+		{
+			const TransientResourceLifetime& lifetime = lifetimes[resource];
+			assert(lifetime.alignment > 0 && (lifetime.alignment & (lifetime.alignment - 1)) == 0 && "Transient alignment must be a power of two");
+			assert(lifetime.first_pass <= lifetime.last_pass && "Transient lifetime must start before it ends");
+
+			out_plan.unaliased_bytes += lifetime.size;
+
+			bool b_placed{ false };
+			for (uint32_t heap = 0; heap < heap_resources.size() && !b_placed; ++heap)
+			{
+				// Memory ranges taken by resources that are alive at the same time as this one
+				occupied_ranges.clear();
+				for (const uint32_t other : heap_resources[heap])
+				{
+					if (transient_lifetimes_overlap(lifetime, lifetimes[other]))
+					{
+						occupied_ranges.push_back({ out_plan.placements[other].offset, lifetimes[other].size });
+					}
+				}
+				std::sort(occupied_ranges.begin(), occupied_ranges.end());
+
+				size_t offset = 0;
+				for (const auto& [range_offset, range_size] : occupied_ranges)
+				{
+					if (align_transient_offset(offset, lifetime.alignment) + lifetime.size <= range_offset)
+					{
+						break;
+					}
+					offset = std::max(offset, range_offset + range_size);
+				}
+				offset = align_transient_offset(offset, lifetime.alignment);
+
+				if (offset + lifetime.size <= out_plan.heap_sizes[heap])
+				{
+					out_plan.placements[resource] = { .heap = heap, .offset = offset };
+					heap_resources[heap].push_back(resource);
+					b_placed = true;
+				}
+			}
+
+			if (!b_placed)
+			{
+				out_plan.placements[resource] = { .heap = static_cast<uint32_t>(heap_resources.size()), .offset = 0 };
+				out_plan.heap_sizes.push_back(lifetime.size);
+				heap_resources.push_back({ resource });
+			}
+		}
+
+		for (const size_t heap_size : out_plan.heap_sizes)
+		{
+			out_plan.aliased_bytes += heap_size;
+		}
+
+		// Every resource waits on the earlier users of its memory. An earlier user is skipped if a later one that also
+		// took over its memory is already waited on, since that one had to wait on it in turn.
+		std::vector<uint32_t> previous_users;
+		std::vector<uint32_t> waited_users;
+		for (const std::vector<uint32_t>& resources : heap_resources)
+		{
+			for (const uint32_t after : resources)
+			{
+				const TransientResourceLifetime& after_lifetime = lifetimes[after];
+				const TransientPlacement& after_placement = out_plan.placements[after];
+
+				previous_users.clear();
+				for (const uint32_t before : resources)
+				{
+					if (lifetimes[before].last_pass < after_lifetime.first_pass
+						&& transient_memory_overlaps(out_plan.placements[before].offset, lifetimes[before].size, after_placement.offset, after_lifetime.size))
+					{
+						previous_users.push_back(before);
+					}
+				}
+				std::sort(previous_users.begin(), previous_users.end(), [&lifetimes](uint32_t a, uint32_t b)
+				{
+					return lifetimes[a].last_pass > lifetimes[b].last_pass;
+				});
+
+				waited_users.clear();
+				for (const uint32_t before : previous_users)
+				{
+					const bool b_already_synchronized = std::any_of(waited_users.begin(), waited_users.end(), [&](uint32_t waited)
+					{
+						return lifetimes[waited].first_pass > lifetimes[before].last_pass
+							&& transient_memory_overlaps(out_plan.placements[waited].offset, lifetimes[waited].size, out_plan.placements[before].offset, lifetimes[before].size);
+					});
+					if (!b_already_synchronized)
+					{
+						waited_users.push_back(before);
+						out_plan.barriers.push_back({ .pass = after_lifetime.first_pass, .before = before, .after = after });
+					}
+				}
+			}
+		}
+
+		std::sort(out_plan.barriers.begin(), out_plan.barriers.end(), [](const TransientAliasingBarrier& a, const TransientAliasingBarrier& b)
+		{
+			return a.pass != b.pass ? a.pass < b.pass : (a.after != b.after ? a.after < b.after : a.before < b.before);
+		});
+
+		// Sweep over lifetime starts and ends to find the largest amount of memory in use at once
+		std::vector<std::pair<int32_t, int64_t>> live_changes;
+		live_changes.reserve(lifetimes.size() * 2);
+		for (const TransientResourceLifetime& lifetime : lifetimes)
+		{
+			live_changes.push_back({ lifetime.first_pass, static_cast<int64_t>(lifetime.size) });
+			live_changes.push_back({ lifetime.last_pass + 1, -static_cast<int64_t>(lifetime.size) });
+		}
+		std::sort(live_changes.begin(), live_changes.end());
+
+		int64_t live_bytes = 0;
+		for (const auto& [pass, change] : live_changes)
+		{
+			live_bytes += change;
+			out_plan.peak_live_bytes = std::max(out_plan.peak_live_bytes, static_cast<size_t>(std::max<int64_t>(live_bytes, 0)));
+		}
+	}
+}
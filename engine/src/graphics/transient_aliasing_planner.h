@@ -0,0 +1,48 @@
+#pragma once
+
+#include <minimal.h>
+
+namespace Sunset
+{
+	// Lifetime and memory requirements of a single transient resource. Passes are in execution order and the lifetime is inclusive.
+	struct TransientResourceLifetime
+	{
+		int32_t first_pass{ 0 };
+		int32_t last_pass{ 0 };
+		size_t size{ 0 };
+		size_t alignment{ 1 };
+	};
+
+	struct TransientPlacement
+	{
+		uint32_t heap{ 0 };
+		size_t offset{ 0 };
+	};
+
+	// Memory used by resource 'before' is reused by resource 'after', so 'after' needs an aliasing barrier ahead of its first pass
+	struct TransientAliasingBarrier
+	{
+		int32_t pass{ 0 };
+		uint32_t before{ 0 };
+		uint32_t after{ 0 };
+	};
+
+	// Placements are stored in the same order as the lifetimes that were planned
+	struct TransientAliasingPlan
+	{
+		std::vector<size_t> heap_sizes;
+		std::vector<TransientPlacement> placements;
+		std::vector<TransientAliasingBarrier> barriers;
+		// Memory needed if every resource got its own allocation
+		size_t unaliased_bytes{ 0 };
+		// Memory needed by all the heaps in this plan
+		size_t aliased_bytes{ 0 };
+		// Largest amount of memory live during any single pass, which no plan can go under
+		size_t peak_live_bytes{ 0 };
+	};
+
+	// Packs resources whose lifetimes do not overlap into shared heaps. Resources are placed largest first, each one at the
+	// lowest offset of the first heap that has room next to every resource it overlaps with in time. A new heap sized for
+	// the resource is opened when none of the existing ones has room.
+	void plan_transient_aliasing(const std::vector<TransientResourceLifetime>& lifetimes, TransientAliasingPlan& out_plan);
+}
@@ -0,0 +1,31 @@
+#include <graphics/transient_resource_pool.h>
+#include <graphics/resource/image.h>
+#include <graphics/resource/buffer.h>
+
+namespace Sunset
+{
+	ImageID TransientImagePoolPolicy::create(class GraphicsContext* const gfx_context, const AttachmentConfig& config, uint64_t unique_id)
+	{
+		// Every pooled image needs its own cache entry, so the name is made unique instead of being keyed by the pass that asked for it
+		AttachmentConfig pooled_config = config;
+		pooled_config.name.computed_hash ^= hash_transient_image_config(config) + unique_id;
+		return ImageFactory::create(gfx_context, pooled_config, false);
+	}
+
+	void TransientImagePoolPolicy::destroy(class GraphicsContext* const gfx_context, ImageID image)
+	{
+		CACHE_DELETE(Image, image, gfx_context);
+	}
+
+	BufferID TransientBufferPoolPolicy::create(class GraphicsContext* const gfx_context, const BufferConfig& config, uint64_t unique_id)
+	{
+		BufferConfig pooled_config = config;
+		pooled_config.name.computed_hash ^= hash_transient_buffer_config(config) + unique_id;
+		return BufferFactory::create(gfx_context, pooled_config, false);
+	}
+
+	void TransientBufferPoolPolicy::destroy(class GraphicsContext* const gfx_context, BufferID buffer)
+	{
+		CACHE_DELETE(Buffer, buffer, gfx_context);
+	}
+}
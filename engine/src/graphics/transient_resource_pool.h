@@ -0,0 +1,239 @@
+#pragma once
+
+#include <minimal.h>
+#include <graphics/resource/image_types.h>
+#include <graphics/resource/buffer_types.h>
+
+namespace Sunset
+{
+	constexpr uint32_t DEFAULT_TRANSIENT_POOL_MAX_UNUSED_FRAMES = 8;
+
+	struct TransientResourcePoolStats
+	{
+		uint32_t frame_creations{ 0 };
+		uint32_t frame_reuses{ 0 };
+		uint32_t frame_evictions{ 0 };
+		uint64_t total_creations{ 0 };
+		size_t acquired_count{ 0 };
+		size_t free_count{ 0 };
+	};
+
+	// Hashes every field that affects the physical image, so only images that can stand in for each other share a hash
+	inline size_t hash_transient_image_config(const AttachmentConfig& config)
+	{
+		size_t seed = 0;
+		const auto hash_combine = [&seed](size_t hash)
+		{
+			seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		};
+
+		hash_combine(static_cast<size_t>(config.format));
+		hash_combine(std::hash<float>{}(config.extent.x));
+		hash_combine(std::hash<float>{}(config.extent.y));
+		hash_combine(std::hash<float>{}(config.extent.z));
+		hash_combine(std::hash<float>{}(config.clear_color.x));
+		hash_combine(std::hash<float>{}(config.clear_color.y));
+		hash_combine(std::hash<float>{}(config.clear_color.z));
+		hash_combine(static_cast<size_t>(config.flags));
+		hash_combine(static_cast<size_t>(config.usage_type));
+		hash_combine(static_cast<size_t>(config.sampler_address_mode));
+		hash_combine(static_cast<size_t>(config.image_filter));
+		hash_combine(config.mip_count);
+		hash_combine(config.array_count);
+		hash_combine(config.attachment_clear);
+		hash_combine(config.attachment_stencil_clear);
+		hash_combine(config.has_store_op);
+		hash_combine(config.is_bindless);
+		hash_combine(config.does_min_reduction);
+		hash_combine(config.linear_mip_filtering);
+		hash_combine(config.split_array_layer_views);
+		hash_combine(config.mips_in_rendering);
+
+		return seed;
+	}
+
+	inline size_t hash_transient_buffer_config(const BufferConfig& config)
+	{
+		size_t seed = 0;
+		const auto hash_combine = [&seed](size_t hash)
+		{
+			seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		};
+
+		hash_combine(config.buffer_size);
+		hash_combine(static_cast<size_t>(config.type));
+		hash_combine(static_cast<size_t>(config.memory_usage));
+		hash_combine(static_cast<size_t>(config.b_is_bindless));
+
+		return seed;
+	}
+
+	// Keeps physical transient resources alive across frames, keyed by a hash of their description. A released resource is only
+	// handed out again once MAX_BUFFERED_FRAMES frames have passed, so frames in flight never see it change under them, and is
+	// destroyed once it has gone unused for max_unused_frames frames.
+	//
+	// Policy provides ConfigType, ResourceID, hash(config), create(gfx_context, config, unique_id) and destroy(gfx_context, resource).
+	template<class Policy>
+	class GenericTransientResourcePool
+	{
+	public:
+		using ConfigType = typename Policy::ConfigType;
+		using ResourceID = typename Policy::ResourceID;
+
+		GenericTransientResourcePool() = default;
+		~GenericTransientResourcePool() = default;
+
+		void begin_frame(class GraphicsContext* const gfx_context, uint64_t frame_number, uint32_t max_unused_frames = DEFAULT_TRANSIENT_POOL_MAX_UNUSED_FRAMES)
+		{
+			current_frame = frame_number;
+			stats.frame_creations = 0;
+			stats.frame_reuses = 0;
+			stats.frame_evictions = 0;
+
+			for (auto it = free_resources.begin(); it != free_resources.end();)
+			{
+				std::vector<PooledResource>& resources = it->second;
+				// Resources are released in frame order, so the stale ones are always at the front
+				size_t stale_count = 0;
+				while (stale_count < resources.size() && resources[stale_count].released_frame + max_unused_frames < current_frame)
+				{
+					policy.destroy(gfx_context, resources[stale_count].resource);
+					++stale_count;
+				}
+				resources.erase(resources.begin(), resources.begin() + stale_count);
+				stats.frame_evictions += stale_count;
+				stats.free_count -= stale_count;
+
+				if (resources.empty())
+				{
+					free_resources.erase(it++);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		ResourceID acquire(class GraphicsContext* const gfx_context, const ConfigType& config)
+		{
+			const size_t description_hash = policy.hash(config);
+
+			ResourceID resource{};
+			if (auto it = free_resources.find(description_hash);
+				it != free_resources.end() && it->second.front().released_frame + MAX_BUFFERED_FRAMES <= current_frame)
+			{
+				resource = it->second.front().resource;
+				it->second.erase(it->second.begin());
+				if (it->second.empty())
+				{
+					free_resources.erase(it);
+				}
+				--stats.free_count;
+				++stats.frame_reuses;
+			}
+			else
+			{
+				resource = policy.create(gfx_context, config, ++creation_count);
+				++stats.frame_creations;
+				++stats.total_creations;
+			}
+
+			acquired_resources.insert({ resource, description_hash });
+			++stats.acquired_count;
+
+			return resource;
+		}
+
+		// Returns the resource to the pool once the current frame's commands using it are submitted
+		void release(ResourceID resource)
+		{
+			const auto it = acquired_resources.find(resource);
+			assert(it != acquired_resources.end() && "Releasing a resource that was not acquired from this pool");
+
+			free_resources[it->second].push_back({ .resource = resource, .released_frame = current_frame });
+			acquired_resources.erase(it);
+			--stats.acquired_count;
+			++stats.free_count;
+		}
+
+		void destroy(class GraphicsContext* const gfx_context)
+		{
+			for (auto& [description_hash, resources] : free_resources)
+			{
+				for (const PooledResource& pooled : resources)
+				{
+					policy.destroy(gfx_context, pooled.resource);
+				}
+			}
+			for (const auto& [resource, description_hash] : acquired_resources)
+			{
+				policy.destroy(gfx_context, resource);
+			}
+			free_resources.clear();
+			acquired_resources.clear();
+			stats.acquired_count = 0;
+			stats.free_count = 0;
+		}
+
+		const TransientResourcePoolStats& get_stats() const
+		{
+			return stats;
+		}
+
+		Policy& get_policy()
+		{
+			return policy;
+		}
+
+	protected:
+		struct PooledResource
+		{
+			ResourceID resource{};
+			uint64_t released_frame{ 0 };
+		};
+
+		Policy policy;
+		phmap::flat_hash_map<size_t, std::vector<PooledResource>> free_resources;
+		phmap::flat_hash_map<ResourceID, size_t> acquired_resources;
+		uint64_t current_frame{ 0 };
+		uint64_t creation_count{ 0 };
+		TransientResourcePoolStats stats;
+	};
+
+	class TransientImagePoolPolicy
+	{
+	public:
+		using ConfigType = AttachmentConfig;
+		using ResourceID = ImageID;
+
+		size_t hash(const AttachmentConfig& config) const
+		{
+			return hash_transient_image_config(config);
+		}
+
+		ImageID create(class GraphicsContext* const gfx_context, const AttachmentConfig& config, uint64_t unique_id);
+		void destroy(class GraphicsContext* const gfx_context, ImageID image);
+	};
+
+	class TransientBufferPoolPolicy
+	{
+	public:
+		using ConfigType = BufferConfig;
+		using ResourceID = BufferID;
+
+		size_t hash(const BufferConfig& config) const
+		{
+			return hash_transient_buffer_config(config);
+		}
+
+		BufferID create(class GraphicsContext* const gfx_context, const BufferConfig& config, uint64_t unique_id);
+		void destroy(class GraphicsContext* const gfx_context, BufferID buffer);
+	};
+
+	class TransientImagePool : public GenericTransientResourcePool<TransientImagePoolPolicy>
+	{ };
+
+	class TransientBufferPool : public GenericTransientResourcePool<TransientBufferPoolPolicy>
+	{ };
+}
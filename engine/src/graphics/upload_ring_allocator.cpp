@@ -0,0 +1,102 @@
+#include <graphics/upload_ring_allocator.h>
+
+namespace Sunset
+{
+	inline size_t align_upload_offset(size_t offset, size_t alignment)
+	{
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	UploadRingAllocator::UploadRingAllocator(size_t capacity)
+		: capacity(capacity)
+	{ }
+
+	void UploadRingAllocator::reset(size_t new_capacity)
+	{
+		capacity = new_capacity;
+		head = 0;
+		tail = 0;
+		used_size = 0;
+		open_frame_size = 0;
+		in_flight_frames.clear();
+	}
+
+	size_t UploadRingAllocator::allocate(size_t size, size_t alignment)
+	{
+		assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "Upload alignment must be a power of two");
+
+		if (size == 0 || size > capacity)
+		{
+			return INVALID_OFFSET;
+		}
+
+		if (used_size == 0)
+		{
+			head = 0;
+			tail = 0;
+		}
+		else if (head == tail)
+		{
+			// Every byte is in use
+			return INVALID_OFFSET;
+		}
+
+		const size_t aligned_head = align_upload_offset(head, alignment);
+
+		if (head < tail)
+		{
+			// Free space is the gap between the head and the oldest in flight frame
+			return aligned_head + size <= tail ? commit(aligned_head, size) : INVALID_OFFSET;
+		}
+
+		// Free space runs from the head to the end of the ring, then wraps around to the oldest in flight frame
+		if (aligned_head + size <= capacity)
+		{
+			return commit(aligned_head, size);
+		}
+
+		if (size <= tail)
+		{
+			// The skipped end of the ring belongs to this frame, so it is freed along with it
+			used_size += capacity - head;
+			open_frame_size += capacity - head;
+			head = 0;
+			return commit(0, size);
+		}
+
+		return INVALID_OFFSET;
+	}
+
+	size_t UploadRingAllocator::commit(size_t offset, size_t size)
+	{
+		const size_t committed_size = offset + size - head;
+		used_size += committed_size;
+		open_frame_size += committed_size;
+		head = offset + size;
+		return offset;
+	}
+
+	void UploadRingAllocator::end_frame(uint64_t fence_value)
+	{
+		if (open_frame_size == 0)
+		{
+			return;
+		}
+
+		assert((in_flight_frames.empty() || in_flight_frames.back().fence_value <= fence_value) && "Upload frame fence values must not go backwards");
+
+		in_flight_frames.push_back({ .fence_value = fence_value, .end_offset = head, .size = open_frame_size });
+		open_frame_size = 0;
+	}
+
+	void UploadRingAllocator::reclaim(uint64_t completed_fence_value)
+	{
+		while (!in_flight_frames.empty() && in_flight_frames.front().fence_value <= completed_fence_value)
+		{
+			const InFlightFrame& frame = in_flight_frames.front();
+			tail = frame.end_offset;
+			used_size -= frame.size;
+			in_flight_frames.pop_front();
+		}
+	}
+}
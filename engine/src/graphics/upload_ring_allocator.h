@@ -0,0 +1,63 @@
+#pragma once
+
+#include <minimal.h>
+
+#include <deque>
+
+namespace Sunset
+{
+	// Hands out aligned offsets into a fixed size ring of upload memory. Allocations are grouped into frames that get
+	// tagged with a fence value, and a frame's space is only handed out again once its fence value has completed.
+	class UploadRingAllocator
+	{
+	public:
+		static constexpr size_t INVALID_OFFSET = std::numeric_limits<size_t>::max();
+
+		explicit UploadRingAllocator(size_t capacity = 0);
+		~UploadRingAllocator() = default;
+
+		// Forgets every allocation, in flight or not
+		void reset(size_t new_capacity);
+
+		// Returns INVALID_OFFSET if the free space cannot fit the allocation
+		size_t allocate(size_t size, size_t alignment);
+		// Closes the allocations made since the last call into a frame guarded by fence_value
+		void end_frame(uint64_t fence_value);
+		// Frees every frame whose fence value is at or below completed_fence_value
+		void reclaim(uint64_t completed_fence_value);
+
+		size_t get_capacity() const
+		{
+			return capacity;
+		}
+
+		// Includes padding skipped for alignment or when wrapping around
+		size_t get_used_size() const
+		{
+			return used_size;
+		}
+
+		size_t get_in_flight_frame_count() const
+		{
+			return in_flight_frames.size();
+		}
+
+	protected:
+		struct InFlightFrame
+		{
+			uint64_t fence_value{ 0 };
+			size_t end_offset{ 0 };
+			size_t size{ 0 };
+		};
+
+		size_t commit(size_t offset, size_t size);
+
+	protected:
+		size_t capacity{ 0 };
+		size_t head{ 0 };
+		size_t tail{ 0 };
+		size_t used_size{ 0 };
+		size_t open_frame_size{ 0 };
+		std::deque<InFlightFrame> in_flight_frames;
+	};
+}
@@ -0,0 +1,111 @@
+#include <graphics/upload_ring_buffer.h>
+#include <graphics/graphics_context.h>
+#include <graphics/resource/buffer.h>
+
+namespace Sunset
+{
+	void UploadRingBuffer::initialize(class GraphicsContext* const gfx_context, size_t initial_size)
+	{
+		grow(gfx_context, initial_size);
+	}
+
+	void UploadRingBuffer::destroy(class GraphicsContext* const gfx_context)
+	{
+		for (const RetiredBuffer& retired : retired_buffers)
+		{
+			CACHE_FETCH(Buffer, retired.buffer)->unmap_gpu(gfx_context);
+			CACHE_DELETE(Buffer, retired.buffer, gfx_context);
+		}
+		retired_buffers.clear();
+
+		if (buffer != 0)
+		{
+			CACHE_FETCH(Buffer, buffer)->unmap_gpu(gfx_context);
+			CACHE_DELETE(Buffer, buffer, gfx_context);
+			buffer = 0;
+			mapped_memory = nullptr;
+		}
+
+		allocator.reset(0);
+	}
+
+	void UploadRingBuffer::begin_frame(class GraphicsContext* const gfx_context, uint64_t completed_fence_value)
+	{
+		allocator.reclaim(completed_fence_value);
+
+		std::erase_if(retired_buffers, [gfx_context, completed_fence_value](const RetiredBuffer& retired)
+		{
+			if (retired.fence_value > completed_fence_value)
+			{
+				return false;
+			}
+			CACHE_FETCH(Buffer, retired.buffer)->unmap_gpu(gfx_context);
+			CACHE_DELETE(Buffer, retired.buffer, gfx_context);
+			return true;
+		});
+	}
+
+	void UploadRingBuffer::end_frame(uint64_t fence_value)
+	{
+		allocator.end_frame(fence_value);
+
+		for (RetiredBuffer& retired : retired_buffers)
+		{
+			retired.fence_value = std::min(retired.fence_value, fence_value);
+		}
+	}
+
+	UploadAllocation UploadRingBuffer::allocate(class GraphicsContext* const gfx_context, size_t size, size_t alignment)
+	{
+		size_t offset = allocator.allocate(size, alignment);
+		if (offset == UploadRingAllocator::INVALID_OFFSET)
+		{
+			grow(gfx_context, size);
+			offset = allocator.allocate(size, alignment);
+		}
+		assert(offset != UploadRingAllocator::INVALID_OFFSET && "Failed to allocate upload memory");
+
+		return UploadAllocation
+		{
+			.buffer = CACHE_FETCH(Buffer, buffer),
+			.offset = offset,
+			.memory = mapped_memory + offset,
+			.size = size
+		};
+	}
+
+	void UploadRingBuffer::grow(class GraphicsContext* const gfx_context, size_t min_size)
+	{
+		ZoneScopedN("UploadRingBuffer::grow");
+
+		size_t new_capacity = std::max<size_t>(allocator.get_capacity(), 1);
+		while (new_capacity < min_size || new_capacity <= allocator.get_capacity())
+		{
+			new_capacity *= 2;
+		}
+
+		if (buffer != 0)
+		{
+			// Frames in flight may still read from the old buffer, so it is only deleted once they complete
+			retired_buffers.push_back({ .buffer = buffer });
+			++grow_count;
+		}
+
+		Identity buffer_name("upload_ring_buffer");
+		buffer_name.computed_hash += grow_count;
+
+		buffer = BufferFactory::create(
+			gfx_context,
+			{
+				.name = buffer_name,
+				.buffer_size = new_capacity,
+				.type = BufferType::TransferSource | BufferType::StorageBuffer,
+				.memory_usage = MemoryUsageType::CPUToGPU
+			},
+			false
+		);
+		mapped_memory = CACHE_FETCH(Buffer, buffer)->map_gpu(gfx_context);
+
+		allocator.reset(new_capacity);
+	}
+}
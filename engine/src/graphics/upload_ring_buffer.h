@@ -0,0 +1,68 @@
+#pragma once
+
+#include <minimal.h>
+#include <graphics/upload_ring_allocator.h>
+
+namespace Sunset
+{
+	constexpr size_t UPLOAD_RING_BUFFER_INITIAL_SIZE = 4 * 1024 * 1024;
+
+	struct UploadAllocation
+	{
+		class Buffer* buffer{ nullptr };
+		size_t offset{ 0 };
+		char* memory{ nullptr };
+		size_t size{ 0 };
+	};
+
+	// Persistently mapped CPU to GPU memory for per frame upload data, suballocated as a ring. Space is reclaimed once
+	// the frame that used it has completed on the GPU. If a frame needs more than is free, the ring moves to a larger
+	// buffer and the old one is kept alive until the frames still reading from it are done.
+	class UploadRingBuffer
+	{
+	public:
+		UploadRingBuffer() = default;
+		~UploadRingBuffer() = default;
+
+		void initialize(class GraphicsContext* const gfx_context, size_t initial_size = UPLOAD_RING_BUFFER_INITIAL_SIZE);
+		void destroy(class GraphicsContext* const gfx_context);
+
+		// Frees space used by frames at or below completed_fence_value, which the caller must have waited on
+		void begin_frame(class GraphicsContext* const gfx_context, uint64_t completed_fence_value);
+		void end_frame(uint64_t fence_value);
+
+		UploadAllocation allocate(class GraphicsContext* const gfx_context, size_t size, size_t alignment = 16);
+
+		size_t get_capacity() const
+		{
+			return allocator.get_capacity();
+		}
+
+		size_t get_used_size() const
+		{
+			return allocator.get_used_size();
+		}
+
+		uint32_t get_grow_count() const
+		{
+			return grow_count;
+		}
+
+	protected:
+		void grow(class GraphicsContext* const gfx_context, size_t min_size);
+
+	protected:
+		struct RetiredBuffer
+		{
+			BufferID buffer{ 0 };
+			// Set when the frame that retired the buffer ends
+			uint64_t fence_value{ std::numeric_limits<uint64_t>::max() };
+		};
+
+		BufferID buffer{ 0 };
+		char* mapped_memory{ nullptr };
+		UploadRingAllocator allocator;
+		std::vector<RetiredBuffer> retired_buffers;
+		uint32_t grow_count{ 0 };
+	};
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <minimal.h>
+#include <graphics/command_queue.h>
+
+#include <deque>
+#include <mutex>
+
+namespace Sunset
+{
+	// Refers to an upload queued on an upload scheduler. Uploads complete in the order they were queued.
+	struct UploadHandle
+	{
+		uint64_t value{ 0 };
+	};
+
+	struct UploadSchedulerStats
+	{
+		uint64_t queued_uploads{ 0 };
+		uint64_t submitted_batches{ 0 };
+		uint64_t retired_batches{ 0 };
+	};
+
+	// Collects copy commands from asset uploads and records all of them into one command buffer per flush, instead of
+	// submitting and waiting on the GPU once per upload. A batch is retired once its fence signals, which completes its
+	// uploads and runs their completion callbacks (usually to delete staging buffers).
+	template<class CommandQueueType>
+	class GenericUploadScheduler
+	{
+	public:
+		using RecordFn = std::function<void(void* command_buffer)>;
+		using CompleteFn = std::function<void()>;
+
+		GenericUploadScheduler() = default;
+		~GenericUploadScheduler() = default;
+
+		void initialize(CommandQueueType* upload_queue)
+		{
+			queue = upload_queue;
+		}
+
+		void destroy(class GraphicsContext* const gfx_context)
+		{
+			wait_all(gfx_context);
+			queue = nullptr;
+		}
+
+		// record_fn runs on the thread that flushes the scheduler and must not queue more uploads
+		UploadHandle enqueue(RecordFn&& record_fn, CompleteFn&& complete_fn = nullptr)
+		{
+			std::scoped_lock lock(mutex);
+			pending_uploads.push_back({ .record_fn = std::move(record_fn), .complete_fn = std::move(complete_fn) });
+			++stats.queued_uploads;
+			return { ++last_queued_value };
+		}
+
+		// Records every pending upload into one command buffer and submits it without waiting
+		void flush(class GraphicsContext* const gfx_context)
+		{
+			std::vector<CompleteFn> completed;
+			{
+				std::scoped_lock lock(mutex);
+
+				if (pending_uploads.empty())
+				{
+					return;
+				}
+
+				if (in_flight_batches.size() == MAX_UPLOAD_BATCHES_IN_FLIGHT)
+				{
+					queue->wait_for_upload_batch(gfx_context, in_flight_batches.front().slot);
+					retire_oldest_batch(completed);
+				}
+
+				InFlightBatch batch{ .slot = next_slot, .last_value = last_queued_value };
+				next_slot = (next_slot + 1) % MAX_UPLOAD_BATCHES_IN_FLIGHT;
+
+				void* command_buffer = queue->begin_upload_batch(gfx_context, batch.slot);
+				for (PendingUpload& upload : pending_uploads)
+				{
+					upload.record_fn(command_buffer);
+					if (upload.complete_fn != nullptr)
+					{
+						batch.complete_fns.push_back(std::move(upload.complete_fn));
+					}
+				}
+				queue->submit_upload_batch(gfx_context, batch.slot);
+
+				pending_uploads.clear();
+				last_submitted_value = batch.last_value;
+				in_flight_batches.push_back(std::move(batch));
+				++stats.submitted_batches;
+			}
+			run_complete_fns(completed);
+		}
+
+		// Retires batches the GPU has finished, oldest first, without blocking
+		void retire(class GraphicsContext* const gfx_context)
+		{
+			std::vector<CompleteFn> completed;
+			{
+				std::scoped_lock lock(mutex);
+				while (!in_flight_batches.empty() && queue->is_upload_batch_complete(gfx_context, in_flight_batches.front().slot))
+				{
+					retire_oldest_batch(completed);
+				}
+			}
+			run_complete_fns(completed);
+		}
+
+		// Blocks until the upload has completed, flushing it first if it has not been submitted yet
+		void wait(class GraphicsContext* const gfx_context, UploadHandle handle)
+		{
+			if (is_complete(handle))
+			{
+				return;
+			}
+
+			bool b_needs_flush{ false };
+			{
+				std::scoped_lock lock(mutex);
+				b_needs_flush = handle.value > last_submitted_value;
+			}
+			if (b_needs_flush)
+			{
+				flush(gfx_context);
+			}
+
+			std::vector<CompleteFn> completed;
+			{
+				std::scoped_lock lock(mutex);
+				while (!in_flight_batches.empty() && completed_value.load(std::memory_order_acquire) < handle.value)
+				{
+					queue->wait_for_upload_batch(gfx_context, in_flight_batches.front().slot);
+					retire_oldest_batch(completed);
+				}
+			}
+			run_complete_fns(completed);
+		}
+
+		void wait_all(class GraphicsContext* const gfx_context)
+		{
+			UploadHandle last_handle;
+			{
+				std::scoped_lock lock(mutex);
+				last_handle.value = last_queued_value;
+			}
+			wait(gfx_context, last_handle);
+		}
+
+		bool is_complete(UploadHandle handle) const
+		{
+			return handle.value <= completed_value.load(std::memory_order_acquire);
+		}
+
+		UploadSchedulerStats get_stats()
+		{
+			std::scoped_lock lock(mutex);
+			return stats;
+		}
+
+	protected:
+		struct PendingUpload
+		{
+			RecordFn record_fn;
+			CompleteFn complete_fn;
+		};
+
+		struct InFlightBatch
+		{
+			uint32_t slot{ 0 };
+			uint64_t last_value{ 0 };
+			std::vector<CompleteFn> complete_fns;
+		};
+
+		void retire_oldest_batch(std::vector<CompleteFn>& out_completed)
+		{
+			InFlightBatch& batch = in_flight_batches.front();
+			std::move(batch.complete_fns.begin(), batch.complete_fns.end(), std::back_inserter(out_completed));
+			completed_value.store(batch.last_value, std::memory_order_release);
+			in_flight_batches.pop_front();
+			++stats.retired_batches;
+		}
+
+		// Called outside the lock so completion callbacks are free to queue new uploads
+		void run_complete_fns(std::vector<CompleteFn>& complete_fns)
+		{
+			for (CompleteFn& complete_fn : complete_fns)
+			{
+				complete_fn();
+			}
+		}
+
+	protected:
+		CommandQueueType* queue{ nullptr };
+		std::mutex mutex;
+		std::vector<PendingUpload> pending_uploads;
+		std::deque<InFlightBatch> in_flight_batches;
+		uint32_t next_slot{ 0 };
+		uint64_t last_queued_value{ 0 };
+		uint64_t last_submitted_value{ 0 };
+		std::atomic<uint64_t> completed_value{ 0 };
+		UploadSchedulerStats stats;
+	};
+
+	class UploadScheduler : public GenericUploadScheduler<CommandQueue>
+	{ };
+}
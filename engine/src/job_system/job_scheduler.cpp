@@ -6,6 +6,7 @@ namespace Sunset
 	AutoCVar_Int cvar_idle_thread_nanosecond_sleep("jobs.idle_thread_nanosecond_sleep", "Number of nanoseconds to wait between sleeps when job scheduler threads have no work queued", 2);
 
 	std::vector<JobQueue> JobScheduler::per_thread_queues;
+	thread_local int32_t JobScheduler::current_thread_index{ -1 };
 
 	JobScheduler::JobScheduler()
 		: thread_pool(MAX_SCHEDULER_THREADS)
@@ -22,15 +23,10 @@ namespace Sunset
 			{
 				thread_pool.run_on_thread([thread_index = i](std::stop_token st, JobScheduler* scheduler)
 				{
+					current_thread_index = thread_index;
 					while (!st.stop_requested())
 					{
-						JobQueue* const thread_queue = JobScheduler::get_job_queue(thread_index);
-						if (thread_queue != nullptr && !thread_queue->was_empty())
-						{
-							Job::Handle job = thread_queue->pop();
-							job.resume();
-						}
-						else
+						if (!scheduler->run_queued_job())
 						{
 							std::this_thread::sleep_for(std::chrono::nanoseconds(cvar_idle_thread_nanosecond_sleep.get()));
 						}
@@ -71,6 +67,24 @@ namespace Sunset
 		return smallest_queue;
 	}
 
+	bool JobScheduler::run_queued_job()
+	{
+		if (current_thread_index < 0)
+		{
+			return false;
+		}
+
+		JobQueue* const thread_queue = get_job_queue(current_thread_index);
+		Job::Handle job;
+		if (thread_queue == nullptr || !thread_queue->try_pop(job))
+		{
+			return false;
+		}
+
+		job.resume();
+		return true;
+	}
+
 	Job::Job(const std::coroutine_handle<>& handle)
 		: handle(handle)
 	{
@@ -84,6 +98,16 @@ namespace Sunset
 
 	void parallel_for(uint32_t iterations, std::function<void(uint32_t)> op)
 	{
+		// Queued jobs would never run without worker threads, so waiting on them would never return
+		if (!JobScheduler::get()->has_available_threads())
+		{
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				op(i);
+			}
+			return;
+		}
+
 		const auto parallel_op = [op](uint32_t index) -> ThreadedJob<>
 		{
 			op(index);
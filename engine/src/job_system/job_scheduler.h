@@ -81,9 +81,15 @@ namespace Sunset
 			return thread_pool.get_num_threads();
 		}
 
+		bool is_initialized() const noexcept
+		{
+			return b_initialized.load();
+		}
+
+		// Worker threads only pick up jobs once initialize has started them, so callers fall back to running inline until then
 		bool has_available_threads() const noexcept
 		{
-			return thread_pool.get_num_threads() > 0;
+			return is_initialized() && thread_pool.get_num_threads() > 0;
 		}
 
 		void set_job_done_state(void* address, bool b_done_state)
@@ -96,6 +102,15 @@ namespace Sunset
 			return job_done_states[address]; 
 		}
 
+		// Index of the worker thread the caller runs on, or -1 when called from outside the scheduler's threads
+		static int32_t get_current_thread_index() noexcept
+		{
+			return current_thread_index;
+		}
+
+		// Pops and runs one job from the calling worker's queue. Returns false if nothing was run.
+		bool run_queued_job();
+
 	protected:
 		ThreadPool thread_pool;	
 		phmap::parallel_flat_hash_map<void*, bool> job_done_states;
@@ -109,6 +124,7 @@ namespace Sunset
 
 	protected:
 		static std::vector<JobQueue> per_thread_queues;
+		static thread_local int32_t current_thread_index;
 	};
 
 	template<int32_t ThreadIndex>
@@ -217,7 +233,11 @@ namespace Sunset
 		{
 			while (!job.is_done())
 			{
-				std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+				// A worker waiting on its own batch may have had some of the batch queued on itself, so it runs queued work instead of just sleeping
+				if (!JobScheduler::get()->run_queued_job())
+				{
+					std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+				}
 			}
 		}
 	}
@@ -3,6 +3,8 @@
 #include <list>
 #include <memory_resource>
 #include <cassert>
+#include <memory>
+#include <vector>
 
 namespace Sunset
 {
@@ -42,27 +44,42 @@ namespace Sunset
 			std::atomic_uint32_t total_free{ 0 };
 	};
 
+	// Fixed size item storage split into chunks of chunk_item_count items. Growing only appends chunks, so pointers
+	// returned by get stay valid and items are never copied.
 	class StaticBytePoolAllocator
 	{
 	public:
-		StaticBytePoolAllocator(size_t item_size, size_t max_item_count)
-			: item_size(item_size), max_item_count(max_item_count)
+		StaticBytePoolAllocator(size_t item_size, size_t chunk_item_count)
+			: item_size(item_size), chunk_item_count(chunk_item_count)
 		{
-			std::pmr::monotonic_buffer_resource buffer_resource{ max_item_count * item_size };
-			std::pmr::polymorphic_allocator<std::byte> allocator{ &buffer_resource };
-			pool = std::pmr::vector<std::byte>{ max_item_count * item_size, std::byte(), allocator};
+			assert(chunk_item_count > 0 && "Pool chunks must hold at least one item!");
+			grow(chunk_item_count);
 		}
 		~StaticBytePoolAllocator() = default;
 
 		inline void* get(size_t index)
 		{
-			assert(index >= 0 && index < max_item_count && "Trying to get an out-of-range pool alloc'd item! Check your index!");
-			return pool.data() + index * item_size;
+			assert(index >= 0 && index < capacity() && "Trying to get an out-of-range pool alloc'd item! Check your index!");
+			return chunks[index / chunk_item_count].get() + (index % chunk_item_count) * item_size;
+		}
+
+		inline size_t capacity() const
+		{
+			return chunks.size() * chunk_item_count;
+		}
+
+		// Adds chunks until the pool can hold at least new_max_item_count items
+		void grow(size_t new_max_item_count)
+		{
+			while (capacity() < new_max_item_count)
+			{
+				chunks.push_back(std::make_unique<std::byte[]>(chunk_item_count * item_size));
+			}
 		}
 
 	protected:
 		size_t item_size;
-		size_t max_item_count;
-		std::pmr::vector<std::byte> pool;
+		size_t chunk_item_count;
+		std::vector<std::unique_ptr<std::byte[]>> chunks;
 	};
 }
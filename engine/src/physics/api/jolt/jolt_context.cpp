@@ -129,6 +129,41 @@ namespace Sunset
 		return create_body_internal(&cylinder_shape_settings, position, rotation, body_type, linear_damping, angular_damping);
 	}
 
+	void JoltContext::create_bodies(const SphereShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+	{
+		JPH::SphereShapeSettings sphere_shape_settings(shape_desc.radius);
+
+		create_bodies_internal(&sphere_shape_settings, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+	}
+
+	void JoltContext::create_bodies(const BoxShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+	{
+		JPH::BoxShapeSettings box_shape_settings(JPH::Vec3Arg(shape_desc.half_extent.x, shape_desc.half_extent.y, shape_desc.half_extent.z), shape_desc.convex_radius);
+
+		create_bodies_internal(&box_shape_settings, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+	}
+
+	void JoltContext::create_bodies(const CapsuleShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+	{
+		if (shape_desc.bottom_radius == shape_desc.top_radius)
+		{
+			JPH::CapsuleShapeSettings capsule_shape_settings(shape_desc.half_height, shape_desc.top_radius);
+			create_bodies_internal(&capsule_shape_settings, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+		}
+		else
+		{
+			JPH::TaperedCapsuleShapeSettings capsule_shape_settings(shape_desc.half_height, shape_desc.top_radius, shape_desc.bottom_radius);
+			create_bodies_internal(&capsule_shape_settings, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+		}
+	}
+
+	void JoltContext::create_bodies(const CylinderShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+	{
+		JPH::CylinderShapeSettings cylinder_shape_settings(shape_desc.half_height, shape_desc.radius, shape_desc.convex_radius);
+
+		create_bodies_internal(&cylinder_shape_settings, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+	}
+
 	void JoltContext::set_global_gravity(const glm::vec3& g)
 	{
 		system_data->physics_system.SetGravity(JPH::RVec3Arg(g.x, g.y, g.z));
@@ -376,6 +411,35 @@ namespace Sunset
 		return new_body_id->GetIndexAndSequenceNumber();
 	}
 
+	void JoltContext::create_bodies_internal(JPH::ShapeSettings* shape_settings, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+	{
+		JPH::BodyInterface& body_interface = system_data->physics_system.GetBodyInterface();
+
+		// Every body in the batch references the same immutable shape instead of building its own
+		JPH::ShapeSettings::ShapeResult shape_result = shape_settings->Create();
+		JPH::ShapeRefC shape = shape_result.Get();
+
+		const JPH::EMotionType motion_type = JOLT_FROM_SUNSET_MOTION_TYPE(body_type);
+		const JPH::ObjectLayer object_layer = JOLT_FROM_SUNSET_OBJECT_LAYER(body_type);
+		JPH::BodyCreationSettings body_settings(shape, JPH::RVec3::sZero(), JPH::Quat::sIdentity(), motion_type, object_layer);
+
+		body_settings.mAllowDynamicOrKinematic = true;
+		body_settings.mLinearDamping = linear_damping;
+		body_settings.mAngularDamping = angular_damping;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			body_settings.mPosition = JPH::RVec3(positions[i].x, positions[i].y, positions[i].z);
+			body_settings.mRotation = JPH::Quat(rotations[i].x, rotations[i].y, rotations[i].z, rotations[i].w);
+
+			JPH::BodyID* new_body_id = system_data->pending_body_adds.get_new();
+			JPH::Body* body = body_interface.CreateBody(body_settings);
+			*new_body_id = body->GetID();
+
+			out_bodies[i] = new_body_id->GetIndexAndSequenceNumber();
+		}
+	}
+
 	void JoltContext::flush_pending_body_adds()
 	{
 		if (system_data->pending_body_adds.size() > 0)
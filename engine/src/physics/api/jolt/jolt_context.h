@@ -117,6 +117,11 @@ namespace Sunset
 		BodyHandle create_body(const CapsuleShapeDescription& shape_desc, const glm::vec3& position, const glm::quat& rotation, PhysicsBodyType body_type, float linear_damping, float angular_damping);
 		BodyHandle create_body(const CylinderShapeDescription& shape_desc, const glm::vec3& position, const glm::quat& rotation, PhysicsBodyType body_type, float linear_damping, float angular_damping);
 
+		void create_bodies(const SphereShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies);
+		void create_bodies(const BoxShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies);
+		void create_bodies(const CapsuleShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies);
+		void create_bodies(const CylinderShapeDescription& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies);
+
 		void set_global_gravity(const glm::vec3& g);
 
 		void destroy_body(BodyHandle body);
@@ -142,6 +147,7 @@ namespace Sunset
 
 	protected:
 		BodyHandle create_body_internal(JPH::ShapeSettings* shape_settings, const glm::vec3& position, const glm::quat& rotation, PhysicsBodyType body_type, float linear_damping, float angular_damping);
+		void create_bodies_internal(JPH::ShapeSettings* shape_settings, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies);
 		void flush_pending_body_adds();
 
 	protected:
@@ -36,6 +36,13 @@ namespace Sunset
 			return physics_policy.create_body(shape_desc, position, rotation, body_type, linear_damping, angular_damping);
 		}
 
+		// Creates count bodies that share a single shape built from shape_desc, writing their handles to out_bodies
+		template<typename T>
+		void create_bodies(const T& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+		{
+			physics_policy.create_bodies(shape_desc, count, positions, rotations, body_type, linear_damping, angular_damping, out_bodies);
+		}
+
 		void destroy_body(BodyHandle body)
 		{
 			physics_policy.destroy_body(body);
@@ -158,6 +165,12 @@ namespace Sunset
 			return -1; 
 		}
 
+		template<typename T>
+		void create_bodies(const T& shape_desc, uint32_t count, const glm::vec3* positions, const glm::quat* rotations, PhysicsBodyType body_type, float linear_damping, float angular_damping, BodyHandle* out_bodies)
+		{
+			std::fill_n(out_bodies, count, BodyHandle(-1));
+		}
+
 		void destroy_body(BodyHandle body)
 		{ }
 
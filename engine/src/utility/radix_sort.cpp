@@ -0,0 +1,146 @@
+#include <utility/radix_sort.h>
+#include <job_system/job_scheduler.h>
+
+namespace Sunset
+{
+	constexpr uint32_t RADIX_SORT_BUCKETS = 256;
+	constexpr uint32_t RADIX_SORT_PASSES = sizeof(uint64_t);
+	// Below this many items per chunk the job round trips cost more than the scatter itself
+	constexpr size_t RADIX_SORT_CHUNK_SIZE = 16384;
+
+	using RadixHistogram = std::array<uint32_t, RADIX_SORT_BUCKETS>;
+
+	inline uint32_t radix_digit(uint64_t key, uint32_t pass)
+	{
+		return static_cast<uint32_t>(key >> (pass * 8)) & (RADIX_SORT_BUCKETS - 1);
+	}
+
+	void RadixSort::sort(std::vector<SortKeyIndex>& items, std::vector<SortKeyIndex>& scratch)
+	{
+		const size_t count = items.size();
+		if (count <= 1)
+		{
+			return;
+		}
+
+		scratch.resize(count);
+
+		// Histograms for every pass can be gathered up front, since a pass only reorders items
+		std::array<RadixHistogram, RADIX_SORT_PASSES> histograms{};
+		for (const SortKeyIndex& item : items)
+		{
+			for (uint32_t pass = 0; pass < RADIX_SORT_PASSES; ++pass)
+			{
+				++histograms[pass][radix_digit(item.key, pass)];
+			}
+		}
+
+		for (uint32_t pass = 0; pass < RADIX_SORT_PASSES; ++pass)
+		{
+			RadixHistogram& histogram = histograms[pass];
+			if (histogram[radix_digit(items[0].key, pass)] == count)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram)
+			{
+				const uint32_t bucket_count = bucket;
+				bucket = offset;
+				offset += bucket_count;
+			}
+
+			for (const SortKeyIndex& item : items)
+			{
+				scratch[histogram[radix_digit(item.key, pass)]++] = item;
+			}
+
+			items.swap(scratch);
+		}
+	}
+
+	void RadixSort::sort_parallel(std::vector<SortKeyIndex>& items, std::vector<SortKeyIndex>& scratch)
+	{
+		const size_t count = items.size();
+		if (count <= RADIX_SORT_CHUNK_SIZE || !JobScheduler::get()->has_available_threads())
+		{
+			sort(items, scratch);
+			return;
+		}
+
+		scratch.resize(count);
+
+		const uint32_t chunk_count = static_cast<uint32_t>((count + RADIX_SORT_CHUNK_SIZE - 1) / RADIX_SORT_CHUNK_SIZE);
+		std::vector<RadixHistogram> chunk_histograms(chunk_count);
+
+		// A pass can be skipped when every key shares its digit, which the min and max keys' differing bits tell us
+		std::vector<uint64_t> chunk_differing_bits(chunk_count, 0);
+		parallel_for(chunk_count, [&items, &chunk_differing_bits, count](uint32_t chunk)
+		{
+			ZoneScopedN("RadixSort::sort_parallel: differing_bits");
+			const size_t begin = chunk * RADIX_SORT_CHUNK_SIZE;
+			const size_t end = std::min(begin + RADIX_SORT_CHUNK_SIZE, count);
+			const uint64_t first_key = items[0].key;
+			uint64_t differing_bits = 0;
+			for (size_t i = begin; i < end; ++i)
+			{
+				differing_bits |= items[i].key ^ first_key;
+			}
+			chunk_differing_bits[chunk] = differing_bits;
+		});
+
+		uint64_t differing_bits = 0;
+		for (const uint64_t chunk_bits : chunk_differing_bits)
+		{
+			differing_bits |= chunk_bits;
+		}
+
+		for (uint32_t pass = 0; pass < RADIX_SORT_PASSES; ++pass)
+		{
+			if (radix_digit(differing_bits, pass) == 0)
+			{
+				continue;
+			}
+
+			parallel_for(chunk_count, [&items, &chunk_histograms, count, pass](uint32_t chunk)
+			{
+				ZoneScopedN("RadixSort::sort_parallel: histogram");
+				const size_t begin = chunk * RADIX_SORT_CHUNK_SIZE;
+				const size_t end = std::min(begin + RADIX_SORT_CHUNK_SIZE, count);
+				RadixHistogram& histogram = chunk_histograms[chunk];
+				histogram.fill(0);
+				for (size_t i = begin; i < end; ++i)
+				{
+					++histogram[radix_digit(items[i].key, pass)];
+				}
+			});
+
+			// Turn counts into write offsets, ordered by bucket and then by chunk so the sort stays stable
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < RADIX_SORT_BUCKETS; ++bucket)
+			{
+				for (RadixHistogram& histogram : chunk_histograms)
+				{
+					const uint32_t bucket_count = histogram[bucket];
+					histogram[bucket] = offset;
+					offset += bucket_count;
+				}
+			}
+
+			parallel_for(chunk_count, [&items, &scratch, &chunk_histograms, count, pass](uint32_t chunk)
+			{
+				ZoneScopedN("RadixSort::sort_parallel: scatter");
+				const size_t begin = chunk * RADIX_SORT_CHUNK_SIZE;
+				const size_t end = std::min(begin + RADIX_SORT_CHUNK_SIZE, count);
+				RadixHistogram& offsets = chunk_histograms[chunk];
+				for (size_t i = begin; i < end; ++i)
+				{
+					scratch[offsets[radix_digit(items[i].key, pass)]++] = items[i];
+				}
+			});
+
+			items.swap(scratch);
+		}
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <minimal.h>
+
+namespace Sunset
+{
+	struct SortKeyIndex
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	namespace RadixSort
+	{
+		// Stable 8-bit LSD radix sort by key. Byte passes that every key agrees on are skipped, so keys that only use
+		// their low bits cost fewer passes. scratch is resized as needed and holds garbage afterwards.
+		void sort(std::vector<SortKeyIndex>& items, std::vector<SortKeyIndex>& scratch);
+		// Same result as sort, with the histogram and scatter steps split into chunks across job threads for large arrays
+		void sort_parallel(std::vector<SortKeyIndex>& items, std::vector<SortKeyIndex>& scratch);
+	}
+}
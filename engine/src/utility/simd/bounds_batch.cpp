@@ -0,0 +1,235 @@
+#include <utility/simd/bounds_batch.h>
+
+#if SUNSET_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Sunset
+{
+	void BoundsBatch::add(const glm::vec3& center, const glm::vec3& extents, float radius, const glm::mat4* transform)
+	{
+		assert(transform != nullptr && "Cannot add bounds to a batch without a transform!");
+		local_center_x.push_back(center.x);
+		local_center_y.push_back(center.y);
+		local_center_z.push_back(center.z);
+		local_extent_x.push_back(extents.x);
+		local_extent_y.push_back(extents.y);
+		local_extent_z.push_back(extents.z);
+		local_radius.push_back(radius);
+		transforms.push_back(transform);
+
+		world_center_x.push_back(0.0f);
+		world_center_y.push_back(0.0f);
+		world_center_z.push_back(0.0f);
+		world_extent_x.push_back(0.0f);
+		world_extent_y.push_back(0.0f);
+		world_extent_z.push_back(0.0f);
+		world_radius.push_back(0.0f);
+	}
+
+	void BoundsBatch::reserve(size_t count)
+	{
+		local_center_x.reserve(count);
+		local_center_y.reserve(count);
+		local_center_z.reserve(count);
+		local_extent_x.reserve(count);
+		local_extent_y.reserve(count);
+		local_extent_z.reserve(count);
+		local_radius.reserve(count);
+		transforms.reserve(count);
+		world_center_x.reserve(count);
+		world_center_y.reserve(count);
+		world_center_z.reserve(count);
+		world_extent_x.reserve(count);
+		world_extent_y.reserve(count);
+		world_extent_z.reserve(count);
+		world_radius.reserve(count);
+	}
+
+	void BoundsBatch::clear()
+	{
+		local_center_x.clear();
+		local_center_y.clear();
+		local_center_z.clear();
+		local_extent_x.clear();
+		local_extent_y.clear();
+		local_extent_z.clear();
+		local_radius.clear();
+		transforms.clear();
+		world_center_x.clear();
+		world_center_y.clear();
+		world_center_z.clear();
+		world_extent_x.clear();
+		world_extent_y.clear();
+		world_extent_z.clear();
+		world_radius.clear();
+	}
+
+	// Center goes through the full affine transform, extents through the absolute value of the upper 3x3 (Arvo's method)
+	static void transform_scalar(BoundsBatch& batch, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const glm::mat4& m = *batch.transforms[i];
+			const float cx = batch.local_center_x[i];
+			const float cy = batch.local_center_y[i];
+			const float cz = batch.local_center_z[i];
+			const float ex = batch.local_extent_x[i];
+			const float ey = batch.local_extent_y[i];
+			const float ez = batch.local_extent_z[i];
+
+			batch.world_center_x[i] = m[0][0] * cx + m[1][0] * cy + m[2][0] * cz + m[3][0];
+			batch.world_center_y[i] = m[0][1] * cx + m[1][1] * cy + m[2][1] * cz + m[3][1];
+			batch.world_center_z[i] = m[0][2] * cx + m[1][2] * cy + m[2][2] * cz + m[3][2];
+
+			batch.world_extent_x[i] = std::abs(m[0][0]) * ex + std::abs(m[1][0]) * ey + std::abs(m[2][0]) * ez;
+			batch.world_extent_y[i] = std::abs(m[0][1]) * ex + std::abs(m[1][1]) * ey + std::abs(m[2][1]) * ez;
+			batch.world_extent_z[i] = std::abs(m[0][2]) * ex + std::abs(m[1][2]) * ey + std::abs(m[2][2]) * ez;
+
+			const float scale_x_sq = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+			const float scale_y_sq = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+			const float scale_z_sq = m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2];
+			batch.world_radius[i] = std::sqrt(std::max(scale_x_sq, std::max(scale_y_sq, scale_z_sq))) * batch.local_radius[i];
+		}
+	}
+
+#if SUNSET_SIMD_X86
+	// Gathers one matrix column from four transforms and transposes it so each register holds one component across all four
+	SUNSET_TARGET_SSE41 static inline void load_column_x4(const glm::mat4* const* transforms, uint32_t column, __m128& x, __m128& y, __m128& z)
+	{
+		__m128 c0 = _mm_loadu_ps(&(*transforms[0])[column][0]);
+		__m128 c1 = _mm_loadu_ps(&(*transforms[1])[column][0]);
+		__m128 c2 = _mm_loadu_ps(&(*transforms[2])[column][0]);
+		__m128 c3 = _mm_loadu_ps(&(*transforms[3])[column][0]);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		x = c0;
+		y = c1;
+		z = c2;
+	}
+
+	SUNSET_TARGET_SSE41 static inline __m128 abs_x4(__m128 value)
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+	}
+
+	SUNSET_TARGET_SSE41 static size_t transform_sse41(BoundsBatch& batch)
+	{
+		const size_t simd_count = batch.size() & ~size_t(3);
+		for (size_t i = 0; i < simd_count; i += 4)
+		{
+			const glm::mat4* const* transforms = &batch.transforms[i];
+			__m128 m0x, m0y, m0z, m1x, m1y, m1z, m2x, m2y, m2z, m3x, m3y, m3z;
+			load_column_x4(transforms, 0, m0x, m0y, m0z);
+			load_column_x4(transforms, 1, m1x, m1y, m1z);
+			load_column_x4(transforms, 2, m2x, m2y, m2z);
+			load_column_x4(transforms, 3, m3x, m3y, m3z);
+
+			const __m128 cx = _mm_loadu_ps(&batch.local_center_x[i]);
+			const __m128 cy = _mm_loadu_ps(&batch.local_center_y[i]);
+			const __m128 cz = _mm_loadu_ps(&batch.local_center_z[i]);
+			const __m128 ex = _mm_loadu_ps(&batch.local_extent_x[i]);
+			const __m128 ey = _mm_loadu_ps(&batch.local_extent_y[i]);
+			const __m128 ez = _mm_loadu_ps(&batch.local_extent_z[i]);
+
+			_mm_storeu_ps(&batch.world_center_x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0x, cx), _mm_mul_ps(m1x, cy)), _mm_add_ps(_mm_mul_ps(m2x, cz), m3x)));
+			_mm_storeu_ps(&batch.world_center_y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0y, cx), _mm_mul_ps(m1y, cy)), _mm_add_ps(_mm_mul_ps(m2y, cz), m3y)));
+			_mm_storeu_ps(&batch.world_center_z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0z, cx), _mm_mul_ps(m1z, cy)), _mm_add_ps(_mm_mul_ps(m2z, cz), m3z)));
+
+			_mm_storeu_ps(&batch.world_extent_x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_x4(m0x), ex), _mm_mul_ps(abs_x4(m1x), ey)), _mm_mul_ps(abs_x4(m2x), ez)));
+			_mm_storeu_ps(&batch.world_extent_y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_x4(m0y), ex), _mm_mul_ps(abs_x4(m1y), ey)), _mm_mul_ps(abs_x4(m2y), ez)));
+			_mm_storeu_ps(&batch.world_extent_z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_x4(m0z), ex), _mm_mul_ps(abs_x4(m1z), ey)), _mm_mul_ps(abs_x4(m2z), ez)));
+
+			const __m128 scale_x_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0x, m0x), _mm_mul_ps(m0y, m0y)), _mm_mul_ps(m0z, m0z));
+			const __m128 scale_y_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1x, m1x), _mm_mul_ps(m1y, m1y)), _mm_mul_ps(m1z, m1z));
+			const __m128 scale_z_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2x, m2x), _mm_mul_ps(m2y, m2y)), _mm_mul_ps(m2z, m2z));
+			const __m128 max_scale = _mm_sqrt_ps(_mm_max_ps(scale_x_sq, _mm_max_ps(scale_y_sq, scale_z_sq)));
+			_mm_storeu_ps(&batch.world_radius[i], _mm_mul_ps(max_scale, _mm_loadu_ps(&batch.local_radius[i])));
+		}
+		return simd_count;
+	}
+
+	// Two four lane gathers merged into one register, since there is no cheap cross-lane 8x4 transpose in AVX2
+	SUNSET_TARGET_AVX2 static inline void load_column_x8(const glm::mat4* const* transforms, uint32_t column, __m256& x, __m256& y, __m256& z)
+	{
+		__m128 lo_x, lo_y, lo_z, hi_x, hi_y, hi_z;
+		load_column_x4(transforms, column, lo_x, lo_y, lo_z);
+		load_column_x4(transforms + 4, column, hi_x, hi_y, hi_z);
+		x = _mm256_insertf128_ps(_mm256_castps128_ps256(lo_x), hi_x, 1);
+		y = _mm256_insertf128_ps(_mm256_castps128_ps256(lo_y), hi_y, 1);
+		z = _mm256_insertf128_ps(_mm256_castps128_ps256(lo_z), hi_z, 1);
+	}
+
+	SUNSET_TARGET_AVX2 static inline __m256 abs_x8(__m256 value)
+	{
+		return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+	}
+
+	SUNSET_TARGET_AVX2 static size_t transform_avx2(BoundsBatch& batch)
+	{
+		const size_t simd_count = batch.size() & ~size_t(7);
+		for (size_t i = 0; i < simd_count; i += 8)
+		{
+			const glm::mat4* const* transforms = &batch.transforms[i];
+			__m256 m0x, m0y, m0z, m1x, m1y, m1z, m2x, m2y, m2z, m3x, m3y, m3z;
+			load_column_x8(transforms, 0, m0x, m0y, m0z);
+			load_column_x8(transforms, 1, m1x, m1y, m1z);
+			load_column_x8(transforms, 2, m2x, m2y, m2z);
+			load_column_x8(transforms, 3, m3x, m3y, m3z);
+
+			const __m256 cx = _mm256_loadu_ps(&batch.local_center_x[i]);
+			const __m256 cy = _mm256_loadu_ps(&batch.local_center_y[i]);
+			const __m256 cz = _mm256_loadu_ps(&batch.local_center_z[i]);
+			const __m256 ex = _mm256_loadu_ps(&batch.local_extent_x[i]);
+			const __m256 ey = _mm256_loadu_ps(&batch.local_extent_y[i]);
+			const __m256 ez = _mm256_loadu_ps(&batch.local_extent_z[i]);
+
+			_mm256_storeu_ps(&batch.world_center_x[i], _mm256_fmadd_ps(m0x, cx, _mm256_fmadd_ps(m1x, cy, _mm256_fmadd_ps(m2x, cz, m3x))));
+			_mm256_storeu_ps(&batch.world_center_y[i], _mm256_fmadd_ps(m0y, cx, _mm256_fmadd_ps(m1y, cy, _mm256_fmadd_ps(m2y, cz, m3y))));
+			_mm256_storeu_ps(&batch.world_center_z[i], _mm256_fmadd_ps(m0z, cx, _mm256_fmadd_ps(m1z, cy, _mm256_fmadd_ps(m2z, cz, m3z))));
+
+			_mm256_storeu_ps(&batch.world_extent_x[i], _mm256_fmadd_ps(abs_x8(m0x), ex, _mm256_fmadd_ps(abs_x8(m1x), ey, _mm256_mul_ps(abs_x8(m2x), ez))));
+			_mm256_storeu_ps(&batch.world_extent_y[i], _mm256_fmadd_ps(abs_x8(m0y), ex, _mm256_fmadd_ps(abs_x8(m1y), ey, _mm256_mul_ps(abs_x8(m2y), ez))));
+			_mm256_storeu_ps(&batch.world_extent_z[i], _mm256_fmadd_ps(abs_x8(m0z), ex, _mm256_fmadd_ps(abs_x8(m1z), ey, _mm256_mul_ps(abs_x8(m2z), ez))));
+
+			const __m256 scale_x_sq = _mm256_fmadd_ps(m0z, m0z, _mm256_fmadd_ps(m0y, m0y, _mm256_mul_ps(m0x, m0x)));
+			const __m256 scale_y_sq = _mm256_fmadd_ps(m1z, m1z, _mm256_fmadd_ps(m1y, m1y, _mm256_mul_ps(m1x, m1x)));
+			const __m256 scale_z_sq = _mm256_fmadd_ps(m2z, m2z, _mm256_fmadd_ps(m2y, m2y, _mm256_mul_ps(m2x, m2x)));
+			const __m256 max_scale = _mm256_sqrt_ps(_mm256_max_ps(scale_x_sq, _mm256_max_ps(scale_y_sq, scale_z_sq)));
+			_mm256_storeu_ps(&batch.world_radius[i], _mm256_mul_ps(max_scale, _mm256_loadu_ps(&batch.local_radius[i])));
+		}
+		return simd_count;
+	}
+#endif
+
+	void BoundsBatchOps::transform(BoundsBatch& batch, SIMDLevel simd_level)
+	{
+		const SIMDLevel supported_level = CPUFeatures::get_simd_level();
+		if (simd_level > supported_level)
+		{
+			simd_level = supported_level;
+		}
+
+		size_t processed_count = 0;
+#if SUNSET_SIMD_X86
+		switch (simd_level)
+		{
+			case SIMDLevel::AVX2:
+				processed_count = transform_avx2(batch);
+				break;
+			case SIMDLevel::SSE41:
+				processed_count = transform_sse41(batch);
+				break;
+			default:
+				break;
+		}
+#endif
+
+		// Leftovers that don't fill a full SIMD lane set
+		transform_scalar(batch, processed_count, batch.size());
+	}
+
+	void BoundsBatchOps::transform(BoundsBatch& batch)
+	{
+		transform(batch, CPUFeatures::get_simd_level());
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <minimal.h>
+#include <utility/simd/cpu_features.h>
+
+namespace Sunset
+{
+	// Structure-of-arrays staging for local bounds that need to be brought into world space. Each entry
+	// produces an enclosing world AABB (center and half extents) and a bounding sphere radius scaled by the
+	// largest axis scale of its transform.
+	struct BoundsBatch
+	{
+		std::vector<float> local_center_x;
+		std::vector<float> local_center_y;
+		std::vector<float> local_center_z;
+		std::vector<float> local_extent_x;
+		std::vector<float> local_extent_y;
+		std::vector<float> local_extent_z;
+		std::vector<float> local_radius;
+		std::vector<const glm::mat4*> transforms;
+
+		std::vector<float> world_center_x;
+		std::vector<float> world_center_y;
+		std::vector<float> world_center_z;
+		std::vector<float> world_extent_x;
+		std::vector<float> world_extent_y;
+		std::vector<float> world_extent_z;
+		std::vector<float> world_radius;
+
+		void add(const glm::vec3& center, const glm::vec3& extents, float radius, const glm::mat4* transform);
+		void reserve(size_t count);
+		void clear();
+
+		glm::vec3 get_world_center(size_t index) const
+		{
+			return glm::vec3(world_center_x[index], world_center_y[index], world_center_z[index]);
+		}
+
+		glm::vec3 get_world_extents(size_t index) const
+		{
+			return glm::vec3(world_extent_x[index], world_extent_y[index], world_extent_z[index]);
+		}
+
+		size_t size() const
+		{
+			return transforms.size();
+		}
+	};
+
+	namespace BoundsBatchOps
+	{
+		// Transforms every entry in the batch using the requested SIMD level, clamped to what the host CPU supports.
+		void transform(BoundsBatch& batch, SIMDLevel simd_level);
+		// Transforms every entry in the batch using the best SIMD level the host CPU supports.
+		void transform(BoundsBatch& batch);
+	}
+}
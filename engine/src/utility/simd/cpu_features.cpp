@@ -0,0 +1,87 @@
+#include <utility/simd/cpu_features.h>
+
+#if SUNSET_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Sunset
+{
+#if SUNSET_SIMD_X86
+	static void query_cpuid(int32_t leaf, int32_t subleaf, int32_t out_registers[4])
+	{
+#if defined(_MSC_VER)
+		__cpuidex(out_registers, leaf, subleaf);
+#else
+		uint32_t eax, ebx, ecx, edx;
+		__cpuid_count(leaf, subleaf, eax, ebx, ecx, edx);
+		out_registers[0] = eax;
+		out_registers[1] = ebx;
+		out_registers[2] = ecx;
+		out_registers[3] = edx;
+#endif
+	}
+
+	static uint64_t query_xcr0()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32_t eax, edx;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return ((uint64_t)edx << 32) | eax;
+#endif
+	}
+
+	static SIMDLevel detect_simd_level()
+	{
+		int32_t registers[4];
+
+		query_cpuid(0, 0, registers);
+		const int32_t max_leaf = registers[0];
+		if (max_leaf < 1)
+		{
+			return SIMDLevel::Scalar;
+		}
+
+		query_cpuid(1, 0, registers);
+		const bool b_has_sse41 = (registers[2] & (1 << 19)) != 0;
+		const bool b_has_fma = (registers[2] & (1 << 12)) != 0;
+		const bool b_has_osxsave = (registers[2] & (1 << 27)) != 0;
+		const bool b_has_avx = (registers[2] & (1 << 28)) != 0;
+
+		// The OS also has to save the upper halves of the YMM registers across context switches
+		const bool b_os_saves_ymm = b_has_osxsave && (query_xcr0() & 0x6) == 0x6;
+
+		bool b_has_avx2 = false;
+		if (max_leaf >= 7)
+		{
+			query_cpuid(7, 0, registers);
+			b_has_avx2 = (registers[1] & (1 << 5)) != 0;
+		}
+
+		if (b_has_avx && b_has_avx2 && b_has_fma && b_os_saves_ymm)
+		{
+			return SIMDLevel::AVX2;
+		}
+		if (b_has_sse41)
+		{
+			return SIMDLevel::SSE41;
+		}
+		return SIMDLevel::Scalar;
+	}
+#endif
+
+	SIMDLevel CPUFeatures::get_simd_level()
+	{
+#if SUNSET_SIMD_X86
+		static const SIMDLevel simd_level = detect_simd_level();
+		return simd_level;
+#else
+		return SIMDLevel::Scalar;
+#endif
+	}
+}
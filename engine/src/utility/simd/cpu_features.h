@@ -0,0 +1,35 @@
+#pragma once
+
+#include <minimal.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SUNSET_SIMD_X86 1
+#else
+#define SUNSET_SIMD_X86 0
+#endif
+
+// MSVC allows intrinsics for any instruction set without a matching /arch flag, while GCC and Clang
+// need the target attribute on the function using them.
+#if SUNSET_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SUNSET_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SUNSET_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SUNSET_TARGET_SSE41
+#define SUNSET_TARGET_AVX2
+#endif
+
+namespace Sunset
+{
+	enum class SIMDLevel : uint8_t
+	{
+		Scalar = 0,
+		SSE41,
+		AVX2
+	};
+
+	namespace CPUFeatures
+	{
+		// Highest SIMD level supported by both the host CPU and this build. Queried once and cached.
+		SIMDLevel get_simd_level();
+	}
+}
@@ -0,0 +1,223 @@
+#include <utility/simd/sphere_cull_batch.h>
+#include <job_system/job_scheduler.h>
+#include <algorithm>
+
+#if SUNSET_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Sunset
+{
+	// Large enough that a job round trip is amortized, small enough to spread a big scene across workers
+	constexpr size_t SPHERE_CULL_CHUNK_SIZE = 4096;
+
+	void SphereCullBatch::add(const glm::vec3& center, float sphere_radius)
+	{
+		center_x.push_back(center.x);
+		center_y.push_back(center.y);
+		center_z.push_back(center.z);
+		radius.push_back(sphere_radius);
+		visibility.push_back(1);
+	}
+
+	void SphereCullBatch::reserve(size_t count)
+	{
+		center_x.reserve(count);
+		center_y.reserve(count);
+		center_z.reserve(count);
+		radius.reserve(count);
+		visibility.reserve(count);
+	}
+
+	void SphereCullBatch::clear()
+	{
+		center_x.clear();
+		center_y.clear();
+		center_z.clear();
+		radius.clear();
+		visibility.clear();
+	}
+
+	static void cull_scalar(SphereCullBatch& batch, const SphereCullView& view, size_t begin, size_t end)
+	{
+		const float max_distance = view.max_distance;
+		for (size_t i = begin; i < end; ++i)
+		{
+			const float x = batch.center_x[i];
+			const float y = batch.center_y[i];
+			const float z = batch.center_z[i];
+			const float r = batch.radius[i];
+
+			bool b_visible = true;
+			for (uint32_t p = 0; p < view.plane_count; ++p)
+			{
+				const glm::vec4& plane = view.planes[p];
+				b_visible &= (x * plane.x + y * plane.y + z * plane.z + plane.w > -r);
+			}
+
+			if (max_distance > 0.0f)
+			{
+				const float dx = x - view.position.x;
+				const float dy = y - view.position.y;
+				const float dz = z - view.position.z;
+				const float reach = max_distance + r;
+				b_visible &= (dx * dx + dy * dy + dz * dz <= reach * reach);
+			}
+
+			batch.visibility[i] = b_visible ? 1 : 0;
+		}
+	}
+
+#if SUNSET_SIMD_X86
+	SUNSET_TARGET_SSE41 static size_t cull_sse41(SphereCullBatch& batch, const SphereCullView& view, size_t begin, size_t end)
+	{
+		const size_t simd_end = begin + ((end - begin) & ~size_t(3));
+		const bool b_distance_check = view.max_distance > 0.0f;
+		const __m128 max_distance = _mm_set1_ps(view.max_distance);
+		const __m128 view_x = _mm_set1_ps(view.position.x);
+		const __m128 view_y = _mm_set1_ps(view.position.y);
+		const __m128 view_z = _mm_set1_ps(view.position.z);
+
+		for (size_t i = begin; i < simd_end; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(&batch.center_x[i]);
+			const __m128 y = _mm_loadu_ps(&batch.center_y[i]);
+			const __m128 z = _mm_loadu_ps(&batch.center_z[i]);
+			const __m128 r = _mm_loadu_ps(&batch.radius[i]);
+			const __m128 negative_r = _mm_sub_ps(_mm_setzero_ps(), r);
+
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (uint32_t p = 0; p < view.plane_count; ++p)
+			{
+				const glm::vec4& plane = view.planes[p];
+				const __m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+					_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w))
+				);
+				visible = _mm_and_ps(visible, _mm_cmpgt_ps(distance, negative_r));
+			}
+
+			if (b_distance_check)
+			{
+				const __m128 dx = _mm_sub_ps(x, view_x);
+				const __m128 dy = _mm_sub_ps(y, view_y);
+				const __m128 dz = _mm_sub_ps(z, view_z);
+				const __m128 reach = _mm_add_ps(max_distance, r);
+				const __m128 distance_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				visible = _mm_and_ps(visible, _mm_cmple_ps(distance_sq, _mm_mul_ps(reach, reach)));
+			}
+
+			const int mask = _mm_movemask_ps(visible);
+			batch.visibility[i + 0] = (mask >> 0) & 1;
+			batch.visibility[i + 1] = (mask >> 1) & 1;
+			batch.visibility[i + 2] = (mask >> 2) & 1;
+			batch.visibility[i + 3] = (mask >> 3) & 1;
+		}
+		return simd_end;
+	}
+
+	SUNSET_TARGET_AVX2 static size_t cull_avx2(SphereCullBatch& batch, const SphereCullView& view, size_t begin, size_t end)
+	{
+		const size_t simd_end = begin + ((end - begin) & ~size_t(7));
+		const bool b_distance_check = view.max_distance > 0.0f;
+		const __m256 max_distance = _mm256_set1_ps(view.max_distance);
+		const __m256 view_x = _mm256_set1_ps(view.position.x);
+		const __m256 view_y = _mm256_set1_ps(view.position.y);
+		const __m256 view_z = _mm256_set1_ps(view.position.z);
+
+		for (size_t i = begin; i < simd_end; i += 8)
+		{
+			const __m256 x = _mm256_loadu_ps(&batch.center_x[i]);
+			const __m256 y = _mm256_loadu_ps(&batch.center_y[i]);
+			const __m256 z = _mm256_loadu_ps(&batch.center_z[i]);
+			const __m256 r = _mm256_loadu_ps(&batch.radius[i]);
+			const __m256 negative_r = _mm256_sub_ps(_mm256_setzero_ps(), r);
+
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (uint32_t p = 0; p < view.plane_count; ++p)
+			{
+				const glm::vec4& plane = view.planes[p];
+				const __m256 distance = _mm256_fmadd_ps(x, _mm256_set1_ps(plane.x),
+					_mm256_fmadd_ps(y, _mm256_set1_ps(plane.y),
+					_mm256_fmadd_ps(z, _mm256_set1_ps(plane.z), _mm256_set1_ps(plane.w))));
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negative_r, _CMP_GT_OQ));
+			}
+
+			if (b_distance_check)
+			{
+				const __m256 dx = _mm256_sub_ps(x, view_x);
+				const __m256 dy = _mm256_sub_ps(y, view_y);
+				const __m256 dz = _mm256_sub_ps(z, view_z);
+				const __m256 reach = _mm256_add_ps(max_distance, r);
+				const __m256 distance_sq = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance_sq, _mm256_mul_ps(reach, reach), _CMP_LE_OQ));
+			}
+
+			const int mask = _mm256_movemask_ps(visible);
+			for (uint32_t lane = 0; lane < 8; ++lane)
+			{
+				batch.visibility[i + lane] = (mask >> lane) & 1;
+			}
+		}
+		return simd_end;
+	}
+#endif
+
+	void SphereCullOps::set_frustum_planes(SphereCullView& view, const glm::vec4* frustum_planes, bool b_distance_check)
+	{
+		view.plane_count = b_distance_check ? MAX_SPHERE_CULL_PLANES : SPHERE_CULL_SIDE_PLANE_COUNT;
+		std::copy_n(frustum_planes, view.plane_count, view.planes);
+	}
+
+	void SphereCullOps::cull(SphereCullBatch& batch, const SphereCullView& view, size_t begin, size_t end, SIMDLevel simd_level)
+	{
+		assert(end <= batch.size() && view.plane_count <= MAX_SPHERE_CULL_PLANES);
+
+		const SIMDLevel supported_level = CPUFeatures::get_simd_level();
+		if (simd_level > supported_level)
+		{
+			simd_level = supported_level;
+		}
+
+		size_t processed_end = begin;
+#if SUNSET_SIMD_X86
+		switch (simd_level)
+		{
+			case SIMDLevel::AVX2:
+				processed_end = cull_avx2(batch, view, begin, end);
+				break;
+			case SIMDLevel::SSE41:
+				processed_end = cull_sse41(batch, view, begin, end);
+				break;
+			default:
+				break;
+		}
+#endif
+
+		// Leftovers that don't fill a full SIMD lane set
+		cull_scalar(batch, view, processed_end, end);
+	}
+
+	size_t SphereCullOps::cull_parallel(SphereCullBatch& batch, const SphereCullView& view)
+	{
+		const SIMDLevel simd_level = CPUFeatures::get_simd_level();
+		const size_t count = batch.size();
+
+		if (count <= SPHERE_CULL_CHUNK_SIZE || !JobScheduler::get()->has_available_threads())
+		{
+			cull(batch, view, 0, count, simd_level);
+		}
+		else
+		{
+			const uint32_t chunk_count = static_cast<uint32_t>((count + SPHERE_CULL_CHUNK_SIZE - 1) / SPHERE_CULL_CHUNK_SIZE);
+			parallel_for(chunk_count, [&batch, &view, count, simd_level](uint32_t chunk)
+			{
+				ZoneScopedN("SphereCullOps::cull_parallel: chunk");
+				const size_t begin = chunk * SPHERE_CULL_CHUNK_SIZE;
+				cull(batch, view, begin, std::min(begin + SPHERE_CULL_CHUNK_SIZE, count), simd_level);
+			});
+		}
+
+		return std::count(batch.visibility.begin(), batch.visibility.end(), uint8_t(0));
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <minimal.h>
+#include <utility/simd/cpu_features.h>
+
+namespace Sunset
+{
+	// Structure-of-arrays world bounding spheres to test against a view. Culling fills visibility with
+	// 1 for spheres that may be visible and 0 for those that are definitely outside the view.
+	struct SphereCullBatch
+	{
+		std::vector<float> center_x;
+		std::vector<float> center_y;
+		std::vector<float> center_z;
+		std::vector<float> radius;
+		std::vector<uint8_t> visibility;
+
+		void add(const glm::vec3& center, float sphere_radius);
+		void reserve(size_t count);
+		void clear();
+
+		size_t size() const
+		{
+			return radius.size();
+		}
+	};
+
+	constexpr uint32_t MAX_SPHERE_CULL_PLANES = 6;
+	// Left, right, top and bottom come first in CameraData::frustum_planes, followed by near and far
+	constexpr uint32_t SPHERE_CULL_SIDE_PLANE_COUNT = 4;
+
+	struct SphereCullView
+	{
+		// Inward facing, normalized planes, laid out like CameraData::frustum_planes
+		glm::vec4 planes[MAX_SPHERE_CULL_PLANES];
+		uint32_t plane_count{ 0 };
+		glm::vec3 position{ 0.0f };
+		// Spheres further than this from the view position are culled. Disabled when <= 0.
+		float max_distance{ 0.0f };
+	};
+
+	namespace SphereCullOps
+	{
+		// Copies a camera's frustum planes into the view. Like the sphere test in cull.comp, near and far are only tested when
+		// b_distance_check is set, so the view never culls a sphere the GPU would keep.
+		void set_frustum_planes(SphereCullView& view, const glm::vec4* frustum_planes, bool b_distance_check);
+		// Culls spheres in [begin, end) using the requested SIMD level, clamped to what the host CPU supports.
+		void cull(SphereCullBatch& batch, const SphereCullView& view, size_t begin, size_t end, SIMDLevel simd_level);
+		// Culls every sphere in the batch, split into chunks across job threads when the batch is large enough.
+		// Returns the number of spheres that were culled.
+		size_t cull_parallel(SphereCullBatch& batch, const SphereCullView& view);
+	}
+}
@@ -0,0 +1,275 @@
+#include <utility/simd/transform_batch.h>
+
+#if SUNSET_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Sunset
+{
+	void TransformBatch::add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4* output)
+	{
+		assert(output != nullptr && "Cannot add a transform to a batch without an output matrix!");
+		position_x.push_back(position.x);
+		position_y.push_back(position.y);
+		position_z.push_back(position.z);
+		rotation_x.push_back(rotation.x);
+		rotation_y.push_back(rotation.y);
+		rotation_z.push_back(rotation.z);
+		rotation_w.push_back(rotation.w);
+		scale_x.push_back(scale.x);
+		scale_y.push_back(scale.y);
+		scale_z.push_back(scale.z);
+		outputs.push_back(output);
+	}
+
+	void TransformBatch::reserve(size_t count)
+	{
+		position_x.reserve(count);
+		position_y.reserve(count);
+		position_z.reserve(count);
+		rotation_x.reserve(count);
+		rotation_y.reserve(count);
+		rotation_z.reserve(count);
+		rotation_w.reserve(count);
+		scale_x.reserve(count);
+		scale_y.reserve(count);
+		scale_z.reserve(count);
+		outputs.reserve(count);
+	}
+
+	void TransformBatch::clear()
+	{
+		position_x.clear();
+		position_y.clear();
+		position_z.clear();
+		rotation_x.clear();
+		rotation_y.clear();
+		rotation_z.clear();
+		rotation_w.clear();
+		scale_x.clear();
+		scale_y.clear();
+		scale_z.clear();
+		outputs.clear();
+	}
+
+	// Mirrors glm::translate * glm::mat4_cast(glm::normalize(q)) * glm::scale without the full matrix multiplies
+	static void compose_scalar(const TransformBatch& batch, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			float qx = batch.rotation_x[i];
+			float qy = batch.rotation_y[i];
+			float qz = batch.rotation_z[i];
+			float qw = batch.rotation_w[i];
+
+			const float length = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+			if (length > 0.0f)
+			{
+				const float inv_length = 1.0f / length;
+				qx *= inv_length;
+				qy *= inv_length;
+				qz *= inv_length;
+				qw *= inv_length;
+			}
+			else
+			{
+				qx = qy = qz = 0.0f;
+				qw = 1.0f;
+			}
+
+			const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+			const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+			const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+			const float sx = batch.scale_x[i];
+			const float sy = batch.scale_y[i];
+			const float sz = batch.scale_z[i];
+
+			glm::mat4& out = *batch.outputs[i];
+			out[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f);
+			out[1] = glm::vec4(2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f);
+			out[2] = glm::vec4(2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f);
+			out[3] = glm::vec4(batch.position_x[i], batch.position_y[i], batch.position_z[i], 1.0f);
+		}
+	}
+
+#if SUNSET_SIMD_X86
+	// Transposes one matrix column held across four lanes (one transform per lane) and writes it to each transform's output matrix
+	SUNSET_TARGET_SSE41 static inline void store_column_x4(glm::mat4* const* outputs, uint32_t column, __m128 x, __m128 y, __m128 z, __m128 w)
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(&(*outputs[0])[column][0], x);
+		_mm_storeu_ps(&(*outputs[1])[column][0], y);
+		_mm_storeu_ps(&(*outputs[2])[column][0], z);
+		_mm_storeu_ps(&(*outputs[3])[column][0], w);
+	}
+
+	SUNSET_TARGET_SSE41 static size_t compose_sse41(const TransformBatch& batch)
+	{
+		const size_t simd_count = batch.size() & ~size_t(3);
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+
+		for (size_t i = 0; i < simd_count; i += 4)
+		{
+			__m128 qx = _mm_loadu_ps(&batch.rotation_x[i]);
+			__m128 qy = _mm_loadu_ps(&batch.rotation_y[i]);
+			__m128 qz = _mm_loadu_ps(&batch.rotation_z[i]);
+			__m128 qw = _mm_loadu_ps(&batch.rotation_w[i]);
+
+			const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw))));
+			const __m128 valid = _mm_cmpgt_ps(length, zero);
+			const __m128 inv_length = _mm_div_ps(one, length);
+			qx = _mm_and_ps(_mm_mul_ps(qx, inv_length), valid);
+			qy = _mm_and_ps(_mm_mul_ps(qy, inv_length), valid);
+			qz = _mm_and_ps(_mm_mul_ps(qz, inv_length), valid);
+			qw = _mm_blendv_ps(one, _mm_mul_ps(qw, inv_length), valid);
+
+			const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+			const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+			const __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+			const __m128 sx = _mm_loadu_ps(&batch.scale_x[i]);
+			const __m128 sy = _mm_loadu_ps(&batch.scale_y[i]);
+			const __m128 sz = _mm_loadu_ps(&batch.scale_z[i]);
+
+			glm::mat4* const* outputs = &batch.outputs[i];
+
+			store_column_x4(outputs, 0,
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+				zero);
+			store_column_x4(outputs, 1,
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+				zero);
+			store_column_x4(outputs, 2,
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+				zero);
+			store_column_x4(outputs, 3,
+				_mm_loadu_ps(&batch.position_x[i]),
+				_mm_loadu_ps(&batch.position_y[i]),
+				_mm_loadu_ps(&batch.position_z[i]),
+				one);
+		}
+
+		return simd_count;
+	}
+
+	// Splits an eight lane column into two four lane transposes, since there is no cheap cross-lane 8x4 transpose in AVX2
+	SUNSET_TARGET_AVX2 static inline void store_column_x8(glm::mat4* const* outputs, uint32_t column, __m256 x, __m256 y, __m256 z, __m256 w)
+	{
+		__m128 lo_x = _mm256_castps256_ps128(x), lo_y = _mm256_castps256_ps128(y), lo_z = _mm256_castps256_ps128(z), lo_w = _mm256_castps256_ps128(w);
+		__m128 hi_x = _mm256_extractf128_ps(x, 1), hi_y = _mm256_extractf128_ps(y, 1), hi_z = _mm256_extractf128_ps(z, 1), hi_w = _mm256_extractf128_ps(w, 1);
+
+		_MM_TRANSPOSE4_PS(lo_x, lo_y, lo_z, lo_w);
+		_MM_TRANSPOSE4_PS(hi_x, hi_y, hi_z, hi_w);
+
+		_mm_storeu_ps(&(*outputs[0])[column][0], lo_x);
+		_mm_storeu_ps(&(*outputs[1])[column][0], lo_y);
+		_mm_storeu_ps(&(*outputs[2])[column][0], lo_z);
+		_mm_storeu_ps(&(*outputs[3])[column][0], lo_w);
+		_mm_storeu_ps(&(*outputs[4])[column][0], hi_x);
+		_mm_storeu_ps(&(*outputs[5])[column][0], hi_y);
+		_mm_storeu_ps(&(*outputs[6])[column][0], hi_z);
+		_mm_storeu_ps(&(*outputs[7])[column][0], hi_w);
+	}
+
+	SUNSET_TARGET_AVX2 static size_t compose_avx2(const TransformBatch& batch)
+	{
+		const size_t simd_count = batch.size() & ~size_t(7);
+
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 two = _mm256_set1_ps(2.0f);
+
+		for (size_t i = 0; i < simd_count; i += 8)
+		{
+			__m256 qx = _mm256_loadu_ps(&batch.rotation_x[i]);
+			__m256 qy = _mm256_loadu_ps(&batch.rotation_y[i]);
+			__m256 qz = _mm256_loadu_ps(&batch.rotation_z[i]);
+			__m256 qw = _mm256_loadu_ps(&batch.rotation_w[i]);
+
+			const __m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(qw, qw, _mm256_fmadd_ps(qz, qz, _mm256_fmadd_ps(qy, qy, _mm256_mul_ps(qx, qx)))));
+			const __m256 valid = _mm256_cmp_ps(length, zero, _CMP_GT_OQ);
+			const __m256 inv_length = _mm256_div_ps(one, length);
+			qx = _mm256_and_ps(_mm256_mul_ps(qx, inv_length), valid);
+			qy = _mm256_and_ps(_mm256_mul_ps(qy, inv_length), valid);
+			qz = _mm256_and_ps(_mm256_mul_ps(qz, inv_length), valid);
+			qw = _mm256_blendv_ps(one, _mm256_mul_ps(qw, inv_length), valid);
+
+			const __m256 xx = _mm256_mul_ps(qx, qx), yy = _mm256_mul_ps(qy, qy), zz = _mm256_mul_ps(qz, qz);
+			const __m256 xy = _mm256_mul_ps(qx, qy), xz = _mm256_mul_ps(qx, qz), yz = _mm256_mul_ps(qy, qz);
+			const __m256 wx = _mm256_mul_ps(qw, qx), wy = _mm256_mul_ps(qw, qy), wz = _mm256_mul_ps(qw, qz);
+
+			const __m256 sx = _mm256_loadu_ps(&batch.scale_x[i]);
+			const __m256 sy = _mm256_loadu_ps(&batch.scale_y[i]);
+			const __m256 sz = _mm256_loadu_ps(&batch.scale_z[i]);
+
+			glm::mat4* const* outputs = &batch.outputs[i];
+
+			store_column_x8(outputs, 0,
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+				zero);
+			store_column_x8(outputs, 1,
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+				zero);
+			store_column_x8(outputs, 2,
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+				zero);
+			store_column_x8(outputs, 3,
+				_mm256_loadu_ps(&batch.position_x[i]),
+				_mm256_loadu_ps(&batch.position_y[i]),
+				_mm256_loadu_ps(&batch.position_z[i]),
+				one);
+		}
+
+		return simd_count;
+	}
+#endif
+
+	void TransformBatchOps::compose(const TransformBatch& batch, SIMDLevel simd_level)
+	{
+		const SIMDLevel supported_level = CPUFeatures::get_simd_level();
+		if (simd_level > supported_level)
+		{
+			simd_level = supported_level;
+		}
+
+		size_t processed_count = 0;
+
+#if SUNSET_SIMD_X86
+		switch (simd_level)
+		{
+			case SIMDLevel::AVX2:
+				processed_count = compose_avx2(batch);
+				break;
+			case SIMDLevel::SSE41:
+				processed_count = compose_sse41(batch);
+				break;
+			default:
+				break;
+		}
+#endif
+
+		// Leftovers that don't fill a full SIMD lane set
+		compose_scalar(batch, processed_count, batch.size());
+	}
+
+	void TransformBatchOps::compose(const TransformBatch& batch)
+	{
+		compose(batch, CPUFeatures::get_simd_level());
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <minimal.h>
+#include <utility/simd/cpu_features.h>
+
+namespace Sunset
+{
+	// Structure-of-arrays staging for transforms that need their matrices rebuilt. Each entry
+	// composes translate * rotate * scale into the matrix pointed at by its output slot, which lets
+	// callers write results straight into whichever buffer ultimately consumes them.
+	struct TransformBatch
+	{
+		std::vector<float> position_x;
+		std::vector<float> position_y;
+		std::vector<float> position_z;
+		std::vector<float> rotation_x;
+		std::vector<float> rotation_y;
+		std::vector<float> rotation_z;
+		std::vector<float> rotation_w;
+		std::vector<float> scale_x;
+		std::vector<float> scale_y;
+		std::vector<float> scale_z;
+		std::vector<glm::mat4*> outputs;
+
+		void add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4* output);
+		void reserve(size_t count);
+		void clear();
+
+		size_t size() const
+		{
+			return outputs.size();
+		}
+	};
+
+	namespace TransformBatchOps
+	{
+		// Builds every matrix in the batch using the requested SIMD level, clamped to what the host CPU supports.
+		void compose(const TransformBatch& batch, SIMDLevel simd_level);
+		// Builds every matrix in the batch using the best SIMD level the host CPU supports.
+		void compose(const TransformBatch& batch);
+	}
+}
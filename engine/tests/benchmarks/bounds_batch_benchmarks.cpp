@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <utility/simd/bounds_batch.h>
+#include <core/ecs/dynamic_aabb_tree.h>
+
+#include <random>
+
+namespace
+{
+	constexpr size_t bounds_benchmark_count = 100000;
+
+	struct BoundsBenchmarkData
+	{
+		std::vector<glm::mat4> transforms;
+		std::vector<Sunset::AABB> local_aabbs;
+		std::vector<Sunset::AABB> world_aabbs;
+
+		BoundsBenchmarkData()
+			: transforms(bounds_benchmark_count, glm::mat4(1.0f)), local_aabbs(bounds_benchmark_count), world_aabbs(bounds_benchmark_count)
+		{
+			std::mt19937 rng(42);
+			std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+			for (size_t i = 0; i < bounds_benchmark_count; ++i)
+			{
+				transforms[i][0] = glm::vec4(1.0f + dist(rng) * 0.1f, dist(rng) * 0.1f, dist(rng) * 0.1f, 0.0f);
+				transforms[i][1] = glm::vec4(dist(rng) * 0.1f, 1.0f + dist(rng) * 0.1f, dist(rng) * 0.1f, 0.0f);
+				transforms[i][2] = glm::vec4(dist(rng) * 0.1f, dist(rng) * 0.1f, 1.0f + dist(rng) * 0.1f, 0.0f);
+				transforms[i][3] = glm::vec4(dist(rng) * 500.0f, dist(rng) * 500.0f, dist(rng) * 500.0f, 1.0f);
+				local_aabbs[i] = { glm::vec3(-1.0f + dist(rng) * 0.1f), glm::vec3(1.0f + dist(rng) * 0.1f) };
+			}
+		}
+	};
+
+	BoundsBenchmarkData& get_bounds_benchmark_data()
+	{
+		static BoundsBenchmarkData data;
+		return data;
+	}
+
+	void set_bounds_per_ms(benchmark::State& state, size_t count)
+	{
+		state.counters["bounds_per_ms"] = benchmark::Counter(double(state.iterations() * count) / 1000.0, benchmark::Counter::kIsRate);
+	}
+}
+
+// Per entity recompute of every entity, which is what happened before dirty tracking and batching
+static void BM_BoundsRecomputeAllScalar(benchmark::State& state)
+{
+	BoundsBenchmarkData& data = get_bounds_benchmark_data();
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < bounds_benchmark_count; ++i)
+		{
+			data.world_aabbs[i] = Sunset::transform_aabb(data.local_aabbs[i], data.transforms[i]);
+		}
+		benchmark::ClobberMemory();
+	}
+	set_bounds_per_ms(state, bounds_benchmark_count);
+}
+BENCHMARK(BM_BoundsRecomputeAllScalar)->Unit(benchmark::kMicrosecond);
+
+// Arg 0 is the SIMD level, arg 1 the percentage of entities with dirty transforms
+static void BM_BoundsBatchDirty(benchmark::State& state)
+{
+	BoundsBenchmarkData& data = get_bounds_benchmark_data();
+	const Sunset::SIMDLevel simd_level = static_cast<Sunset::SIMDLevel>(state.range(0));
+	if (simd_level > Sunset::CPUFeatures::get_simd_level())
+	{
+		state.SkipWithError("SIMD level not supported on this CPU");
+		return;
+	}
+
+	const size_t dirty_stride = std::max<int64_t>(1, 100 / std::max<int64_t>(1, state.range(1)));
+
+	Sunset::BoundsBatch batch;
+	batch.reserve(bounds_benchmark_count);
+	for (auto _ : state)
+	{
+		batch.clear();
+		for (size_t i = 0; i < bounds_benchmark_count; i += dirty_stride)
+		{
+			const Sunset::AABB& local_aabb = data.local_aabbs[i];
+			const glm::vec3 extents = (local_aabb.max - local_aabb.min) * 0.5f;
+			batch.add((local_aabb.min + local_aabb.max) * 0.5f, extents, glm::length(extents), &data.transforms[i]);
+		}
+		Sunset::BoundsBatchOps::transform(batch, simd_level);
+		benchmark::ClobberMemory();
+	}
+	set_bounds_per_ms(state, batch.size());
+	state.counters["recomputed"] = double(batch.size());
+}
+BENCHMARK(BM_BoundsBatchDirty)
+	->Args({ static_cast<int>(Sunset::SIMDLevel::Scalar), 100 })
+	->Args({ static_cast<int>(Sunset::SIMDLevel::SSE41), 100 })
+	->Args({ static_cast<int>(Sunset::SIMDLevel::AVX2), 100 })
+	->Args({ static_cast<int>(Sunset::SIMDLevel::AVX2), 10 })
+	->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+#include <core/ecs/dynamic_aabb_tree.h>
+
+#include <random>
+
+namespace
+{
+	constexpr uint32_t aabb_tree_benchmark_count = 100000;
+	// Every fourth entity moves each frame, the rest stay static
+	constexpr uint32_t aabb_tree_moving_stride = 4;
+
+	struct AABBTreeBenchmarkData
+	{
+		std::vector<Sunset::EntityID> entities;
+		std::vector<Sunset::AABB> bounds;
+		std::vector<glm::vec3> velocities;
+		Sunset::DynamicAABBTree tree;
+
+		AABBTreeBenchmarkData()
+		{
+			std::mt19937 rng(42);
+			std::uniform_real_distribution<float> position_dist(-1000.0f, 1000.0f);
+			std::uniform_real_distribution<float> size_dist(0.5f, 2.0f);
+			std::uniform_real_distribution<float> velocity_dist(-0.5f, 0.5f);
+
+			entities.reserve(aabb_tree_benchmark_count);
+			bounds.reserve(aabb_tree_benchmark_count);
+			velocities.reserve(aabb_tree_benchmark_count);
+
+			for (uint32_t i = 0; i < aabb_tree_benchmark_count; ++i)
+			{
+				const glm::vec3 center(position_dist(rng), position_dist(rng) * 0.1f, position_dist(rng));
+				const glm::vec3 extents(size_dist(rng));
+				entities.push_back(Sunset::create_entity_id(i, 1));
+				bounds.push_back({ center - extents, center + extents });
+				velocities.push_back(glm::vec3(velocity_dist(rng), 0.0f, velocity_dist(rng)));
+				tree.update_entity(entities.back(), bounds.back());
+			}
+		}
+	};
+
+	AABBTreeBenchmarkData& get_aabb_tree_benchmark_data()
+	{
+		static AABBTreeBenchmarkData data;
+		return data;
+	}
+
+	// Inward facing planes of a box shaped view volume covering roughly a tenth of the world
+	const glm::vec4 benchmark_frustum_planes[6] =
+	{
+		glm::vec4(1.0f, 0.0f, 0.0f, 150.0f),
+		glm::vec4(-1.0f, 0.0f, 0.0f, 150.0f),
+		glm::vec4(0.0f, 1.0f, 0.0f, 100.0f),
+		glm::vec4(0.0f, -1.0f, 0.0f, 100.0f),
+		glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+		glm::vec4(0.0f, 0.0f, -1.0f, 600.0f)
+	};
+}
+
+static void BM_AABBTreeBuild(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	for (auto _ : state)
+	{
+		Sunset::DynamicAABBTree tree;
+		for (uint32_t i = 0; i < aabb_tree_benchmark_count; ++i)
+		{
+			tree.update_entity(data.entities[i], data.bounds[i]);
+		}
+		benchmark::DoNotOptimize(tree.get_height());
+	}
+	state.counters["entities"] = aabb_tree_benchmark_count;
+}
+BENCHMARK(BM_AABBTreeBuild)->Unit(benchmark::kMillisecond);
+
+static void BM_AABBTreeUpdateMoving(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	for (auto _ : state)
+	{
+		for (uint32_t i = 0; i < aabb_tree_benchmark_count; i += aabb_tree_moving_stride)
+		{
+			data.bounds[i] = { data.bounds[i].min + data.velocities[i], data.bounds[i].max + data.velocities[i] };
+			data.tree.update_entity(data.entities[i], data.bounds[i]);
+		}
+	}
+	state.counters["moving_entities"] = aabb_tree_benchmark_count / aabb_tree_moving_stride;
+	state.counters["tree_height"] = data.tree.get_height();
+}
+BENCHMARK(BM_AABBTreeUpdateMoving)->Unit(benchmark::kMicrosecond);
+
+static void BM_AABBTreeQueryFrustum(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	std::vector<Sunset::EntityID> results;
+	for (auto _ : state)
+	{
+		results.clear();
+		data.tree.query_frustum(benchmark_frustum_planes, 6, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.counters["visible"] = results.size();
+}
+BENCHMARK(BM_AABBTreeQueryFrustum)->Unit(benchmark::kMicrosecond);
+
+static void BM_BruteForceQueryFrustum(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	std::vector<Sunset::EntityID> results;
+	for (auto _ : state)
+	{
+		results.clear();
+		for (uint32_t i = 0; i < aabb_tree_benchmark_count; ++i)
+		{
+			if (Sunset::aabb_overlaps_frustum(data.bounds[i], benchmark_frustum_planes, 6))
+			{
+				results.push_back(data.entities[i]);
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.counters["visible"] = results.size();
+}
+BENCHMARK(BM_BruteForceQueryFrustum)->Unit(benchmark::kMicrosecond);
+
+static void BM_AABBTreeQuerySphere(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	std::vector<Sunset::EntityID> results;
+	for (auto _ : state)
+	{
+		results.clear();
+		data.tree.query_sphere(glm::vec3(0.0f), 50.0f, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.counters["hits"] = results.size();
+}
+BENCHMARK(BM_AABBTreeQuerySphere)->Unit(benchmark::kMicrosecond);
+
+static void BM_AABBTreeQueryRay(benchmark::State& state)
+{
+	AABBTreeBenchmarkData& data = get_aabb_tree_benchmark_data();
+	std::vector<Sunset::EntityID> results;
+	const glm::vec3 direction = glm::normalize(glm::vec3(1.0f, 0.0f, 0.7f));
+	for (auto _ : state)
+	{
+		results.clear();
+		data.tree.query_ray(glm::vec3(-1000.0f, 0.0f, -700.0f), direction, 2500.0f, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.counters["hits"] = results.size();
+}
+BENCHMARK(BM_AABBTreeQueryRay)->Unit(benchmark::kMicrosecond);
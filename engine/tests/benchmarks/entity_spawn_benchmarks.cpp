@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <core/layers/scene.h>
+#include <core/ecs/components/transform_component.h>
+#include <core/ecs/components/body_component.h>
+#include <physics/physics.h>
+
+// Bodies are registered with physics like the demo does, so the numbers include body creation. Physics is restarted
+// between iterations so every iteration starts from an empty physics system, and spawn counts stay under MAX_PHYSICS_BODIES.
+static void restart_physics()
+{
+	Sunset::Physics::get()->destroy();
+	Sunset::Physics::get()->initialize();
+}
+
+static void BM_SpawnEntitiesIndividually(benchmark::State& state)
+{
+	const uint32_t spawn_count = uint32_t(state.range(0));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		std::unique_ptr<Sunset::Scene> scene = std::make_unique<Sunset::Scene>();
+		restart_physics();
+		state.ResumeTiming();
+
+		const Sunset::SphereShapeDescription sphere_shape{ .radius = 1.0f };
+		for (uint32_t i = 0; i < spawn_count; ++i)
+		{
+			const Sunset::EntityID entity = scene->make_entity();
+			Sunset::TransformComponent* const transform_comp = scene->assign_component<Sunset::TransformComponent>(entity);
+			Sunset::set_position(transform_comp, glm::vec3(float(i), 0.0f, 0.0f));
+			Sunset::BodyComponent* const body_comp = scene->assign_component<Sunset::BodyComponent>(entity);
+			Sunset::set_body_type(body_comp, Sunset::PhysicsBodyType::Dynamic);
+			body_comp->body_data.position = transform_comp->transform.position;
+			Sunset::set_body_shape(body_comp, sphere_shape);
+		}
+		benchmark::DoNotOptimize(scene->entities.data());
+
+		state.PauseTiming();
+		scene.reset();
+		state.ResumeTiming();
+	}
+	Sunset::Physics::get()->destroy();
+	state.SetItemsProcessed(state.iterations() * spawn_count);
+}
+BENCHMARK(BM_SpawnEntitiesIndividually)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_SpawnEntitiesFromPrefab(benchmark::State& state)
+{
+	const uint32_t spawn_count = uint32_t(state.range(0));
+
+	Sunset::EntityPrefab<Sunset::TransformComponent, Sunset::BodyComponent> prefab;
+	Sunset::set_body_type(&prefab.get<Sunset::BodyComponent>(), Sunset::PhysicsBodyType::Dynamic);
+
+	std::vector<Sunset::EntityID> spawned;
+	std::vector<Sunset::BodyComponent*> bodies;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		std::unique_ptr<Sunset::Scene> scene = std::make_unique<Sunset::Scene>();
+		restart_physics();
+		spawned.clear();
+		bodies.clear();
+		state.ResumeTiming();
+
+		scene->instantiate(prefab, spawn_count, spawned, [&bodies](uint32_t i, Sunset::EntityID entity, Sunset::TransformComponent& transform_comp, Sunset::BodyComponent& body_comp)
+		{
+			Sunset::set_position(&transform_comp, glm::vec3(float(i), 0.0f, 0.0f));
+			body_comp.body_data.position = transform_comp.transform.position;
+			bodies.push_back(&body_comp);
+		});
+
+		const Sunset::SphereShapeDescription sphere_shape{ .radius = 1.0f };
+		Sunset::set_body_shapes(bodies.data(), spawn_count, sphere_shape);
+		benchmark::DoNotOptimize(scene->entities.data());
+
+		state.PauseTiming();
+		scene.reset();
+		state.ResumeTiming();
+	}
+	Sunset::Physics::get()->destroy();
+	state.SetItemsProcessed(state.iterations() * spawn_count);
+}
+BENCHMARK(BM_SpawnEntitiesFromPrefab)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <graphics/gpu_shared_data_types.h>
+#include <graphics/resource/buffer.h>
+#include <core/ecs/entity.h>
+
+#include <random>
+
+namespace
+{
+	using RecordingBuffer = Sunset::GenericBuffer<Sunset::NoopBuffer>;
+
+	void initialize_entity_buffer(RecordingBuffer& buffer)
+	{
+		buffer.initialize(nullptr, { .name = "entity_datas", .buffer_size = sizeof(Sunset::EntitySceneData) * Sunset::MIN_ENTITIES, .type = Sunset::BufferType::StorageBuffer });
+	}
+
+	// Entities written in a frame, as a per mille of every entity
+	std::vector<uint32_t> make_dirty_entities(int64_t dirty_per_mille)
+	{
+		std::mt19937 rng(42);
+		std::uniform_int_distribution<uint32_t> index_dist(0, Sunset::MIN_ENTITIES - 1);
+		std::vector<uint32_t> dirty_entities(Sunset::MIN_ENTITIES * dirty_per_mille / 1000);
+		for (uint32_t& index : dirty_entities)
+		{
+			index = index_dist(rng);
+		}
+		return dirty_entities;
+	}
+}
+
+// Copying the whole entity array every frame, as the mesh processor used to
+static void BM_EntityDataFullUpload(benchmark::State& state)
+{
+	Sunset::EntitySceneDataShared entity_data;
+	RecordingBuffer buffer;
+	initialize_entity_buffer(buffer);
+
+	for (auto _ : state)
+	{
+		buffer.copy_from(nullptr, entity_data.data.data(), entity_data.data.size() * sizeof(Sunset::EntitySceneData));
+		benchmark::DoNotOptimize(buffer.get());
+	}
+	state.counters["uploaded_bytes"] = static_cast<double>(entity_data.data.size() * sizeof(Sunset::EntitySceneData));
+}
+BENCHMARK(BM_EntityDataFullUpload)->Unit(benchmark::kMicrosecond);
+
+// Coalesced dirty range uploads with the given per mille of entities written each frame
+static void BM_EntityDataDirtyRangeUpload(benchmark::State& state)
+{
+	Sunset::EntitySceneDataShared entity_data;
+	RecordingBuffer buffer;
+	initialize_entity_buffer(buffer);
+
+	const std::vector<uint32_t> dirty_entities = make_dirty_entities(state.range(0));
+
+	Sunset::GPUSharedDataUploadStats stats;
+	for (auto _ : state)
+	{
+		for (const uint32_t index : dirty_entities)
+		{
+			entity_data.mark_dirty(index, 0);
+		}
+		stats = entity_data.upload(nullptr, &buffer, 0, 8);
+		benchmark::DoNotOptimize(buffer.get());
+	}
+	state.counters["uploaded_bytes"] = static_cast<double>(stats.uploaded_bytes);
+	state.counters["ranges"] = static_cast<double>(stats.range_count);
+}
+BENCHMARK(BM_EntityDataDirtyRangeUpload)->Arg(0)->Arg(10)->Arg(100)->Arg(500)->Unit(benchmark::kMicrosecond);
@@ -2,6 +2,7 @@
 #include <array>
 #include <memory/allocators/pool_allocator.h>
 #include <graphics/resource/mesh.h>
+#include <job_system/job_scheduler.h>
 
 constexpr size_t allocation_size = 1024;
 
@@ -40,4 +41,17 @@ static void BM_PoolAllocatorAllocations(benchmark::State& state)
 }
 BENCHMARK(BM_PoolAllocatorAllocations);
 
-BENCHMARK_MAIN();
+int main(int argc, char** argv)
+{
+	// Parallel benchmarks queue jobs, which only run once the scheduler's worker threads are started
+	Sunset::JobScheduler::get()->initialize();
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <graphics/mesh_render_task.h>
+#include <graphics/mesh_task_queue.h>
+
+#include <random>
+#include <tuple>
+
+namespace
+{
+	// A scene built from a few meshes, each with many material variants (tints, texture swaps, etc.)
+	constexpr uint32_t mesh_batching_benchmark_meshes = 32;
+	constexpr uint32_t mesh_batching_benchmark_materials = 256;
+	constexpr uint32_t mesh_batching_benchmark_tasks = 100000;
+
+	struct MeshBatchingBenchmarkData
+	{
+		std::vector<Sunset::MeshRenderTask> tasks;
+		std::vector<Sunset::MeshRenderTask*> material_sorted_tasks;
+		std::vector<Sunset::MeshRenderTask*> resource_sorted_tasks;
+
+		MeshBatchingBenchmarkData()
+		{
+			std::mt19937 rng(42);
+			std::uniform_int_distribution<uint32_t> mesh_dist(1, mesh_batching_benchmark_meshes);
+			std::uniform_int_distribution<uint32_t> material_dist(1, mesh_batching_benchmark_materials);
+
+			tasks.resize(mesh_batching_benchmark_tasks);
+			for (Sunset::MeshRenderTask& task : tasks)
+			{
+				task.setup(material_dist(rng), mesh_dist(rng), 0);
+				material_sorted_tasks.push_back(&task);
+			}
+			resource_sorted_tasks = material_sorted_tasks;
+
+			// Same orderings sort_and_batch produces with material agnostic batching off and on
+			std::sort(material_sorted_tasks.begin(), material_sorted_tasks.end(), [](Sunset::MeshRenderTask* const first, Sunset::MeshRenderTask* const second)
+			{
+				return std::tie(first->material, first->resource_state) < std::tie(second->material, second->resource_state);
+			});
+			std::sort(resource_sorted_tasks.begin(), resource_sorted_tasks.end(), [](Sunset::MeshRenderTask* const first, Sunset::MeshRenderTask* const second)
+			{
+				return std::tie(first->resource_state, first->material) < std::tie(second->resource_state, second->material);
+			});
+		}
+	};
+
+	MeshBatchingBenchmarkData& get_mesh_batching_benchmark_data()
+	{
+		static MeshBatchingBenchmarkData data;
+		return data;
+	}
+}
+
+// Reports indirect draw counts with batches split per material (arg 0) against material agnostic batching (arg 1)
+static void BM_MeshBatching(benchmark::State& state)
+{
+	MeshBatchingBenchmarkData& data = get_mesh_batching_benchmark_data();
+	const bool b_material_agnostic = state.range(0) != 0;
+	const std::vector<Sunset::MeshRenderTask*>& tasks = b_material_agnostic ? data.resource_sorted_tasks : data.material_sorted_tasks;
+	Sunset::MeshTaskQueue::assign_sort_keys(tasks, b_material_agnostic);
+
+	std::vector<Sunset::IndirectDrawBatch> batches;
+	Sunset::MeshBatchingStats stats;
+	for (auto _ : state)
+	{
+		Sunset::MeshTaskQueue::batch_tasks(tasks, b_material_agnostic, batches, stats);
+		benchmark::DoNotOptimize(batches.data());
+	}
+	state.counters["tasks"] = double(stats.task_count);
+	state.counters["draws"] = double(stats.batch_count);
+}
+BENCHMARK(BM_MeshBatching)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
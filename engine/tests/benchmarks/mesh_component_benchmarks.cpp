@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <core/ecs/components/mesh_component.h>
+
+namespace
+{
+	constexpr size_t mesh_benchmark_count = 8192;
+
+	// Mirrors the previous MeshComponent layout with fixed size section arrays, kept for comparison
+	struct LegacyMeshComponent
+	{
+		Sunset::MeshID mesh;
+		uint32_t section_count{ 0 };
+		float custom_bounds_scale{ 1.1f };
+		std::array<Sunset::MaterialID, MAX_MESH_MATERIALS> materials;
+		std::array<Sunset::ResourceStateID, MAX_MESH_RESOURCE_STATES> resource_states;
+	};
+
+	void set_mesh_counters(benchmark::State& state, size_t component_size)
+	{
+		state.counters["bytes_per_component"] = double(component_size);
+		state.counters["pool_kb"] = double(component_size * mesh_benchmark_count) / 1024.0;
+		state.counters["sections_per_ms"] = benchmark::Counter(
+			double(state.iterations() * mesh_benchmark_count * state.range(0)) / 1000.0,
+			benchmark::Counter::kIsRate
+		);
+	}
+}
+
+static void BM_MeshComponentIterateLegacy(benchmark::State& state)
+{
+	const uint32_t section_count = static_cast<uint32_t>(state.range(0));
+	std::vector<LegacyMeshComponent> components(mesh_benchmark_count);
+	for (size_t i = 0; i < mesh_benchmark_count; ++i)
+	{
+		components[i].section_count = section_count;
+		components[i].materials.fill(i);
+		components[i].resource_states.fill(i + 1);
+	}
+
+	for (auto _ : state)
+	{
+		size_t sum = 0;
+		for (LegacyMeshComponent& mesh_comp : components)
+		{
+			for (uint32_t section_idx = 0; section_idx < mesh_comp.section_count; ++section_idx)
+			{
+				sum += mesh_comp.materials[section_idx] ^ mesh_comp.resource_states[section_idx];
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_mesh_counters(state, sizeof(LegacyMeshComponent));
+}
+BENCHMARK(BM_MeshComponentIterateLegacy)->Arg(1)->Arg(4)->Arg(16);
+
+static void BM_MeshComponentIterateCompact(benchmark::State& state)
+{
+	const uint32_t section_count = static_cast<uint32_t>(state.range(0));
+	Sunset::MeshSectionPool* const section_pool = Sunset::MeshSectionPool::get();
+	std::vector<Sunset::MeshComponent> components(mesh_benchmark_count);
+	for (size_t i = 0; i < mesh_benchmark_count; ++i)
+	{
+		components[i].section_count = section_count;
+		if (section_count > Sunset::MESH_INLINE_SECTIONS)
+		{
+			components[i].spilled_sections = section_pool->allocate(section_count);
+		}
+		Sunset::set_material(&components[i], i);
+		std::fill_n(Sunset::mesh_resource_states(&components[i]), section_count, i + 1);
+	}
+
+	for (auto _ : state)
+	{
+		size_t sum = 0;
+		for (Sunset::MeshComponent& mesh_comp : components)
+		{
+			const Sunset::MaterialID* const materials = Sunset::mesh_materials(&mesh_comp);
+			const Sunset::ResourceStateID* const resource_states = Sunset::mesh_resource_states(&mesh_comp);
+			for (uint32_t section_idx = 0; section_idx < mesh_comp.section_count; ++section_idx)
+			{
+				sum += materials[section_idx] ^ resource_states[section_idx];
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_mesh_counters(state, sizeof(Sunset::MeshComponent));
+}
+BENCHMARK(BM_MeshComponentIterateCompact)->Arg(1)->Arg(4)->Arg(16);
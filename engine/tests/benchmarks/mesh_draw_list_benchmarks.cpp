@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+#include <graphics/mesh_render_task.h>
+#include <graphics/mesh_task_queue.h>
+#include <graphics/mesh_draw_list.h>
+#include <utility/radix_sort.h>
+
+#include <random>
+
+namespace
+{
+	constexpr uint32_t MESH_DRAW_LIST_BENCHMARK_SECTIONS = 2;
+
+	// A static scene of multi section meshes, with hashed ids like the resource caches hand out
+	struct MeshDrawListBenchmarkData
+	{
+		std::vector<Sunset::MeshDrawDesc> entity_draws;
+		std::vector<uint8_t> visibility;
+
+		explicit MeshDrawListBenchmarkData(uint32_t entity_count)
+		{
+			std::mt19937_64 rng(42);
+			std::vector<size_t> resource_states(64);
+			std::vector<size_t> materials(512);
+			for (size_t& id : resource_states)
+			{
+				id = rng();
+			}
+			for (size_t& id : materials)
+			{
+				id = rng();
+			}
+
+			std::uniform_int_distribution<size_t> resource_state_dist(0, resource_states.size() - 1);
+			std::uniform_int_distribution<size_t> material_dist(0, materials.size() - 1);
+			std::bernoulli_distribution visible_dist(0.7);
+
+			for (uint32_t e = 0; e < entity_count; ++e)
+			{
+				for (uint32_t s = 0; s < MESH_DRAW_LIST_BENCHMARK_SECTIONS; ++s)
+				{
+					const size_t material = material_dist(rng);
+					entity_draws.push_back({
+						.material = materials[material],
+						.material_index = static_cast<uint32_t>(material),
+						.resource_state = resource_states[resource_state_dist(rng)]
+					});
+				}
+				visibility.push_back(visible_dist(rng) ? 1 : 0);
+			}
+		}
+
+		uint32_t entity_count() const
+		{
+			return static_cast<uint32_t>(visibility.size());
+		}
+
+		Sunset::EntityID entity(uint32_t index) const
+		{
+			return static_cast<Sunset::EntityID>(index) << 32;
+		}
+	};
+}
+
+// Fresh render tasks for every visible section, keyed and radix sorted, as the mesh processor did every frame
+static void BM_MeshDrawsRebuiltPerFrame(benchmark::State& state)
+{
+	MeshDrawListBenchmarkData data(static_cast<uint32_t>(state.range(0)));
+	std::vector<Sunset::MeshRenderTask> tasks(data.entity_draws.size());
+	std::vector<Sunset::MeshRenderTask*> queue;
+	std::vector<Sunset::MeshRenderTask*> sorted_queue;
+	std::vector<Sunset::SortKeyIndex> sort_items;
+	std::vector<Sunset::SortKeyIndex> sort_scratch;
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (uint32_t e = 0; e < data.entity_count(); ++e)
+		{
+			if (data.visibility[e] == 0)
+			{
+				continue;
+			}
+			for (uint32_t s = 0; s < MESH_DRAW_LIST_BENCHMARK_SECTIONS; ++s)
+			{
+				const uint32_t draw_index = e * MESH_DRAW_LIST_BENCHMARK_SECTIONS + s;
+				const Sunset::MeshDrawDesc& draw = data.entity_draws[draw_index];
+				Sunset::MeshRenderTask& task = tasks[draw_index];
+				task.setup(draw.material, draw.resource_state, 0)
+					->set_entity(e)
+					->set_material_index(draw.material_index);
+				queue.push_back(&task);
+			}
+		}
+
+		Sunset::MeshTaskQueue::assign_sort_keys(queue, true);
+
+		sort_items.resize(queue.size());
+		for (uint32_t i = 0; i < queue.size(); ++i)
+		{
+			sort_items[i] = { .key = queue[i]->sort_key, .index = i };
+		}
+
+		Sunset::RadixSort::sort_parallel(sort_items, sort_scratch);
+
+		sorted_queue.resize(sort_items.size());
+		for (uint32_t i = 0; i < sort_items.size(); ++i)
+		{
+			sorted_queue[i] = queue[sort_items[i].index];
+		}
+		benchmark::DoNotOptimize(sorted_queue.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeshDrawsRebuiltPerFrame)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Retained draws for the same static scene, where each frame only reports visibility and walks the sorted draws
+static void BM_MeshDrawsRetained(benchmark::State& state)
+{
+	MeshDrawListBenchmarkData data(static_cast<uint32_t>(state.range(0)));
+	Sunset::MeshDrawList draw_list;
+	for (uint32_t e = 0; e < data.entity_count(); ++e)
+	{
+		draw_list.set_entity_draws(data.entity(e), 1, &data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS], MESH_DRAW_LIST_BENCHMARK_SECTIONS);
+	}
+
+	for (auto _ : state)
+	{
+		Sunset::MeshTaskQueue queue;
+
+		draw_list.begin_frame();
+		for (uint32_t e = 0; e < data.entity_count(); ++e)
+		{
+			const Sunset::EntityID entity = data.entity(e);
+			if (!draw_list.is_entity_current(entity, 1))
+			{
+				draw_list.set_entity_draws(entity, 1, &data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS], MESH_DRAW_LIST_BENCHMARK_SECTIONS);
+			}
+			draw_list.set_entity_visible(entity, data.visibility[e] != 0);
+		}
+		draw_list.submit(queue, true);
+
+		benchmark::DoNotOptimize(queue.get_queue_size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeshDrawsRetained)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Retained draws where one percent of entities change material every frame
+static void BM_MeshDrawsRetainedWithChanges(benchmark::State& state)
+{
+	MeshDrawListBenchmarkData data(static_cast<uint32_t>(state.range(0)));
+	Sunset::MeshDrawList draw_list;
+	std::vector<uint32_t> revisions(data.entity_count(), 1);
+	for (uint32_t e = 0; e < data.entity_count(); ++e)
+	{
+		draw_list.set_entity_draws(data.entity(e), 1, &data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS], MESH_DRAW_LIST_BENCHMARK_SECTIONS);
+	}
+
+	uint32_t frame = 0;
+	for (auto _ : state)
+	{
+		Sunset::MeshTaskQueue queue;
+
+		for (uint32_t e = frame % 100; e < data.entity_count(); e += 100)
+		{
+			++revisions[e];
+			std::swap(data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS].material, data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS + 1].material);
+		}
+
+		draw_list.begin_frame();
+		for (uint32_t e = 0; e < data.entity_count(); ++e)
+		{
+			const Sunset::EntityID entity = data.entity(e);
+			if (!draw_list.is_entity_current(entity, revisions[e]))
+			{
+				draw_list.set_entity_draws(entity, revisions[e], &data.entity_draws[e * MESH_DRAW_LIST_BENCHMARK_SECTIONS], MESH_DRAW_LIST_BENCHMARK_SECTIONS);
+			}
+			draw_list.set_entity_visible(entity, data.visibility[e] != 0);
+		}
+		draw_list.submit(queue, true);
+
+		benchmark::DoNotOptimize(queue.get_queue_size());
+		++frame;
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeshDrawsRetainedWithChanges)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <graphics/resource/mesh_lod.h>
+
+#include <random>
+
+namespace
+{
+	constexpr size_t mesh_lod_benchmark_count = 100000;
+
+	struct MeshLODBenchmarkData
+	{
+		std::vector<glm::vec3> centers;
+		std::vector<float> radii;
+		std::vector<uint8_t> current_lods;
+		const float lod_screen_sizes[4] = { 1.0f, 0.1f, 0.05f, 0.025f };
+
+		MeshLODBenchmarkData()
+		{
+			std::mt19937 rng(42);
+			std::uniform_real_distribution<float> position_dist(-2000.0f, 2000.0f);
+			std::uniform_real_distribution<float> radius_dist(0.5f, 4.0f);
+
+			for (size_t i = 0; i < mesh_lod_benchmark_count; ++i)
+			{
+				centers.emplace_back(position_dist(rng), position_dist(rng) * 0.05f, position_dist(rng));
+				radii.push_back(radius_dist(rng));
+			}
+			current_lods.resize(mesh_lod_benchmark_count, 0);
+		}
+	};
+
+	MeshLODBenchmarkData& get_mesh_lod_benchmark_data()
+	{
+		static MeshLODBenchmarkData data;
+		return data;
+	}
+}
+
+// Per frame selection cost for every mesh entity, with the camera drifting so some entities change LOD each frame
+static void BM_MeshLODSelection(benchmark::State& state)
+{
+	MeshLODBenchmarkData& data = get_mesh_lod_benchmark_data();
+	const Sunset::MeshLODSelector selector = Sunset::make_mesh_lod_selector(1.0f / std::tan(glm::radians(35.0f)), 0.0f, 0.1f);
+
+	glm::vec3 view_position(0.0f);
+	size_t lod_changes = 0;
+	for (auto _ : state)
+	{
+		view_position.z += 1.0f;
+		lod_changes = 0;
+		for (size_t i = 0; i < mesh_lod_benchmark_count; ++i)
+		{
+			const float screen_size = Sunset::compute_lod_screen_size(selector, view_position, data.centers[i], data.radii[i]);
+			const uint32_t lod = Sunset::select_mesh_lod(data.lod_screen_sizes, 4, screen_size, data.current_lods[i], selector.hysteresis);
+			lod_changes += lod != data.current_lods[i];
+			data.current_lods[i] = static_cast<uint8_t>(lod);
+		}
+		benchmark::DoNotOptimize(data.current_lods.data());
+	}
+	state.counters["lod_changes"] = double(lod_changes);
+	state.counters["entities_per_ms"] = benchmark::Counter(
+		double(state.iterations() * mesh_lod_benchmark_count) / 1000.0,
+		benchmark::Counter::kIsRate
+	);
+}
+BENCHMARK(BM_MeshLODSelection)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <graphics/mesh_render_task.h>
+#include <graphics/mesh_task_queue.h>
+#include <utility/radix_sort.h>
+
+#include <random>
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+	struct MeshSortBenchmarkData
+	{
+		std::vector<Sunset::MeshRenderTask> tasks;
+		std::vector<Sunset::MeshRenderTask*> submitted_tasks;
+
+		explicit MeshSortBenchmarkData(uint32_t task_count)
+		{
+			// Ids are hashes in the resource caches, so spread them across the full 64 bit range
+			std::mt19937_64 rng(42);
+			std::vector<size_t> resource_states(64);
+			std::vector<size_t> materials(512);
+			for (size_t& id : resource_states)
+			{
+				id = rng();
+			}
+			for (size_t& id : materials)
+			{
+				id = rng();
+			}
+
+			std::uniform_int_distribution<size_t> resource_state_dist(0, resource_states.size() - 1);
+			std::uniform_int_distribution<size_t> material_dist(0, materials.size() - 1);
+			std::uniform_int_distribution<uint32_t> depth_dist(0, 1u << 20);
+
+			tasks.resize(task_count);
+			for (Sunset::MeshRenderTask& task : tasks)
+			{
+				task.setup(materials[material_dist(rng)], resource_states[resource_state_dist(rng)], depth_dist(rng));
+				submitted_tasks.push_back(&task);
+			}
+		}
+	};
+
+	MeshSortBenchmarkData& get_mesh_sort_benchmark_data(uint32_t task_count)
+	{
+		static std::unordered_map<uint32_t, std::unique_ptr<MeshSortBenchmarkData>> data;
+		std::unique_ptr<MeshSortBenchmarkData>& entry = data[task_count];
+		if (entry == nullptr)
+		{
+			entry = std::make_unique<MeshSortBenchmarkData>(task_count);
+		}
+		return *entry;
+	}
+}
+
+// Comparator sort over task pointers, as MeshTaskQueue::sort_and_batch did before packing sort keys
+static void BM_MeshTaskComparatorSort(benchmark::State& state)
+{
+	MeshSortBenchmarkData& data = get_mesh_sort_benchmark_data(static_cast<uint32_t>(state.range(0)));
+	std::vector<Sunset::MeshRenderTask*> queue;
+	for (auto _ : state)
+	{
+		queue = data.submitted_tasks;
+		std::sort(queue.begin(), queue.end(), [](Sunset::MeshRenderTask* const first, Sunset::MeshRenderTask* const second) -> bool
+		{
+			return std::tie(first->resource_state, first->material, first->render_depth) < std::tie(second->resource_state, second->material, second->render_depth);
+		});
+		benchmark::DoNotOptimize(queue.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeshTaskComparatorSort)->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000)->Unit(benchmark::kMicrosecond);
+
+// Key packing, radix sort and the gather back into task order, matching MeshTaskQueue::sort_and_batch
+static void BM_MeshTaskRadixSort(benchmark::State& state)
+{
+	MeshSortBenchmarkData& data = get_mesh_sort_benchmark_data(static_cast<uint32_t>(state.range(0)));
+	std::vector<Sunset::MeshRenderTask*> queue;
+	std::vector<Sunset::SortKeyIndex> sort_items;
+	std::vector<Sunset::SortKeyIndex> sort_scratch;
+	for (auto _ : state)
+	{
+		Sunset::MeshTaskQueue::assign_sort_keys(data.submitted_tasks, true);
+
+		sort_items.resize(data.submitted_tasks.size());
+		for (uint32_t i = 0; i < data.submitted_tasks.size(); ++i)
+		{
+			sort_items[i] = { .key = data.submitted_tasks[i]->sort_key, .index = i };
+		}
+
+		Sunset::RadixSort::sort_parallel(sort_items, sort_scratch);
+
+		queue.resize(sort_items.size());
+		for (uint32_t i = 0; i < sort_items.size(); ++i)
+		{
+			queue[i] = data.submitted_tasks[sort_items[i].index];
+		}
+		benchmark::DoNotOptimize(queue.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeshTaskRadixSort)->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000)->Unit(benchmark::kMicrosecond);
+
+// The radix sort alone on prepacked keys, without job threads
+static void BM_RadixSortKeys(benchmark::State& state)
+{
+	MeshSortBenchmarkData& data = get_mesh_sort_benchmark_data(static_cast<uint32_t>(state.range(0)));
+	Sunset::MeshTaskQueue::assign_sort_keys(data.submitted_tasks, true);
+
+	std::vector<Sunset::SortKeyIndex> submitted_items;
+	for (uint32_t i = 0; i < data.submitted_tasks.size(); ++i)
+	{
+		submitted_items.push_back({ .key = data.submitted_tasks[i]->sort_key, .index = i });
+	}
+
+	std::vector<Sunset::SortKeyIndex> sort_items;
+	std::vector<Sunset::SortKeyIndex> sort_scratch;
+	for (auto _ : state)
+	{
+		sort_items = submitted_items;
+		Sunset::RadixSort::sort(sort_items, sort_scratch);
+		benchmark::DoNotOptimize(sort_items.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RadixSortKeys)->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000)->Unit(benchmark::kMicrosecond);
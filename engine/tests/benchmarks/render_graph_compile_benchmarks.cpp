@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include <graphics/render_graph.h>
+#include <utility/cvar.h>
+
+#include <random>
+
+namespace
+{
+	constexpr uint32_t SYNTHETIC_GRAPH_PASS_COUNT = 200;
+	constexpr uint32_t SYNTHETIC_GRAPH_RESOURCE_COUNT = 1000;
+
+	// RenderGraph::begin needs a graphics context, so the benchmark resets the frame directly
+	class HeadlessRenderGraph : public Sunset::RenderGraph
+	{
+	public:
+		using Sunset::RenderGraph::reset;
+	};
+
+	// Random DAG where every pass writes five resources and reads up to eight written by earlier passes. Some outputs are never
+	// read, so culling has work to do as well.
+	void build_synthetic_graph(Sunset::RenderGraph& graph, int32_t buffered_frame)
+	{
+		const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+		constexpr uint32_t outputs_per_pass = SYNTHETIC_GRAPH_RESOURCE_COUNT / SYNTHETIC_GRAPH_PASS_COUNT;
+
+		std::mt19937 rng(1337);
+		std::uniform_int_distribution<uint32_t> input_count_dist(1, 8);
+
+		std::vector<Sunset::RGResourceHandle> resources;
+		resources.reserve(SYNTHETIC_GRAPH_RESOURCE_COUNT);
+		for (uint32_t i = 0; i < SYNTHETIC_GRAPH_RESOURCE_COUNT; ++i)
+		{
+			if (i % 4 == 0)
+			{
+				resources.push_back(graph.create_buffer(nullptr, { .name = "buffer", .buffer_size = 4096 }, buffered_frame));
+			}
+			else
+			{
+				resources.push_back(graph.create_image(nullptr, { .name = "image", .format = Sunset::Format::Float4x16, .extent = glm::vec3(256.0f, 256.0f, 1.0f), .flags = Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage }, buffered_frame));
+			}
+		}
+
+		for (uint32_t pass = 0; pass < SYNTHETIC_GRAPH_PASS_COUNT; ++pass)
+		{
+			Sunset::RGPassParameters params;
+			if (pass > 0)
+			{
+				std::uniform_int_distribution<uint32_t> input_dist(0, pass * outputs_per_pass - 1);
+				const uint32_t input_count = input_count_dist(rng);
+				for (uint32_t i = 0; i < input_count; ++i)
+				{
+					params.inputs.push_back(resources[input_dist(rng)]);
+				}
+			}
+			for (uint32_t i = 0; i < outputs_per_pass; ++i)
+			{
+				params.outputs.push_back(resources[pass * outputs_per_pass + i]);
+			}
+
+			const Sunset::RenderPassFlags flags = pass == SYNTHETIC_GRAPH_PASS_COUNT - 1
+				? Sunset::RenderPassFlags::Compute | Sunset::RenderPassFlags::Present
+				: Sunset::RenderPassFlags::Compute;
+			graph.add_pass(nullptr, "pass", flags, buffered_frame, params, no_op);
+		}
+	}
+
+	void run_synthetic_graph_benchmark(benchmark::State& state, bool b_compile_cache)
+	{
+		Sunset::CVarSystem::get()->set_bool_cvar("ren.render_graph.compile_cache", b_compile_cache);
+
+		std::unique_ptr<HeadlessRenderGraph> graph = std::make_unique<HeadlessRenderGraph>();
+		for (auto _ : state)
+		{
+			graph->reset(nullptr, 0);
+			build_synthetic_graph(*graph, 0);
+			graph->compile(nullptr, nullptr, 0);
+			benchmark::DoNotOptimize(graph->get_nonculled_passes(0).data());
+		}
+
+		state.counters["nonculled_passes"] = static_cast<double>(graph->get_nonculled_passes(0).size());
+		state.counters["passes_per_second"] = benchmark::Counter(static_cast<double>(state.iterations() * SYNTHETIC_GRAPH_PASS_COUNT), benchmark::Counter::kIsRate);
+
+		Sunset::CVarSystem::get()->set_bool_cvar("ren.render_graph.compile_cache", true);
+	}
+}
+
+// Per-frame cost of declaring and compiling a large graph headlessly, with every compile starting from scratch
+static void BM_SyntheticRenderGraphBuildAndCompile(benchmark::State& state)
+{
+	run_synthetic_graph_benchmark(state, false);
+}
+BENCHMARK(BM_SyntheticRenderGraphBuildAndCompile)->Unit(benchmark::kMicrosecond);
+
+// Same graph every frame, so after the first frame compilation comes from the compile cache
+static void BM_SyntheticRenderGraphBuildAndCompileCached(benchmark::State& state)
+{
+	run_synthetic_graph_benchmark(state, true);
+}
+BENCHMARK(BM_SyntheticRenderGraphBuildAndCompileCached)->Unit(benchmark::kMicrosecond);
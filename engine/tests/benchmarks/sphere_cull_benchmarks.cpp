@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include <utility/simd/sphere_cull_batch.h>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+	constexpr size_t sphere_cull_benchmark_count = 100000;
+
+	struct SphereCullBenchmarkData
+	{
+		Sunset::SphereCullBatch batch;
+		Sunset::SphereCullView view;
+		std::vector<uint64_t> task_keys;
+
+		SphereCullBenchmarkData()
+		{
+			// Large open scene with the camera at the origin looking down +z, seeing a slice of the world
+			std::mt19937 rng(42);
+			std::uniform_real_distribution<float> position_dist(-2000.0f, 2000.0f);
+			std::uniform_real_distribution<float> radius_dist(0.5f, 4.0f);
+			std::uniform_int_distribution<uint64_t> key_dist;
+
+			batch.reserve(sphere_cull_benchmark_count);
+			for (size_t i = 0; i < sphere_cull_benchmark_count; ++i)
+			{
+				batch.add(glm::vec3(position_dist(rng), position_dist(rng) * 0.05f, position_dist(rng)), radius_dist(rng));
+				task_keys.push_back(key_dist(rng));
+			}
+
+			const float diagonal = 0.70710678f;
+			view.planes[0] = glm::vec4(diagonal, 0.0f, diagonal, 0.0f);
+			view.planes[1] = glm::vec4(-diagonal, 0.0f, diagonal, 0.0f);
+			view.planes[2] = glm::vec4(0.0f, diagonal, diagonal, 0.0f);
+			view.planes[3] = glm::vec4(0.0f, -diagonal, diagonal, 0.0f);
+			view.planes[4] = glm::vec4(0.0f, 0.0f, 1.0f, -0.1f);
+			view.planes[5] = glm::vec4(0.0f, 0.0f, -1.0f, 1000.0f);
+			view.plane_count = 6;
+			view.max_distance = 800.0f;
+		}
+	};
+
+	SphereCullBenchmarkData& get_sphere_cull_benchmark_data()
+	{
+		static SphereCullBenchmarkData data;
+		return data;
+	}
+
+	// Stand-in for the per task work that follows submission: building the task, sorting it into batches
+	// and writing its instance data. Only the sort is modeled, since that is what scales with task count.
+	void simulate_task_submission(const SphereCullBenchmarkData& data, std::vector<uint64_t>& scratch, bool b_use_visibility)
+	{
+		scratch.clear();
+		for (size_t i = 0; i < sphere_cull_benchmark_count; ++i)
+		{
+			if (!b_use_visibility || data.batch.visibility[i] != 0)
+			{
+				scratch.push_back(data.task_keys[i]);
+			}
+		}
+		std::sort(scratch.begin(), scratch.end());
+	}
+}
+
+static void BM_SphereCull(benchmark::State& state)
+{
+	SphereCullBenchmarkData& data = get_sphere_cull_benchmark_data();
+	const Sunset::SIMDLevel simd_level = static_cast<Sunset::SIMDLevel>(state.range(0));
+	if (simd_level > Sunset::CPUFeatures::get_simd_level())
+	{
+		state.SkipWithError("SIMD level not supported on this CPU");
+		return;
+	}
+	for (auto _ : state)
+	{
+		Sunset::SphereCullOps::cull(data.batch, data.view, 0, data.batch.size(), simd_level);
+		benchmark::ClobberMemory();
+	}
+	state.counters["tasks_dropped"] = double(std::count(data.batch.visibility.begin(), data.batch.visibility.end(), uint8_t(0)));
+	state.counters["spheres_per_ms"] = benchmark::Counter(
+		double(state.iterations() * sphere_cull_benchmark_count) / 1000.0,
+		benchmark::Counter::kIsRate
+	);
+}
+BENCHMARK(BM_SphereCull)
+	->Arg(static_cast<int>(Sunset::SIMDLevel::Scalar))
+	->Arg(static_cast<int>(Sunset::SIMDLevel::SSE41))
+	->Arg(static_cast<int>(Sunset::SIMDLevel::AVX2))
+	->Unit(benchmark::kMicrosecond);
+
+static void BM_SphereCullParallel(benchmark::State& state)
+{
+	SphereCullBenchmarkData& data = get_sphere_cull_benchmark_data();
+	size_t culled_count = 0;
+	for (auto _ : state)
+	{
+		culled_count = Sunset::SphereCullOps::cull_parallel(data.batch, data.view);
+		benchmark::ClobberMemory();
+	}
+	state.counters["tasks_dropped"] = double(culled_count);
+}
+BENCHMARK(BM_SphereCullParallel)->Unit(benchmark::kMicrosecond);
+
+// Compare against BM_TaskSubmissionWithoutPreCull, the difference is the CPU time saved per frame
+static void BM_TaskSubmissionWithPreCull(benchmark::State& state)
+{
+	SphereCullBenchmarkData& data = get_sphere_cull_benchmark_data();
+	std::vector<uint64_t> scratch;
+	scratch.reserve(sphere_cull_benchmark_count);
+	for (auto _ : state)
+	{
+		Sunset::SphereCullOps::cull_parallel(data.batch, data.view);
+		simulate_task_submission(data, scratch, true);
+		benchmark::DoNotOptimize(scratch.data());
+	}
+	state.counters["tasks_submitted"] = double(scratch.size());
+	state.counters["tasks_dropped"] = double(sphere_cull_benchmark_count - scratch.size());
+}
+BENCHMARK(BM_TaskSubmissionWithPreCull)->Unit(benchmark::kMicrosecond);
+
+static void BM_TaskSubmissionWithoutPreCull(benchmark::State& state)
+{
+	SphereCullBenchmarkData& data = get_sphere_cull_benchmark_data();
+	std::vector<uint64_t> scratch;
+	scratch.reserve(sphere_cull_benchmark_count);
+	for (auto _ : state)
+	{
+		simulate_task_submission(data, scratch, false);
+		benchmark::DoNotOptimize(scratch.data());
+	}
+	state.counters["tasks_submitted"] = double(scratch.size());
+}
+BENCHMARK(BM_TaskSubmissionWithoutPreCull)->Unit(benchmark::kMicrosecond);
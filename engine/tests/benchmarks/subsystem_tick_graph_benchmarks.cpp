@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <core/subsystem_tick_graph.h>
+
+#include <cmath>
+
+namespace
+{
+	constexpr uint32_t synthetic_subsystem_count = 8;
+
+	template<int32_t Index>
+	struct SyntheticComponent
+	{
+		float value{ 0.0f };
+	};
+
+	// Burns a fixed amount of CPU per update and only touches its own component type, so every instance is independent
+	template<int32_t Index>
+	class SyntheticSubsystem : public Sunset::Subsystem
+	{
+	public:
+		virtual void initialize(class Sunset::Scene* scene) override { };
+		virtual void destroy(class Sunset::Scene* scene) override { };
+		virtual void update(class Sunset::Scene* scene, double delta_time) override
+		{
+			float accumulator = 0.0f;
+			for (uint32_t i = 0; i < 200000; ++i)
+			{
+				accumulator += std::sqrt(float(i) + accumulator);
+			}
+			benchmark::DoNotOptimize(accumulator);
+		}
+		virtual void declare_access(Sunset::SubsystemAccess& access) override
+		{
+			access.write<SyntheticComponent<Index>>();
+		}
+	};
+
+	template<int32_t... Indices>
+	void add_synthetic_subsystems(std::vector<std::unique_ptr<Sunset::Subsystem>>& subsystems, std::integer_sequence<int32_t, Indices...>)
+	{
+		(subsystems.push_back(std::make_unique<SyntheticSubsystem<Indices>>()), ...);
+	}
+
+	void run_synthetic_tick(benchmark::State& state, bool b_parallel)
+	{
+		std::vector<std::unique_ptr<Sunset::Subsystem>> subsystems;
+		add_synthetic_subsystems(subsystems, std::make_integer_sequence<int32_t, synthetic_subsystem_count>{});
+
+		Sunset::SubsystemTickGraph graph;
+		graph.build(subsystems);
+
+		for (auto _ : state)
+		{
+			graph.run(subsystems, [](Sunset::Subsystem* subsystem) { subsystem->update(nullptr, 0.0); }, b_parallel);
+		}
+	}
+}
+
+static void BM_SubsystemTickSerial(benchmark::State& state)
+{
+	run_synthetic_tick(state, false);
+}
+BENCHMARK(BM_SubsystemTickSerial)->Unit(benchmark::kMillisecond);
+
+static void BM_SubsystemTickParallel(benchmark::State& state)
+{
+	run_synthetic_tick(state, true);
+}
+BENCHMARK(BM_SubsystemTickParallel)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <utility/simd/transform_batch.h>
+#include <core/ecs/components/transform_component.h>
+
+#include <random>
+
+namespace
+{
+	constexpr size_t transform_benchmark_count = 8192;
+
+	struct TransformBenchmarkData
+	{
+		std::vector<Sunset::TransformComponent> transforms;
+		std::vector<glm::mat4> matrices;
+		Sunset::TransformBatch batch;
+
+		TransformBenchmarkData()
+			: transforms(transform_benchmark_count), matrices(transform_benchmark_count)
+		{
+			std::mt19937 rng(42);
+			std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+			for (size_t i = 0; i < transform_benchmark_count; ++i)
+			{
+				Sunset::TransformData& transform = transforms[i].transform;
+				transform.position = glm::vec3(dist(rng), dist(rng), dist(rng)) * 100.0f;
+				transform.rotation = glm::quat(dist(rng), dist(rng), dist(rng), dist(rng));
+				transform.scale = glm::vec3(2.0f + dist(rng));
+				batch.add(transform.position, transform.rotation, transform.scale, &matrices[i]);
+			}
+		}
+	};
+
+	TransformBenchmarkData& get_transform_benchmark_data()
+	{
+		static TransformBenchmarkData data;
+		return data;
+	}
+
+	void set_transforms_per_ms(benchmark::State& state)
+	{
+		state.counters["transforms_per_ms"] = benchmark::Counter(
+			double(state.iterations() * transform_benchmark_count) / 1000.0,
+			benchmark::Counter::kIsRate
+		);
+	}
+}
+
+static void BM_TransformRecalculateGLM(benchmark::State& state)
+{
+	TransformBenchmarkData& data = get_transform_benchmark_data();
+	for (auto _ : state)
+	{
+		for (Sunset::TransformComponent& transform_comp : data.transforms)
+		{
+			Sunset::recalculate_transform(&transform_comp);
+		}
+		benchmark::ClobberMemory();
+	}
+	set_transforms_per_ms(state);
+}
+BENCHMARK(BM_TransformRecalculateGLM);
+
+static void BM_TransformBatchCompose(benchmark::State& state)
+{
+	TransformBenchmarkData& data = get_transform_benchmark_data();
+	const Sunset::SIMDLevel simd_level = static_cast<Sunset::SIMDLevel>(state.range(0));
+	if (simd_level > Sunset::CPUFeatures::get_simd_level())
+	{
+		state.SkipWithError("SIMD level not supported on this CPU");
+		return;
+	}
+	for (auto _ : state)
+	{
+		Sunset::TransformBatchOps::compose(data.batch, simd_level);
+		benchmark::ClobberMemory();
+	}
+	set_transforms_per_ms(state);
+}
+BENCHMARK(BM_TransformBatchCompose)
+	->Arg(static_cast<int>(Sunset::SIMDLevel::Scalar))
+	->Arg(static_cast<int>(Sunset::SIMDLevel::SSE41))
+	->Arg(static_cast<int>(Sunset::SIMDLevel::AVX2));
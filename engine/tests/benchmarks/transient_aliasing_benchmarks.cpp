@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <graphics/transient_aliasing_planner.h>
+#include <graphics/render_graph.h>
+
+#include <random>
+
+namespace
+{
+	// Transient images and passes of the deferred pipeline at 1080p, without the registered resources it also uses
+	void build_deferred_graph(Sunset::RenderGraph& graph)
+	{
+		const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+		const auto image = [&graph](Sunset::Format format, Sunset::ImageFlags flags, float width = 1920.0f, float height = 1080.0f, uint32_t mip_count = 1)
+		{
+			return graph.create_image(nullptr, { .name = "image", .format = format, .extent = glm::vec3(width, height, 1.0f), .flags = flags, .mip_count = mip_count }, 0);
+		};
+		const auto buffer = [&graph](size_t size)
+		{
+			return graph.create_buffer(nullptr, { .name = "buffer", .buffer_size = size }, 0);
+		};
+
+		const Sunset::RGResourceHandle object_instances = buffer(sizeof(uint32_t) * 4 * 65536);
+		const Sunset::RGResourceHandle compacted_instances = buffer(sizeof(uint32_t) * 4 * 65536);
+		const Sunset::RGResourceHandle draw_indirect = buffer(sizeof(uint32_t) * 5 * 4096);
+		const Sunset::RGResourceHandle sky = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle shadow_map = image(Sunset::Format::FloatDepth32, Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil, 4096.0f, 4096.0f);
+		const Sunset::RGResourceHandle albedo = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle depth = image(Sunset::Format::FloatDepth32, Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil);
+		const Sunset::RGResourceHandle smra = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle cc = image(Sunset::Format::Float2x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle normal = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle position = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle motion_vectors = image(Sunset::Format::Float2x16, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage);
+		const Sunset::RGResourceHandle ssao_staging = image(Sunset::Format::Float32, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage);
+		const Sunset::RGResourceHandle ssao = image(Sunset::Format::Float32, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage);
+		const Sunset::RGResourceHandle scene_color = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle ssr = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage);
+		const Sunset::RGResourceHandle ssr_blurred = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage);
+		const Sunset::RGResourceHandle post_ssr_color = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+		const Sunset::RGResourceHandle bloom = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage, 1920.0f, 1080.0f, 6);
+		const Sunset::RGResourceHandle tonemapped = image(Sunset::Format::Float4x32, Sunset::ImageFlags::Color);
+
+		graph.add_pass(nullptr, "sky", Sunset::RenderPassFlags::Graphics, 0, { .outputs = { sky } }, no_op);
+		graph.add_pass(nullptr, "compute_cull", Sunset::RenderPassFlags::Compute, 0, { .inputs = { object_instances }, .outputs = { compacted_instances, draw_indirect } }, no_op);
+		graph.add_pass(nullptr, "csm", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { compacted_instances, draw_indirect }, .outputs = { shadow_map } }, no_op);
+		graph.add_pass(nullptr, "gbuffer", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { compacted_instances, draw_indirect }, .outputs = { albedo, depth, smra, cc, normal, position } }, no_op);
+		graph.add_pass(nullptr, "motion_vectors", Sunset::RenderPassFlags::Compute, 0, { .inputs = { depth }, .outputs = { motion_vectors } }, no_op);
+		graph.add_pass(nullptr, "ssao", Sunset::RenderPassFlags::Compute, 0, { .inputs = { position, normal }, .outputs = { ssao_staging } }, no_op);
+		graph.add_pass(nullptr, "ssao_blur", Sunset::RenderPassFlags::Compute, 0, { .inputs = { ssao_staging }, .outputs = { ssao } }, no_op);
+		graph.add_pass(nullptr, "lighting", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { sky, shadow_map, albedo, depth, smra, cc, normal, position, ssao }, .outputs = { scene_color } }, no_op);
+		graph.add_pass(nullptr, "ssr", Sunset::RenderPassFlags::Compute, 0, { .inputs = { position, normal, smra, scene_color }, .outputs = { ssr } }, no_op);
+		graph.add_pass(nullptr, "ssr_blur", Sunset::RenderPassFlags::Compute, 0, { .inputs = { ssr }, .outputs = { ssr_blurred } }, no_op);
+		graph.add_pass(nullptr, "ssr_resolve", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { smra, ssr, ssr_blurred, scene_color }, .outputs = { post_ssr_color } }, no_op);
+		graph.add_pass(nullptr, "taa", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { post_ssr_color, motion_vectors, depth }, .outputs = { post_ssr_color } }, no_op);
+		graph.add_pass(nullptr, "bloom", Sunset::RenderPassFlags::Compute, 0, { .inputs = { post_ssr_color }, .outputs = { bloom } }, no_op);
+		graph.add_pass(nullptr, "tonemap", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { post_ssr_color, bloom }, .outputs = { tonemapped } }, no_op);
+		graph.add_pass(nullptr, "present", Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::Present, 0, { .inputs = { tonemapped } }, no_op);
+	}
+}
+
+// Compiles the deferred pipeline's graph and reports its transient memory with and without aliasing
+static void BM_DeferredGraphTransientAliasing(benchmark::State& state)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+	build_deferred_graph(*graph);
+
+	for (auto _ : state)
+	{
+		graph->compile(nullptr, nullptr, 0);
+		benchmark::DoNotOptimize(graph->get_transient_aliasing_plan(0).aliased_bytes);
+	}
+
+	const Sunset::TransientAliasingPlan& plan = graph->get_transient_aliasing_plan(0);
+	state.counters["unaliased_mb"] = static_cast<double>(plan.unaliased_bytes) / (1024.0 * 1024.0);
+	state.counters["aliased_mb"] = static_cast<double>(plan.aliased_bytes) / (1024.0 * 1024.0);
+	state.counters["peak_live_mb"] = static_cast<double>(plan.peak_live_bytes) / (1024.0 * 1024.0);
+	state.counters["heaps"] = static_cast<double>(plan.heap_sizes.size());
+	state.counters["aliasing_barriers"] = static_cast<double>(plan.barriers.size());
+}
+BENCHMARK(BM_DeferredGraphTransientAliasing)->Unit(benchmark::kMicrosecond);
+
+// Planning cost for graphs with the given number of short lived transient resources
+static void BM_TransientAliasingPlan(benchmark::State& state)
+{
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int32_t> pass_dist(0, 200);
+	std::uniform_int_distribution<int32_t> length_dist(0, 12);
+	std::uniform_int_distribution<size_t> size_dist(64 * 1024, 32 * 1024 * 1024);
+
+	std::vector<Sunset::TransientResourceLifetime> lifetimes(state.range(0));
+	for (Sunset::TransientResourceLifetime& lifetime : lifetimes)
+	{
+		lifetime.first_pass = pass_dist(rng);
+		lifetime.last_pass = lifetime.first_pass + length_dist(rng);
+		lifetime.size = size_dist(rng);
+		lifetime.alignment = Sunset::RG_TRANSIENT_IMAGE_ALIGNMENT;
+	}
+
+	Sunset::TransientAliasingPlan plan;
+	for (auto _ : state)
+	{
+		Sunset::plan_transient_aliasing(lifetimes, plan);
+		benchmark::DoNotOptimize(plan.aliased_bytes);
+	}
+	state.counters["aliased_ratio"] = static_cast<double>(plan.aliased_bytes) / static_cast<double>(plan.unaliased_bytes);
+}
+BENCHMARK(BM_TransientAliasingPlan)->Arg(32)->Arg(128)->Arg(512)->Unit(benchmark::kMicrosecond);
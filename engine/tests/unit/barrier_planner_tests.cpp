@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <graphics/barrier_planner.h>
+
+TEST(SunsetTests, BarrierPlanMergesConsecutiveReads)
+{
+	Sunset::BarrierPlanInput input;
+	input.resources.push_back({ .uses =
+	{
+		{ .pass = 0, .access = Sunset::AccessFlags::ShaderWrite },
+		{ .pass = 1, .access = Sunset::AccessFlags::IndirectCommandRead },
+		{ .pass = 2, .access = Sunset::AccessFlags::ShaderRead },
+		{ .pass = 3, .access = Sunset::AccessFlags::ShaderWrite }
+	} });
+
+	Sunset::BarrierPlan plan;
+	Sunset::plan_barriers(input, plan);
+
+	EXPECT_EQ(plan.unoptimized_barrier_count, 4);
+	ASSERT_EQ(plan.barriers.size(), 3);
+
+	// The first read makes the buffer visible to both kinds of reads, so the second read needs no barrier
+	EXPECT_EQ(plan.barriers[1].pass, 1);
+	EXPECT_EQ(plan.barriers[1].src_access, Sunset::AccessFlags::ShaderWrite);
+	EXPECT_EQ(plan.barriers[1].dst_access, Sunset::AccessFlags::IndirectCommandRead | Sunset::AccessFlags::ShaderRead);
+	EXPECT_EQ(plan.barriers[2].pass, 3);
+	EXPECT_EQ(plan.barriers[2].src_access, Sunset::AccessFlags::IndirectCommandRead | Sunset::AccessFlags::ShaderRead);
+}
+
+TEST(SunsetTests, BarrierPlanDropsRedundantReadBarriers)
+{
+	Sunset::BarrierPlanInput input;
+	// Already readable by shaders when the frame starts
+	input.resources.push_back({ .uses =
+	{
+		{ .pass = 0, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly },
+		{ .pass = 2, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly }
+	}, .initial_access = Sunset::AccessFlags::ShaderRead | Sunset::AccessFlags::UniformRead, .initial_layout = Sunset::ImageLayout::ShaderReadOnly });
+	// Reads in a different layout still need a transition
+	input.resources.push_back({ .uses =
+	{
+		{ .pass = 0, .access = Sunset::AccessFlags::DepthStencilAttachmentRead, .layout = Sunset::ImageLayout::DepthStencilReadOnly },
+		{ .pass = 1, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly }
+	}, .initial_access = Sunset::AccessFlags::DepthStencilAttachmentRead, .initial_layout = Sunset::ImageLayout::DepthStencilReadOnly });
+
+	Sunset::BarrierPlan plan;
+	Sunset::plan_barriers(input, plan);
+
+	EXPECT_EQ(plan.unoptimized_barrier_count, 2);
+	ASSERT_EQ(plan.barriers.size(), 1);
+	EXPECT_EQ(plan.barriers[0].resource, 1);
+	EXPECT_EQ(plan.barriers[0].old_layout, Sunset::ImageLayout::DepthStencilReadOnly);
+	EXPECT_EQ(plan.barriers[0].new_layout, Sunset::ImageLayout::ShaderReadOnly);
+}
+
+TEST(SunsetTests, BarrierPlanCombinesMipBarriersIntoRanges)
+{
+	constexpr uint32_t mip_count = 4;
+
+	Sunset::BarrierPlanInput input;
+	Sunset::BarrierPlanResource& image = input.resources.emplace_back();
+	image.mip_count = mip_count;
+	// Every mip is written on its own by the first pass, then the whole chain is sampled
+	for (uint32_t mip = 0; mip < mip_count; ++mip)
+	{
+		image.uses.push_back({ .pass = 0, .access = Sunset::AccessFlags::ShaderWrite, .layout = Sunset::ImageLayout::General, .base_mip = mip });
+	}
+	image.uses.push_back({ .pass = 1, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly, .mip_count = mip_count });
+
+	Sunset::BarrierPlan plan;
+	Sunset::plan_barriers(input, plan);
+
+	EXPECT_EQ(plan.unoptimized_barrier_count, 2 * mip_count);
+	ASSERT_EQ(plan.barriers.size(), 2);
+	for (const Sunset::PlannedBarrier& barrier : plan.barriers)
+	{
+		EXPECT_EQ(barrier.base_mip, 0);
+		EXPECT_EQ(barrier.mip_count, mip_count);
+	}
+}
+
+TEST(SunsetTests, BarrierPlanKeepsMipsInDifferentStatesApart)
+{
+	constexpr uint32_t mip_count = 4;
+
+	Sunset::BarrierPlanInput input;
+	Sunset::BarrierPlanResource& image = input.resources.emplace_back();
+	image.mip_count = mip_count;
+	image.uses.push_back({ .pass = 0, .access = Sunset::AccessFlags::ShaderWrite, .layout = Sunset::ImageLayout::General });
+	// Downsample chain, each pass reads the previous mip and writes the next one
+	for (uint32_t mip = 1; mip < mip_count; ++mip)
+	{
+		image.uses.push_back({ .pass = mip, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly, .base_mip = mip - 1 });
+		image.uses.push_back({ .pass = mip, .access = Sunset::AccessFlags::ShaderWrite, .layout = Sunset::ImageLayout::General, .base_mip = mip });
+	}
+
+	Sunset::BarrierPlan plan;
+	Sunset::plan_barriers(input, plan);
+
+	EXPECT_EQ(plan.barriers.size(), 1 + 2 * (mip_count - 1));
+	for (const Sunset::PlannedBarrier& barrier : plan.barriers)
+	{
+		EXPECT_EQ(barrier.mip_count, 1);
+	}
+}
+
+TEST(SunsetTests, BarrierPlanSplitsDistantBarriers)
+{
+	Sunset::BarrierPlanInput input;
+	input.split_min_distance = 2;
+	input.resources.push_back({ .uses =
+	{
+		{ .pass = 0, .access = Sunset::AccessFlags::ColorAttachmentWrite, .layout = Sunset::ImageLayout::ColorAttachment },
+		{ .pass = 1, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly }
+	} });
+	input.resources.push_back({ .uses =
+	{
+		{ .pass = 0, .access = Sunset::AccessFlags::ColorAttachmentWrite, .layout = Sunset::ImageLayout::ColorAttachment },
+		{ .pass = 3, .access = Sunset::AccessFlags::ShaderRead, .layout = Sunset::ImageLayout::ShaderReadOnly }
+	} });
+
+	Sunset::BarrierPlan plan;
+	Sunset::plan_barriers(input, plan);
+
+	ASSERT_EQ(plan.barriers.size(), 4);
+	EXPECT_EQ(plan.split_barrier_count, 1);
+
+	// Nothing comes before a resource's first use in the frame, so that barrier is never split
+	EXPECT_FALSE(plan.barriers[0].is_split());
+	EXPECT_FALSE(plan.barriers[1].is_split());
+	EXPECT_FALSE(plan.barriers[2].is_split());
+
+	const Sunset::PlannedBarrier& split_barrier = plan.barriers[3];
+	EXPECT_EQ(split_barrier.resource, 1);
+	EXPECT_EQ(split_barrier.release_pass, 0);
+	EXPECT_EQ(split_barrier.pass, 3);
+
+	input.split_min_distance = 0;
+	Sunset::plan_barriers(input, plan);
+	EXPECT_EQ(plan.split_barrier_count, 0);
+}
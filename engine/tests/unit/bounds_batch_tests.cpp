@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <utility/simd/bounds_batch.h>
+#include <core/ecs/dynamic_aabb_tree.h>
+
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	struct BoundsTestData
+	{
+		std::vector<glm::mat4> transforms;
+		BoundsBatch batch;
+	};
+
+	glm::mat4 random_transform(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		// Orthonormal basis from Gram-Schmidt on random vectors, scaled per axis, so the result is a valid TRS matrix
+		glm::vec3 x_axis = glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng)) + glm::vec3(0.01f, 0.0f, 0.0f));
+		glm::vec3 y_axis = glm::vec3(dist(rng), dist(rng), dist(rng)) + glm::vec3(0.0f, 0.01f, 0.0f);
+		y_axis = glm::normalize(y_axis - x_axis * glm::dot(x_axis, y_axis));
+		const glm::vec3 z_axis = glm::cross(x_axis, y_axis);
+
+		const glm::vec3 scale(2.0f + dist(rng), 2.0f + dist(rng), 2.0f + dist(rng));
+
+		glm::mat4 transform(1.0f);
+		transform[0] = glm::vec4(x_axis * scale.x, 0.0f);
+		transform[1] = glm::vec4(y_axis * scale.y, 0.0f);
+		transform[2] = glm::vec4(z_axis * scale.z, 0.0f);
+		transform[3] = glm::vec4(dist(rng) * 100.0f, dist(rng) * 100.0f, dist(rng) * 100.0f, 1.0f);
+		return transform;
+	}
+
+	void fill_bounds_batch(BoundsTestData& data, uint32_t count)
+	{
+		std::mt19937 rng(5);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		data.transforms.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			data.transforms[i] = random_transform(rng);
+			const glm::vec3 extents(1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f);
+			data.batch.add(glm::vec3(dist(rng), dist(rng), dist(rng)), extents, glm::length(extents), &data.transforms[i]);
+		}
+	}
+}
+
+TEST(SunsetTests, BoundsBatch_SIMDLevelsMatchScalar)
+{
+	BoundsTestData data;
+	// Odd count so every SIMD path also exercises its scalar tail
+	fill_bounds_batch(data, 257);
+
+	BoundsBatchOps::transform(data.batch, SIMDLevel::Scalar);
+	const std::vector<float> reference_center_x = data.batch.world_center_x;
+	const std::vector<float> reference_extent_y = data.batch.world_extent_y;
+	const std::vector<float> reference_radius = data.batch.world_radius;
+
+	for (SIMDLevel simd_level : { SIMDLevel::SSE41, SIMDLevel::AVX2 })
+	{
+		std::fill(data.batch.world_center_x.begin(), data.batch.world_center_x.end(), 0.0f);
+		std::fill(data.batch.world_extent_y.begin(), data.batch.world_extent_y.end(), 0.0f);
+		std::fill(data.batch.world_radius.begin(), data.batch.world_radius.end(), 0.0f);
+
+		BoundsBatchOps::transform(data.batch, simd_level);
+
+		for (size_t i = 0; i < data.batch.size(); ++i)
+		{
+			EXPECT_NEAR(data.batch.world_center_x[i], reference_center_x[i], 1e-3f);
+			EXPECT_NEAR(data.batch.world_extent_y[i], reference_extent_y[i], 1e-4f);
+			EXPECT_NEAR(data.batch.world_radius[i], reference_radius[i], 1e-4f);
+		}
+	}
+}
+
+TEST(SunsetTests, BoundsBatch_EnclosesTransformedCorners)
+{
+	BoundsTestData data;
+	fill_bounds_batch(data, 64);
+
+	BoundsBatchOps::transform(data.batch);
+
+	for (size_t i = 0; i < data.batch.size(); ++i)
+	{
+		const glm::vec3 local_center(data.batch.local_center_x[i], data.batch.local_center_y[i], data.batch.local_center_z[i]);
+		const glm::vec3 local_extents(data.batch.local_extent_x[i], data.batch.local_extent_y[i], data.batch.local_extent_z[i]);
+		const glm::vec3 world_center = data.batch.get_world_center(i);
+		const glm::vec3 world_extents = data.batch.get_world_extents(i);
+
+		// Brute force: transform all 8 corners and take their min/max, which the abs-matrix result must match
+		glm::vec3 corner_min(std::numeric_limits<float>::max());
+		glm::vec3 corner_max(-std::numeric_limits<float>::max());
+		float max_corner_distance = 0.0f;
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			const glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+			const glm::vec3 world_corner = glm::vec3(data.transforms[i] * glm::vec4(local_center + local_extents * sign, 1.0f));
+			corner_min = glm::min(corner_min, world_corner);
+			corner_max = glm::max(corner_max, world_corner);
+			max_corner_distance = std::max(max_corner_distance, glm::length(world_corner - world_center));
+		}
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			EXPECT_NEAR(world_center[axis] - world_extents[axis], corner_min[axis], 1e-3f);
+			EXPECT_NEAR(world_center[axis] + world_extents[axis], corner_max[axis], 1e-3f);
+		}
+
+		// Matches the single entity helper used outside of batches
+		const AABB single_aabb = transform_aabb({ local_center - local_extents, local_center + local_extents }, data.transforms[i]);
+		EXPECT_NEAR(single_aabb.min.x, corner_min.x, 1e-3f);
+		EXPECT_NEAR(single_aabb.max.z, corner_max.z, 1e-3f);
+
+		// Sphere must enclose the transformed box
+		EXPECT_GE(data.batch.world_radius[i] + 1e-3f, max_corner_distance);
+	}
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include <graphics/command_recording_planner.h>
+#include <job_system/job_scheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+	struct RecordedPass
+	{
+		std::string name;
+		bool b_parallel{ false };
+		uint32_t chunk_count{ 1 };
+	};
+
+	// Stands in for a graphics context. Commands are recorded as strings into a primary stream and into one secondary stream
+	// per slot, and executing a slot copies its commands into the primary stream the way the GPU would see them.
+	class RecordingCommandContext
+	{
+	public:
+		explicit RecordingCommandContext(const std::vector<RecordedPass>& passes)
+			: passes(passes)
+		{ }
+
+		Sunset::CommandRecordingCallbacks make_callbacks()
+		{
+			return
+			{
+				.record_pass = [this](uint32_t pass)
+				{
+					primary.push_back("barriers " + passes[pass].name);
+					primary.push_back("begin " + passes[pass].name);
+					primary.push_back("draw " + passes[pass].name);
+					primary.push_back("end " + passes[pass].name);
+				},
+				.prepare_pass = [this](uint32_t pass, uint32_t first_slot)
+				{
+					for (uint32_t chunk = 0; chunk < passes[pass].chunk_count; ++chunk)
+					{
+						EXPECT_TRUE(secondaries[first_slot + chunk].empty());
+						secondaries[first_slot + chunk].push_back("bind " + passes[pass].name);
+					}
+				},
+				.record_chunk = [this](uint32_t pass, uint32_t chunk, uint32_t slot)
+				{
+					secondaries[slot].push_back("draw " + passes[pass].name + " chunk " + std::to_string(chunk));
+					ended_slots[slot] = 1;
+				},
+				.execute_pass = [this](uint32_t pass, uint32_t first_slot)
+				{
+					primary.push_back("barriers " + passes[pass].name);
+					primary.push_back("begin " + passes[pass].name);
+					for (uint32_t chunk = 0; chunk < passes[pass].chunk_count; ++chunk)
+					{
+						EXPECT_EQ(ended_slots[first_slot + chunk], 1);
+						primary.insert(primary.end(), secondaries[first_slot + chunk].begin(), secondaries[first_slot + chunk].end());
+					}
+					primary.push_back("end " + passes[pass].name);
+				}
+			};
+		}
+
+		void record(bool b_parallel, uint32_t max_slots = Sunset::MAX_PARALLEL_RECORD_SLOTS_PER_FRAME)
+		{
+			Sunset::CommandRecordingInput input{ .max_slots = max_slots };
+			for (const RecordedPass& pass : passes)
+			{
+				input.passes.push_back({ .b_parallel = pass.b_parallel, .chunk_count = pass.chunk_count });
+			}
+			Sunset::plan_command_recording(input, plan);
+
+			primary.clear();
+			secondaries.assign(plan.slot_count, {});
+			ended_slots.assign(plan.slot_count, 0);
+
+			Sunset::record_command_stream(plan, make_callbacks(), b_parallel);
+		}
+
+		std::vector<RecordedPass> passes;
+		Sunset::CommandRecordingPlan plan;
+		std::vector<std::string> primary;
+		std::vector<std::vector<std::string>> secondaries;
+		std::vector<uint8_t> ended_slots;
+	};
+
+	std::vector<std::string> expected_pass_stream(const RecordedPass& pass)
+	{
+		std::vector<std::string> stream = { "barriers " + pass.name, "begin " + pass.name };
+		if (!pass.b_parallel)
+		{
+			stream.push_back("draw " + pass.name);
+		}
+		for (uint32_t chunk = 0; pass.b_parallel && chunk < pass.chunk_count; ++chunk)
+		{
+			stream.push_back("bind " + pass.name);
+			stream.push_back("draw " + pass.name + " chunk " + std::to_string(chunk));
+		}
+		stream.push_back("end " + pass.name);
+		return stream;
+	}
+}
+
+TEST(SunsetTests, CommandRecordingPlanBatchesConsecutiveParallelPasses)
+{
+	Sunset::CommandRecordingInput input;
+	input.passes =
+	{
+		{ .b_parallel = false },
+		{ .b_parallel = true, .chunk_count = 4 },
+		{ .b_parallel = true, .chunk_count = 2 },
+		{ .b_parallel = false },
+		{ .b_parallel = true, .chunk_count = 0 }
+	};
+
+	Sunset::CommandRecordingPlan plan;
+	Sunset::plan_command_recording(input, plan);
+
+	ASSERT_EQ(plan.batches.size(), 2);
+	EXPECT_EQ(plan.batches[0].first_pass, 1);
+	EXPECT_EQ(plan.batches[0].pass_count, 2);
+	EXPECT_EQ(plan.batches[0].first_slot, 0);
+	EXPECT_EQ(plan.batches[0].slot_count, 6);
+	EXPECT_EQ(plan.batches[1].first_pass, 4);
+	EXPECT_EQ(plan.batches[1].pass_count, 1);
+	EXPECT_EQ(plan.batches[1].first_slot, 6);
+	// Parallel passes always record at least one chunk
+	EXPECT_EQ(plan.batches[1].slot_count, 1);
+
+	EXPECT_EQ(plan.slot_count, 7);
+	EXPECT_EQ(plan.inlined_pass_count, 0);
+	EXPECT_EQ(plan.pass_first_slots, (std::vector<uint32_t>{ Sunset::COMMAND_RECORDING_INLINE_PASS, 0, 4, Sunset::COMMAND_RECORDING_INLINE_PASS, 6 }));
+}
+
+TEST(SunsetTests, CommandRecordingPlanInlinesPassesOverSlotLimit)
+{
+	RecordingCommandContext context({
+		{ .name = "shadow_0", .b_parallel = true, .chunk_count = 3 },
+		{ .name = "shadow_1", .b_parallel = true, .chunk_count = 2 },
+		{ .name = "gbuffer", .b_parallel = true, .chunk_count = 1 }
+	});
+	context.record(true, 4);
+
+	// The second pass does not fit, which leaves the passes on either side of it in separate batches
+	EXPECT_EQ(context.plan.inlined_pass_count, 1);
+	EXPECT_EQ(context.plan.slot_count, 4);
+	ASSERT_EQ(context.plan.batches.size(), 2);
+	EXPECT_EQ(context.plan.pass_first_slots[1], Sunset::COMMAND_RECORDING_INLINE_PASS);
+
+	std::vector<std::string> expected_stream = expected_pass_stream(context.passes[0]);
+	const std::vector<std::string> inline_stream = expected_pass_stream({ .name = "shadow_1" });
+	expected_stream.insert(expected_stream.end(), inline_stream.begin(), inline_stream.end());
+	const std::vector<std::string> last_stream = expected_pass_stream(context.passes[2]);
+	expected_stream.insert(expected_stream.end(), last_stream.begin(), last_stream.end());
+	EXPECT_EQ(context.primary, expected_stream);
+}
+
+TEST(SunsetTests, CommandRecordingStreamPreservesSubmissionOrder)
+{
+	// Deferred frame with chunked shadow cascades and gbuffer, recorded in parallel around passes that stay on the recording thread
+	const std::vector<RecordedPass> passes =
+	{
+		{ .name = "cull" },
+		{ .name = "shadow_cascade_0", .b_parallel = true, .chunk_count = 4 },
+		{ .name = "shadow_cascade_1", .b_parallel = true, .chunk_count = 4 },
+		{ .name = "depth_prepass", .b_parallel = true, .chunk_count = 2 },
+		{ .name = "gbuffer", .b_parallel = true, .chunk_count = 8 },
+		{ .name = "ssao" },
+		{ .name = "lighting", .b_parallel = true },
+		{ .name = "present" }
+	};
+
+	std::vector<std::string> expected_stream;
+	for (const RecordedPass& pass : passes)
+	{
+		const std::vector<std::string> pass_stream = expected_pass_stream(pass);
+		expected_stream.insert(expected_stream.end(), pass_stream.begin(), pass_stream.end());
+	}
+
+	RecordingCommandContext serial_context(passes);
+	serial_context.record(false);
+	EXPECT_EQ(serial_context.primary, expected_stream);
+
+	// Chunks only run on job threads once the test environment has started the scheduler
+	ASSERT_TRUE(Sunset::JobScheduler::get()->has_available_threads());
+	for (uint32_t run = 0; run < 8; ++run)
+	{
+		RecordingCommandContext parallel_context(passes);
+		parallel_context.record(true);
+		EXPECT_EQ(parallel_context.plan.batches.size(), 2);
+		EXPECT_EQ(parallel_context.primary, expected_stream);
+	}
+}
+
+TEST(SunsetTests, CommandRecordingChunkRangesCoverEveryItem)
+{
+	for (uint32_t item_count : { 0u, 1u, 7u, 64u, 1001u })
+	{
+		for (uint32_t chunk_count = 1; chunk_count <= 9; ++chunk_count)
+		{
+			uint32_t next_item{ 0 };
+			for (uint32_t chunk = 0; chunk < chunk_count; ++chunk)
+			{
+				const Sunset::CommandRecordingChunkRange range = Sunset::get_command_recording_chunk_range(item_count, chunk, chunk_count);
+				// Chunks are contiguous and in order, so draws keep their sorted order across the pass's command buffers
+				EXPECT_EQ(range.begin, next_item);
+				EXPECT_LE(range.end - range.begin, item_count / chunk_count + 1);
+				next_item = range.end;
+			}
+			EXPECT_EQ(next_item, item_count);
+		}
+	}
+}
+
+TEST(SunsetTests, CommandRecordingStreamFromPinnedJobCompletes)
+{
+	// Renderer::draw records the frame from a job pinned to worker 1, and chunk jobs can get queued on that same worker
+	if (Sunset::JobScheduler::get()->get_num_threads() < 2)
+	{
+		GTEST_SKIP() << "Needs a second job thread to pin the recording job to";
+	}
+	ASSERT_TRUE(Sunset::JobScheduler::get()->has_available_threads());
+
+	constexpr uint32_t chunk_count = Sunset::MAX_PARALLEL_RECORD_SLOTS_PER_FRAME;
+	Sunset::CommandRecordingInput input;
+	input.passes = { { .b_parallel = true, .chunk_count = chunk_count } };
+	Sunset::CommandRecordingPlan plan;
+	Sunset::plan_command_recording(input, plan);
+	ASSERT_EQ(plan.batches.size(), 1);
+
+	std::atomic_uint32_t recorded_chunk_count{ 0 };
+	const Sunset::CommandRecordingCallbacks callbacks
+	{
+		.record_pass = [](uint32_t pass) {},
+		.prepare_pass = [](uint32_t pass, uint32_t first_slot) {},
+		.record_chunk = [&](uint32_t pass, uint32_t chunk, uint32_t slot)
+		{
+			// Slow chunks keep the other workers' queues occupied, so the scheduler also hands chunks to the recording worker
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			++recorded_chunk_count;
+		},
+		.execute_pass = [](uint32_t pass, uint32_t first_slot) {}
+	};
+
+	const auto recording_job = [&]() -> Sunset::ThreadedJob<1>
+	{
+		Sunset::record_command_stream(plan, callbacks, true);
+		co_return;
+	};
+
+	const Sunset::ThreadedJob<1> job = recording_job();
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (!job.is_done() && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_TRUE(job.is_done());
+	EXPECT_EQ(recorded_chunk_count.load(), chunk_count);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <graphics/descriptor.h>
+#include <graphics/graphics_context.h>
+
+namespace
+{
+	// Noop backend that records what reaches the GPI
+	class CountingGraphicsContext : public Sunset::NoopGraphicsContext
+	{
+	public:
+		void push_descriptor_writes(const std::vector<Sunset::DescriptorWrite>& descriptor_writes)
+		{
+			++update_call_count;
+			pushed_writes.insert(pushed_writes.end(), descriptor_writes.begin(), descriptor_writes.end());
+		}
+
+		static inline uint32_t update_call_count{ 0 };
+		static inline std::vector<Sunset::DescriptorWrite> pushed_writes;
+	};
+
+	Sunset::DescriptorWrite make_image_write(Sunset::DescriptorSet* set, uint16_t slot, int32_t array_index, void* image)
+	{
+		Sunset::DescriptorWrite write;
+		write.slot = slot;
+		write.count = 1;
+		write.array_index = array_index;
+		write.type = Sunset::DescriptorType::Image;
+		write.buffer_desc.buffer = image;
+		write.set = set;
+		return write;
+	}
+}
+
+TEST(SunsetTests, DescriptorBindingTableReusesFreedIndices)
+{
+	Sunset::DescriptorBindingTable table;
+	table.add_binding_slot(3, 4);
+
+	std::vector<Sunset::BindingTableHandle> handles;
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		handles.push_back(table.get_new(3));
+		EXPECT_EQ(handles.back() >> 32, 3);
+		EXPECT_EQ(0x0000ffff & handles.back(), i);
+	}
+	EXPECT_EQ(table.get_bound_count(3), 4);
+	EXPECT_EQ(table.get_new(3), -1);
+
+	table.free(handles[1]);
+	EXPECT_EQ(table.get_bound_count(3), 3);
+
+	// Freeing an index that is no longer bound must not hand it out twice
+	table.free(handles[1]);
+	EXPECT_EQ(table.get_bound_count(3), 3);
+
+	EXPECT_EQ(table.get_new(3), handles[1]);
+	EXPECT_EQ(table.get_new(3), -1);
+
+	table.reset(3);
+	EXPECT_EQ(table.get_bound_count(3), 0);
+	EXPECT_EQ(table.get_new(3), handles[0]);
+	EXPECT_EQ(table.get_bound_count(7), 0);
+}
+
+TEST(SunsetTests, DescriptorWriteBatchPushesDeduplicatedWritesOnce)
+{
+	CountingGraphicsContext::update_call_count = 0;
+	CountingGraphicsContext::pushed_writes.clear();
+
+	Sunset::GenericGraphicsContext<CountingGraphicsContext> gfx_context;
+
+	int set_a_storage{ 0 }, set_b_storage{ 0 };
+	Sunset::DescriptorSet* const set_a = reinterpret_cast<Sunset::DescriptorSet*>(&set_a_storage);
+	Sunset::DescriptorSet* const set_b = reinterpret_cast<Sunset::DescriptorSet*>(&set_b_storage);
+
+	int image_a{ 0 }, image_b{ 0 };
+
+	Sunset::DescriptorWriteBatch batch;
+	batch.add(make_image_write(set_a, 0, 0, &image_a));
+	batch.add(make_image_write(set_a, 0, 1, &image_a));
+	batch.add(make_image_write(set_b, 0, 0, &image_a));
+	// Rewrites an element already in the batch, so only the later image should reach the GPI
+	batch.add(make_image_write(set_a, 0, 0, &image_b));
+	EXPECT_EQ(batch.size(), 3);
+
+	batch.flush(&gfx_context);
+	EXPECT_EQ(batch.size(), 0);
+	EXPECT_EQ(CountingGraphicsContext::update_call_count, 1);
+	ASSERT_EQ(CountingGraphicsContext::pushed_writes.size(), 3);
+	EXPECT_EQ(CountingGraphicsContext::pushed_writes[0].set, set_a);
+	EXPECT_EQ(CountingGraphicsContext::pushed_writes[0].buffer_desc.buffer, &image_b);
+
+	// Nothing queued, nothing pushed
+	batch.flush(&gfx_context);
+	EXPECT_EQ(CountingGraphicsContext::update_call_count, 1);
+
+	// Writes from after a flush are not deduplicated against writes that already went out
+	batch.add(make_image_write(set_a, 0, 0, &image_a));
+	batch.flush(&gfx_context);
+	EXPECT_EQ(CountingGraphicsContext::update_call_count, 2);
+
+	const Sunset::DescriptorWriteBatchStats& stats = batch.get_stats();
+	EXPECT_EQ(stats.queued_write_count, 5);
+	EXPECT_EQ(stats.deduplicated_write_count, 1);
+	EXPECT_EQ(stats.pushed_write_count, 4);
+	EXPECT_EQ(stats.update_call_count, 2);
+}
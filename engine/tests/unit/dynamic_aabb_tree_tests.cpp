@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <core/ecs/dynamic_aabb_tree.h>
+
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	struct AABBTreeTestData
+	{
+		std::vector<EntityID> entities;
+		std::vector<AABB> bounds;
+	};
+
+	AABB random_aabb(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position_dist(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> size_dist(0.1f, 4.0f);
+		const glm::vec3 center(position_dist(rng), position_dist(rng), position_dist(rng));
+		const glm::vec3 extents(size_dist(rng), size_dist(rng), size_dist(rng));
+		return { center - extents, center + extents };
+	}
+
+	AABBTreeTestData populate_tree(DynamicAABBTree& tree, uint32_t count, std::mt19937& rng)
+	{
+		AABBTreeTestData data;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			data.entities.push_back(create_entity_id(i, 1));
+			data.bounds.push_back(random_aabb(rng));
+			tree.update_entity(data.entities.back(), data.bounds.back());
+		}
+		return data;
+	}
+
+	template<typename OverlapFunc>
+	std::vector<EntityID> brute_force_query(const AABBTreeTestData& data, OverlapFunc&& overlap_test)
+	{
+		std::vector<EntityID> results;
+		for (size_t i = 0; i < data.entities.size(); ++i)
+		{
+			if (data.entities[i] != INVALID_ENTITY && overlap_test(data.bounds[i]))
+			{
+				results.push_back(data.entities[i]);
+			}
+		}
+		return results;
+	}
+
+	void expect_same_entities(std::vector<EntityID> a, std::vector<EntityID> b)
+	{
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+		EXPECT_EQ(a, b);
+	}
+}
+
+TEST(SunsetTests, DynamicAABBTree_QueriesMatchBruteForce)
+{
+	std::mt19937 rng(7);
+	DynamicAABBTree tree;
+	const AABBTreeTestData data = populate_tree(tree, 2000, rng);
+
+	EXPECT_TRUE(tree.validate());
+	EXPECT_EQ(tree.size(), 2000);
+
+	for (uint32_t query = 0; query < 32; ++query)
+	{
+		const AABB query_box = random_aabb(rng);
+		std::vector<EntityID> tree_results;
+		tree.query_aabb(query_box, tree_results);
+		expect_same_entities(tree_results, brute_force_query(data, [&](const AABB& aabb) { return aabb_overlaps(aabb, query_box); }));
+
+		const glm::vec3 center = (query_box.min + query_box.max) * 0.5f;
+		const float radius = 5.0f + query;
+		tree_results.clear();
+		tree.query_sphere(center, radius, tree_results);
+		expect_same_entities(tree_results, brute_force_query(data, [&](const AABB& aabb) { return aabb_overlaps_sphere(aabb, center, radius); }));
+
+		const glm::vec3 direction = glm::normalize(glm::vec3(1.0f, 0.25f * query - 4.0f, 0.5f));
+		const glm::vec3 inverse_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+		tree_results.clear();
+		tree.query_ray(center, direction, 150.0f, tree_results);
+		expect_same_entities(tree_results, brute_force_query(data, [&](const AABB& aabb) { return aabb_overlaps_ray(aabb, center, inverse_direction, 150.0f); }));
+	}
+}
+
+TEST(SunsetTests, DynamicAABBTree_FrustumQueryMatchesBruteForce)
+{
+	std::mt19937 rng(11);
+	DynamicAABBTree tree;
+	const AABBTreeTestData data = populate_tree(tree, 2000, rng);
+
+	// Box shaped frustum around the origin, looking down +z
+	const glm::vec4 planes[6] =
+	{
+		glm::vec4(1.0f, 0.0f, 0.0f, 30.0f),
+		glm::vec4(-1.0f, 0.0f, 0.0f, 30.0f),
+		glm::vec4(0.0f, 1.0f, 0.0f, 20.0f),
+		glm::vec4(0.0f, -1.0f, 0.0f, 20.0f),
+		glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+		glm::vec4(0.0f, 0.0f, -1.0f, 60.0f)
+	};
+
+	std::vector<EntityID> tree_results;
+	tree.query_frustum(planes, 6, tree_results);
+	EXPECT_FALSE(tree_results.empty());
+	expect_same_entities(tree_results, brute_force_query(data, [&](const AABB& aabb) { return aabb_overlaps_frustum(aabb, planes, 6); }));
+}
+
+TEST(SunsetTests, DynamicAABBTree_MovesAndRemovalsStayConsistent)
+{
+	std::mt19937 rng(3);
+	DynamicAABBTree tree;
+	AABBTreeTestData data = populate_tree(tree, 1000, rng);
+
+	std::uniform_real_distribution<float> step_dist(-2.0f, 2.0f);
+	for (uint32_t frame = 0; frame < 20; ++frame)
+	{
+		for (size_t i = 0; i < data.entities.size(); i += 3)
+		{
+			if (data.entities[i] == INVALID_ENTITY)
+			{
+				continue;
+			}
+			const glm::vec3 step(step_dist(rng), step_dist(rng), step_dist(rng));
+			data.bounds[i] = { data.bounds[i].min + step, data.bounds[i].max + step };
+			tree.update_entity(data.entities[i], data.bounds[i]);
+		}
+
+		const size_t removed_index = (frame * 37) % data.entities.size();
+		if (data.entities[removed_index] != INVALID_ENTITY)
+		{
+			tree.remove_entity(data.entities[removed_index]);
+			data.entities[removed_index] = INVALID_ENTITY;
+		}
+
+		ASSERT_TRUE(tree.validate());
+	}
+
+	const AABB query_box = { glm::vec3(-50.0f), glm::vec3(50.0f) };
+	std::vector<EntityID> tree_results;
+	tree.query_aabb(query_box, tree_results);
+	expect_same_entities(tree_results, brute_force_query(data, [&](const AABB& aabb) { return aabb_overlaps(aabb, query_box); }));
+
+	// Balanced trees stay well within the worst case height for this many leaves
+	EXPECT_LT(tree.get_height(), 40);
+}
+
+TEST(SunsetTests, DynamicAABBTree_ReusedEntityIndexReplacesStaleProxy)
+{
+	DynamicAABBTree tree;
+
+	const EntityID old_entity = create_entity_id(5, 1);
+	const EntityID new_entity = create_entity_id(5, 2);
+
+	tree.update_entity(old_entity, { glm::vec3(0.0f), glm::vec3(1.0f) });
+	tree.update_entity(new_entity, { glm::vec3(10.0f), glm::vec3(11.0f) });
+
+	EXPECT_EQ(tree.size(), 1);
+	EXPECT_FALSE(tree.contains_entity(old_entity));
+	EXPECT_TRUE(tree.contains_entity(new_entity));
+
+	tree.remove_entity(old_entity);
+	EXPECT_EQ(tree.size(), 1);
+
+	tree.remove_entity(new_entity);
+	EXPECT_EQ(tree.size(), 0);
+	EXPECT_TRUE(tree.validate());
+}
+
+TEST(SunsetTests, DynamicAABBTree_TransformAABBEnclosesCorners)
+{
+	const AABB local_aabb = { glm::vec3(-1.0f, -2.0f, -0.5f), glm::vec3(1.0f, 2.0f, 0.5f) };
+
+	glm::mat4 transform(1.0f);
+	// 90 degree rotation about z, followed by a translation
+	transform[0] = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+	transform[1] = glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f);
+	transform[3] = glm::vec4(5.0f, 0.0f, 0.0f, 1.0f);
+
+	const AABB world_aabb = transform_aabb(local_aabb, transform);
+	EXPECT_FLOAT_EQ(world_aabb.min.x, 3.0f);
+	EXPECT_FLOAT_EQ(world_aabb.max.x, 7.0f);
+	EXPECT_FLOAT_EQ(world_aabb.min.y, -1.0f);
+	EXPECT_FLOAT_EQ(world_aabb.max.y, 1.0f);
+	EXPECT_FLOAT_EQ(world_aabb.min.z, -0.5f);
+	EXPECT_FLOAT_EQ(world_aabb.max.z, 0.5f);
+}
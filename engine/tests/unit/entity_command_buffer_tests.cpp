@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <core/layers/scene.h>
+
+#include <thread>
+
+using namespace Sunset;
+
+namespace
+{
+	struct TestHealthComponent
+	{
+		int32_t health{ 100 };
+	};
+
+	struct TestTagComponent
+	{
+		uint32_t tag{ 0 };
+	};
+}
+
+TEST(SunsetTests, EntityCommandBuffer_CreateAndAddAppliedOnFlush)
+{
+	Scene scene;
+
+	EntityCommandBuffer* const command_buffer = scene.get_entity_command_buffer();
+	const EntityID temporary_entity = command_buffer->create_entity();
+	EXPECT_TRUE(is_temporary_entity(temporary_entity));
+
+	command_buffer->add_component(temporary_entity, TestHealthComponent{ .health = 42 });
+	command_buffer->add_component<TestTagComponent>(temporary_entity)->tag = 7;
+
+	EXPECT_TRUE(scene.entities.empty());
+
+	scene.flush_entity_commands();
+
+	ASSERT_EQ(scene.entities.size(), 1);
+	const EntityID entity = scene.entities[0].id;
+	EXPECT_FALSE(is_temporary_entity(entity));
+	ASSERT_NE(scene.get_component<TestHealthComponent>(entity), nullptr);
+	EXPECT_EQ(scene.get_component<TestHealthComponent>(entity)->health, 42);
+	ASSERT_NE(scene.get_component<TestTagComponent>(entity), nullptr);
+	EXPECT_EQ(scene.get_component<TestTagComponent>(entity)->tag, 7);
+	EXPECT_TRUE(command_buffer->empty());
+}
+
+TEST(SunsetTests, EntityCommandBuffer_RemoveAndDestroyDuringIteration)
+{
+	Scene scene;
+
+	for (int32_t i = 0; i < 16; ++i)
+	{
+		const EntityID entity = scene.make_entity();
+		scene.assign_component<TestHealthComponent>(entity)->health = i;
+		scene.assign_component<TestTagComponent>(entity);
+	}
+
+	EntityCommandBuffer* const command_buffer = scene.get_entity_command_buffer();
+	for (EntityID entity : SceneView<TestHealthComponent>(scene))
+	{
+		if (scene.get_component<TestHealthComponent>(entity)->health % 2 == 0)
+		{
+			command_buffer->destroy_entity(entity);
+			// Duplicate destroys should be ignored on playback
+			command_buffer->destroy_entity(entity);
+		}
+		else
+		{
+			command_buffer->remove_component<TestTagComponent>(entity);
+		}
+	}
+
+	scene.flush_entity_commands();
+
+	uint32_t remaining = 0;
+	for (EntityID entity : SceneView<TestHealthComponent>(scene))
+	{
+		EXPECT_EQ(scene.get_component<TestHealthComponent>(entity)->health % 2, 1);
+		EXPECT_EQ(scene.get_component<TestTagComponent>(entity), nullptr);
+		++remaining;
+	}
+	EXPECT_EQ(remaining, 8);
+	EXPECT_EQ(scene.free_entities.size(), 8);
+}
+
+TEST(SunsetTests, EntityCommandBuffer_RecordFromMultipleThreads)
+{
+	Scene scene;
+
+	constexpr uint32_t num_threads = 4;
+	constexpr uint32_t entities_per_thread = 256;
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < num_threads; ++t)
+	{
+		threads.emplace_back([&scene, t]()
+		{
+			EntityCommandBuffer* const command_buffer = scene.get_entity_command_buffer();
+			for (uint32_t i = 0; i < entities_per_thread; ++i)
+			{
+				const EntityID entity = command_buffer->create_entity();
+				command_buffer->add_component(entity, TestTagComponent{ .tag = t });
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	scene.flush_entity_commands();
+
+	std::array<uint32_t, num_threads> per_thread_counts{};
+	for (EntityID entity : SceneView<TestTagComponent>(scene))
+	{
+		const uint32_t tag = scene.get_component<TestTagComponent>(entity)->tag;
+		ASSERT_LT(tag, num_threads);
+		++per_thread_counts[tag];
+	}
+	for (uint32_t count : per_thread_counts)
+	{
+		EXPECT_EQ(count, entities_per_thread);
+	}
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <core/layers/scene.h>
+
+using namespace Sunset;
+
+namespace
+{
+	struct TestPositionComponent
+	{
+		float x{ 0.0f };
+		float y{ 0.0f };
+	};
+
+	struct TestHealthComponent
+	{
+		int32_t health{ 100 };
+	};
+}
+
+TEST(SunsetTests, EntityPrefab_InstantiateCopiesPrototypes)
+{
+	Scene scene;
+
+	EntityPrefab<TestPositionComponent, TestHealthComponent> prefab;
+	prefab.get<TestHealthComponent>().health = 25;
+
+	std::vector<EntityID> spawned;
+	scene.instantiate(prefab, 64, spawned, [](uint32_t i, EntityID entity, TestPositionComponent& position, TestHealthComponent& health)
+	{
+		position.x = float(i);
+	});
+
+	ASSERT_EQ(spawned.size(), 64);
+	for (uint32_t i = 0; i < spawned.size(); ++i)
+	{
+		const TestPositionComponent* const position = scene.get_component<TestPositionComponent>(spawned[i]);
+		const TestHealthComponent* const health = scene.get_component<TestHealthComponent>(spawned[i]);
+		ASSERT_NE(position, nullptr);
+		ASSERT_NE(health, nullptr);
+		EXPECT_EQ(position->x, float(i));
+		EXPECT_EQ(health->health, 25);
+	}
+}
+
+TEST(SunsetTests, EntityPrefab_InstantiateReusesFreeEntities)
+{
+	Scene scene;
+
+	std::vector<EntityID> spawned;
+	scene.make_entities(16, spawned);
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		scene.destroy_entity(spawned[i]);
+	}
+
+	std::vector<EntityID> respawned;
+	scene.instantiate(EntityPrefab<TestHealthComponent>(), 12, respawned);
+
+	EXPECT_EQ(scene.entities.size(), 20);
+	EXPECT_TRUE(scene.free_entities.empty());
+
+	uint32_t alive_with_health = 0;
+	for (EntityID entity : SceneView<TestHealthComponent>(scene))
+	{
+		++alive_with_health;
+	}
+	EXPECT_EQ(alive_with_health, 12);
+}
+
+TEST(SunsetTests, EntityPrefab_InstantiatePastMinimumEntities)
+{
+	Scene scene;
+
+	const uint32_t spawn_count = MIN_ENTITIES * 2 + 1;
+
+	std::vector<EntityID> spawned;
+	scene.instantiate(EntityPrefab<TestHealthComponent>(TestHealthComponent{ .health = 7 }), spawn_count, spawned);
+
+	ASSERT_EQ(spawned.size(), spawn_count);
+	EXPECT_EQ(scene.get_component<TestHealthComponent>(spawned.back())->health, 7);
+
+	// Single entity path should keep working once pools have grown
+	const EntityID extra = scene.make_entity();
+	EXPECT_NE(scene.assign_component<TestHealthComponent>(extra), nullptr);
+}
+
+TEST(SunsetTests, EntityPrefab_ComponentsKeepAddressWhenPoolsGrow)
+{
+	Scene scene;
+
+	const EntityID first = scene.make_entity();
+	TestHealthComponent* const first_health = scene.assign_component<TestHealthComponent>(first);
+	first_health->health = 3;
+
+	// Assigning one by one past the first pool chunk grows the pool on demand
+	std::vector<EntityID> entities;
+	for (uint32_t i = 0; i < MIN_ENTITIES * 2; ++i)
+	{
+		entities.push_back(scene.make_entity());
+		scene.assign_component<TestHealthComponent>(entities.back());
+	}
+
+	EXPECT_EQ(scene.get_component<TestHealthComponent>(first), first_health);
+	EXPECT_EQ(first_health->health, 3);
+	EXPECT_EQ(scene.get_component<TestHealthComponent>(entities.back())->health, 100);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include <graphics/geometry_heap_allocator.h>
+
+#include <random>
+
+TEST(SunsetTests, GeometryHeapAllocatorBinsCoverEverySize)
+{
+	using Allocator = Sunset::GeometryHeapAllocator;
+
+	for (uint32_t size = 1; size < 100000; ++size)
+	{
+		const uint32_t bin = Allocator::size_to_bin_round_down(size);
+		ASSERT_LE(Allocator::bin_to_size(bin), size);
+		ASSERT_GT(Allocator::bin_to_size(bin + 1), size);
+		ASSERT_GE(Allocator::bin_to_size(Allocator::size_to_bin_round_up(size)), size);
+	}
+
+	EXPECT_LT(Allocator::size_to_bin_round_down(std::numeric_limits<uint32_t>::max()), Allocator::BIN_COUNT);
+}
+
+TEST(SunsetTests, GeometryHeapAllocatorAllocatesSequentially)
+{
+	Sunset::GeometryHeapAllocator allocator(1000);
+
+	const Sunset::GeometryHeapAllocation a = allocator.allocate(100);
+	const Sunset::GeometryHeapAllocation b = allocator.allocate(300);
+	const Sunset::GeometryHeapAllocation c = allocator.allocate(600);
+	ASSERT_TRUE(a.is_valid() && b.is_valid() && c.is_valid());
+	EXPECT_EQ(a.offset, 0);
+	EXPECT_EQ(b.offset, 100);
+	EXPECT_EQ(c.offset, 400);
+	EXPECT_EQ(allocator.get_used_size(), 1000);
+
+	EXPECT_FALSE(allocator.allocate(1).is_valid());
+	EXPECT_FALSE(allocator.allocate(0).is_valid());
+	EXPECT_FALSE(Sunset::GeometryHeapAllocator(0).allocate(1).is_valid());
+
+	const Sunset::GeometryHeapStats stats = allocator.get_stats();
+	EXPECT_EQ(stats.allocation_count, 3);
+	EXPECT_EQ(stats.free_region_count, 0);
+	EXPECT_EQ(stats.get_fragmentation(), 0.0f);
+}
+
+TEST(SunsetTests, GeometryHeapAllocatorMergesFreedNeighbors)
+{
+	Sunset::GeometryHeapAllocator allocator(1000);
+
+	const Sunset::GeometryHeapAllocation a = allocator.allocate(100);
+	const Sunset::GeometryHeapAllocation b = allocator.allocate(100);
+	const Sunset::GeometryHeapAllocation c = allocator.allocate(100);
+	const Sunset::GeometryHeapAllocation d = allocator.allocate(100);
+
+	allocator.free(a);
+	allocator.free(c);
+	// Two holes of 100 plus the tail of 600
+	EXPECT_EQ(allocator.get_stats().free_region_count, 3);
+	EXPECT_EQ(allocator.get_stats().largest_free_region, 600);
+
+	// Closing the gap between the holes merges them into one region
+	allocator.free(b);
+	EXPECT_EQ(allocator.get_stats().free_region_count, 2);
+	EXPECT_EQ(allocator.get_stats().largest_free_region, 600);
+
+	// 900 elements are free, but not in one piece
+	EXPECT_FALSE(allocator.allocate(700).is_valid());
+	const Sunset::GeometryHeapAllocation e = allocator.allocate(600);
+	EXPECT_EQ(e.offset, 400);
+
+	allocator.free(d);
+	allocator.free(e);
+	const Sunset::GeometryHeapStats stats = allocator.get_stats();
+	EXPECT_EQ(stats.free_region_count, 1);
+	EXPECT_EQ(stats.largest_free_region, 1000);
+	EXPECT_EQ(stats.used_size, 0);
+	EXPECT_EQ(stats.allocation_count, 0);
+}
+
+TEST(SunsetTests, GeometryHeapAllocatorReportsFragmentation)
+{
+	Sunset::GeometryHeapAllocator allocator(800);
+
+	std::vector<Sunset::GeometryHeapAllocation> allocations;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		allocations.push_back(allocator.allocate(100));
+	}
+
+	for (uint32_t i = 0; i < 8; i += 2)
+	{
+		allocator.free(allocations[i]);
+	}
+
+	// Half the heap is free, but only in 100 element holes
+	const Sunset::GeometryHeapStats stats = allocator.get_stats();
+	EXPECT_EQ(stats.get_free_size(), 400);
+	EXPECT_EQ(stats.free_region_count, 4);
+	EXPECT_EQ(stats.largest_free_region, 100);
+	EXPECT_FLOAT_EQ(stats.get_fragmentation(), 0.75f);
+	EXPECT_FALSE(allocator.allocate(200).is_valid());
+}
+
+TEST(SunsetTests, GeometryHeapAllocatorDefragmentPacksAllocations)
+{
+	Sunset::GeometryHeapAllocator allocator(800);
+
+	std::vector<Sunset::GeometryHeapAllocation> allocations;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		allocations.push_back(allocator.allocate(100));
+	}
+
+	for (uint32_t i = 0; i < 8; i += 2)
+	{
+		allocator.free(allocations[i]);
+	}
+
+	std::vector<Sunset::GeometryHeapMove> moves;
+	allocator.defragment(moves);
+
+	ASSERT_EQ(moves.size(), 4);
+	for (uint32_t i = 0; i < moves.size(); ++i)
+	{
+		const Sunset::GeometryHeapAllocation& moved = allocations[i * 2 + 1];
+		EXPECT_EQ(moves[i].node, moved.node);
+		EXPECT_EQ(moves[i].src_offset, moved.offset);
+		EXPECT_EQ(moves[i].dst_offset, i * 100);
+		EXPECT_EQ(moves[i].size, 100);
+		EXPECT_EQ(allocator.get_offset(moved.node), i * 100);
+	}
+
+	const Sunset::GeometryHeapStats stats = allocator.get_stats();
+	EXPECT_EQ(stats.free_region_count, 1);
+	EXPECT_EQ(stats.largest_free_region, 400);
+	EXPECT_EQ(stats.get_fragmentation(), 0.0f);
+
+	const Sunset::GeometryHeapAllocation packed = allocator.allocate(400);
+	EXPECT_EQ(packed.offset, 400);
+
+	// Already packed, nothing to move
+	allocator.free(packed);
+	allocator.defragment(moves);
+	EXPECT_TRUE(moves.empty());
+
+	// Freeing still merges with neighbors after the relocation
+	for (uint32_t i = 1; i < 8; i += 2)
+	{
+		Sunset::GeometryHeapAllocation moved = allocations[i];
+		moved.offset = allocator.get_offset(moved.node);
+		allocator.free(moved);
+	}
+	EXPECT_EQ(allocator.get_stats().free_region_count, 1);
+	EXPECT_EQ(allocator.allocate(800).offset, 0);
+}
+
+TEST(SunsetTests, GeometryHeapAllocatorSurvivesRandomChurn)
+{
+	constexpr uint32_t capacity = 1 << 16;
+	Sunset::GeometryHeapAllocator allocator(capacity);
+
+	std::mt19937 rng(1234);
+	std::vector<Sunset::GeometryHeapAllocation> live;
+	std::vector<uint8_t> owners(capacity, 0);
+
+	const auto check_consistent = [&]()
+	{
+		uint32_t live_size{ 0 };
+		for (const Sunset::GeometryHeapAllocation& allocation : live)
+		{
+			live_size += allocation.size;
+		}
+		const Sunset::GeometryHeapStats stats = allocator.get_stats();
+		EXPECT_EQ(stats.used_size, live_size);
+		EXPECT_EQ(stats.allocation_count, live.size());
+		EXPECT_LE(stats.largest_free_region, stats.get_free_size());
+	};
+
+	for (uint32_t step = 0; step < 20000; ++step)
+	{
+		if (live.empty() || rng() % 3 != 0)
+		{
+			const uint32_t size = 1 + rng() % 700;
+			const Sunset::GeometryHeapAllocation allocation = allocator.allocate(size);
+			if (!allocation.is_valid())
+			{
+				// Failing is only allowed when no single free region fits
+				EXPECT_LT(allocator.get_stats().largest_free_region, size);
+				continue;
+			}
+
+			ASSERT_LE(allocation.offset + allocation.size, capacity);
+			for (uint32_t i = allocation.offset; i < allocation.offset + allocation.size; ++i)
+			{
+				// Overlapping a live allocation
+				ASSERT_EQ(owners[i], 0);
+				owners[i] = 1;
+			}
+			live.push_back(allocation);
+		}
+		else
+		{
+			const uint32_t index = rng() % live.size();
+			const Sunset::GeometryHeapAllocation allocation = live[index];
+			std::fill(owners.begin() + allocation.offset, owners.begin() + allocation.offset + allocation.size, 0);
+			allocator.free(allocation);
+			live[index] = live.back();
+			live.pop_back();
+		}
+
+		if (step % 5000 == 4999)
+		{
+			std::vector<Sunset::GeometryHeapMove> moves;
+			allocator.defragment(moves);
+
+			for (Sunset::GeometryHeapAllocation& allocation : live)
+			{
+				allocation.offset = allocator.get_offset(allocation.node);
+			}
+			std::fill(owners.begin(), owners.end(), 0);
+			std::fill(owners.begin(), owners.begin() + allocator.get_used_size(), 1);
+
+			EXPECT_LE(allocator.get_stats().free_region_count, 1);
+		}
+
+		check_consistent();
+	}
+
+	for (const Sunset::GeometryHeapAllocation& allocation : live)
+	{
+		allocator.free(allocation);
+	}
+	EXPECT_EQ(allocator.get_stats().free_region_count, 1);
+	EXPECT_EQ(allocator.get_stats().largest_free_region, capacity);
+}
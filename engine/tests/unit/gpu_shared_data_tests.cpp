@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <graphics/gpu_shared_data_types.h>
+#include <graphics/resource/buffer.h>
+
+#include <cstring>
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	struct TestSharedData
+	{
+		uint32_t values[4]{ 0, 0, 0, 0 };
+	};
+
+	constexpr uint32_t TEST_SHARED_DATA_COUNT = 300;
+
+	using TestSharedDataShared = GPUSharedData<TestSharedData, TEST_SHARED_DATA_COUNT>;
+	using RecordingBuffer = GenericBuffer<NoopBuffer>;
+
+	void initialize_recording_buffer(RecordingBuffer& buffer)
+	{
+		buffer.initialize(nullptr, { .name = "test_shared_data", .buffer_size = sizeof(TestSharedData) * TEST_SHARED_DATA_COUNT, .type = BufferType::StorageBuffer });
+	}
+
+	bool buffer_matches(RecordingBuffer& buffer, TestSharedDataShared& shared_data)
+	{
+		return memcmp(buffer.get(), shared_data.data.data(), sizeof(TestSharedData) * TEST_SHARED_DATA_COUNT) == 0;
+	}
+}
+
+TEST(SunsetTests, GPUSharedData_CoalescesDirtyRanges)
+{
+	GPUSharedDataDirtyState dirty_state(TEST_SHARED_DATA_COUNT);
+	for (const uint32_t index : { 3, 4, 5, 10, 100, 101 })
+	{
+		dirty_state.mark_dirty(index, 0);
+	}
+
+	std::vector<GPUSharedDataRange> ranges;
+	dirty_state.consume_dirty_ranges(0, 0, ranges);
+
+	ASSERT_EQ(ranges.size(), 3);
+	EXPECT_EQ(ranges[0].first, 3);
+	EXPECT_EQ(ranges[0].count, 3);
+	EXPECT_EQ(ranges[1].first, 10);
+	EXPECT_EQ(ranges[1].count, 1);
+	EXPECT_EQ(ranges[2].first, 100);
+	EXPECT_EQ(ranges[2].count, 2);
+
+	// Consuming clears the frame's dirty elements
+	dirty_state.consume_dirty_ranges(0, 0, ranges);
+	EXPECT_TRUE(ranges.empty());
+}
+
+TEST(SunsetTests, GPUSharedData_MergesRangesWithinGap)
+{
+	GPUSharedDataDirtyState dirty_state(TEST_SHARED_DATA_COUNT);
+	for (const uint32_t index : { 3, 4, 5, 10, 100, 101 })
+	{
+		dirty_state.mark_dirty(index, 0);
+	}
+
+	std::vector<GPUSharedDataRange> ranges;
+	dirty_state.consume_dirty_ranges(0, 4, ranges);
+
+	ASSERT_EQ(ranges.size(), 2);
+	EXPECT_EQ(ranges[0].first, 3);
+	EXPECT_EQ(ranges[0].count, 8);
+	EXPECT_EQ(ranges[1].first, 100);
+	EXPECT_EQ(ranges[1].count, 2);
+}
+
+TEST(SunsetTests, GPUSharedData_RangesSpanDirtyWords)
+{
+	GPUSharedDataDirtyState dirty_state(TEST_SHARED_DATA_COUNT);
+	for (uint32_t index = 60; index < 200; ++index)
+	{
+		dirty_state.mark_dirty(index, 1);
+	}
+	dirty_state.mark_dirty(TEST_SHARED_DATA_COUNT - 1, 1);
+
+	std::vector<GPUSharedDataRange> ranges;
+	dirty_state.consume_dirty_ranges(1, 0, ranges);
+
+	ASSERT_EQ(ranges.size(), 2);
+	EXPECT_EQ(ranges[0].first, 60);
+	EXPECT_EQ(ranges[0].count, 140);
+	EXPECT_EQ(ranges[1].first, TEST_SHARED_DATA_COUNT - 1);
+	EXPECT_EQ(ranges[1].count, 1);
+}
+
+TEST(SunsetTests, GPUSharedData_DirtyStatePerBufferedFrame)
+{
+	GPUSharedDataDirtyState dirty_state(TEST_SHARED_DATA_COUNT);
+	dirty_state.mark_dirty(7);
+	dirty_state.mark_dirty(8, 0);
+
+	std::vector<GPUSharedDataRange> ranges;
+	dirty_state.consume_dirty_ranges(0, 0, ranges);
+	ASSERT_EQ(ranges.size(), 1);
+	EXPECT_EQ(ranges[0].first, 7);
+	EXPECT_EQ(ranges[0].count, 2);
+
+	// Other frames keep elements marked for every frame until they upload themselves
+	for (uint32_t frame = 1; frame < MAX_BUFFERED_FRAMES; ++frame)
+	{
+		EXPECT_TRUE(dirty_state.is_dirty(7, frame));
+		EXPECT_FALSE(dirty_state.is_dirty(8, frame));
+	}
+}
+
+TEST(SunsetTests, GPUSharedData_UploadsKeepEveryFrameBufferCurrent)
+{
+	TestSharedDataShared shared_data;
+	RecordingBuffer buffers[MAX_BUFFERED_FRAMES];
+	for (RecordingBuffer& buffer : buffers)
+	{
+		initialize_recording_buffer(buffer);
+	}
+
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<uint32_t> index_dist(0, TEST_SHARED_DATA_COUNT - 1);
+
+	for (uint32_t frame = 0; frame < 32; ++frame)
+	{
+		const uint32_t buffered_frame = frame % MAX_BUFFERED_FRAMES;
+
+		for (uint32_t write = 0; write < 12; ++write)
+		{
+			const uint32_t index = index_dist(rng);
+			shared_data[index].values[write % 4] = frame * 100 + write + 1;
+			shared_data.mark_dirty(index);
+		}
+
+		shared_data.upload(nullptr, &buffers[buffered_frame], buffered_frame, frame % 3);
+
+		// Writes made while other frames uploaded must still have reached this frame's buffer
+		EXPECT_TRUE(buffer_matches(buffers[buffered_frame], shared_data));
+	}
+}
+
+TEST(SunsetTests, GPUSharedData_UploadReportsBytes)
+{
+	TestSharedDataShared shared_data;
+	RecordingBuffer buffer;
+	initialize_recording_buffer(buffer);
+
+	for (const uint32_t index : { 0, 1, 2, 50, 52 })
+	{
+		shared_data[index].values[0] = index + 1;
+		shared_data.mark_dirty(index, 0);
+	}
+
+	GPUSharedDataUploadStats stats = shared_data.upload(nullptr, &buffer, 0, 0);
+	EXPECT_EQ(stats.range_count, 3);
+	EXPECT_EQ(stats.uploaded_bytes, 5 * sizeof(TestSharedData));
+	EXPECT_TRUE(buffer_matches(buffer, shared_data));
+
+	// The gap between 50 and 52 is copied too when merged
+	for (const uint32_t index : { 50, 52 })
+	{
+		shared_data[index].values[1] = index;
+		shared_data.mark_dirty(index, 0);
+	}
+	stats = shared_data.upload(nullptr, &buffer, 0, 1);
+	EXPECT_EQ(stats.range_count, 1);
+	EXPECT_EQ(stats.uploaded_bytes, 3 * sizeof(TestSharedData));
+	EXPECT_EQ(shared_data.upload_stats[0].uploaded_bytes, stats.uploaded_bytes);
+
+	// Nothing written means nothing copied
+	stats = shared_data.upload(nullptr, &buffer, 0, 0);
+	EXPECT_EQ(stats.range_count, 0);
+	EXPECT_EQ(stats.uploaded_bytes, 0);
+	EXPECT_TRUE(buffer_matches(buffer, shared_data));
+}
@@ -6,6 +6,18 @@
 
 using namespace Sunset;
 
+// Starts the scheduler's worker threads before any test runs, so code paths that queue jobs have something to run them
+class JobSchedulerEnvironment : public ::testing::Environment
+{
+public:
+	void SetUp() override
+	{
+		JobScheduler::get()->initialize();
+	}
+};
+
+static ::testing::Environment* const job_scheduler_environment = ::testing::AddGlobalTestEnvironment(new JobSchedulerEnvironment);
+
 class SchedulerTestMethods
 {
 public:
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <graphics/mesh_render_task.h>
+#include <graphics/mesh_task_queue.h>
+
+using namespace Sunset;
+
+namespace
+{
+	// Tasks already in the order sort_and_batch leaves them in for material agnostic batching
+	std::vector<MeshRenderTask> make_sorted_tasks(uint32_t resource_state_count, uint32_t materials_per_resource_state, uint32_t instances_per_material)
+	{
+		std::vector<MeshRenderTask> tasks;
+		for (uint32_t r = 0; r < resource_state_count; ++r)
+		{
+			for (uint32_t m = 0; m < materials_per_resource_state; ++m)
+			{
+				for (uint32_t i = 0; i < instances_per_material; ++i)
+				{
+					MeshRenderTask& task = tasks.emplace_back();
+					task.setup(100 + m, 1 + r, i);
+					task.set_entity(tasks.size());
+				}
+			}
+		}
+		return tasks;
+	}
+
+	std::vector<MeshRenderTask*> get_task_pointers(std::vector<MeshRenderTask>& tasks)
+	{
+		std::vector<MeshRenderTask*> task_pointers;
+		for (MeshRenderTask& task : tasks)
+		{
+			task_pointers.push_back(&task);
+		}
+		return task_pointers;
+	}
+}
+
+TEST(SunsetTests, MeshBatching_MaterialAgnosticCollapsesMaterialVariants)
+{
+	std::vector<MeshRenderTask> tasks = make_sorted_tasks(3, 16, 4);
+	const std::vector<MeshRenderTask*> task_pointers = get_task_pointers(tasks);
+
+	std::vector<IndirectDrawBatch> batches;
+	MeshBatchingStats stats;
+	MeshTaskQueue::assign_sort_keys(task_pointers, true);
+	MeshTaskQueue::batch_tasks(task_pointers, true, batches, stats);
+
+	EXPECT_EQ(stats.task_count, 3 * 16 * 4);
+	EXPECT_EQ(stats.material_batch_count, 3 * 16);
+	EXPECT_EQ(stats.batch_count, 3);
+	ASSERT_EQ(batches.size(), 3);
+
+	uint32_t expected_first = 0;
+	for (uint32_t i = 0; i < batches.size(); ++i)
+	{
+		EXPECT_EQ(batches[i].resource_state, i + 1);
+		EXPECT_EQ(batches[i].first, expected_first);
+		EXPECT_EQ(batches[i].count, 16 * 4);
+		expected_first += batches[i].count;
+	}
+}
+
+TEST(SunsetTests, MeshBatching_MaterialChangesSplitWhenDisabled)
+{
+	std::vector<MeshRenderTask> tasks = make_sorted_tasks(3, 16, 4);
+	const std::vector<MeshRenderTask*> task_pointers = get_task_pointers(tasks);
+
+	std::vector<IndirectDrawBatch> batches;
+	MeshBatchingStats stats;
+	MeshTaskQueue::assign_sort_keys(task_pointers, false);
+	MeshTaskQueue::batch_tasks(task_pointers, false, batches, stats);
+
+	EXPECT_EQ(stats.material_batch_count, 3 * 16);
+	EXPECT_EQ(stats.batch_count, 3 * 16);
+	ASSERT_EQ(batches.size(), 3 * 16);
+	for (const IndirectDrawBatch& batch : batches)
+	{
+		EXPECT_EQ(batch.count, 4);
+		for (uint32_t i = batch.first; i < batch.first + batch.count; ++i)
+		{
+			EXPECT_EQ(task_pointers[i]->material, batch.material);
+			EXPECT_EQ(task_pointers[i]->resource_state, batch.resource_state);
+		}
+	}
+}
+
+TEST(SunsetTests, MeshBatching_ResourceStateChangesAlwaysSplit)
+{
+	// Alternating meshes with a shared material can't be merged, batching only looks at neighbouring tasks
+	std::vector<MeshRenderTask> tasks(6);
+	for (uint32_t i = 0; i < tasks.size(); ++i)
+	{
+		tasks[i].setup(7, 1 + i % 2, 0);
+	}
+	const std::vector<MeshRenderTask*> task_pointers = get_task_pointers(tasks);
+
+	std::vector<IndirectDrawBatch> batches;
+	MeshBatchingStats stats;
+	MeshTaskQueue::assign_sort_keys(task_pointers, true);
+	MeshTaskQueue::batch_tasks(task_pointers, true, batches, stats);
+	EXPECT_EQ(stats.batch_count, 6);
+
+	MeshTaskQueue::batch_tasks({}, true, batches, stats);
+	EXPECT_TRUE(batches.empty());
+	EXPECT_EQ(stats.task_count, 0);
+	EXPECT_EQ(stats.batch_count, 0);
+}
+
+TEST(SunsetTests, MeshBatching_SortKeysOrderTasks)
+{
+	// Submitted out of order, with two materials on each of two meshes
+	std::vector<MeshRenderTask> tasks(8);
+	const uint32_t materials[] = { 5, 6, 5, 6, 6, 5, 6, 5 };
+	const uint32_t resource_states[] = { 1, 2, 2, 1, 2, 1, 1, 2 };
+	for (uint32_t i = 0; i < tasks.size(); ++i)
+	{
+		tasks[i].setup(materials[i], resource_states[i], 8 - i);
+	}
+	const std::vector<MeshRenderTask*> task_pointers = get_task_pointers(tasks);
+
+	for (const bool b_material_agnostic : { true, false })
+	{
+		MeshTaskQueue::assign_sort_keys(task_pointers, b_material_agnostic);
+
+		std::vector<SortKeyIndex> items;
+		for (uint32_t i = 0; i < task_pointers.size(); ++i)
+		{
+			items.push_back({ .key = task_pointers[i]->sort_key, .index = i });
+		}
+		std::vector<SortKeyIndex> scratch;
+		RadixSort::sort(items, scratch);
+
+		std::vector<MeshRenderTask*> sorted_tasks;
+		for (const SortKeyIndex& item : items)
+		{
+			sorted_tasks.push_back(task_pointers[item.index]);
+		}
+
+		std::vector<IndirectDrawBatch> batches;
+		MeshBatchingStats stats;
+		MeshTaskQueue::batch_tasks(sorted_tasks, b_material_agnostic, batches, stats);
+
+		EXPECT_EQ(stats.material_batch_count, 4);
+		EXPECT_EQ(stats.batch_count, b_material_agnostic ? 2 : 4);
+		for (uint32_t i = 1; i < items.size(); ++i)
+		{
+			const MeshRenderTask* const previous = sorted_tasks[i - 1];
+			const MeshRenderTask* const current = sorted_tasks[i];
+			// Tasks sharing a resource state and material stay in submission order
+			if (previous->resource_state == current->resource_state && previous->material == current->material)
+			{
+				EXPECT_LT(items[i - 1].index, items[i].index);
+			}
+		}
+	}
+}
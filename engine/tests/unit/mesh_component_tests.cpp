@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <core/ecs/components/mesh_component.h>
+#include <core/layers/scene.h>
+
+using namespace Sunset;
+
+namespace
+{
+	void spill_sections(MeshComponent& mesh_comp, uint32_t section_count)
+	{
+		mesh_comp.section_count = section_count;
+		mesh_comp.spilled_sections = MeshSectionPool::get()->allocate(section_count);
+	}
+}
+
+TEST(SunsetTests, MeshComponent_InlineSections)
+{
+	MeshComponent mesh_comp;
+	mesh_comp.section_count = MESH_INLINE_SECTIONS;
+
+	set_material(&mesh_comp, 7);
+	set_material(&mesh_comp, 9, 2);
+
+	EXPECT_EQ(mesh_comp.spilled_sections, -1);
+	EXPECT_EQ(mesh_materials(&mesh_comp), mesh_comp.inline_materials.data());
+	EXPECT_EQ(mesh_materials(&mesh_comp)[0], 7);
+	EXPECT_EQ(mesh_materials(&mesh_comp)[2], 9);
+	EXPECT_LE(sizeof(MeshComponent), 128);
+}
+
+TEST(SunsetTests, MeshComponent_SpilledSectionsCopyAndMove)
+{
+	MeshComponent mesh_comp;
+	spill_sections(mesh_comp, 12);
+
+	set_material(&mesh_comp, 3);
+	set_material(&mesh_comp, 5, 11);
+	mesh_resource_states(&mesh_comp)[10] = 42;
+
+	MeshComponent copied = mesh_comp;
+	EXPECT_NE(copied.spilled_sections, mesh_comp.spilled_sections);
+	EXPECT_EQ(mesh_materials(&copied)[0], 3);
+	EXPECT_EQ(mesh_materials(&copied)[11], 5);
+	EXPECT_EQ(mesh_resource_states(&copied)[10], 42);
+
+	set_material(&copied, 8, 11);
+	EXPECT_EQ(mesh_materials(&mesh_comp)[11], 5);
+
+	const int32_t span = mesh_comp.spilled_sections;
+	MeshComponent moved = std::move(mesh_comp);
+	EXPECT_EQ(moved.spilled_sections, span);
+	EXPECT_EQ(mesh_comp.spilled_sections, -1);
+	EXPECT_EQ(mesh_materials(&moved)[11], 5);
+}
+
+TEST(SunsetTests, MeshComponent_ReleasedSpansAreReused)
+{
+	MeshSectionPool* const section_pool = MeshSectionPool::get();
+
+	int32_t span = -1;
+	{
+		MeshComponent mesh_comp;
+		spill_sections(mesh_comp, 20);
+		set_material(&mesh_comp, 1);
+		span = mesh_comp.spilled_sections;
+	}
+
+	const size_t pool_size = section_pool->get_allocated_section_count();
+
+	MeshComponent mesh_comp;
+	spill_sections(mesh_comp, 24);
+	EXPECT_EQ(mesh_comp.spilled_sections, span);
+	EXPECT_EQ(section_pool->get_allocated_section_count(), pool_size);
+	EXPECT_EQ(mesh_materials(&mesh_comp)[19], 0);
+}
+
+TEST(SunsetTests, MeshComponent_SpansStayInPlaceWhenPoolGrows)
+{
+	MeshComponent mesh_comp;
+	spill_sections(mesh_comp, 8);
+	set_material(&mesh_comp, 6);
+	const MaterialID* const materials = mesh_materials(&mesh_comp);
+
+	// Enough spans to need several more pool chunks
+	std::vector<MeshComponent> others(2 * MESH_SECTION_POOL_CHUNK_SIZE / 8);
+	for (MeshComponent& other : others)
+	{
+		spill_sections(other, 8);
+	}
+
+	EXPECT_EQ(mesh_materials(&mesh_comp), materials);
+	EXPECT_EQ(materials[7], 6);
+}
+
+TEST(SunsetTests, MeshComponent_DestroyEntityReleasesSpans)
+{
+	Scene scene;
+
+	const EntityID entity = scene.make_entity();
+	MeshComponent* const mesh_comp = scene.assign_component<MeshComponent>(entity);
+	spill_sections(*mesh_comp, 40);
+	const int32_t span = mesh_comp->spilled_sections;
+
+	scene.destroy_entity(entity);
+
+	MeshComponent reused;
+	spill_sections(reused, 40);
+	EXPECT_EQ(reused.spilled_sections, span);
+}
@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+#include <graphics/mesh_draw_list.h>
+#include <graphics/mesh_task_queue.h>
+
+using namespace Sunset;
+
+namespace
+{
+	EntityID make_entity(uint32_t index, uint32_t version = 0)
+	{
+		return (static_cast<EntityID>(index) << 32) | version;
+	}
+
+	// One draw per section, with materials and resource states spread so entities interleave in sort order
+	void set_test_entity_draws(MeshDrawList& draw_list, EntityID entity, uint32_t revision, uint32_t section_count, uint32_t material_offset = 0)
+	{
+		std::vector<MeshDrawDesc> draws;
+		for (uint32_t s = 0; s < section_count; ++s)
+		{
+			const uint32_t entity_index = get_entity_index(entity);
+			draws.push_back({
+				.material = 100 + (entity_index + s + material_offset) % 7,
+				.material_index = s,
+				.resource_state = 1 + (entity_index + s) % 3
+			});
+		}
+		draw_list.set_entity_draws(entity, revision, draws.data(), section_count);
+	}
+
+	bool is_sorted_by_key(const MeshDrawList& draw_list)
+	{
+		const std::vector<uint32_t>& slots = draw_list.get_sorted_slots();
+		for (size_t i = 1; i < slots.size(); ++i)
+		{
+			if (draw_list.get_draw(slots[i - 1]).sort_key > draw_list.get_draw(slots[i]).sort_key)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void report_all_visible(MeshDrawList& draw_list, uint32_t entity_count)
+	{
+		draw_list.begin_frame();
+		for (uint32_t e = 0; e < entity_count; ++e)
+		{
+			draw_list.set_entity_visible(make_entity(e), true);
+		}
+	}
+}
+
+TEST(SunsetTests, MeshDrawList_RetainsDrawsInSortedOrder)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 32; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 2);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(queue, true);
+
+	EXPECT_EQ(draw_list.size(), 64);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), 64);
+	EXPECT_EQ(queue.get_queue_size(), 64);
+	EXPECT_TRUE(is_sorted_by_key(draw_list));
+	EXPECT_EQ(draw_list.get_stats().patched_draw_count, 64);
+	EXPECT_TRUE(draw_list.get_stats().b_resorted);
+}
+
+TEST(SunsetTests, MeshDrawList_StaticFrameSkipsResort)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue first_queue;
+	MeshTaskQueue second_queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 16; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 1);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(first_queue, true);
+
+	for (uint32_t e = 0; e < 16; ++e)
+	{
+		EXPECT_TRUE(draw_list.is_entity_current(make_entity(e), 1));
+		EXPECT_FALSE(draw_list.is_entity_current(make_entity(e), 2));
+	}
+
+	report_all_visible(draw_list, 16);
+	draw_list.submit(second_queue, true);
+
+	EXPECT_EQ(second_queue.get_queue_size(), 16);
+	EXPECT_EQ(draw_list.get_stats().patched_draw_count, 0);
+	EXPECT_FALSE(draw_list.get_stats().b_resorted);
+}
+
+TEST(SunsetTests, MeshDrawList_PatchedDrawsMergeIntoOrder)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 64; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 2);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(queue, false);
+
+	// Swap materials on a few entities and change the section count on another
+	report_all_visible(draw_list, 64);
+	set_test_entity_draws(draw_list, make_entity(3), 2, 2, 4);
+	set_test_entity_draws(draw_list, make_entity(40), 2, 2, 5);
+	set_test_entity_draws(draw_list, make_entity(41), 2, 3);
+	draw_list.submit(queue, false);
+
+	EXPECT_EQ(draw_list.size(), 64 * 2 + 1);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), 64 * 2 + 1);
+	EXPECT_EQ(draw_list.get_stats().patched_draw_count, 7);
+	EXPECT_TRUE(is_sorted_by_key(draw_list));
+	EXPECT_TRUE(draw_list.is_entity_current(make_entity(41), 2));
+}
+
+TEST(SunsetTests, MeshDrawList_CulledEntitiesKeepDraws)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue first_queue;
+	MeshTaskQueue second_queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 10; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 1);
+		draw_list.set_entity_visible(make_entity(e), e % 2 == 0);
+	}
+	draw_list.submit(first_queue, true);
+
+	EXPECT_EQ(first_queue.get_queue_size(), 5);
+	EXPECT_EQ(draw_list.size(), 10);
+
+	// Culled entities come back without rewriting their draws
+	report_all_visible(draw_list, 10);
+	draw_list.submit(second_queue, true);
+
+	EXPECT_EQ(second_queue.get_queue_size(), 10);
+	EXPECT_EQ(draw_list.get_stats().patched_draw_count, 0);
+}
+
+TEST(SunsetTests, MeshDrawList_DropsAbsentEntities)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 8; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 2);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(queue, true);
+
+	// Entity 5 is destroyed, so it is never reported again
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 8; ++e)
+	{
+		if (e != 5)
+		{
+			draw_list.set_entity_visible(make_entity(e), true);
+		}
+	}
+	draw_list.submit(queue, true);
+
+	EXPECT_EQ(draw_list.size(), 7 * 2);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), 7 * 2);
+	EXPECT_FALSE(draw_list.is_entity_current(make_entity(5), 1));
+	for (const uint32_t slot : draw_list.get_sorted_slots())
+	{
+		EXPECT_NE(draw_list.get_draw(slot).entity, 5);
+	}
+
+	// A new entity reusing the index gets a fresh record and reuses the released slots
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 8; ++e)
+	{
+		if (e == 5)
+		{
+			EXPECT_FALSE(draw_list.is_entity_current(make_entity(5, 1), 1));
+			set_test_entity_draws(draw_list, make_entity(5, 1), 1, 2);
+		}
+		draw_list.set_entity_visible(make_entity(e, e == 5 ? 1 : 0), true);
+	}
+	draw_list.submit(queue, true);
+
+	EXPECT_EQ(draw_list.size(), 8 * 2);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), 8 * 2);
+	EXPECT_TRUE(is_sorted_by_key(draw_list));
+}
+
+TEST(SunsetTests, MeshDrawList_IncrementalOrderMatchesFullSort)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue queue;
+
+	const uint32_t entity_count = 200;
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < entity_count; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 1 + e % 3);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(queue, false);
+
+	for (uint32_t frame = 0; frame < 5; ++frame)
+	{
+		report_all_visible(draw_list, entity_count);
+		for (uint32_t e = frame; e < entity_count; e += 17)
+		{
+			set_test_entity_draws(draw_list, make_entity(e), 2 + frame, 1 + (e + frame) % 3, frame);
+		}
+		draw_list.submit(queue, false);
+	}
+
+	// Resorting every live draw from scratch must land on the same order the merges produced
+	std::vector<uint32_t> full_sort = draw_list.get_sorted_slots();
+	std::sort(full_sort.begin(), full_sort.end(), [&draw_list](uint32_t first, uint32_t second)
+	{
+		return std::make_pair(draw_list.get_draw(first).sort_key, first) < std::make_pair(draw_list.get_draw(second).sort_key, second);
+	});
+
+	EXPECT_EQ(draw_list.get_sorted_slots(), full_sort);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), draw_list.size());
+}
+
+TEST(SunsetTests, MeshDrawList_BatchingModeChangeRekeys)
+{
+	MeshDrawList draw_list;
+	MeshTaskQueue queue;
+
+	draw_list.begin_frame();
+	for (uint32_t e = 0; e < 32; ++e)
+	{
+		set_test_entity_draws(draw_list, make_entity(e), 1, 2);
+		draw_list.set_entity_visible(make_entity(e), true);
+	}
+	draw_list.submit(queue, true);
+
+	report_all_visible(draw_list, 32);
+	draw_list.submit(queue, false);
+
+	EXPECT_TRUE(draw_list.get_stats().b_resorted);
+	EXPECT_TRUE(is_sorted_by_key(draw_list));
+
+	// Material sorted keys keep draws of the same material contiguous within a resource state
+	const std::vector<uint32_t>& slots = draw_list.get_sorted_slots();
+	for (size_t i = 1; i < slots.size(); ++i)
+	{
+		const MeshRenderTask& previous = draw_list.get_draw(slots[i - 1]);
+		const MeshRenderTask& current = draw_list.get_draw(slots[i]);
+		if (previous.sort_key == current.sort_key)
+		{
+			EXPECT_EQ(previous.material, current.material);
+			EXPECT_EQ(previous.resource_state, current.resource_state);
+		}
+	}
+}
+
+TEST(SunsetTests, MeshDrawList_SortKeyRanksShrinkWithMaterialChurn)
+{
+	MeshDrawList draw_list;
+
+	constexpr uint32_t entity_count = 8;
+	for (uint32_t frame = 0; frame < 1000; ++frame)
+	{
+		// Every frame rewrites each entity with a material that was never seen before
+		draw_list.begin_frame();
+		for (uint32_t e = 0; e < entity_count; ++e)
+		{
+			const MeshDrawDesc draw{ .material = static_cast<MaterialID>(1000 + frame * entity_count + e), .resource_state = 1 + e % 3 };
+			draw_list.set_entity_draws(make_entity(e), frame + 1, &draw, 1);
+			draw_list.set_entity_visible(make_entity(e), true);
+		}
+		MeshTaskQueue queue;
+		draw_list.submit(queue, true);
+
+		ASSERT_LE(draw_list.get_sort_key_ranks().materials.size(), draw_list.size() + MESH_DRAW_LIST_RANK_SLACK);
+		ASSERT_TRUE(is_sorted_by_key(draw_list));
+	}
+
+	EXPECT_EQ(draw_list.size(), entity_count);
+	EXPECT_EQ(draw_list.get_sorted_slots().size(), entity_count);
+}
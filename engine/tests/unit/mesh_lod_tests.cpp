@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <graphics/resource/mesh_lod.h>
+
+using namespace Sunset;
+
+namespace
+{
+	// LOD 1 below a tenth of the screen, LOD 2 below a twentieth, LOD 3 below a fortieth
+	const float lod_screen_sizes[] = { 1.0f, 0.1f, 0.05f, 0.025f };
+	constexpr uint32_t lod_count = 4;
+}
+
+TEST(SunsetTests, MeshLOD_SelectsFromScreenSize)
+{
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.5f, 0, 0.0f), 0);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.07f, 0, 0.0f), 1);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.03f, 0, 0.0f), 2);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.001f, 0, 0.0f), 3);
+
+	// The starting LOD doesn't matter without hysteresis
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.5f, 3, 0.0f), 0);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.07f, 3, 0.0f), 1);
+
+	// Single LOD meshes and out of range current LODs
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, 1, 0.001f, 0, 0.0f), 0);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.001f, 12, 0.0f), 3);
+}
+
+TEST(SunsetTests, MeshLOD_HysteresisHoldsCurrentLOD)
+{
+	const float hysteresis = 0.1f;
+
+	// Just under the LOD 1 switch point, but not by enough to leave LOD 0
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.095f, 0, hysteresis), 0);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.085f, 0, hysteresis), 1);
+
+	// Just over it, but not by enough to return from LOD 1
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.105f, 1, hysteresis), 1);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.115f, 1, hysteresis), 0);
+
+	// Large jumps still cross several LODs at once
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.001f, 0, hysteresis), 3);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, 0.5f, 3, hysteresis), 0);
+}
+
+TEST(SunsetTests, MeshLOD_HysteresisDoesNotFlicker)
+{
+	const float hysteresis = 0.1f;
+
+	// Oscillating around a switch point should settle on one LOD
+	uint32_t lod = 0;
+	uint32_t lod_changes = 0;
+	for (int frame = 0; frame < 100; ++frame)
+	{
+		const float screen_size = frame % 2 == 0 ? 0.098f : 0.102f;
+		const uint32_t new_lod = select_mesh_lod(lod_screen_sizes, lod_count, screen_size, lod, hysteresis);
+		lod_changes += new_lod != lod;
+		lod = new_lod;
+	}
+	EXPECT_EQ(lod_changes, 0);
+	EXPECT_EQ(lod, 0);
+}
+
+TEST(SunsetTests, MeshLOD_ScreenSizeAndBias)
+{
+	// 90 degree vertical fov, so a sphere at distance d spans radius / d of the screen height
+	const MeshLODSelector selector = make_mesh_lod_selector(1.0f, 0.0f, 0.0f);
+	const glm::vec3 view_position(0.0f);
+
+	EXPECT_NEAR(compute_lod_screen_size(selector, view_position, glm::vec3(0.0f, 0.0f, 10.0f), 1.0f), 0.1f, 1e-6f);
+	EXPECT_NEAR(compute_lod_screen_size(selector, view_position, glm::vec3(0.0f, 0.0f, 40.0f), 1.0f), 0.025f, 1e-6f);
+
+	// Views inside the sphere always get the base LOD
+	const float inside_size = compute_lod_screen_size(selector, view_position, glm::vec3(0.5f, 0.0f, 0.0f), 1.0f);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, inside_size, 3, 0.1f), 0);
+
+	// Flipped projections produce the same sizes
+	const MeshLODSelector flipped_selector = make_mesh_lod_selector(-1.0f, 0.0f, 0.0f);
+	EXPECT_FLOAT_EQ(flipped_selector.screen_size_scale, selector.screen_size_scale);
+
+	// Each unit of positive bias halves the size, pushing the mesh one LOD coarser here
+	const glm::vec3 center(0.0f, 0.0f, 14.0f);
+	const MeshLODSelector biased_selector = make_mesh_lod_selector(1.0f, 1.0f, 0.0f);
+	const MeshLODSelector negative_biased_selector = make_mesh_lod_selector(1.0f, -1.0f, 0.0f);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, compute_lod_screen_size(selector, view_position, center, 1.0f), 0, 0.0f), 1);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, compute_lod_screen_size(biased_selector, view_position, center, 1.0f), 0, 0.0f), 2);
+	EXPECT_EQ(select_mesh_lod(lod_screen_sizes, lod_count, compute_lod_screen_size(negative_biased_selector, view_position, center, 1.0f), 0, 0.0f), 0);
+}
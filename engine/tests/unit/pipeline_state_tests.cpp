@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <graphics/pipeline_state.h>
+#include <graphics/pipeline_cache.h>
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+namespace
+{
+	Sunset::PipelineCacheDeviceInfo make_device_info(uint32_t vendor_id, uint32_t device_id, uint8_t uuid_seed)
+	{
+		Sunset::PipelineCacheDeviceInfo device_info{ .vendor_id = vendor_id, .device_id = device_id };
+		for (uint32_t i = 0; i < Sunset::PIPELINE_CACHE_UUID_SIZE; ++i)
+		{
+			device_info.cache_uuid[i] = static_cast<uint8_t>(uuid_seed + i);
+		}
+		return device_info;
+	}
+
+	// Cache data the way a driver would write it, a header followed by an opaque blob
+	std::vector<char> make_cache_data(const Sunset::PipelineCacheDeviceInfo& device_info, size_t blob_size = 64)
+	{
+		Sunset::PipelineCacheHeader header
+		{
+			.header_size = sizeof(Sunset::PipelineCacheHeader),
+			.header_version = Sunset::PIPELINE_CACHE_HEADER_VERSION,
+			.vendor_id = device_info.vendor_id,
+			.device_id = device_info.device_id
+		};
+		std::memcpy(header.cache_uuid, device_info.cache_uuid, Sunset::PIPELINE_CACHE_UUID_SIZE);
+
+		std::vector<char> data(sizeof(Sunset::PipelineCacheHeader) + blob_size, 'x');
+		std::memcpy(data.data(), &header, sizeof(Sunset::PipelineCacheHeader));
+		return data;
+	}
+
+	// Noop backend whose pipeline creation blocks until released, so the pending state can be observed
+	class GatedPipelineState : public Sunset::NoopPipelineState
+	{
+	public:
+		bool create(class Sunset::GraphicsContext* const gfx_context, Sunset::PipelineStateData* state_data)
+		{
+			while (!b_released.load(std::memory_order_acquire))
+			{
+				std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+			}
+			++create_count;
+			return b_create_result;
+		}
+
+		static inline std::atomic_bool b_released{ false };
+		static inline std::atomic_uint32_t create_count{ 0 };
+		static inline bool b_create_result{ true };
+	};
+}
+
+TEST(SunsetTests, PipelineCacheDataValidatesDeviceHeader)
+{
+	const Sunset::PipelineCacheDeviceInfo device_info = make_device_info(0x10de, 0x2684, 7);
+	const std::vector<char> data = make_cache_data(device_info);
+
+	EXPECT_TRUE(Sunset::is_pipeline_cache_data_valid(data, device_info));
+
+	// Same device after a driver update
+	EXPECT_FALSE(Sunset::is_pipeline_cache_data_valid(data, make_device_info(0x10de, 0x2684, 8)));
+	EXPECT_FALSE(Sunset::is_pipeline_cache_data_valid(data, make_device_info(0x1002, 0x2684, 7)));
+	EXPECT_FALSE(Sunset::is_pipeline_cache_data_valid(data, make_device_info(0x10de, 0x2204, 7)));
+
+	const std::vector<char> truncated_data(data.begin(), data.begin() + sizeof(Sunset::PipelineCacheHeader) - 1);
+	EXPECT_FALSE(Sunset::is_pipeline_cache_data_valid(truncated_data, device_info));
+	EXPECT_FALSE(Sunset::is_pipeline_cache_data_valid({}, device_info));
+}
+
+TEST(SunsetTests, PipelineCacheDataRoundTripsThroughDisk)
+{
+	const std::string cache_path = (std::filesystem::temp_directory_path() / "sunset_pipeline_cache_test.bin").string();
+	std::filesystem::remove(cache_path);
+
+	const Sunset::PipelineCacheDeviceInfo device_info = make_device_info(0x10de, 0x2684, 7);
+
+	std::vector<char> loaded_data;
+	EXPECT_FALSE(Sunset::load_pipeline_cache_data(cache_path, device_info, loaded_data));
+
+	const std::vector<char> data = make_cache_data(device_info, 1024);
+	ASSERT_TRUE(Sunset::save_pipeline_cache_data(cache_path, data));
+	EXPECT_TRUE(Sunset::load_pipeline_cache_data(cache_path, device_info, loaded_data));
+	EXPECT_EQ(loaded_data, data);
+
+	// A cache written by another device is dropped rather than handed to the driver
+	EXPECT_FALSE(Sunset::load_pipeline_cache_data(cache_path, make_device_info(0x1002, 0x73bf, 1), loaded_data));
+	EXPECT_TRUE(loaded_data.empty());
+
+	std::filesystem::remove(cache_path);
+}
+
+TEST(SunsetTests, PipelineStateBuildsAsynchronously)
+{
+	Sunset::GenericPipelineState<Sunset::NoopPipelineState> pipeline_state;
+	pipeline_state.initialize(nullptr);
+	EXPECT_EQ(pipeline_state.get_build_status(), Sunset::PipelineBuildStatus::Unbuilt);
+	EXPECT_FALSE(pipeline_state.is_ready());
+
+	pipeline_state.build_async(nullptr, nullptr);
+	pipeline_state.wait_for_build();
+	EXPECT_TRUE(pipeline_state.is_ready());
+
+	pipeline_state.destroy(nullptr);
+	EXPECT_EQ(pipeline_state.get_build_status(), Sunset::PipelineBuildStatus::Unbuilt);
+
+	pipeline_state.build_compute(nullptr, nullptr);
+	EXPECT_TRUE(pipeline_state.is_ready());
+}
+
+TEST(SunsetTests, PipelineStateStaysPendingUntilCreated)
+{
+	// The test environment starts the scheduler, so the build is picked up by a job thread and can be held pending
+	ASSERT_TRUE(Sunset::JobScheduler::get()->has_available_threads());
+	GatedPipelineState::b_released = false;
+	GatedPipelineState::create_count = 0;
+	GatedPipelineState::b_create_result = true;
+
+	Sunset::GenericPipelineState<GatedPipelineState> pipeline_state;
+	pipeline_state.build_async(nullptr, nullptr);
+	EXPECT_EQ(pipeline_state.get_build_status(), Sunset::PipelineBuildStatus::Pending);
+	EXPECT_FALSE(pipeline_state.is_ready());
+	GatedPipelineState::b_released = true;
+	pipeline_state.wait_for_build();
+	EXPECT_EQ(pipeline_state.get_build_status(), Sunset::PipelineBuildStatus::Ready);
+	EXPECT_EQ(GatedPipelineState::create_count, 1);
+
+	// Failed builds are never reported as ready, so draws keep skipping the pipeline
+	Sunset::GenericPipelineState<GatedPipelineState> failing_pipeline_state;
+	GatedPipelineState::b_create_result = false;
+	failing_pipeline_state.build_compute_async(nullptr, nullptr);
+	failing_pipeline_state.wait_for_build();
+	EXPECT_EQ(failing_pipeline_state.get_build_status(), Sunset::PipelineBuildStatus::Failed);
+	EXPECT_FALSE(failing_pipeline_state.is_ready());
+
+	pipeline_state.destroy(nullptr);
+	failing_pipeline_state.destroy(nullptr);
+}
@@ -0,0 +1,325 @@
+#include <gtest/gtest.h>
+#include <graphics/queue_schedule_planner.h>
+
+#include <random>
+
+namespace
+{
+	constexpr size_t QUEUE_COUNT = static_cast<size_t>(Sunset::DeviceQueueType::Num) + 1;
+
+	// Replays a schedule's command stream the way the queues would see it and checks that every cross queue use is ordered
+	// by semaphores and preceded by an ownership transfer
+	struct RecordedSchedule
+	{
+		// For each submission, the latest submission of every queue that is known to be complete before it starts
+		std::vector<std::array<int32_t, QUEUE_COUNT>> completed_before;
+		std::vector<int32_t> pass_submissions;
+	};
+
+	bool happens_before(const Sunset::QueueSchedule& schedule, const RecordedSchedule& recorded, int32_t earlier, int32_t later)
+	{
+		const size_t earlier_queue = static_cast<size_t>(schedule.submissions[earlier].queue);
+		return recorded.completed_before[later][earlier_queue] >= earlier
+			|| (earlier < later && schedule.submissions[earlier].queue == schedule.submissions[later].queue);
+	}
+
+	RecordedSchedule replay_schedule(const Sunset::QueueScheduleInput& input, const Sunset::QueueSchedule& schedule)
+	{
+		RecordedSchedule recorded;
+		recorded.pass_submissions.resize(input.passes.size(), -1);
+
+		std::vector<int32_t> semaphore_signals(schedule.semaphore_count, -1);
+		std::vector<int32_t> semaphore_waits(schedule.semaphore_count, -1);
+		std::array<int32_t, QUEUE_COUNT> last_queue_submissions;
+		last_queue_submissions.fill(-1);
+		std::array<uint32_t, QUEUE_COUNT> queue_submission_counts;
+		queue_submission_counts.fill(0);
+
+		uint32_t resource_count = static_cast<uint32_t>(input.external_resources.size());
+		for (const Sunset::QueueScheduledPass& pass : input.passes)
+		{
+			for (const uint32_t resource : pass.resources)
+			{
+				resource_count = std::max(resource_count, resource + 1);
+			}
+		}
+		std::vector<Sunset::DeviceQueueType> owners(resource_count, Sunset::DeviceQueueType::None);
+		std::vector<int32_t> last_use_submissions(resource_count, -1);
+		std::vector<int32_t> release_submissions(resource_count, -1);
+		for (uint32_t resource = 0; resource < input.external_resources.size(); ++resource)
+		{
+			owners[resource] = input.external_resources[resource] ? Sunset::DeviceQueueType::Graphics : Sunset::DeviceQueueType::None;
+		}
+
+		int32_t current_submission = -1;
+		for (const Sunset::QueueCommand& command : schedule.commands)
+		{
+			EXPECT_EQ(command.queue, schedule.submissions[command.submission].queue);
+
+			switch (command.type)
+			{
+			case Sunset::QueueCommandType::BeginSubmission:
+			{
+				EXPECT_EQ(command.submission, current_submission + 1);
+				current_submission = command.submission;
+
+				// Each queue has its own per-frame command buffers, indexed by the submission's slot on that queue
+				const uint32_t queue_slot = queue_submission_counts[static_cast<size_t>(command.queue)]++;
+				EXPECT_EQ(schedule.submissions[current_submission].queue_slot, queue_slot);
+				EXPECT_LT(queue_slot, Sunset::MAX_QUEUE_SUBMISSIONS_PER_FRAME);
+
+				std::array<int32_t, QUEUE_COUNT> completed;
+				completed.fill(-1);
+				const int32_t previous = last_queue_submissions[static_cast<size_t>(command.queue)];
+				if (previous >= 0)
+				{
+					completed = recorded.completed_before[previous];
+				}
+				recorded.completed_before.push_back(completed);
+				last_queue_submissions[static_cast<size_t>(command.queue)] = current_submission;
+				break;
+			}
+			case Sunset::QueueCommandType::WaitSemaphore:
+			{
+				EXPECT_EQ(semaphore_waits[command.index], -1);
+				semaphore_waits[command.index] = current_submission;
+
+				// Binary semaphores have to be signalled by a submission that was handed to its queue earlier
+				const int32_t signaller = semaphore_signals[command.index];
+				EXPECT_GE(signaller, 0);
+				EXPECT_LT(signaller, current_submission);
+				if (signaller >= 0)
+				{
+					std::array<int32_t, QUEUE_COUNT>& completed = recorded.completed_before[current_submission];
+					for (size_t queue = 0; queue < QUEUE_COUNT; ++queue)
+					{
+						completed[queue] = std::max(completed[queue], recorded.completed_before[signaller][queue]);
+					}
+					const size_t signaller_queue = static_cast<size_t>(schedule.submissions[signaller].queue);
+					completed[signaller_queue] = std::max(completed[signaller_queue], signaller);
+				}
+				break;
+			}
+			case Sunset::QueueCommandType::SignalSemaphore:
+				EXPECT_EQ(semaphore_signals[command.index], -1);
+				semaphore_signals[command.index] = current_submission;
+				break;
+			case Sunset::QueueCommandType::ReleaseOwnership:
+			{
+				const Sunset::QueueOwnershipTransfer& transfer = schedule.transfers[command.index];
+				EXPECT_EQ(transfer.src_queue, command.queue);
+				EXPECT_EQ(owners[transfer.resource], command.queue);
+				owners[transfer.resource] = Sunset::DeviceQueueType::None;
+				release_submissions[transfer.resource] = current_submission;
+				break;
+			}
+			case Sunset::QueueCommandType::AcquireOwnership:
+			{
+				const Sunset::QueueOwnershipTransfer& transfer = schedule.transfers[command.index];
+				EXPECT_EQ(transfer.dst_queue, command.queue);
+				EXPECT_EQ(owners[transfer.resource], Sunset::DeviceQueueType::None);
+				EXPECT_GE(release_submissions[transfer.resource], 0);
+				if (release_submissions[transfer.resource] >= 0)
+				{
+					EXPECT_TRUE(happens_before(schedule, recorded, release_submissions[transfer.resource], current_submission));
+				}
+				owners[transfer.resource] = command.queue;
+				break;
+			}
+			case Sunset::QueueCommandType::ExecutePass:
+			{
+				EXPECT_EQ(recorded.pass_submissions[command.index], -1);
+				recorded.pass_submissions[command.index] = current_submission;
+
+				for (const uint32_t resource : input.passes[command.index].resources)
+				{
+					if (owners[resource] == Sunset::DeviceQueueType::None && last_use_submissions[resource] == -1 && !(resource < input.external_resources.size() && input.external_resources[resource]))
+					{
+						// First use of a resource created this frame, its contents do not need to survive a transfer
+						owners[resource] = command.queue;
+					}
+					EXPECT_EQ(owners[resource], command.queue);
+					if (last_use_submissions[resource] >= 0 && last_use_submissions[resource] != current_submission)
+					{
+						EXPECT_TRUE(happens_before(schedule, recorded, last_use_submissions[resource], current_submission));
+					}
+					last_use_submissions[resource] = current_submission;
+				}
+				break;
+			}
+			case Sunset::QueueCommandType::EndSubmission:
+				break;
+			}
+		}
+
+		for (uint32_t semaphore = 0; semaphore < schedule.semaphore_count; ++semaphore)
+		{
+			EXPECT_GE(semaphore_signals[semaphore], 0);
+			EXPECT_GE(semaphore_waits[semaphore], 0);
+		}
+		for (uint32_t pass = 0; pass < input.passes.size(); ++pass)
+		{
+			EXPECT_GE(recorded.pass_submissions[pass], 0);
+		}
+
+		if (!schedule.submissions.empty())
+		{
+			// The frame is complete once its last submission is, so that one has to run on graphics after everything else
+			const int32_t last_submission = static_cast<int32_t>(schedule.submissions.size()) - 1;
+			EXPECT_EQ(schedule.submissions[last_submission].queue, Sunset::DeviceQueueType::Graphics);
+			for (int32_t submission = 0; submission < last_submission; ++submission)
+			{
+				EXPECT_TRUE(happens_before(schedule, recorded, submission, last_submission));
+			}
+		}
+		for (uint32_t resource = 0; resource < input.external_resources.size(); ++resource)
+		{
+			if (input.external_resources[resource])
+			{
+				EXPECT_EQ(owners[resource], Sunset::DeviceQueueType::Graphics);
+			}
+		}
+
+		return recorded;
+	}
+
+	Sunset::QueueScheduledPass graphics_pass(std::vector<uint32_t> resources)
+	{
+		return { .queue = Sunset::DeviceQueueType::Graphics, .resources = std::move(resources) };
+	}
+
+	Sunset::QueueScheduledPass compute_pass(std::vector<uint32_t> resources)
+	{
+		return { .queue = Sunset::DeviceQueueType::Compute, .resources = std::move(resources) };
+	}
+}
+
+TEST(SunsetTests, QueueScheduleKeepsGraphicsOnlyFramesInOneSubmission)
+{
+	const Sunset::QueueScheduleInput input{ .passes = { graphics_pass({ 0 }), graphics_pass({ 0, 1 }), graphics_pass({ 1 }) } };
+
+	Sunset::QueueSchedule schedule;
+	Sunset::plan_queue_schedule(input, schedule);
+	replay_schedule(input, schedule);
+
+	ASSERT_EQ(schedule.submissions.size(), 1);
+	EXPECT_EQ(schedule.submissions[0].passes.size(), 3);
+	EXPECT_EQ(schedule.semaphore_count, 0);
+	EXPECT_TRUE(schedule.transfers.empty());
+	EXPECT_FALSE(schedule.b_fell_back_to_single_queue);
+}
+
+TEST(SunsetTests, QueueScheduleOverlapsAsyncComputeWithGraphics)
+{
+	// gbuffer writes normals(0) and depth(1), SSAO reads them into ao(2) while shadows write the shadow map(3), lighting
+	// reads both into the lit image(4)
+	const Sunset::QueueScheduleInput input{ .passes =
+	{
+		graphics_pass({ 0, 1 }),
+		compute_pass({ 0, 1, 2 }),
+		graphics_pass({ 3 }),
+		graphics_pass({ 2, 3, 4 })
+	} };
+
+	Sunset::QueueSchedule schedule;
+	Sunset::plan_queue_schedule(input, schedule);
+	const RecordedSchedule recorded = replay_schedule(input, schedule);
+
+	const int32_t ssao_submission = recorded.pass_submissions[1];
+	const int32_t shadow_submission = recorded.pass_submissions[2];
+	EXPECT_EQ(schedule.submissions[ssao_submission].queue, Sunset::DeviceQueueType::Compute);
+	EXPECT_FALSE(happens_before(schedule, recorded, ssao_submission, shadow_submission));
+	EXPECT_FALSE(happens_before(schedule, recorded, shadow_submission, ssao_submission));
+
+	// Normals and depth go over to compute and the AO result comes back, nothing else moves
+	EXPECT_EQ(schedule.transfers.size(), 3);
+	EXPECT_FALSE(schedule.b_fell_back_to_single_queue);
+}
+
+TEST(SunsetTests, QueueScheduleDropsWaitsCoveredByEarlierWaits)
+{
+	// Both compute passes read what the first graphics pass wrote, but only the first one has to wait for it
+	const Sunset::QueueScheduleInput input{ .passes =
+	{
+		graphics_pass({ 0, 1 }),
+		compute_pass({ 0, 2 }),
+		compute_pass({ 1, 3 }),
+		graphics_pass({ 2, 3, 4 })
+	} };
+
+	Sunset::QueueSchedule schedule;
+	Sunset::plan_queue_schedule(input, schedule);
+	const RecordedSchedule recorded = replay_schedule(input, schedule);
+
+	EXPECT_EQ(recorded.pass_submissions[1], recorded.pass_submissions[2]);
+	const Sunset::QueueSubmission& compute_submission = schedule.submissions[recorded.pass_submissions[1]];
+	EXPECT_EQ(compute_submission.wait_semaphores.size(), 1);
+}
+
+TEST(SunsetTests, QueueScheduleReturnsExternalResourcesToGraphics)
+{
+	// A compute pass that updates an external buffer(0) nobody else reads this frame still has to finish before the frame does
+	Sunset::QueueScheduleInput input{ .passes = { graphics_pass({ 1 }), compute_pass({ 0 }) } };
+	input.external_resources = { 1, 0 };
+
+	Sunset::QueueSchedule schedule;
+	Sunset::plan_queue_schedule(input, schedule);
+	replay_schedule(input, schedule);
+
+	ASSERT_EQ(schedule.transfers.size(), 2);
+	EXPECT_EQ(schedule.transfers[0].src_pass, Sunset::QUEUE_SCHEDULE_FRAME_BOUNDARY);
+	EXPECT_EQ(schedule.transfers[0].dst_pass, 1);
+	EXPECT_EQ(schedule.transfers[1].src_pass, 1);
+	EXPECT_EQ(schedule.transfers[1].dst_pass, Sunset::QUEUE_SCHEDULE_FRAME_BOUNDARY);
+	EXPECT_TRUE(schedule.submissions.back().passes.empty());
+}
+
+TEST(SunsetTests, QueueScheduleFallsBackToOneQueueOverLimits)
+{
+	// Every pass depends on the one before it on the other queue, so each one needs its own submission
+	Sunset::QueueScheduleInput input;
+	for (uint32_t pass = 0; pass < 4 * Sunset::MAX_QUEUE_SUBMISSIONS_PER_FRAME; ++pass)
+	{
+		input.passes.push_back(pass % 2 == 0 ? graphics_pass({ pass, pass + 1 }) : compute_pass({ pass, pass + 1 }));
+	}
+
+	Sunset::QueueSchedule schedule;
+	Sunset::plan_queue_schedule(input, schedule);
+	replay_schedule(input, schedule);
+
+	EXPECT_TRUE(schedule.b_fell_back_to_single_queue);
+	ASSERT_EQ(schedule.submissions.size(), 1);
+	EXPECT_EQ(schedule.submissions[0].queue, Sunset::DeviceQueueType::Graphics);
+	EXPECT_EQ(schedule.semaphore_count, 0);
+}
+
+TEST(SunsetTests, QueueScheduleOrdersRandomGraphs)
+{
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<uint32_t> resource_dist(0, 23);
+	std::uniform_int_distribution<uint32_t> resource_count_dist(1, 4);
+	std::bernoulli_distribution compute_dist(0.3);
+	std::bernoulli_distribution external_dist(0.2);
+
+	for (int32_t iteration = 0; iteration < 64; ++iteration)
+	{
+		Sunset::QueueScheduleInput input;
+		for (uint32_t resource = 0; resource < 24; ++resource)
+		{
+			input.external_resources.push_back(external_dist(rng));
+		}
+		for (uint32_t pass = 0; pass < 16; ++pass)
+		{
+			std::vector<uint32_t> resources(resource_count_dist(rng));
+			for (uint32_t& resource : resources)
+			{
+				resource = resource_dist(rng);
+			}
+			input.passes.push_back(compute_dist(rng) ? compute_pass(resources) : graphics_pass(resources));
+		}
+
+		Sunset::QueueSchedule schedule;
+		Sunset::plan_queue_schedule(input, schedule);
+		replay_schedule(input, schedule);
+	}
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <utility/radix_sort.h>
+
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	std::vector<SortKeyIndex> make_random_items(uint32_t count, uint64_t key_mask, uint32_t seed)
+	{
+		std::mt19937_64 rng(seed);
+		std::vector<SortKeyIndex> items(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			items[i] = { .key = rng() & key_mask, .index = i };
+		}
+		return items;
+	}
+
+	void expect_stable_sorted(const std::vector<SortKeyIndex>& sorted, std::vector<SortKeyIndex> expected)
+	{
+		std::stable_sort(expected.begin(), expected.end(), [](const SortKeyIndex& first, const SortKeyIndex& second)
+		{
+			return first.key < second.key;
+		});
+
+		ASSERT_EQ(sorted.size(), expected.size());
+		for (size_t i = 0; i < sorted.size(); ++i)
+		{
+			ASSERT_EQ(sorted[i].key, expected[i].key);
+			ASSERT_EQ(sorted[i].index, expected[i].index);
+		}
+	}
+}
+
+TEST(SunsetTests, RadixSort_MatchesStableSort)
+{
+	// Full width keys, plus narrow keys with lots of duplicates to check stability
+	for (const uint64_t key_mask : { ~0ull, 0xFFull, 0xFF00000000F0ull })
+	{
+		const std::vector<SortKeyIndex> items = make_random_items(5000, key_mask, 7);
+
+		std::vector<SortKeyIndex> sorted = items;
+		std::vector<SortKeyIndex> scratch;
+		RadixSort::sort(sorted, scratch);
+
+		expect_stable_sorted(sorted, items);
+	}
+}
+
+TEST(SunsetTests, RadixSort_ParallelMatchesSerial)
+{
+	const std::vector<SortKeyIndex> items = make_random_items(100000, 0x0000FFFFF00000FFull, 11);
+
+	std::vector<SortKeyIndex> serial_sorted = items;
+	std::vector<SortKeyIndex> parallel_sorted = items;
+	std::vector<SortKeyIndex> scratch;
+	RadixSort::sort(serial_sorted, scratch);
+	RadixSort::sort_parallel(parallel_sorted, scratch);
+
+	expect_stable_sorted(serial_sorted, items);
+	expect_stable_sorted(parallel_sorted, items);
+}
+
+TEST(SunsetTests, RadixSort_TrivialInputs)
+{
+	std::vector<SortKeyIndex> scratch;
+
+	std::vector<SortKeyIndex> empty;
+	RadixSort::sort(empty, scratch);
+	RadixSort::sort_parallel(empty, scratch);
+	EXPECT_TRUE(empty.empty());
+
+	// Every pass is skipped when all keys match, leaving the input order untouched
+	std::vector<SortKeyIndex> same_keys(64);
+	for (uint32_t i = 0; i < same_keys.size(); ++i)
+	{
+		same_keys[i] = { .key = 42, .index = i };
+	}
+	RadixSort::sort(same_keys, scratch);
+	for (uint32_t i = 0; i < same_keys.size(); ++i)
+	{
+		EXPECT_EQ(same_keys[i].index, i);
+	}
+}
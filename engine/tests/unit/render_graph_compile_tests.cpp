@@ -0,0 +1,436 @@
+#include <gtest/gtest.h>
+#include <graphics/render_graph.h>
+#include <graphics/pipeline_state.h>
+#include <utility/cvar.h>
+
+namespace
+{
+	struct TestGraphHandles
+	{
+		Sunset::RGResourceHandle object_buffer;
+		Sunset::RGResourceHandle depth;
+		Sunset::RGResourceHandle albedo;
+		Sunset::RGResourceHandle normal;
+		Sunset::RGResourceHandle ssao;
+		Sunset::RGResourceHandle debug;
+		Sunset::RGResourceHandle lit;
+		Sunset::RGPassHandle debug_pass;
+		std::vector<Sunset::RGResourceHandle> all_resources;
+	};
+
+	Sunset::AttachmentConfig make_image_config(Sunset::ImageFlags flags, bool b_clear = true)
+	{
+		Sunset::AttachmentConfig config{ .name = "test_image", .flags = flags };
+		config.attachment_clear = b_clear;
+		return config;
+	}
+
+	// A small deferred-like topology: depth prepass, gbuffer, compute SSAO, an unused debug pass, lighting and present
+	TestGraphHandles build_test_graph(Sunset::RenderGraph& graph, int32_t buffered_frame, bool b_extra_lighting_input = false, bool b_async_ssao = false)
+	{
+		TestGraphHandles handles;
+		const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+
+		handles.object_buffer = graph.create_buffer(nullptr, { .name = "objects", .buffer_size = 1024 }, buffered_frame);
+		handles.depth = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil), buffered_frame);
+		handles.albedo = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), buffered_frame);
+		handles.normal = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), buffered_frame);
+		handles.ssao = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage), buffered_frame);
+		handles.debug = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), buffered_frame);
+		handles.lit = graph.create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), buffered_frame);
+		handles.all_resources = { handles.object_buffer, handles.depth, handles.albedo, handles.normal, handles.ssao, handles.debug, handles.lit };
+
+		graph.add_pass(nullptr, "depth_prepass", Sunset::RenderPassFlags::Graphics, buffered_frame, { .inputs = { handles.object_buffer }, .outputs = { handles.depth } }, no_op);
+		graph.add_pass(nullptr, "gbuffer", Sunset::RenderPassFlags::Graphics, buffered_frame, { .inputs = { handles.object_buffer, handles.depth }, .outputs = { handles.albedo, handles.normal } }, no_op);
+		const Sunset::RenderPassFlags ssao_flags = b_async_ssao ? Sunset::RenderPassFlags::Compute | Sunset::RenderPassFlags::AsyncCompute : Sunset::RenderPassFlags::Compute;
+		const Sunset::RGPassHandle ssao_pass = graph.add_pass(nullptr, "ssao", ssao_flags, buffered_frame, { .inputs = { handles.normal, handles.depth }, .outputs = { handles.ssao } }, no_op);
+		handles.debug_pass = graph.add_pass(nullptr, "debug", Sunset::RenderPassFlags::Graphics, buffered_frame, { .inputs = { handles.albedo }, .outputs = { handles.debug } }, no_op);
+
+		std::vector<Sunset::RGResourceHandle> lighting_inputs = { handles.albedo, handles.normal, handles.ssao };
+		if (b_extra_lighting_input)
+		{
+			lighting_inputs.push_back(handles.depth);
+		}
+		graph.add_pass(nullptr, "lighting", Sunset::RenderPassFlags::Graphics, buffered_frame, { .inputs = lighting_inputs, .outputs = { handles.lit } }, no_op);
+		graph.add_pass(nullptr, "present", Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::Present, buffered_frame, { .inputs = { handles.lit } }, no_op);
+
+		graph.add_pass_resource_barrier(handles.ssao, ssao_pass, Sunset::AccessFlags::ShaderWrite, Sunset::ImageLayout::General, buffered_frame);
+
+		return handles;
+	}
+
+	void expect_same_compile_output(Sunset::RenderGraph& graph_a, int32_t frame_a, Sunset::RenderGraph& graph_b, int32_t frame_b, const TestGraphHandles& handles)
+	{
+		EXPECT_EQ(graph_a.get_nonculled_passes(frame_a), graph_b.get_nonculled_passes(frame_b));
+
+		for (const Sunset::RGResourceHandle resource : handles.all_resources)
+		{
+			const std::optional<Sunset::RGResourceMetadata> metadata_a = graph_a.get_resource_metadata(resource, frame_a);
+			const std::optional<Sunset::RGResourceMetadata> metadata_b = graph_b.get_resource_metadata(resource, frame_b);
+			ASSERT_TRUE(metadata_a.has_value());
+			ASSERT_TRUE(metadata_b.has_value());
+			EXPECT_EQ(metadata_a->reference_count, metadata_b->reference_count);
+			EXPECT_EQ(metadata_a->first_user, metadata_b->first_user);
+			EXPECT_EQ(metadata_a->last_user, metadata_b->last_user);
+			EXPECT_EQ(metadata_a->access_flags, metadata_b->access_flags);
+			EXPECT_EQ(metadata_a->layouts, metadata_b->layouts);
+		}
+	}
+
+	// Stands in for a device that exposes a dedicated compute queue
+	class AsyncComputeRenderGraph : public Sunset::RenderGraph
+	{
+	public:
+		AsyncComputeRenderGraph()
+		{
+			b_async_compute_queue_available = true;
+		}
+	};
+
+	// Exposes the compile cache steps so collisions and eviction can be driven directly
+	class CompileCacheRenderGraph : public Sunset::RenderGraph
+	{
+	public:
+		using Sunset::RenderGraph::compute_graph_structure_hash;
+		using Sunset::RenderGraph::apply_compiled_graph;
+		using Sunset::RenderGraph::store_compiled_graph;
+	};
+
+	// Exposes the per-pass skip decisions recording makes, so they can be driven without a device
+	class PassSkippingRenderGraph : public Sunset::RenderGraph
+	{
+	public:
+		using Sunset::RenderGraph::reset_skipped_passes;
+		using Sunset::RenderGraph::skip_pass_executor;
+	};
+
+	// Sets an int cvar for the rest of the scope and puts the previous value back afterwards, even if an assertion bails out early
+	class ScopedIntCVar
+	{
+	public:
+		ScopedIntCVar(Sunset::Identity name, int32_t value)
+			: name(name), previous_value(*Sunset::CVarSystem::get()->get_int_cvar(name))
+		{
+			Sunset::CVarSystem::get()->set_int_cvar(name, value);
+		}
+
+		~ScopedIntCVar()
+		{
+			Sunset::CVarSystem::get()->set_int_cvar(name, previous_value);
+		}
+
+	private:
+		Sunset::Identity name;
+		int32_t previous_value;
+	};
+
+	void set_compile_cache_enabled(bool b_enabled)
+	{
+		Sunset::CVarSystem::get()->set_bool_cvar("ren.render_graph.compile_cache", b_enabled);
+	}
+}
+
+TEST(SunsetTests, RenderGraphCompileCacheHitMatchesFreshCompile)
+{
+	std::unique_ptr<Sunset::RenderGraph> reference_graph = std::make_unique<Sunset::RenderGraph>();
+	std::unique_ptr<Sunset::RenderGraph> cached_graph = std::make_unique<Sunset::RenderGraph>();
+
+	set_compile_cache_enabled(false);
+	const TestGraphHandles handles = build_test_graph(*reference_graph, 0);
+	reference_graph->compile(nullptr, nullptr, 0);
+	EXPECT_EQ(reference_graph->get_compile_stats().cache_hits + reference_graph->get_compile_stats().cache_misses, 0);
+
+	set_compile_cache_enabled(true);
+	build_test_graph(*cached_graph, 0);
+	cached_graph->compile(nullptr, nullptr, 0);
+	build_test_graph(*cached_graph, 1);
+	cached_graph->compile(nullptr, nullptr, 1);
+
+	EXPECT_EQ(cached_graph->get_compile_stats().cache_misses, 1);
+	EXPECT_EQ(cached_graph->get_compile_stats().cache_hits, 1);
+
+	expect_same_compile_output(*reference_graph, 0, *cached_graph, 0, handles);
+	expect_same_compile_output(*reference_graph, 0, *cached_graph, 1, handles);
+}
+
+TEST(SunsetTests, RenderGraphCompileCullsUnusedPasses)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+
+	const TestGraphHandles handles = build_test_graph(*graph, 0);
+	graph->compile(nullptr, nullptr, 0);
+
+	const std::vector<Sunset::RGPassHandle>& passes = graph->get_nonculled_passes(0);
+	EXPECT_EQ(passes.size(), 5);
+	EXPECT_EQ(std::find(passes.begin(), passes.end(), handles.debug_pass), passes.end());
+
+	const std::optional<Sunset::RGResourceMetadata> depth_metadata = graph->get_resource_metadata(handles.depth, 0);
+	ASSERT_TRUE(depth_metadata.has_value());
+	EXPECT_EQ(depth_metadata->first_user, 0);
+	EXPECT_EQ(depth_metadata->last_user, 2);
+	EXPECT_EQ(depth_metadata->access_flags[0], Sunset::AccessFlags::DepthStencilAttachmentWrite);
+	EXPECT_EQ(depth_metadata->layouts[1], Sunset::ImageLayout::ShaderReadOnly);
+
+	// Set through add_pass_resource_barrier, which compilation must leave alone
+	const std::optional<Sunset::RGResourceMetadata> ssao_metadata = graph->get_resource_metadata(handles.ssao, 0);
+	ASSERT_TRUE(ssao_metadata.has_value());
+	EXPECT_EQ(ssao_metadata->access_flags[2], Sunset::AccessFlags::ShaderWrite);
+	EXPECT_EQ(ssao_metadata->layouts[2], Sunset::ImageLayout::General);
+}
+
+TEST(SunsetTests, RenderGraphCompileCacheMissesOnStructureChange)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+	std::unique_ptr<Sunset::RenderGraph> reference_graph = std::make_unique<Sunset::RenderGraph>();
+
+	build_test_graph(*graph, 0);
+	graph->compile(nullptr, nullptr, 0);
+	const TestGraphHandles handles = build_test_graph(*graph, 1, true);
+	graph->compile(nullptr, nullptr, 1);
+
+	EXPECT_EQ(graph->get_compile_stats().cache_misses, 2);
+	EXPECT_EQ(graph->get_compile_stats().cache_hits, 0);
+
+	set_compile_cache_enabled(false);
+	build_test_graph(*reference_graph, 0, true);
+	reference_graph->compile(nullptr, nullptr, 0);
+	set_compile_cache_enabled(true);
+
+	expect_same_compile_output(*reference_graph, 0, *graph, 1, handles);
+}
+
+TEST(SunsetTests, RenderGraphCompileCacheRejectsHashCollisions)
+{
+	std::unique_ptr<CompileCacheRenderGraph> graph = std::make_unique<CompileCacheRenderGraph>();
+
+	build_test_graph(*graph, 0);
+	const size_t structure_hash = graph->compute_graph_structure_hash(0);
+	graph->compile(nullptr, nullptr, 0);
+
+	// A different structure looked up under the first graph's hash must not get its compile output
+	build_test_graph(*graph, 1, true);
+	graph->compute_graph_structure_hash(1);
+	EXPECT_FALSE(graph->apply_compiled_graph(structure_hash, 1));
+}
+
+TEST(SunsetTests, RenderGraphCompileCacheEvictsLeastRecentlyUsed)
+{
+	std::unique_ptr<CompileCacheRenderGraph> graph = std::make_unique<CompileCacheRenderGraph>();
+
+	build_test_graph(*graph, 0);
+	graph->compute_graph_structure_hash(0);
+
+	// Fill the cache under made up hashes, touching the first entry after every store so it stays the most recently used
+	for (size_t hash = 0; hash < Sunset::MAX_COMPILED_GRAPH_CACHE_SIZE + 4; ++hash)
+	{
+		graph->store_compiled_graph(hash, 0);
+		EXPECT_TRUE(graph->apply_compiled_graph(0, 0));
+	}
+
+	EXPECT_TRUE(graph->apply_compiled_graph(0, 0));
+	for (size_t hash = 1; hash < 5; ++hash)
+	{
+		EXPECT_FALSE(graph->apply_compiled_graph(hash, 0));
+	}
+	for (size_t hash = 5; hash < Sunset::MAX_COMPILED_GRAPH_CACHE_SIZE + 4; ++hash)
+	{
+		EXPECT_TRUE(graph->apply_compiled_graph(hash, 0));
+	}
+}
+
+TEST(SunsetTests, RenderGraphResourcesUseDenseIndices)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+
+	const TestGraphHandles handles = build_test_graph(*graph, 0);
+	graph->compile(nullptr, nullptr, 0);
+
+	// Images and buffers share one index space in creation order
+	for (uint32_t i = 0; i < handles.all_resources.size(); ++i)
+	{
+		EXPECT_EQ(Sunset::get_graph_resource_index(handles.all_resources[i]), i);
+	}
+
+	const std::optional<Sunset::RGResourceMetadata> debug_metadata = graph->get_resource_metadata(handles.debug, 0);
+	ASSERT_TRUE(debug_metadata.has_value());
+	EXPECT_EQ(debug_metadata->reference_count, 0);
+
+	const Sunset::RGResourceHandle unknown_resource = Sunset::create_graph_resource_handle(static_cast<Sunset::RGResourceIndex>(handles.all_resources.size()), static_cast<Sunset::RGResourceType>(Sunset::ResourceType::Image), 1);
+	EXPECT_FALSE(graph->get_resource_metadata(unknown_resource, 0).has_value());
+	EXPECT_FALSE(graph->get_resource_metadata(handles.depth, 1).has_value());
+}
+
+TEST(SunsetTests, RenderGraphSchedulesAsyncComputePasses)
+{
+	std::unique_ptr<AsyncComputeRenderGraph> graph = std::make_unique<AsyncComputeRenderGraph>();
+
+	const TestGraphHandles handles = build_test_graph(*graph, 0, false, true);
+	graph->compile(nullptr, nullptr, 0);
+
+	const Sunset::QueueSchedule& schedule = graph->get_queue_schedule(0);
+	EXPECT_FALSE(schedule.b_fell_back_to_single_queue);
+
+	// SSAO is the third nonculled pass and the only one allowed on the compute queue
+	uint32_t compute_submission_count{ 0 };
+	for (const Sunset::QueueSubmission& submission : schedule.submissions)
+	{
+		if (submission.queue == Sunset::DeviceQueueType::Compute)
+		{
+			++compute_submission_count;
+			EXPECT_EQ(submission.passes, std::vector<uint32_t>{ 2 });
+			EXPECT_FALSE(submission.wait_semaphores.empty());
+			EXPECT_FALSE(submission.signal_semaphores.empty());
+		}
+	}
+	EXPECT_EQ(compute_submission_count, 1);
+
+	// The gbuffer normals are handed to the compute queue for SSAO and the result is handed back for lighting
+	const auto has_transfer = [&schedule](Sunset::RGResourceHandle resource, Sunset::DeviceQueueType src_queue, Sunset::DeviceQueueType dst_queue, uint32_t dst_pass)
+	{
+		return std::find_if(schedule.transfers.begin(), schedule.transfers.end(), [=](const Sunset::QueueOwnershipTransfer& transfer)
+		{
+			return transfer.resource == static_cast<uint32_t>(Sunset::get_graph_resource_index(resource)) && transfer.src_queue == src_queue && transfer.dst_queue == dst_queue && transfer.dst_pass == dst_pass;
+		}) != schedule.transfers.end();
+	};
+	EXPECT_TRUE(has_transfer(handles.normal, Sunset::DeviceQueueType::Graphics, Sunset::DeviceQueueType::Compute, 2));
+	EXPECT_TRUE(has_transfer(handles.ssao, Sunset::DeviceQueueType::Compute, Sunset::DeviceQueueType::Graphics, 3));
+}
+
+TEST(SunsetTests, RenderGraphKeepsAsyncComputeOnGraphicsQueueWithoutComputeQueue)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+
+	build_test_graph(*graph, 0, false, true);
+	graph->compile(nullptr, nullptr, 0);
+
+	const Sunset::QueueSchedule& schedule = graph->get_queue_schedule(0);
+	ASSERT_EQ(schedule.submissions.size(), 1);
+	EXPECT_EQ(schedule.submissions[0].queue, Sunset::DeviceQueueType::Graphics);
+	EXPECT_EQ(schedule.submissions[0].passes.size(), graph->get_nonculled_passes(0).size());
+	EXPECT_TRUE(schedule.transfers.empty());
+	EXPECT_EQ(schedule.semaphore_count, 0);
+}
+
+TEST(SunsetTests, RenderGraphPlansFewerBarriersForDeferredGraph)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+	const ScopedIntCVar split_barrier_min_distance("ren.render_graph.split_barrier_min_distance", 2);
+
+	const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+
+	// GPU driven variant of the deferred graph, the culled draw arguments are consumed as indirect commands and as shader reads
+	const Sunset::RGResourceHandle draw_args = graph->create_buffer(nullptr, { .name = "draw_args", .buffer_size = 1024 }, 0);
+	const Sunset::RGResourceHandle depth = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil), 0);
+	const Sunset::RGResourceHandle albedo = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), 0);
+	const Sunset::RGResourceHandle normal = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), 0);
+	const Sunset::RGResourceHandle ssao = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage), 0);
+	const Sunset::RGResourceHandle lit = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), 0);
+
+	graph->add_pass(nullptr, "cull", Sunset::RenderPassFlags::Compute, 0, { .outputs = { draw_args } }, no_op);
+	const Sunset::RGPassHandle depth_pass = graph->add_pass(nullptr, "depth_prepass", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { draw_args }, .outputs = { depth } }, no_op);
+	const Sunset::RGPassHandle gbuffer_pass = graph->add_pass(nullptr, "gbuffer", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { draw_args, depth }, .outputs = { albedo, normal } }, no_op);
+	const Sunset::RGPassHandle ssao_pass = graph->add_pass(nullptr, "ssao", Sunset::RenderPassFlags::Compute, 0, { .inputs = { normal, depth }, .outputs = { ssao } }, no_op);
+	const Sunset::RGPassHandle lighting_pass = graph->add_pass(nullptr, "lighting", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { albedo, normal, ssao, draw_args }, .outputs = { lit } }, no_op);
+	graph->add_pass(nullptr, "present", Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::Present, 0, { .inputs = { lit } }, no_op);
+
+	graph->add_pass_resource_barrier(draw_args, depth_pass, Sunset::AccessFlags::IndirectCommandRead, Sunset::ImageLayout::Undefined, 0);
+	graph->add_pass_resource_barrier(draw_args, gbuffer_pass, Sunset::AccessFlags::IndirectCommandRead, Sunset::ImageLayout::Undefined, 0);
+	graph->add_pass_resource_barrier(ssao, ssao_pass, Sunset::AccessFlags::ShaderWrite, Sunset::ImageLayout::General, 0);
+
+	graph->compile(nullptr, nullptr, 0);
+
+	const Sunset::BarrierPlan& plan = graph->get_barrier_plan(0);
+	EXPECT_EQ(plan.unoptimized_barrier_count, 13);
+	// The lighting pass' shader read of the draw arguments is folded into the depth prepass' barrier
+	EXPECT_EQ(plan.barriers.size(), 12);
+	// Albedo is not read again until two passes after the gbuffer, so its transition is split around the SSAO pass
+	EXPECT_EQ(plan.split_barrier_count, 1);
+
+	const std::optional<Sunset::RGResourceMetadata> draw_args_metadata = graph->get_resource_metadata(draw_args, 0);
+	ASSERT_TRUE(draw_args_metadata.has_value());
+	EXPECT_EQ(draw_args_metadata->access_flags[depth_pass], Sunset::AccessFlags::IndirectCommandRead | Sunset::AccessFlags::ShaderRead);
+	EXPECT_EQ(draw_args_metadata->access_flags[lighting_pass], Sunset::AccessFlags::ShaderRead);
+
+	const ScopedIntCVar no_split_barrier_min_distance("ren.render_graph.split_barrier_min_distance", 0);
+	build_test_graph(*graph, 1);
+	graph->compile(nullptr, nullptr, 1);
+	EXPECT_EQ(graph->get_barrier_plan(1).split_barrier_count, 0);
+}
+
+TEST(SunsetTests, RenderGraphPlansParallelPassRecording)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+
+	const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+	const Sunset::RenderPassFlags parallel_graphics = Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::ParallelRecord;
+
+	const Sunset::RGResourceHandle shadow = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil), 0);
+	const Sunset::RGResourceHandle depth = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Depth | Sunset::ImageFlags::DepthStencil), 0);
+	const Sunset::RGResourceHandle albedo = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), 0);
+	const Sunset::RGResourceHandle ssao = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color | Sunset::ImageFlags::Storage), 0);
+	const Sunset::RGResourceHandle lit = graph->create_image(nullptr, make_image_config(Sunset::ImageFlags::Color), 0);
+
+	graph->add_pass(nullptr, "shadow", parallel_graphics, 0, { .outputs = { shadow }, .record_chunk_count = 4 }, no_op);
+	graph->add_pass(nullptr, "gbuffer", parallel_graphics, 0, { .outputs = { albedo, depth }, .record_chunk_count = 2 }, no_op);
+	graph->add_pass(nullptr, "ssao", Sunset::RenderPassFlags::Compute, 0, { .inputs = { depth }, .outputs = { ssao } }, no_op);
+	graph->add_pass(nullptr, "lighting", parallel_graphics, 0, { .inputs = { shadow, albedo, ssao }, .outputs = { lit } }, no_op);
+	graph->add_pass(nullptr, "present", Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::Present, 0, { .inputs = { lit } }, no_op);
+
+	graph->compile(nullptr, nullptr, 0);
+
+	const Sunset::CommandRecordingPlan& plan = graph->get_recording_plan(0);
+	ASSERT_EQ(plan.pass_first_slots.size(), 5);
+	EXPECT_EQ(plan.slot_count, 7);
+	// The SSAO pass is recorded on the recording thread, which splits the parallel passes into two batches
+	ASSERT_EQ(plan.batches.size(), 2);
+	EXPECT_EQ(plan.batches[0].first_pass, 0);
+	EXPECT_EQ(plan.batches[0].pass_count, 2);
+	EXPECT_EQ(plan.batches[0].slot_count, 6);
+	EXPECT_EQ(plan.batches[1].first_pass, 3);
+	EXPECT_EQ(plan.batches[1].slot_count, 1);
+	EXPECT_EQ(plan.pass_first_slots[2], Sunset::COMMAND_RECORDING_INLINE_PASS);
+	EXPECT_EQ(plan.pass_first_slots[4], Sunset::COMMAND_RECORDING_INLINE_PASS);
+}
+
+TEST(SunsetTests, RenderGraphSkipsReadersOfPassesWithPendingPipelines)
+{
+	std::unique_ptr<PassSkippingRenderGraph> graph = std::make_unique<PassSkippingRenderGraph>();
+
+	Sunset::GenericPipelineState<Sunset::NoopPipelineState> ready_pipeline_state;
+	ready_pipeline_state.build(nullptr, nullptr);
+	Sunset::GenericPipelineState<Sunset::NoopPipelineState> pending_pipeline_state;
+	pending_pipeline_state.initialize(nullptr);
+	ASSERT_TRUE(ready_pipeline_state.is_ready());
+	ASSERT_FALSE(pending_pipeline_state.is_ready());
+
+	build_test_graph(*graph, 0);
+	graph->compile(nullptr, nullptr, 0);
+
+	// Depth prepass, gbuffer, SSAO, lighting and present, with only the gbuffer still waiting on its pipeline
+	const std::vector<Sunset::RGPassHandle>& passes = graph->get_nonculled_passes(0);
+	ASSERT_EQ(passes.size(), 5);
+	const Sunset::RGPassHandle gbuffer_pass = passes[1];
+
+	graph->reset_skipped_passes(0);
+	for (const Sunset::RGPassHandle pass : passes)
+	{
+		const bool b_pipeline_ready = pass == gbuffer_pass ? pending_pipeline_state.is_ready() : ready_pipeline_state.is_ready();
+		graph->skip_pass_executor(pass, b_pipeline_ready, 0);
+	}
+
+	EXPECT_FALSE(graph->is_pass_skipped(passes[0], 0));
+	EXPECT_TRUE(graph->is_pass_skipped(gbuffer_pass, 0));
+	// SSAO reads the gbuffer normals and lighting reads SSAO, so both skip even though their pipelines are ready
+	EXPECT_TRUE(graph->is_pass_skipped(passes[2], 0));
+	EXPECT_TRUE(graph->is_pass_skipped(passes[3], 0));
+	EXPECT_TRUE(graph->is_pass_skipped(passes[4], 0));
+
+	// Once the producer is ready nothing downstream is held back
+	pending_pipeline_state.build(nullptr, nullptr);
+	graph->reset_skipped_passes(0);
+	for (const Sunset::RGPassHandle pass : passes)
+	{
+		const bool b_pipeline_ready = pass == gbuffer_pass ? pending_pipeline_state.is_ready() : ready_pipeline_state.is_ready();
+		EXPECT_FALSE(graph->skip_pass_executor(pass, b_pipeline_ready, 0));
+	}
+}
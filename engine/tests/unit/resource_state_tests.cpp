@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <minimal.h>
+#include <graphics/resource_types.h>
+
+TEST(SunsetTests, ResourceStateHashCoversEveryField)
+{
+	const Sunset::ResourceStateData base
+	{
+		.vertex_buffer = 1,
+		.index_buffer = 2,
+		.vertex_count = 300,
+		.index_count = 900,
+		.index_start = 0,
+		.vertex_offset = 0
+	};
+	const size_t base_hash = std::hash<Sunset::ResourceStateData>{}(base);
+
+	Sunset::ResourceStateData changed = base;
+	changed.vertex_count = 301;
+	EXPECT_NE(std::hash<Sunset::ResourceStateData>{}(changed), base_hash);
+
+	changed = base;
+	changed.vertex_buffer = 2;
+	changed.index_buffer = 1;
+	EXPECT_NE(std::hash<Sunset::ResourceStateData>{}(changed), base_hash);
+
+	// Buffer IDs are 64 bits, so IDs that only differ in their upper half must not collide
+	changed = base;
+	changed.vertex_buffer = base.vertex_buffer | (size_t(1) << 40);
+	EXPECT_NE(std::hash<Sunset::ResourceStateData>{}(changed), base_hash);
+
+	changed = base;
+	changed.vertex_offset = -1;
+	EXPECT_NE(std::hash<Sunset::ResourceStateData>{}(changed), base_hash);
+
+	EXPECT_EQ(std::hash<Sunset::ResourceStateData>{}(Sunset::ResourceStateData(base)), base_hash);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <utility/simd/sphere_cull_batch.h>
+#include <job_system/job_scheduler.h>
+
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	SphereCullView make_box_view(float max_distance)
+	{
+		// Inward facing planes of a 60 x 40 x 60 box in front of the origin
+		SphereCullView view;
+		view.planes[0] = glm::vec4(1.0f, 0.0f, 0.0f, 30.0f);
+		view.planes[1] = glm::vec4(-1.0f, 0.0f, 0.0f, 30.0f);
+		view.planes[2] = glm::vec4(0.0f, 1.0f, 0.0f, 20.0f);
+		view.planes[3] = glm::vec4(0.0f, -1.0f, 0.0f, 20.0f);
+		view.planes[4] = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+		view.planes[5] = glm::vec4(0.0f, 0.0f, -1.0f, 60.0f);
+		view.plane_count = 6;
+		view.position = glm::vec3(0.0f);
+		view.max_distance = max_distance;
+		return view;
+	}
+
+	SphereCullBatch make_random_batch(uint32_t count)
+	{
+		std::mt19937 rng(21);
+		std::uniform_real_distribution<float> position_dist(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> radius_dist(0.1f, 5.0f);
+
+		SphereCullBatch batch;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			batch.add(glm::vec3(position_dist(rng), position_dist(rng), position_dist(rng)), radius_dist(rng));
+		}
+		return batch;
+	}
+
+	bool reference_visible(const SphereCullBatch& batch, const SphereCullView& view, size_t i)
+	{
+		const glm::vec3 center(batch.center_x[i], batch.center_y[i], batch.center_z[i]);
+		for (uint32_t p = 0; p < view.plane_count; ++p)
+		{
+			if (center.x * view.planes[p].x + center.y * view.planes[p].y + center.z * view.planes[p].z + view.planes[p].w <= -batch.radius[i])
+			{
+				return false;
+			}
+		}
+		if (view.max_distance > 0.0f)
+		{
+			return glm::length(center - view.position) <= view.max_distance + batch.radius[i];
+		}
+		return true;
+	}
+}
+
+TEST(SunsetTests, SphereCull_SIMDLevelsMatchReference)
+{
+	// Odd count so every SIMD path also exercises its scalar tail
+	SphereCullBatch batch = make_random_batch(1003);
+
+	for (float max_distance : { 0.0f, 45.0f })
+	{
+		const SphereCullView view = make_box_view(max_distance);
+		for (SIMDLevel simd_level : { SIMDLevel::Scalar, SIMDLevel::SSE41, SIMDLevel::AVX2 })
+		{
+			std::fill(batch.visibility.begin(), batch.visibility.end(), uint8_t(2));
+			SphereCullOps::cull(batch, view, 0, batch.size(), simd_level);
+
+			size_t visible_count = 0;
+			for (size_t i = 0; i < batch.size(); ++i)
+			{
+				ASSERT_EQ(batch.visibility[i], reference_visible(batch, view, i) ? 1 : 0);
+				visible_count += batch.visibility[i];
+			}
+			EXPECT_GT(visible_count, 0);
+			EXPECT_LT(visible_count, batch.size());
+		}
+	}
+}
+
+TEST(SunsetTests, SphereCull_RangesOnlyTouchTheirSpheres)
+{
+	SphereCullBatch batch = make_random_batch(100);
+	std::fill(batch.visibility.begin(), batch.visibility.end(), uint8_t(2));
+
+	SphereCullOps::cull(batch, make_box_view(0.0f), 13, 61, SIMDLevel::AVX2);
+
+	for (size_t i = 0; i < batch.size(); ++i)
+	{
+		if (i < 13 || i >= 61)
+		{
+			EXPECT_EQ(batch.visibility[i], 2);
+		}
+		else
+		{
+			EXPECT_LE(batch.visibility[i], 1);
+		}
+	}
+}
+
+TEST(SunsetTests, SphereCull_ParallelCountsCulledSpheres)
+{
+	SphereCullBatch batch = make_random_batch(20000);
+	const SphereCullView view = make_box_view(0.0f);
+
+	// Enough spheres to be split into several chunks, which run on the job threads the test environment starts
+	ASSERT_TRUE(JobScheduler::get()->has_available_threads());
+
+	const size_t culled_count = SphereCullOps::cull_parallel(batch, view);
+
+	size_t expected_culled = 0;
+	for (size_t i = 0; i < batch.size(); ++i)
+	{
+		expected_culled += reference_visible(batch, view, i) ? 0 : 1;
+	}
+	EXPECT_EQ(culled_count, expected_culled);
+}
+
+TEST(SunsetTests, SphereCull_NoPlanesKeepsEverything)
+{
+	SphereCullBatch batch = make_random_batch(37);
+	SphereCullView view;
+
+	EXPECT_EQ(SphereCullOps::cull_parallel(batch, view), 0);
+	EXPECT_EQ(std::count(batch.visibility.begin(), batch.visibility.end(), uint8_t(1)), 37);
+}
+
+TEST(SunsetTests, SphereCull_FrustumPlanesSkipNearFarWithoutDistanceCheck)
+{
+	const SphereCullView box_view = make_box_view(0.0f);
+
+	SphereCullBatch batch;
+	// Inside the side planes but past the far plane
+	batch.add(glm::vec3(0.0f, 0.0f, 80.0f), 1.0f);
+
+	for (SIMDLevel simd_level : { SIMDLevel::Scalar, SIMDLevel::SSE41, SIMDLevel::AVX2 })
+	{
+		SphereCullView view = box_view;
+		SphereCullOps::set_frustum_planes(view, box_view.planes, false);
+		EXPECT_EQ(view.plane_count, SPHERE_CULL_SIDE_PLANE_COUNT);
+		SphereCullOps::cull(batch, view, 0, batch.size(), simd_level);
+		EXPECT_EQ(batch.visibility[0], 1);
+
+		SphereCullOps::set_frustum_planes(view, box_view.planes, true);
+		EXPECT_EQ(view.plane_count, MAX_SPHERE_CULL_PLANES);
+		SphereCullOps::cull(batch, view, 0, batch.size(), simd_level);
+		EXPECT_EQ(batch.visibility[0], 0);
+	}
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <core/layers/scene.h>
+#include <core/subsystem_tick_graph.h>
+
+using namespace Sunset;
+
+namespace
+{
+	struct TickTestComponentA
+	{
+		int32_t value{ 0 };
+	};
+
+	struct TickTestComponentB
+	{
+		int32_t value{ 0 };
+	};
+
+	std::atomic_int32_t g_tick_sequence{ 0 };
+
+	class TickTestSubsystem : public Subsystem
+	{
+	public:
+		virtual void initialize(class Scene* scene) override { };
+		virtual void destroy(class Scene* scene) override { };
+		virtual void update(class Scene* scene, double delta_time) override
+		{
+			update_sequence = g_tick_sequence++;
+		}
+
+		int32_t update_sequence{ -1 };
+	};
+
+	class WriterA : public TickTestSubsystem
+	{
+	public:
+		virtual void declare_access(SubsystemAccess& access) override
+		{
+			access.write<TickTestComponentA>();
+		}
+	};
+
+	class ReaderA : public TickTestSubsystem
+	{
+	public:
+		virtual void declare_access(SubsystemAccess& access) override
+		{
+			access.read<TickTestComponentA>();
+		}
+	};
+
+	class WriterB : public TickTestSubsystem
+	{
+	public:
+		virtual void declare_access(SubsystemAccess& access) override
+		{
+			access.write<TickTestComponentB>();
+		}
+	};
+
+	class ReaderB : public TickTestSubsystem
+	{
+	public:
+		virtual void declare_access(SubsystemAccess& access) override
+		{
+			access.read<TickTestComponentB>();
+		}
+	};
+
+	class AfterReaderA : public TickTestSubsystem
+	{
+	public:
+		virtual void declare_access(SubsystemAccess& access) override
+		{
+			access.read<TickTestComponentB>()
+				.run_after<ReaderA>();
+		}
+	};
+
+	class Undeclared : public TickTestSubsystem
+	{ };
+
+	int32_t index_of(Scene& scene, Subsystem* subsystem)
+	{
+		for (int32_t i = 0; i < scene.subsystems.size(); ++i)
+		{
+			if (scene.subsystems[i].get() == subsystem)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+}
+
+TEST(SunsetTests, SubsystemTickGraph_OrderingGuarantees)
+{
+	Scene scene;
+
+	WriterA* const writer_a = scene.add_subsystem<WriterA>();
+	WriterB* const writer_b = scene.add_subsystem<WriterB>();
+	ReaderA* const reader_a = scene.add_subsystem<ReaderA>();
+	ReaderB* const reader_b = scene.add_subsystem<ReaderB>();
+	AfterReaderA* const after_reader_a = scene.add_subsystem<AfterReaderA>();
+	Undeclared* const undeclared = scene.add_subsystem<Undeclared>();
+
+	EXPECT_EQ(scene.get_subsystem<ReaderA>(), reader_a);
+	EXPECT_EQ(scene.get_subsystem<Undeclared>(), undeclared);
+
+	const SubsystemTickGraph& graph = scene.get_subsystem_graph();
+
+	// Independent writers share a wave, readers wait on their writers
+	EXPECT_FALSE(graph.is_ordered_before(index_of(scene, writer_a), index_of(scene, writer_b)));
+	EXPECT_TRUE(graph.is_ordered_before(index_of(scene, writer_a), index_of(scene, reader_a)));
+	EXPECT_TRUE(graph.is_ordered_before(index_of(scene, writer_b), index_of(scene, reader_b)));
+	// Readers of different components don't depend on each other
+	EXPECT_FALSE(graph.is_ordered_before(index_of(scene, reader_a), index_of(scene, reader_b)));
+	// Explicit ordering holds even without a component conflict
+	EXPECT_TRUE(graph.is_ordered_before(index_of(scene, reader_a), index_of(scene, after_reader_a)));
+	// Undeclared subsystems run after everything registered before them
+	for (int32_t i = 0; i < index_of(scene, undeclared); ++i)
+	{
+		EXPECT_TRUE(graph.is_ordered_before(i, index_of(scene, undeclared)));
+	}
+
+	for (uint32_t frame = 0; frame < 8; ++frame)
+	{
+		scene.update(0.0);
+
+		EXPECT_LT(writer_a->update_sequence, reader_a->update_sequence);
+		EXPECT_LT(writer_b->update_sequence, reader_b->update_sequence);
+		EXPECT_LT(reader_a->update_sequence, after_reader_a->update_sequence);
+		EXPECT_LT(after_reader_a->update_sequence, undeclared->update_sequence);
+		EXPECT_LT(reader_b->update_sequence, undeclared->update_sequence);
+	}
+}
+
+TEST(SunsetTests, SubsystemTickGraph_RemoveSubsystem)
+{
+	Scene scene;
+
+	scene.add_subsystem<WriterA>();
+	scene.add_subsystem<ReaderA>();
+	EXPECT_EQ(scene.get_subsystem_graph().get_waves().size(), 2);
+
+	scene.remove_subsystem<WriterA>();
+	EXPECT_EQ(scene.get_subsystem<WriterA>(), nullptr);
+	EXPECT_NE(scene.get_subsystem<ReaderA>(), nullptr);
+	EXPECT_EQ(scene.get_subsystem_graph().get_waves().size(), 1);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <utility/simd/transform_batch.h>
+#include <core/ecs/components/transform_component.h>
+
+#include <random>
+
+using namespace Sunset;
+
+namespace
+{
+	constexpr float transform_tolerance = 1e-4f;
+
+	// Odd count so every SIMD path also exercises its scalar tail
+	constexpr size_t test_transform_count = 1027;
+
+	std::vector<TransformComponent> make_random_transforms(size_t count)
+	{
+		std::mt19937 rng(1337);
+		std::uniform_real_distribution<float> position_dist(-1000.0f, 1000.0f);
+		std::uniform_real_distribution<float> rotation_dist(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> scale_dist(0.01f, 10.0f);
+
+		std::vector<TransformComponent> transforms(count);
+		for (TransformComponent& transform_comp : transforms)
+		{
+			transform_comp.transform.position = glm::vec3(position_dist(rng), position_dist(rng), position_dist(rng));
+			// Deliberately left unnormalized, recalculation is expected to normalize it
+			transform_comp.transform.rotation = glm::quat(rotation_dist(rng), rotation_dist(rng), rotation_dist(rng), rotation_dist(rng));
+			transform_comp.transform.scale = glm::vec3(scale_dist(rng), scale_dist(rng), scale_dist(rng));
+		}
+		return transforms;
+	}
+
+	void expect_matrices_near(const glm::mat4& expected, const glm::mat4& actual)
+	{
+		for (int column = 0; column < 4; ++column)
+		{
+			for (int row = 0; row < 4; ++row)
+			{
+				const float scale = std::max(1.0f, std::abs(expected[column][row]));
+				EXPECT_NEAR(expected[column][row], actual[column][row], transform_tolerance * scale);
+			}
+		}
+	}
+
+	void test_batch_matches_scalar(SIMDLevel simd_level)
+	{
+		std::vector<TransformComponent> transforms = make_random_transforms(test_transform_count);
+		std::vector<glm::mat4> batched_matrices(transforms.size());
+
+		TransformBatch batch;
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			batch.add(transforms[i].transform.position, transforms[i].transform.rotation, transforms[i].transform.scale, &batched_matrices[i]);
+		}
+
+		TransformBatchOps::compose(batch, simd_level);
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			recalculate_transform(&transforms[i]);
+			expect_matrices_near(transforms[i].transform.local_matrix, batched_matrices[i]);
+		}
+	}
+}
+
+TEST(SunsetTests, TransformBatch_ScalarMatchesGLM)
+{
+	test_batch_matches_scalar(SIMDLevel::Scalar);
+}
+
+TEST(SunsetTests, TransformBatch_SSE41MatchesScalar)
+{
+	if (CPUFeatures::get_simd_level() < SIMDLevel::SSE41)
+	{
+		GTEST_SKIP() << "SSE4.1 not supported on this CPU";
+	}
+	test_batch_matches_scalar(SIMDLevel::SSE41);
+}
+
+TEST(SunsetTests, TransformBatch_AVX2MatchesScalar)
+{
+	if (CPUFeatures::get_simd_level() < SIMDLevel::AVX2)
+	{
+		GTEST_SKIP() << "AVX2 not supported on this CPU";
+	}
+	test_batch_matches_scalar(SIMDLevel::AVX2);
+}
+
+TEST(SunsetTests, TransformBatch_ZeroRotationIsIdentity)
+{
+	glm::mat4 matrices[8];
+
+	TransformBatch batch;
+	for (glm::mat4& matrix : matrices)
+	{
+		batch.add(glm::vec3(1.0f, 2.0f, 3.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f), &matrix);
+	}
+
+	TransformBatchOps::compose(batch);
+
+	const glm::mat4 expected = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+	for (const glm::mat4& matrix : matrices)
+	{
+		expect_matrices_near(expected, matrix);
+	}
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <graphics/transient_aliasing_planner.h>
+#include <graphics/render_graph.h>
+
+#include <random>
+
+namespace
+{
+	void expect_valid_plan(const std::vector<Sunset::TransientResourceLifetime>& lifetimes, const Sunset::TransientAliasingPlan& plan)
+	{
+		ASSERT_EQ(plan.placements.size(), lifetimes.size());
+
+		for (uint32_t i = 0; i < lifetimes.size(); ++i)
+		{
+			const Sunset::TransientPlacement& placement = plan.placements[i];
+			ASSERT_LT(placement.heap, plan.heap_sizes.size());
+			EXPECT_EQ(placement.offset % lifetimes[i].alignment, 0);
+			EXPECT_LE(placement.offset + lifetimes[i].size, plan.heap_sizes[placement.heap]);
+
+			for (uint32_t j = i + 1; j < lifetimes.size(); ++j)
+			{
+				const bool b_same_heap = placement.heap == plan.placements[j].heap;
+				const bool b_time_overlap = lifetimes[i].first_pass <= lifetimes[j].last_pass && lifetimes[j].first_pass <= lifetimes[i].last_pass;
+				const bool b_memory_overlap = placement.offset < plan.placements[j].offset + lifetimes[j].size && plan.placements[j].offset < placement.offset + lifetimes[i].size;
+				EXPECT_FALSE(b_same_heap && b_time_overlap && b_memory_overlap);
+			}
+		}
+
+		EXPECT_GE(plan.aliased_bytes, plan.peak_live_bytes);
+		EXPECT_LE(plan.aliased_bytes, plan.unaliased_bytes);
+	}
+}
+
+TEST(SunsetTests, TransientAliasingNeverOverlapsLiveResources)
+{
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int32_t> pass_dist(0, 40);
+	std::uniform_int_distribution<int32_t> length_dist(0, 8);
+	std::uniform_int_distribution<size_t> size_dist(1, 64 * 1024);
+	std::uniform_int_distribution<uint32_t> alignment_shift_dist(0, 12);
+
+	for (int32_t iteration = 0; iteration < 32; ++iteration)
+	{
+		std::vector<Sunset::TransientResourceLifetime> lifetimes(64);
+		for (Sunset::TransientResourceLifetime& lifetime : lifetimes)
+		{
+			lifetime.first_pass = pass_dist(rng);
+			lifetime.last_pass = lifetime.first_pass + length_dist(rng);
+			lifetime.size = size_dist(rng);
+			lifetime.alignment = size_t(1) << alignment_shift_dist(rng);
+		}
+
+		Sunset::TransientAliasingPlan plan;
+		Sunset::plan_transient_aliasing(lifetimes, plan);
+		expect_valid_plan(lifetimes, plan);
+	}
+}
+
+TEST(SunsetTests, TransientAliasingPacksDisjointLifetimesIntoOneHeap)
+{
+	const std::vector<Sunset::TransientResourceLifetime> lifetimes =
+	{
+		{ .first_pass = 0, .last_pass = 1, .size = 1024, .alignment = 256 },
+		{ .first_pass = 2, .last_pass = 3, .size = 1024, .alignment = 256 },
+		{ .first_pass = 4, .last_pass = 5, .size = 512, .alignment = 256 },
+		{ .first_pass = 6, .last_pass = 6, .size = 1024, .alignment = 256 }
+	};
+
+	Sunset::TransientAliasingPlan plan;
+	Sunset::plan_transient_aliasing(lifetimes, plan);
+	expect_valid_plan(lifetimes, plan);
+
+	EXPECT_EQ(plan.heap_sizes.size(), 1);
+	EXPECT_EQ(plan.unaliased_bytes, 3584);
+	EXPECT_EQ(plan.aliased_bytes, 1024);
+	EXPECT_EQ(plan.peak_live_bytes, 1024);
+}
+
+TEST(SunsetTests, TransientAliasingKeepsOverlappingLifetimesApart)
+{
+	const std::vector<Sunset::TransientResourceLifetime> lifetimes =
+	{
+		{ .first_pass = 0, .last_pass = 4, .size = 1000, .alignment = 1 },
+		{ .first_pass = 2, .last_pass = 6, .size = 1000, .alignment = 1 },
+		{ .first_pass = 4, .last_pass = 8, .size = 1000, .alignment = 1 }
+	};
+
+	Sunset::TransientAliasingPlan plan;
+	Sunset::plan_transient_aliasing(lifetimes, plan);
+	expect_valid_plan(lifetimes, plan);
+
+	EXPECT_EQ(plan.aliased_bytes, plan.unaliased_bytes);
+	EXPECT_EQ(plan.peak_live_bytes, 3000);
+	EXPECT_TRUE(plan.barriers.empty());
+}
+
+TEST(SunsetTests, TransientAliasingFillsGapsNextToLiveResources)
+{
+	// The first resource sizes the heap, the later ones are packed side by side into it once it is done
+	const std::vector<Sunset::TransientResourceLifetime> lifetimes =
+	{
+		{ .first_pass = 0, .last_pass = 1, .size = 4096, .alignment = 1024 },
+		{ .first_pass = 2, .last_pass = 5, .size = 2048, .alignment = 1024 },
+		{ .first_pass = 3, .last_pass = 4, .size = 1000, .alignment = 1024 },
+		{ .first_pass = 3, .last_pass = 4, .size = 1000, .alignment = 1024 }
+	};
+
+	Sunset::TransientAliasingPlan plan;
+	Sunset::plan_transient_aliasing(lifetimes, plan);
+	expect_valid_plan(lifetimes, plan);
+
+	EXPECT_EQ(plan.heap_sizes.size(), 1);
+	EXPECT_EQ(plan.aliased_bytes, 4096);
+	EXPECT_EQ(plan.placements[2].offset, 2048);
+	EXPECT_EQ(plan.placements[3].offset, 3072);
+}
+
+TEST(SunsetTests, TransientAliasingBarriersOnlyWaitOnLatestPreviousUser)
+{
+	const std::vector<Sunset::TransientResourceLifetime> lifetimes =
+	{
+		{ .first_pass = 0, .last_pass = 0, .size = 256, .alignment = 256 },
+		{ .first_pass = 1, .last_pass = 1, .size = 256, .alignment = 256 },
+		{ .first_pass = 2, .last_pass = 3, .size = 256, .alignment = 256 }
+	};
+
+	Sunset::TransientAliasingPlan plan;
+	Sunset::plan_transient_aliasing(lifetimes, plan);
+	expect_valid_plan(lifetimes, plan);
+
+	// Resource 2 only has to wait on resource 1, which already waited on resource 0
+	ASSERT_EQ(plan.barriers.size(), 2);
+	EXPECT_EQ(plan.barriers[0].pass, 1);
+	EXPECT_EQ(plan.barriers[0].before, 0);
+	EXPECT_EQ(plan.barriers[0].after, 1);
+	EXPECT_EQ(plan.barriers[1].pass, 2);
+	EXPECT_EQ(plan.barriers[1].before, 1);
+	EXPECT_EQ(plan.barriers[1].after, 2);
+}
+
+TEST(SunsetTests, RenderGraphPlansAliasingForGraphCreatedResources)
+{
+	std::unique_ptr<Sunset::RenderGraph> graph = std::make_unique<Sunset::RenderGraph>();
+	const auto no_op = [](Sunset::RenderGraph&, Sunset::RGFrameData&, void*) {};
+
+	const auto make_color_config = [](Sunset::Format format)
+	{
+		return Sunset::AttachmentConfig{ .name = "color", .format = format, .extent = glm::vec3(1920.0f, 1080.0f, 1.0f), .flags = Sunset::ImageFlags::Color };
+	};
+
+	const Sunset::RGResourceHandle albedo = graph->create_image(nullptr, make_color_config(Sunset::Format::Float4x32), 0);
+	const Sunset::RGResourceHandle ssao = graph->create_image(nullptr, make_color_config(Sunset::Format::Float32), 0);
+	const Sunset::RGResourceHandle ssao_blurred = graph->create_image(nullptr, make_color_config(Sunset::Format::Float32), 0);
+	const Sunset::RGResourceHandle lit = graph->create_image(nullptr, make_color_config(Sunset::Format::Float4x32), 0);
+	const Sunset::RGResourceHandle tonemapped = graph->create_image(nullptr, make_color_config(Sunset::Format::Float4x32), 0);
+
+	graph->add_pass(nullptr, "gbuffer", Sunset::RenderPassFlags::Graphics, 0, { .outputs = { albedo } }, no_op);
+	graph->add_pass(nullptr, "ssao", Sunset::RenderPassFlags::Compute, 0, { .inputs = { albedo }, .outputs = { ssao } }, no_op);
+	graph->add_pass(nullptr, "ssao_blur", Sunset::RenderPassFlags::Compute, 0, { .inputs = { ssao }, .outputs = { ssao_blurred } }, no_op);
+	graph->add_pass(nullptr, "lighting", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { albedo, ssao_blurred }, .outputs = { lit } }, no_op);
+	graph->add_pass(nullptr, "tonemap", Sunset::RenderPassFlags::Graphics, 0, { .inputs = { lit }, .outputs = { tonemapped } }, no_op);
+	graph->add_pass(nullptr, "present", Sunset::RenderPassFlags::Graphics | Sunset::RenderPassFlags::Present, 0, { .inputs = { tonemapped } }, no_op);
+
+	graph->compile(nullptr, nullptr, 0);
+
+	const std::vector<Sunset::RGResourceHandle>& transient_resources = graph->get_transient_resources(0);
+	const Sunset::TransientAliasingPlan& plan = graph->get_transient_aliasing_plan(0);
+	EXPECT_EQ(transient_resources.size(), 5);
+	ASSERT_EQ(plan.placements.size(), transient_resources.size());
+
+	constexpr size_t color_size = 1920 * 1080 * 16;
+	constexpr size_t ssao_size = 1920 * 1080 * 4;
+	EXPECT_EQ(plan.unaliased_bytes, 3 * color_size + 2 * ssao_size);
+	// The tonemapped image reuses the albedo memory and SSAO runs in the memory lighting writes to later
+	EXPECT_EQ(plan.aliased_bytes, 2 * color_size + ssao_size);
+	EXPECT_FALSE(plan.barriers.empty());
+}
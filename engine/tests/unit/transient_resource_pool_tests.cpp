@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <graphics/transient_resource_pool.h>
+#include <graphics/resource/image.h>
+
+namespace
+{
+	using NoopPoolImage = Sunset::GenericImage<Sunset::NoopImage>;
+
+	// Backs the pool with Noop images and keeps track of how many are alive
+	class NoopImagePoolPolicy
+	{
+	public:
+		using ConfigType = Sunset::AttachmentConfig;
+		using ResourceID = Sunset::ImageID;
+
+		size_t hash(const Sunset::AttachmentConfig& config) const
+		{
+			return Sunset::hash_transient_image_config(config);
+		}
+
+		Sunset::ImageID create(class Sunset::GraphicsContext* const gfx_context, const Sunset::AttachmentConfig& config, uint64_t unique_id)
+		{
+			images.push_back(std::make_unique<NoopPoolImage>());
+			images.back()->initialize(gfx_context, config);
+			++alive_count;
+			return images.size();
+		}
+
+		void destroy(class Sunset::GraphicsContext* const gfx_context, Sunset::ImageID image)
+		{
+			images[image - 1]->destroy(gfx_context);
+			images[image - 1].reset();
+			--alive_count;
+		}
+
+		std::vector<std::unique_ptr<NoopPoolImage>> images;
+		int32_t alive_count{ 0 };
+	};
+	using NoopImagePool = Sunset::GenericTransientResourcePool<NoopImagePoolPolicy>;
+
+	Sunset::AttachmentConfig make_pool_image_config(float width, float height)
+	{
+		return Sunset::AttachmentConfig{ .name = "pooled", .format = Sunset::Format::Float4x16, .extent = glm::vec3(width, height, 1.0f), .flags = Sunset::ImageFlags::Color };
+	}
+}
+
+TEST(SunsetTests, TransientResourcePoolWaitsForBufferedFramesBeforeReuse)
+{
+	NoopImagePool pool;
+	const Sunset::AttachmentConfig config = make_pool_image_config(1920.0f, 1080.0f);
+
+	pool.begin_frame(nullptr, 0);
+	const Sunset::ImageID first = pool.acquire(nullptr, config);
+	pool.release(first);
+
+	// The previous frame may still be in flight, so its image cannot be handed out yet
+	pool.begin_frame(nullptr, 1);
+	const Sunset::ImageID second = pool.acquire(nullptr, config);
+	EXPECT_NE(first, second);
+	EXPECT_EQ(pool.get_stats().frame_creations, 1);
+	pool.release(second);
+
+	pool.begin_frame(nullptr, Sunset::MAX_BUFFERED_FRAMES);
+	EXPECT_EQ(pool.acquire(nullptr, config), first);
+	EXPECT_EQ(pool.get_stats().frame_creations, 0);
+	EXPECT_EQ(pool.get_stats().frame_reuses, 1);
+}
+
+TEST(SunsetTests, TransientResourcePoolStopsCreatingInSteadyState)
+{
+	NoopImagePool pool;
+	const Sunset::AttachmentConfig gbuffer_config = make_pool_image_config(1920.0f, 1080.0f);
+	const Sunset::AttachmentConfig half_res_config = make_pool_image_config(960.0f, 540.0f);
+
+	for (uint64_t frame = 0; frame < 32; ++frame)
+	{
+		pool.begin_frame(nullptr, frame);
+
+		std::vector<Sunset::ImageID> frame_images;
+		for (int32_t i = 0; i < 3; ++i)
+		{
+			frame_images.push_back(pool.acquire(nullptr, gbuffer_config));
+		}
+		frame_images.push_back(pool.acquire(nullptr, half_res_config));
+
+		if (frame >= Sunset::MAX_BUFFERED_FRAMES)
+		{
+			EXPECT_EQ(pool.get_stats().frame_creations, 0);
+			EXPECT_EQ(pool.get_stats().frame_reuses, 4);
+		}
+
+		for (const Sunset::ImageID image : frame_images)
+		{
+			pool.release(image);
+		}
+	}
+
+	EXPECT_EQ(pool.get_stats().total_creations, 4 * Sunset::MAX_BUFFERED_FRAMES);
+	EXPECT_EQ(pool.get_policy().alive_count, 4 * Sunset::MAX_BUFFERED_FRAMES);
+}
+
+TEST(SunsetTests, TransientResourcePoolKeepsDescriptionsApart)
+{
+	NoopImagePool pool;
+
+	pool.begin_frame(nullptr, 0);
+	const Sunset::ImageID image = pool.acquire(nullptr, make_pool_image_config(1920.0f, 1080.0f));
+	pool.release(image);
+
+	pool.begin_frame(nullptr, 4);
+	EXPECT_NE(pool.acquire(nullptr, make_pool_image_config(1280.0f, 720.0f)), image);
+	EXPECT_EQ(pool.get_stats().frame_creations, 1);
+}
+
+TEST(SunsetTests, TransientResourcePoolAgesOutUnusedResources)
+{
+	NoopImagePool pool;
+	const Sunset::AttachmentConfig config = make_pool_image_config(1920.0f, 1080.0f);
+	constexpr uint32_t max_unused_frames = 4;
+
+	pool.begin_frame(nullptr, 0, max_unused_frames);
+	pool.release(pool.acquire(nullptr, config));
+
+	pool.begin_frame(nullptr, max_unused_frames, max_unused_frames);
+	EXPECT_EQ(pool.get_stats().frame_evictions, 0);
+	EXPECT_EQ(pool.get_stats().free_count, 1);
+
+	pool.begin_frame(nullptr, max_unused_frames + 1, max_unused_frames);
+	EXPECT_EQ(pool.get_stats().frame_evictions, 1);
+	EXPECT_EQ(pool.get_stats().free_count, 0);
+	EXPECT_EQ(pool.get_policy().alive_count, 0);
+}
+
+TEST(SunsetTests, TransientResourcePoolDestroysEverything)
+{
+	NoopImagePool pool;
+	const Sunset::AttachmentConfig config = make_pool_image_config(1920.0f, 1080.0f);
+
+	pool.begin_frame(nullptr, 0);
+	pool.release(pool.acquire(nullptr, config));
+	pool.acquire(nullptr, config);
+	EXPECT_EQ(pool.get_policy().alive_count, 2);
+
+	pool.destroy(nullptr);
+	EXPECT_EQ(pool.get_policy().alive_count, 0);
+	EXPECT_EQ(pool.get_stats().acquired_count, 0);
+	EXPECT_EQ(pool.get_stats().free_count, 0);
+}
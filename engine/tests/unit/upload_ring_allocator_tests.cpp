@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <graphics/upload_ring_allocator.h>
+
+TEST(SunsetTests, UploadRingAllocatorAlignsSequentialAllocations)
+{
+	Sunset::UploadRingAllocator allocator(256);
+
+	EXPECT_EQ(allocator.allocate(10, 16), 0);
+	EXPECT_EQ(allocator.allocate(8, 16), 16);
+	EXPECT_EQ(allocator.allocate(4, 4), 24);
+	EXPECT_EQ(allocator.get_used_size(), 28);
+}
+
+TEST(SunsetTests, UploadRingAllocatorFailsWhenFull)
+{
+	Sunset::UploadRingAllocator allocator(64);
+
+	EXPECT_EQ(allocator.allocate(48, 16), 0);
+	EXPECT_EQ(allocator.allocate(16, 16), 48);
+	EXPECT_EQ(allocator.allocate(1, 1), Sunset::UploadRingAllocator::INVALID_OFFSET);
+	EXPECT_EQ(allocator.allocate(128, 16), Sunset::UploadRingAllocator::INVALID_OFFSET);
+}
+
+TEST(SunsetTests, UploadRingAllocatorReclaimsCompletedFrames)
+{
+	Sunset::UploadRingAllocator allocator(64);
+
+	EXPECT_EQ(allocator.allocate(32, 16), 0);
+	allocator.end_frame(1);
+	EXPECT_EQ(allocator.allocate(32, 16), 32);
+	allocator.end_frame(2);
+	EXPECT_EQ(allocator.get_in_flight_frame_count(), 2);
+
+	EXPECT_EQ(allocator.allocate(16, 16), Sunset::UploadRingAllocator::INVALID_OFFSET);
+
+	// Fence 1 is not done yet, nothing gets freed
+	allocator.reclaim(0);
+	EXPECT_EQ(allocator.get_used_size(), 64);
+
+	allocator.reclaim(1);
+	EXPECT_EQ(allocator.get_in_flight_frame_count(), 1);
+	EXPECT_EQ(allocator.get_used_size(), 32);
+	EXPECT_EQ(allocator.allocate(32, 16), 0);
+	EXPECT_EQ(allocator.allocate(1, 1), Sunset::UploadRingAllocator::INVALID_OFFSET);
+}
+
+TEST(SunsetTests, UploadRingAllocatorChargesWrapPaddingToFrame)
+{
+	Sunset::UploadRingAllocator allocator(100);
+
+	EXPECT_EQ(allocator.allocate(40, 4), 0);
+	allocator.end_frame(1);
+	EXPECT_EQ(allocator.allocate(40, 4), 40);
+	allocator.end_frame(2);
+	allocator.reclaim(1);
+
+	// 20 bytes are left at the end of the ring, too few for this allocation, so it wraps to the start
+	EXPECT_EQ(allocator.allocate(30, 4), 0);
+	EXPECT_EQ(allocator.get_used_size(), 40 + 20 + 30);
+	allocator.end_frame(3);
+
+	allocator.reclaim(2);
+	EXPECT_EQ(allocator.get_used_size(), 50);
+	allocator.reclaim(3);
+	EXPECT_EQ(allocator.get_used_size(), 0);
+	EXPECT_EQ(allocator.get_in_flight_frame_count(), 0);
+}
+
+TEST(SunsetTests, UploadRingAllocatorRestartsAtZeroWhenEmpty)
+{
+	Sunset::UploadRingAllocator allocator(64);
+
+	EXPECT_EQ(allocator.allocate(48, 16), 0);
+	allocator.end_frame(1);
+	allocator.reclaim(1);
+
+	// The whole ring is free again, so a large allocation fits even though the head was near the end
+	EXPECT_EQ(allocator.allocate(64, 16), 0);
+}
+
+TEST(SunsetTests, UploadRingAllocatorSkipsEmptyFrames)
+{
+	Sunset::UploadRingAllocator allocator(64);
+
+	allocator.end_frame(1);
+	EXPECT_EQ(allocator.get_in_flight_frame_count(), 0);
+
+	EXPECT_EQ(allocator.allocate(16, 16), 0);
+	allocator.end_frame(2);
+	allocator.end_frame(3);
+	EXPECT_EQ(allocator.get_in_flight_frame_count(), 1);
+}
+
+TEST(SunsetTests, UploadRingAllocatorSteadyStateFramesDoNotOverlap)
+{
+	constexpr size_t frame_upload_size = 24;
+	constexpr uint64_t buffered_frames = 2;
+
+	Sunset::UploadRingAllocator allocator(100);
+
+	std::vector<std::pair<size_t, uint64_t>> live_ranges;
+	for (uint64_t fence = 1; fence < 64; ++fence)
+	{
+		// Mimics the renderer: the fence of the frame that last used this buffered slot is waited on first
+		const uint64_t completed = fence > buffered_frames ? fence - buffered_frames : 0;
+		allocator.reclaim(completed);
+		std::erase_if(live_ranges, [completed](const auto& range) { return range.second <= completed; });
+
+		const size_t offset = allocator.allocate(frame_upload_size, 8);
+		ASSERT_NE(offset, Sunset::UploadRingAllocator::INVALID_OFFSET);
+		ASSERT_LE(offset + frame_upload_size, allocator.get_capacity());
+		for (const auto& [live_offset, live_fence] : live_ranges)
+		{
+			EXPECT_TRUE(offset + frame_upload_size <= live_offset || live_offset + frame_upload_size <= offset);
+		}
+		live_ranges.push_back({ offset, fence });
+
+		allocator.end_frame(fence);
+	}
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <graphics/upload_scheduler.h>
+
+namespace
+{
+	using NoopUploadQueue = Sunset::GenericCommandQueue<Sunset::NoopCommandQueue>;
+	using NoopUploadScheduler = Sunset::GenericUploadScheduler<NoopUploadQueue>;
+
+	// Noop queue whose batches only complete when the test says so
+	class ManualFenceCommandQueue : public Sunset::NoopCommandQueue
+	{
+	public:
+		void submit_upload_batch(class Sunset::GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			b_slot_complete[batch_slot] = false;
+			++submit_count;
+		}
+
+		bool is_upload_batch_complete(class Sunset::GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			return b_slot_complete[batch_slot];
+		}
+
+		void wait_for_upload_batch(class Sunset::GraphicsContext* const gfx_context, uint32_t batch_slot)
+		{
+			b_slot_complete[batch_slot] = true;
+		}
+
+		bool b_slot_complete[Sunset::MAX_UPLOAD_BATCHES_IN_FLIGHT]{ true, true, true, true };
+		uint32_t submit_count{ 0 };
+	};
+	using ManualUploadScheduler = Sunset::GenericUploadScheduler<ManualFenceCommandQueue>;
+}
+
+TEST(SunsetTests, UploadSchedulerBatchesUploadsIntoOneSubmission)
+{
+	NoopUploadQueue queue;
+	NoopUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	int32_t recorded_count = 0;
+	std::vector<Sunset::UploadHandle> handles;
+	for (int32_t i = 0; i < 16; ++i)
+	{
+		handles.push_back(scheduler.enqueue([&recorded_count](void* command_buffer) { ++recorded_count; }));
+	}
+
+	EXPECT_EQ(recorded_count, 0);
+	EXPECT_EQ(scheduler.get_stats().submitted_batches, 0);
+
+	scheduler.flush(nullptr);
+
+	EXPECT_EQ(recorded_count, 16);
+	EXPECT_EQ(scheduler.get_stats().queued_uploads, 16);
+	EXPECT_EQ(scheduler.get_stats().submitted_batches, 1);
+
+	// Flushing with nothing pending does not submit an empty batch
+	scheduler.flush(nullptr);
+	EXPECT_EQ(scheduler.get_stats().submitted_batches, 1);
+}
+
+TEST(SunsetTests, UploadSchedulerCompletesOnRetire)
+{
+	NoopUploadQueue queue;
+	NoopUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	std::vector<int32_t> completion_order;
+	const Sunset::UploadHandle first = scheduler.enqueue([](void*) {}, [&completion_order]() { completion_order.push_back(0); });
+	const Sunset::UploadHandle second = scheduler.enqueue([](void*) {}, [&completion_order]() { completion_order.push_back(1); });
+
+	scheduler.flush(nullptr);
+
+	// Submitted is not completed, the fence has to be checked first
+	EXPECT_FALSE(scheduler.is_complete(first));
+	EXPECT_TRUE(completion_order.empty());
+
+	scheduler.retire(nullptr);
+
+	EXPECT_TRUE(scheduler.is_complete(first));
+	EXPECT_TRUE(scheduler.is_complete(second));
+	EXPECT_EQ(completion_order, std::vector<int32_t>({ 0, 1 }));
+	EXPECT_EQ(scheduler.get_stats().retired_batches, 1);
+}
+
+TEST(SunsetTests, UploadSchedulerWaitFlushesPendingUploads)
+{
+	NoopUploadQueue queue;
+	NoopUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	bool b_completed{ false };
+	const Sunset::UploadHandle handle = scheduler.enqueue([](void*) {}, [&b_completed]() { b_completed = true; });
+
+	scheduler.wait(nullptr, handle);
+
+	EXPECT_TRUE(scheduler.is_complete(handle));
+	EXPECT_TRUE(b_completed);
+	EXPECT_EQ(scheduler.get_stats().submitted_batches, 1);
+}
+
+TEST(SunsetTests, UploadSchedulerRetiresOnlyFinishedBatches)
+{
+	ManualFenceCommandQueue queue;
+	ManualUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	const Sunset::UploadHandle first = scheduler.enqueue([](void*) {});
+	scheduler.flush(nullptr);
+	const Sunset::UploadHandle second = scheduler.enqueue([](void*) {});
+	scheduler.flush(nullptr);
+
+	// Batches retire in submission order, so a finished second batch waits behind the first
+	queue.b_slot_complete[1] = true;
+	scheduler.retire(nullptr);
+	EXPECT_FALSE(scheduler.is_complete(first));
+	EXPECT_FALSE(scheduler.is_complete(second));
+
+	queue.b_slot_complete[0] = true;
+	scheduler.retire(nullptr);
+	EXPECT_TRUE(scheduler.is_complete(first));
+	EXPECT_TRUE(scheduler.is_complete(second));
+	EXPECT_EQ(scheduler.get_stats().retired_batches, 2);
+}
+
+TEST(SunsetTests, UploadSchedulerWaitsOnOldestBatchWhenSlotsAreFull)
+{
+	ManualFenceCommandQueue queue;
+	ManualUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	std::vector<Sunset::UploadHandle> handles;
+	for (uint32_t i = 0; i < Sunset::MAX_UPLOAD_BATCHES_IN_FLIGHT + 1; ++i)
+	{
+		handles.push_back(scheduler.enqueue([](void*) {}));
+		scheduler.flush(nullptr);
+	}
+
+	EXPECT_EQ(queue.submit_count, Sunset::MAX_UPLOAD_BATCHES_IN_FLIGHT + 1);
+	EXPECT_TRUE(scheduler.is_complete(handles.front()));
+	EXPECT_FALSE(scheduler.is_complete(handles[1]));
+
+	scheduler.wait_all(nullptr);
+	for (const Sunset::UploadHandle handle : handles)
+	{
+		EXPECT_TRUE(scheduler.is_complete(handle));
+	}
+}
+
+TEST(SunsetTests, UploadSchedulerCompletionCanQueueUploads)
+{
+	NoopUploadQueue queue;
+	NoopUploadScheduler scheduler;
+	scheduler.initialize(&queue);
+
+	Sunset::UploadHandle follow_up;
+	scheduler.enqueue([](void*) {}, [&scheduler, &follow_up]() { follow_up = scheduler.enqueue([](void*) {}); });
+	scheduler.flush(nullptr);
+	scheduler.retire(nullptr);
+
+	EXPECT_NE(follow_up.value, 0);
+	EXPECT_FALSE(scheduler.is_complete(follow_up));
+
+	scheduler.wait_all(nullptr);
+	EXPECT_TRUE(scheduler.is_complete(follow_up));
+}
@@ -152,16 +152,8 @@ namespace Sunset
 			}
 
 			// Add spheres
-			for (uint32_t i = 0; i < 100; ++i)
 			{
-				EntityID mesh_ent = scene->make_entity();
-
-				TransformComponent* const transform_comp = scene->assign_component<TransformComponent>(mesh_ent);
-
-				set_position(transform_comp, glm::vec3((i / 10.0f) * 2.0f, 10.0f + (i / 50.0f) * 2.0f, (i % 10) * 2.0f));
-				set_scale(transform_comp, glm::vec3(1.0f));
-
-				MeshComponent* const mesh_comp = scene->assign_component<MeshComponent>(mesh_ent);
+				constexpr uint32_t sphere_count = 100;
 
 				MaterialID drone_material = MaterialFactory::create(
 					Renderer::get()->context(),
@@ -179,20 +171,36 @@ namespace Sunset
 					}
 				);
 
+				EntityPrefab<TransformComponent, MeshComponent, BodyComponent> sphere_prefab;
+
+				MeshComponent* const mesh_comp = &sphere_prefab.get<MeshComponent>();
 				set_mesh(mesh_comp, MeshFactory::create_sphere(Renderer::get()->context(), glm::ivec2(32, 32), 1.0f));
 				set_material(mesh_comp, drone_material);
 				set_custom_bounds_scale(mesh_comp, 2.0f);
 
-				BodyComponent* const body_comp = scene->assign_component<BodyComponent>(mesh_ent);
+				BodyComponent* const body_comp = &sphere_prefab.get<BodyComponent>();
+				set_body_type(body_comp, PhysicsBodyType::Dynamic);
+				set_body_gravity_scale(body_comp, 1.0f);
+				set_body_restitution(body_comp, 0.5f);
+
+				std::vector<EntityID> sphere_entities;
+				std::vector<BodyComponent*> sphere_bodies;
+				sphere_bodies.reserve(sphere_count);
+
+				scene->instantiate(sphere_prefab, sphere_count, sphere_entities,
+					[&sphere_bodies](uint32_t i, EntityID entity, TransformComponent& transform_comp, MeshComponent& mesh_comp, BodyComponent& body_comp)
+					{
+						set_position(&transform_comp, glm::vec3((i / 10.0f) * 2.0f, 10.0f + (i / 50.0f) * 2.0f, (i % 10) * 2.0f));
+						set_scale(&transform_comp, glm::vec3(1.0f));
+						sphere_bodies.push_back(&body_comp);
+					}
+				);
 
 				SphereShapeDescription sphere_shape
 				{
-					.radius = 1.0f		
+					.radius = 1.0f
 				};
-				set_body_shape(body_comp, sphere_shape);
-				set_body_type(body_comp, PhysicsBodyType::Dynamic);
-				set_body_gravity_scale(body_comp, 1.0f);
-				set_body_restitution(body_comp, 0.5f);
+				set_body_shapes(sphere_bodies.data(), sphere_count, sphere_shape);
 			}
 
 			SimulationCore::get()->register_layer(std::move(scene));